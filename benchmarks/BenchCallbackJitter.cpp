@@ -0,0 +1,326 @@
+/**
+ * Callback jitter benchmark
+ *
+ * Runs an input and an output callback on two threads while a third thread keeps changing
+ * settings the way the UI does while a slider is dragged, and reports the distribution of
+ * the time each callback takes.
+ *
+ * The first part runs a model of the state the callbacks share twice: laid out by topic,
+ * as the layer used to be (meters, counters and settings written by different threads on
+ * the same cache lines), and partitioned into one cache-line-aligned block per writing
+ * thread, as the layer is now. The work per callback is identical; only the layout
+ * differs, so the difference in spread is the cost of false sharing. The second part
+ * drives the callbacks of AudioProcessingLayer itself (mock devices) the same way.
+ *
+ * Each thread needs a core of its own for the figures to mean anything.
+ *
+ * Usage: bench-callback-jitter [model callbacks] [layer callbacks]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+#include <AudioProcessingLayer.h>
+#include <CacheLine.h>
+#include <mocks/MockAudioDevice.h>
+
+using namespace PrecisionTuner::Layers;
+using PrecisionTuner::Audio::kCacheLineSize;
+
+namespace
+{
+    constexpr uint32_t kSampleRate = 48000;
+    constexpr uint32_t kBufferSize = 128;
+    constexpr uint32_t kOutputChannels = 2;
+
+    /** Prevents the compiler from optimising away benchmark results */
+    std::atomic<float> gSink = 0.0f;
+
+    /** Shared state laid out by topic: every thread writes into the same few lines */
+    struct PackedState
+    {
+        std::atomic<bool> monitoringEnabled{ true };    ///< Main thread
+        std::atomic<float> inputGain{ 1.0f };           ///< Main thread
+        std::atomic<float> currentInputLevel{ 0.0f };   ///< Input callback
+        std::atomic<float> currentInputRms{ 0.0f };     ///< Input callback
+        std::atomic<uint64_t> samplesQueued{ 0 };       ///< Input callback
+        std::atomic<uint64_t> monitoringUnderruns{ 0 }; ///< Output callback
+        double phase = 0.0;                             ///< Output callback (generator)
+        std::atomic<float> volume{ 0.5f };              ///< Main thread
+        std::atomic<float> frequency{ 440.0f };         ///< Main thread
+        std::atomic<uint64_t> versionApplied{ 0 };      ///< Output callback
+        uint64_t framesRendered = 0;                    ///< Output callback
+    };
+
+    /** The same state partitioned into one cache-line-aligned block per writing thread */
+    struct PartitionedState
+    {
+        alignas(kCacheLineSize) std::atomic<bool> monitoringEnabled{ true };
+        std::atomic<float> inputGain{ 1.0f };
+        std::atomic<float> volume{ 0.5f };
+        std::atomic<float> frequency{ 440.0f };
+
+        alignas(kCacheLineSize) std::atomic<float> currentInputLevel{ 0.0f };
+        std::atomic<float> currentInputRms{ 0.0f };
+        std::atomic<uint64_t> samplesQueued{ 0 };
+
+        alignas(kCacheLineSize) double phase = 0.0;
+        std::atomic<uint64_t> monitoringUnderruns{ 0 };
+        std::atomic<uint64_t> versionApplied{ 0 };
+        uint64_t framesRendered = 0;
+    };
+
+    /** Gain, meters and queue bookkeeping, as in ConditionInput */
+    template<typename State> void ModelInput(State &state, std::span<const float> input, std::span<float> processing)
+    {
+        const float gain = state.inputGain.load(std::memory_order_relaxed);
+        float peak = 0.0f;
+        float sumSquares = 0.0f;
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            processing[i] = input[i] * gain;
+            peak = std::max(peak, std::abs(processing[i]));
+            sumSquares += processing[i] * processing[i];
+        }
+        state.currentInputLevel.store(peak, std::memory_order_relaxed);
+        state.currentInputRms.store(std::sqrt(sumSquares / static_cast<float>(input.size())),
+            std::memory_order_relaxed);
+        if (state.monitoringEnabled.load(std::memory_order_relaxed))
+        {
+            state.samplesQueued.fetch_add(input.size(), std::memory_order_release);
+        }
+    }
+
+    /** One sine generator plus the feedback bookkeeping, as in MixFeedback */
+    template<typename State> void ModelOutput(State &state, std::span<float> output, uint64_t version)
+    {
+        const float volume = state.volume.load(std::memory_order_relaxed);
+        const double step = 2.0 * 3.14159265358979323846 * state.frequency.load(std::memory_order_relaxed)
+                            / static_cast<double>(kSampleRate);
+        double phase = state.phase;
+        for (size_t frame = 0; frame < output.size() / kOutputChannels; ++frame)
+        {
+            const auto sample = static_cast<float>(std::sin(phase)) * volume;
+            output[frame * kOutputChannels] = sample;
+            output[frame * kOutputChannels + 1] = sample;
+            phase += step;
+        }
+        state.phase = std::fmod(phase, 2.0 * 3.14159265358979323846);
+        state.versionApplied.store(version, std::memory_order_relaxed);
+        state.framesRendered += output.size() / kOutputChannels;
+        if (state.samplesQueued.load(std::memory_order_acquire) == 0)
+        {
+            state.monitoringUnderruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    struct Distribution
+    {
+        double mean = 0.0;
+        double stddev = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    Distribution Summarize(std::vector<double> samples)
+    {
+        Distribution result;
+        if (samples.empty())
+        {
+            return result;
+        }
+        double sum = 0.0;
+        for (double sample : samples)
+        {
+            sum += sample;
+        }
+        result.mean = sum / static_cast<double>(samples.size());
+        double variance = 0.0;
+        for (double sample : samples)
+        {
+            variance += (sample - result.mean) * (sample - result.mean);
+        }
+        result.stddev = std::sqrt(variance / static_cast<double>(samples.size()));
+        std::sort(samples.begin(), samples.end());
+        result.p50 = samples[samples.size() / 2];
+        result.p99 = samples[samples.size() * 99 / 100];
+        result.max = samples.back();
+        return result;
+    }
+
+    void PrintRow(const char *name, const char *thread, const Distribution &distribution)
+    {
+        std::printf("%-12s %-7s %10.0f %10.0f %10.0f %10.0f %10.0f\n",
+            name,
+            thread,
+            distribution.mean,
+            distribution.stddev,
+            distribution.p50,
+            distribution.p99,
+            distribution.max);
+    }
+
+    /**
+     * Calls fn() `count` times and records how long each call took (ns)
+     * With a period, each call starts `period` after the previous one (spinning in between,
+     * outside the timed region); without one, calls run back to back.
+     */
+    template<typename Fn> std::vector<double> TimeCalls(size_t count, std::chrono::nanoseconds period, Fn &&fn)
+    {
+        std::vector<double> durations;
+        durations.reserve(count);
+        const auto first = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < count; ++i)
+        {
+            while (std::chrono::steady_clock::now() < first + period * static_cast<int64_t>(i))
+            {
+            }
+            const auto start = std::chrono::steady_clock::now();
+            fn();
+            durations.push_back(
+                std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+        }
+        return durations;
+    }
+
+    std::vector<float> Signal(size_t frames)
+    {
+        std::vector<float> signal(frames);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            signal[i] = 0.5f * std::sin(2.0f * 3.14159265f * 110.0f * static_cast<float>(i) / kSampleRate);
+        }
+        return signal;
+    }
+
+    /** Both model callbacks on their own threads, settings changed continuously from a third */
+    template<typename State> void RunModel(const char *name, size_t callbacks)
+    {
+        auto state = std::make_unique<State>();
+        const std::vector<float> input = Signal(kBufferSize);
+        std::atomic<uint32_t> running = 2;
+        std::atomic<uint64_t> version = 0;
+
+        std::thread ui([&]() {
+            for (uint64_t step = 0; running.load(std::memory_order_relaxed) > 0; ++step)
+            {
+                const float position = static_cast<float>(step % 1000) / 1000.0f;
+                state->inputGain.store(0.5f + position, std::memory_order_relaxed);
+                state->volume.store(position, std::memory_order_relaxed);
+                state->frequency.store(430.0f + 20.0f * position, std::memory_order_relaxed);
+                version.store(step, std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<double> inputTimes;
+        std::thread inputThread([&]() {
+            std::vector<float> processing(kBufferSize);
+            inputTimes = TimeCalls(callbacks, {}, [&]() { ModelInput(*state, input, processing); });
+            gSink.store(processing[0], std::memory_order_relaxed);
+            running.fetch_sub(1);
+        });
+
+        std::vector<double> outputTimes;
+        std::thread outputThread([&]() {
+            std::vector<float> output(kBufferSize * kOutputChannels);
+            outputTimes = TimeCalls(callbacks,
+                {},
+                [&]() { ModelOutput(*state, output, version.load(std::memory_order_relaxed)); });
+            gSink.store(output[0], std::memory_order_relaxed);
+            running.fetch_sub(1);
+        });
+
+        inputThread.join();
+        outputThread.join();
+        ui.join();
+
+        PrintRow(name, "input", Summarize(std::move(inputTimes)));
+        PrintRow(name, "output", Summarize(std::move(outputTimes)));
+    }
+
+    /** AudioProcessingLayer's own callbacks, paced at 4x real time, with UI updates and meter reads */
+    void RunLayer(size_t callbacks)
+    {
+        auto inputMock = std::make_unique<MockAudioDevice>();
+        auto outputMock = std::make_unique<MockAudioDevice>();
+        MockAudioDevice *inputDevice = inputMock.get();
+        MockAudioDevice *outputDevice = outputMock.get();
+
+        AudioProcessingLayerConfig config;
+        config.sampleRate = kSampleRate;
+        config.bufferSize = kBufferSize;
+        config.duplexMode = DuplexMode::Off;
+        AudioProcessingLayer layer(config, std::move(inputMock), std::move(outputMock));
+
+        PrecisionTuner::AudioConfig feedback;
+        feedback.enableInputMonitoring = true;
+        feedback.enableReference = true;
+        layer.UpdateAudioFeedback(feedback);
+
+        const std::vector<float> input = Signal(kBufferSize);
+        const uint32_t channels = std::max<uint32_t>(outputDevice->GetConfig().outputChannels, 1);
+        const auto period = std::chrono::nanoseconds(1000000000ull * kBufferSize / kSampleRate / 4);
+        std::atomic<uint32_t> running = 2;
+
+        std::thread ui([&]() {
+            for (uint64_t step = 0; running.load(std::memory_order_relaxed) > 0; ++step)
+            {
+                const float position = static_cast<float>(step % 1000) / 1000.0f;
+                feedback.inputGain = 0.5f + position;
+                feedback.referenceVolume = position;
+                layer.UpdateAudioFeedback(feedback);
+                gSink.store(layer.GetInputLevel() + static_cast<float>(layer.GetMonitoringStats().overruns),
+                    std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<double> inputTimes;
+        std::thread inputThread([&]() {
+            std::vector<float> unused(kBufferSize);
+            inputTimes = TimeCalls(callbacks, period, [&]() { (void)inputDevice->TriggerCallback(input, unused); });
+            running.fetch_sub(1);
+        });
+
+        std::vector<double> outputTimes;
+        std::thread outputThread([&]() {
+            std::vector<float> output(kBufferSize * channels);
+            outputTimes = TimeCalls(callbacks, period, [&]() { (void)outputDevice->TriggerCallback({}, output); });
+            gSink.store(output[0], std::memory_order_relaxed);
+            running.fetch_sub(1);
+        });
+
+        inputThread.join();
+        outputThread.join();
+        ui.join();
+
+        PrintRow("layer", "input", Summarize(std::move(inputTimes)));
+        PrintRow("layer", "output", Summarize(std::move(outputTimes)));
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t modelCallbacks = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200000;
+    const size_t layerCallbacks = argc > 2 ? static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)) : 4000;
+
+    std::printf("%u frames per callback, %u Hz; times in ns\n", kBufferSize, kSampleRate);
+    if (std::thread::hardware_concurrency() < 3)
+    {
+        std::printf("Fewer than 3 cores: the threads take turns and no cache line is ever contended\n");
+    }
+    std::printf("%-12s %-7s %10s %10s %10s %10s %10s\n", "layout", "thread", "mean", "stddev", "p50", "p99", "max");
+    RunModel<PackedState>("packed", modelCallbacks);
+    RunModel<PartitionedState>("partitioned", modelCallbacks);
+    RunLayer(layerCallbacks);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * Capture format benchmark
+ *
+ * Compares the two ways an integer device buffer can reach the analysis path:
+ *  - backend: the audio backend converts the buffer to float (one scalar pass into its own
+ *    buffer, as RtAudio and the ALSA plug layer do), then the fused float kernel applies gain
+ *  - native: the fused conditioning kernel converts, applies gain and meters in one pass
+ *
+ * Reports CPU cost per sample and the per-buffer conditioning latency (p50 / p99) for each
+ * integer format and typical buffer sizes. The plug layer's own period of buffering comes on
+ * top of the backend path and is not modelled here.
+ *
+ * Usage: bench-capture-format [iterations]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+#include <InputConditioning.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define BENCH_HAS_RDTSC 1
+#endif
+
+using namespace PrecisionTuner::Audio;
+
+namespace
+{
+    /** Prevents the compiler from optimising away benchmark results */
+    volatile float gSink = 0.0f;
+
+    uint64_t ReadCycleCounter()
+    {
+#ifdef BENCH_HAS_RDTSC
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    /** Encodes a test tone little-endian in an integer format */
+    std::vector<std::byte> MakeDeviceBuffer(size_t frames, SampleFormat format)
+    {
+        const size_t width = BytesPerSample(format);
+        const double fullScale = static_cast<double>(int64_t{ 1 } << (8 * width - 1));
+        std::vector<std::byte> bytes(frames * width);
+        for (size_t i = 0; i < frames; ++i)
+        {
+            const double value = 0.7 * std::sin(0.031 * static_cast<double>(i)) * fullScale;
+            const auto sample = static_cast<uint32_t>(static_cast<int32_t>(value));
+            for (size_t byte = 0; byte < width; ++byte)
+            {
+                bytes[i * width + byte] = static_cast<std::byte>((sample >> (8 * byte)) & 0xFF);
+            }
+        }
+        return bytes;
+    }
+
+    /** The backend's conversion pass: a plain per-sample loop into its own float buffer (left to the compiler) */
+    void BackendConvert(std::span<const std::byte> input, SampleFormat format, std::span<float> output)
+    {
+        const std::byte *bytes = input.data();
+        switch (format)
+        {
+        case SampleFormat::Int16:
+        {
+            const auto *samples = reinterpret_cast<const int16_t *>(bytes);
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                output[i] = static_cast<float>(samples[i]) * (1.0f / 32768.0f);
+            }
+            break;
+        }
+        case SampleFormat::Int24:
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                const auto *packed = reinterpret_cast<const uint8_t *>(bytes + i * 3);
+                const uint32_t raw = packed[0] | (packed[1] << 8) | (packed[2] << 16);
+                output[i] = static_cast<float>(static_cast<int32_t>(raw << 8) >> 8) * (1.0f / 8388608.0f);
+            }
+            break;
+        case SampleFormat::Int32:
+        default:
+        {
+            const auto *samples = reinterpret_cast<const int32_t *>(bytes);
+            for (size_t i = 0; i < output.size(); ++i)
+            {
+                output[i] = static_cast<float>(samples[i]) * (1.0f / 2147483648.0f);
+            }
+            break;
+        }
+        }
+    }
+
+    struct Result
+    {
+        double nsPerSample;
+        double cyclesPerSample;
+        double p50Us;
+        double p99Us;
+    };
+
+    template<typename Fn> Result Measure(size_t frames, size_t iterations, Fn &&fn)
+    {
+        // Warm-up (page faults, frequency ramp)
+        for (size_t i = 0; i < iterations / 10 + 1; ++i)
+        {
+            gSink = gSink + fn();
+        }
+
+        std::vector<double> buffers(iterations);
+        double totalNs = 0.0;
+        uint64_t totalCycles = 0;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            const uint64_t startCycles = ReadCycleCounter();
+            gSink = gSink + fn();
+            totalCycles += ReadCycleCounter() - startCycles;
+            buffers[i] = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            totalNs += buffers[i];
+        }
+        std::sort(buffers.begin(), buffers.end());
+
+        const double samples = static_cast<double>(frames) * static_cast<double>(iterations);
+        return { totalNs / samples,
+            static_cast<double>(totalCycles) / samples,
+            buffers[iterations / 2] / 1000.0,
+            buffers[std::min(iterations - 1, iterations * 99 / 100)] / 1000.0 };
+    }
+
+    void PrintRow(const char *format, const char *path, size_t frames, const Result &result, const Result &baseline)
+    {
+        std::printf("%-7s %-8s %6zu %10.3f %12.3f %9.2f %9.2f %9.2fx\n",
+            format,
+            path,
+            frames,
+            result.nsPerSample,
+            result.cyclesPerSample,
+            result.p50Us,
+            result.p99Us,
+            baseline.nsPerSample / result.nsPerSample);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 100000;
+    const float gain = 1.25f;
+
+    std::printf("Active conditioning kernel: %s\n", ToString(GetActiveSimdLevel()));
+#ifndef BENCH_HAS_RDTSC
+    std::printf("Cycle counter not available on this platform; cycles/sample reads 0\n");
+#endif
+    std::printf("%-7s %-8s %6s %10s %12s %9s %9s %10s\n",
+        "format",
+        "path",
+        "frames",
+        "ns/sample",
+        "cycles/smpl",
+        "p50 us",
+        "p99 us",
+        "speedup");
+
+    for (SampleFormat format : { SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32 })
+    {
+        for (size_t frames : { 128u, 256u, 1024u })
+        {
+            const std::vector<std::byte> device = MakeDeviceBuffer(frames, format);
+            std::vector<float> converted(frames);
+            std::vector<float> processing(frames);
+            std::vector<float> monitoring(frames);
+
+            const Result backend = Measure(frames, iterations, [&] {
+                BackendConvert(device, format, converted);
+                const ConditioningStats stats = ConditionBlock(converted, gain, processing, monitoring);
+                return stats.peak + stats.Rms();
+            });
+            PrintRow(ToString(format), "backend", frames, backend, backend);
+
+            const Result native = Measure(frames, iterations, [&] {
+                const ConditioningStats stats = ConditionBlock(device, format, gain, processing, monitoring);
+                return stats.peak + stats.Rms();
+            });
+            PrintRow(ToString(format), "native", frames, native, backend);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+/**
+ * Decimated detection benchmark
+ *
+ * Times one analysis window (4096 samples at 48 kHz, the layer defaults) through the
+ * detector at the full rate against decimation + detection + full-rate refinement as
+ * AudioProcessingLayer runs it, for each factor up to the one the default pitch ceiling
+ * allows, and reports the cents error of every path on each open string.
+ *
+ * Then runs the same path at 44.1, 48, 96 and 192 kHz with the window kept at 85 ms and
+ * reports the detection cost per second of audio: once with the decimation limit and
+ * refinement of the 48 kHz setup, and once as planned for the rate (see PlanAnalysis()).
+ *
+ * Usage: bench-decimation [iterations]
+ */
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+#include <AnalysisPlan.h>
+#include <Decimation.h>
+#include <HybridPitchDetector.h>
+
+using namespace PrecisionTuner::Audio;
+
+namespace
+{
+    constexpr float kSampleRate = 48000.0f;
+    constexpr size_t kWindow = 4096;
+
+    /** Prevents the compiler from optimising away benchmark results */
+    volatile float gSink = 0.0f;
+
+    /** Same settings as the layer's detector */
+    GuitarDSP::HybridPitchDetector CreateDetector()
+    {
+        return GuitarDSP::HybridPitchDetector(GuitarDSP::HybridPitchDetectorConfig{ .yinConfidenceThreshold = 0.8f,
+            .enableHarmonicRejection = true,
+            .harmonicTolerance = 0.05f,
+            .yinConfig = { .threshold = 0.10f, .minFrequency = 80.0f, .maxFrequency = 1200.0f },
+            .mpmConfig = { .threshold = 0.93f, .minFrequency = 80.0f, .maxFrequency = 1200.0f } });
+    }
+
+    /** A plucked string a moment after the attack: fundamental, two harmonics and a little noise */
+    std::vector<float> Note(float frequency, float sampleRate = kSampleRate, size_t samples = kWindow)
+    {
+        std::mt19937 random(11);
+        std::uniform_real_distribution<float> noise(-0.005f, 0.005f);
+        std::vector<float> window(samples);
+        for (size_t i = 0; i < window.size(); ++i)
+        {
+            const float phase = 2.0f * std::numbers::pi_v<float> * frequency * static_cast<float>(i) / sampleRate;
+            window[i] = 0.3f * std::sin(phase) + 0.12f * std::sin(2.0f * phase) + 0.05f * std::sin(3.0f * phase)
+                        + noise(random);
+        }
+        return window;
+    }
+
+    /** The layer's decimated path (see AudioProcessingLayer::DetectPitch) */
+    std::optional<float> DetectDecimated(GuitarDSP::HybridPitchDetector &detector,
+        const PolyphaseDecimator &decimator,
+        std::span<const float> window,
+        std::vector<float> &decimated,
+        float sampleRate = kSampleRate,
+        size_t refineStride = 1)
+    {
+        const uint32_t factor = decimator.Factor();
+        const size_t filtered = window.size() - (decimator.TapCount() - 1);
+        const size_t used = filtered - filtered % factor;
+        const size_t produced = decimator.Process(window, window.size() - used, decimated);
+        const auto result = detector.Detect(std::span<const float>(decimated).first(produced),
+            sampleRate / static_cast<float>(factor));
+        if (!result.has_value())
+        {
+            return std::nullopt;
+        }
+        return RefineFrequency(window.last(used), sampleRate, result->frequency, factor, refineStride);
+    }
+
+    float Cents(std::optional<float> detected, float frequency)
+    {
+        return detected.has_value() ? 1200.0f * std::log2(*detected / frequency) : NAN;
+    }
+
+    template<typename Fn> double MicrosecondsPerWindow(size_t iterations, Fn &&fn)
+    {
+        // Warm-up (page faults, detector buffers, frequency ramp)
+        for (size_t i = 0; i < iterations / 10 + 1; ++i)
+        {
+            gSink = gSink + fn();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            gSink = gSink + fn();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(elapsed).count() / static_cast<double>(iterations);
+    }
+
+    /** Microseconds of detection per second of audio, and the mean cents error over the open strings */
+    struct RateCost
+    {
+        double usPerSecond = 0.0;
+        double usPerWindow = 0.0;
+        float cents = 0.0f;
+    };
+
+    /** Times the layer's decimated path on every string with the sizes, factor and stride of a plan */
+    RateCost MeasureRate(const AnalysisPlan &plan, size_t iterations, std::span<const float> strings)
+    {
+        const PolyphaseDecimator decimator(plan.decimationFactor);
+        GuitarDSP::HybridPitchDetector detector = CreateDetector();
+        std::vector<float> decimated(plan.decimatedWindowSize);
+        const auto rate = static_cast<float>(plan.sampleRate);
+
+        RateCost cost;
+        for (const float frequency : strings)
+        {
+            const std::vector<float> window = Note(frequency, rate, plan.windowSize);
+            cost.usPerWindow += MicrosecondsPerWindow(iterations, [&] {
+                return DetectDecimated(detector, decimator, window, decimated, rate, plan.refineStride).value_or(0.0f);
+            });
+            cost.cents += std::abs(
+                Cents(DetectDecimated(detector, decimator, window, decimated, rate, plan.refineStride), frequency));
+        }
+        cost.usPerWindow /= static_cast<double>(strings.size());
+        cost.cents /= static_cast<float>(strings.size());
+        cost.usPerSecond = cost.usPerWindow * static_cast<double>(plan.sampleRate) / static_cast<double>(plan.hopSize);
+        return cost;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t iterations = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 200;
+
+    constexpr std::array<float, 6> kStrings = { 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f };
+    const uint32_t maxFactor = ChooseDecimationFactor({}, static_cast<uint32_t>(kSampleRate), 1200.0f);
+
+    std::printf("Window %zu samples at %.0f Hz, decimation kernel %s, %zu iterations\n",
+        kWindow,
+        static_cast<double>(kSampleRate),
+        ToString(GetActiveSimdLevel()),
+        iterations);
+    std::printf("%10s %6s %12s %10s %10s\n", "string Hz", "factor", "us/window", "speedup", "cents");
+
+    for (const float frequency : kStrings)
+    {
+        const std::vector<float> window = Note(frequency);
+        GuitarDSP::HybridPitchDetector fullRateDetector = CreateDetector();
+        const double fullRateUs = MicrosecondsPerWindow(iterations, [&] {
+            const auto result = fullRateDetector.Detect(window, kSampleRate);
+            return result.has_value() ? result->frequency : 0.0f;
+        });
+        const auto fullRate = fullRateDetector.Detect(window, kSampleRate);
+        const float fullRateCents =
+            Cents(fullRate.has_value() ? std::optional<float>(fullRate->frequency) : std::nullopt, frequency);
+        std::printf("%10.2f %6u %12.1f %10s %10.3f\n",
+            static_cast<double>(frequency),
+            1u,
+            fullRateUs,
+            "1.00x",
+            static_cast<double>(fullRateCents));
+
+        for (uint32_t factor = 2; factor <= maxFactor; ++factor)
+        {
+            const PolyphaseDecimator decimator(factor);
+            GuitarDSP::HybridPitchDetector detector = CreateDetector();
+            std::vector<float> decimated(kWindow / factor);
+            const double decimatedUs = MicrosecondsPerWindow(iterations, [&] {
+                return DetectDecimated(detector, decimator, window, decimated).value_or(0.0f);
+            });
+            const float cents = Cents(DetectDecimated(detector, decimator, window, decimated), frequency);
+
+            std::array<char, 16> speedup{};
+            std::snprintf(speedup.data(), speedup.size(), "%.2fx", fullRateUs / decimatedUs);
+            std::printf("%10s %6u %12.1f %10s %10.3f\n",
+                "",
+                factor,
+                decimatedUs,
+                speedup.data(),
+                static_cast<double>(cents));
+        }
+    }
+
+    // Detection cost per second of audio across stream rates, window and hop kept at 85 ms / 10.7 ms
+    std::printf("\n%8s %-9s %7s %6s %6s %12s %12s %10s\n",
+        "rate Hz",
+        "setup",
+        "window",
+        "factor",
+        "stride",
+        "us/window",
+        "us/s audio",
+        "cents");
+    for (const uint32_t sampleRate : { 44100u, 48000u, 96000u, 192000u })
+    {
+        // The 48 kHz setup carried over: decimation capped at x8, refinement on every lag and sample
+        AnalysisPlan fixed = PlanAnalysis(sampleRate, {}, {}, 80.0f, 1200.0f);
+        fixed.decimationFactor = ChooseDecimationFactor({}, sampleRate, 1200.0f);
+        fixed.decimatedWindowSize = fixed.windowSize / fixed.decimationFactor;
+        fixed.refineStride = 1;
+        const AnalysisPlan planned = PlanAnalysis(sampleRate, {}, {}, 80.0f, 1200.0f);
+
+        for (const auto &[name, plan] : { std::pair{ "48k-fixed", fixed }, std::pair{ "planned", planned } })
+        {
+            const RateCost cost = MeasureRate(plan, iterations, kStrings);
+            std::printf("%8u %-9s %7u %6u %6u %12.1f %12.0f %10.3f\n",
+                sampleRate,
+                name,
+                plan.windowSize,
+                plan.decimationFactor,
+                plan.refineStride,
+                cost.usPerWindow,
+                cost.usPerSecond,
+                static_cast<double>(cost.cents));
+        }
+    }
+
+    return 0;
+}
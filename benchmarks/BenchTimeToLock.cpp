@@ -0,0 +1,106 @@
+/**
+ * Time-to-lock benchmark
+ *
+ * Plays synthetic plucks of every string of a standard-tuned guitar (previous string still
+ * ringing, pick noise on each attack) through AudioProcessingLayer and reports how long
+ * after each onset the published pitch became stable, with and without reseeding the
+ * stabilizer and skipping the attack at each onset, for every stabilizer type.
+ *
+ * Time-to-lock is measured in stream time, so the figures do not depend on how fast the
+ * machine runs the analysis.
+ *
+ * Usage: bench-time-to-lock [rounds]
+ */
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <vector>
+#include <AudioProcessingLayer.h>
+#include <mocks/MockAudioDevice.h>
+#include <mocks/PluckSignal.h>
+
+using namespace PrecisionTuner::Layers;
+
+namespace
+{
+    constexpr uint32_t kSampleRate = 48000;
+    constexpr uint32_t kBufferSize = 512;
+
+    const char *Name(StabilizerType type)
+    {
+        switch (type)
+        {
+        case StabilizerType::EMA:
+            return "ema";
+        case StabilizerType::Median:
+            return "median";
+        case StabilizerType::Hybrid:
+            return "hybrid";
+        case StabilizerType::None:
+        default:
+            return "none";
+        }
+    }
+
+    /** Feeds the signal one device buffer at a time, letting the analysis catch up after each */
+    AnalysisStats Play(const std::vector<float> &signal, StabilizerType stabilizer, bool reseedOnOnset)
+    {
+        auto inputMock = std::make_unique<MockAudioDevice>();
+        MockAudioDevice *input = inputMock.get();
+
+        AudioProcessingLayerConfig config;
+        config.sampleRate = kSampleRate;
+        config.bufferSize = kBufferSize;
+        config.stabilizerType = stabilizer;
+        config.duplexMode = DuplexMode::Off;
+        config.onsetDetector.reseedOnOnset = reseedOnOnset;
+        AudioProcessingLayer layer(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+        std::vector<float> output(kBufferSize);
+        for (size_t offset = 0; offset + kBufferSize <= signal.size(); offset += kBufferSize)
+        {
+            input->TriggerCallback(std::span<const float>(signal).subspan(offset, kBufferSize), output);
+            (void)layer.FlushAnalysis(std::chrono::milliseconds(10000));
+        }
+        return layer.GetAnalysisStats(0);
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const size_t rounds = argc > 1 ? static_cast<size_t>(std::strtoull(argv[1], nullptr, 10)) : 2;
+
+    // Up and down the strings, as when tuning
+    constexpr std::array<float, 6> kStrings = { 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f };
+    std::vector<float> sequence;
+    for (size_t round = 0; round < rounds; ++round)
+    {
+        sequence.insert(sequence.end(), kStrings.begin(), kStrings.end());
+        sequence.insert(sequence.end(), kStrings.rbegin(), kStrings.rend());
+    }
+    const std::vector<float> signal = RenderPlucks(sequence, kSampleRate, kSampleRate, kSampleRate / 2);
+
+    std::printf("%zu plucks, 1 s each\n", sequence.size());
+    std::printf("%-8s %-8s %8s %8s %12s %12s\n", "stab", "onset", "onsets", "locks", "mean ms", "last ms");
+    for (StabilizerType stabilizer :
+        { StabilizerType::None, StabilizerType::EMA, StabilizerType::Median, StabilizerType::Hybrid })
+    {
+        for (bool reseed : { false, true })
+        {
+            const AnalysisStats stats = Play(signal, stabilizer, reseed);
+            std::printf("%-8s %-8s %8llu %8llu %12.1f %12.1f\n",
+                Name(stabilizer),
+                reseed ? "reseed" : "measure",
+                static_cast<unsigned long long>(stats.onsets),
+                static_cast<unsigned long long>(stats.locks),
+                stats.meanTimeToLockMs,
+                stats.lastTimeToLockMs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * Analysis Plan
+ * Rate-dependent window, hop, decimation and lag bounds of the pitch analysis
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "AnalysisPlan.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PrecisionTuner::Audio
+{
+    AnalysisPlan PlanAnalysis(uint32_t sampleRate,
+        const AnalysisTiming &timing,
+        const DecimationConfig &decimation,
+        float minFrequency,
+        float maxFrequency)
+    {
+        // Sizes keep their duration: a 192 kHz stream gets four times the samples of a 48 kHz one
+        const double scale = timing.referenceRate > 0 && sampleRate > 0
+                                 ? static_cast<double>(sampleRate) / static_cast<double>(timing.referenceRate)
+                                 : 1.0;
+        const auto scaled = [scale](uint32_t size) {
+            return std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(static_cast<double>(size) * scale)));
+        };
+
+        AnalysisPlan plan;
+        plan.sampleRate = sampleRate;
+        plan.windowSize = scaled(timing.windowSize);
+        plan.hopSize = std::min(scaled(timing.hopSize), plan.windowSize);
+
+        DecimationConfig rateDecimation = decimation;
+        rateDecimation.maxFactor = scaled(decimation.maxFactor);
+        plan.decimationFactor = ChooseDecimationFactor(rateDecimation, sampleRate, maxFrequency);
+        plan.detectionRate = static_cast<float>(sampleRate) / static_cast<float>(plan.decimationFactor);
+        plan.decimatedWindowSize = plan.windowSize / plan.decimationFactor;
+
+        if (maxFrequency > 0.0f)
+        {
+            plan.minLag = static_cast<uint32_t>(std::floor(plan.detectionRate / maxFrequency));
+        }
+        if (minFrequency > 0.0f)
+        {
+            plan.maxLag = static_cast<uint32_t>(std::ceil(plan.detectionRate / minFrequency));
+            plan.minDetectionSamples = std::min<size_t>(plan.windowSize,
+                static_cast<size_t>(std::ceil(2.0f * static_cast<float>(sampleRate) / minFrequency)));
+        }
+
+        // The coarse estimate is good to about one decimated sample; the refinement never steps coarser than that
+        plan.refineRadius = plan.decimationFactor;
+        plan.refineStride = std::clamp<uint32_t>(static_cast<uint32_t>(scale), 1, plan.decimationFactor);
+        return plan;
+    }
+
+} // namespace PrecisionTuner::Audio
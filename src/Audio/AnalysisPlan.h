@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Decimation.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace PrecisionTuner::Audio
+{
+    /** Analysis sizes as configured, before they are fitted to the stream rate */
+    struct AnalysisTiming
+    {
+        uint32_t windowSize = 4096;     ///< Samples per detection window at referenceRate
+        uint32_t hopSize = 512;         ///< Samples between successive windows at referenceRate
+        uint32_t referenceRate = 48000; ///< Rate the sizes and DecimationConfig::maxFactor are given at (0 = as is)
+    };
+
+    /** Window, hop, decimation and lag bounds for one stream rate and detection band */
+    struct AnalysisPlan
+    {
+        uint32_t sampleRate = 0;          ///< Stream rate the plan was made for (Hz)
+        uint32_t windowSize = 0;          ///< Full-rate samples per detection window
+        uint32_t hopSize = 0;             ///< Full-rate samples between successive windows
+        uint32_t decimationFactor = 1;    ///< Downsampling ahead of the detector (1 = full rate)
+        float detectionRate = 0.0f;       ///< Rate the detector runs at (Hz)
+        uint32_t decimatedWindowSize = 0; ///< Samples the detector sees per window
+        uint32_t minLag = 0;              ///< Shortest period searched (maxFrequency), in detection-rate samples
+        uint32_t maxLag = 0;              ///< Longest period searched (minFrequency), in detection-rate samples
+        uint32_t refineRadius = 0;        ///< Lag uncertainty of a decimated estimate, in full-rate samples
+        uint32_t refineStride = 1;        ///< Lag step and summation stride of the full-rate refinement
+        size_t minDetectionSamples = 0;   ///< Two periods of minFrequency, the least the detector needs after an onset
+    };
+
+    /**
+     * @brief Fits the analysis to the rate a stream was opened at
+     *
+     * The window, the hop and the decimation limit are configured for referenceRate and keep
+     * their duration at any other rate, so frames per second, latency and low-string
+     * resolution do not change with the interface's rate. The decimation factor then grows
+     * with the rate (see ChooseDecimationFactor()), which holds the detection rate, the
+     * decimated window and the lag range near their reference values: detection cost per
+     * second of audio stays about flat instead of growing with the square of the window.
+     * The full-rate refinement steps its lags and sums every refineStride samples, so it too
+     * costs what it costs at the reference rate and keeps the reference lag resolution.
+     *
+     * Called when the streams open and when the detection band changes, never on an audio thread.
+     *
+     * @param sampleRate Stream sample rate in Hz
+     * @param timing Configured window, hop and their reference rate
+     * @param decimation Decimation settings
+     * @param minFrequency Lowest frequency the detector has to find, in Hz
+     * @param maxFrequency Highest frequency the detector has to find, in Hz
+     * @return Plan for the rate
+     */
+    [[nodiscard]] AnalysisPlan PlanAnalysis(uint32_t sampleRate,
+        const AnalysisTiming &timing,
+        const DecimationConfig &decimation,
+        float minFrequency,
+        float maxFrequency);
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Granule that keeps data written by different threads apart
+     *
+     * State written by one thread is grouped and aligned to this size, so a store on one
+     * thread never invalidates the line another thread is reading or writing (false sharing).
+     * 64 bytes is the line size of current x86-64 and most ARM cores.
+     *
+     * std::hardware_destructive_interference_size is not used: its value depends on the
+     * compiler's tuning flags, so it would not be stable across the translation units and
+     * libraries sharing these layouts (GCC warns about exactly that with -Winterference-size).
+     */
+    inline constexpr size_t kCacheLineSize = 64;
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,265 @@
+/**
+ * Analysis Decimation
+ * Polyphase anti-aliased decimator with runtime ISA dispatch and full-rate pitch refinement
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "Decimation.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+// Platform-specific includes (BEFORE namespace to avoid pollution)
+#if defined(__x86_64__) || defined(_M_X64)
+#define PRECISION_TUNER_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC accepts AVX2 intrinsics in any function; the caller guarantees CPU support
+#define PRECISION_TUNER_TARGET_AVX2
+#else
+#define PRECISION_TUNER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        /// Dot product signature: (taps, samples, count)
+        using DotFn = float (*)(const float *, const float *, size_t);
+
+        float ScalarDot(const float *taps, const float *samples, size_t count)
+        {
+            float sum = 0.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                sum += taps[i] * samples[i];
+            }
+            return sum;
+        }
+
+#ifdef PRECISION_TUNER_X86_64
+        float Sse2Dot(const float *taps, const float *samples, size_t count)
+        {
+            // Two accumulators hide the add latency
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(taps + i), _mm_loadu_ps(samples + i)));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(taps + i + 4), _mm_loadu_ps(samples + i + 4)));
+            }
+
+            alignas(16) std::array<float, 4> lanes{};
+            _mm_store_ps(lanes.data(), _mm_add_ps(sum0, sum1));
+            float sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+            // Scalar tail (fewer than 8 taps)
+            for (; i < count; ++i)
+            {
+                sum += taps[i] * samples[i];
+            }
+            return sum;
+        }
+
+        PRECISION_TUNER_TARGET_AVX2 float Avx2Dot(const float *taps, const float *samples, size_t count)
+        {
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16)
+            {
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(taps + i), _mm256_loadu_ps(samples + i)));
+                sum1 = _mm256_add_ps(sum1,
+                    _mm256_mul_ps(_mm256_loadu_ps(taps + i + 8), _mm256_loadu_ps(samples + i + 8)));
+            }
+
+            alignas(32) std::array<float, 8> lanes{};
+            _mm256_store_ps(lanes.data(), _mm256_add_ps(sum0, sum1));
+            float sum =
+                ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+
+            // Scalar tail (fewer than 16 taps)
+            for (; i < count; ++i)
+            {
+                sum += taps[i] * samples[i];
+            }
+            return sum;
+        }
+#endif
+
+        DotFn SelectDot(SimdLevel level)
+        {
+            switch (level)
+            {
+#ifdef PRECISION_TUNER_X86_64
+            case SimdLevel::AVX2:
+                return &Avx2Dot;
+            case SimdLevel::SSE2:
+                return &Sse2Dot;
+#endif
+            case SimdLevel::Scalar:
+            default:
+                return &ScalarDot;
+            }
+        }
+
+        size_t RunDecimation(DotFn dot,
+            std::span<const float> reversedTaps,
+            uint32_t factor,
+            std::span<const float> signal,
+            size_t start,
+            std::span<float> output)
+        {
+            start = std::min(start, signal.size());
+            const size_t count = std::min((signal.size() - start) / factor, output.size());
+            if (factor <= 1)
+            {
+                std::copy_n(signal.begin() + static_cast<std::ptrdiff_t>(start), count, output.begin());
+                return count;
+            }
+
+            const size_t taps = reversedTaps.size();
+            for (size_t k = 0; k < count; ++k)
+            {
+                // Newest sample under the filter, and how much of the filter reaches before the signal
+                const size_t newest = start + (k + 1) * factor - 1;
+                const size_t missing = newest + 1 < taps ? taps - (newest + 1) : 0;
+                const float *oldest = signal.data() + (newest + 1 + missing - taps);
+                output[k] = dot(reversedTaps.data() + missing, oldest, taps - missing);
+            }
+            return count;
+        }
+    } // namespace
+
+    uint32_t ChooseDecimationFactor(const DecimationConfig &config, uint32_t sampleRate, float maxFrequency)
+    {
+        if (!config.enabled || maxFrequency <= 0.0f || config.minRateRatio <= 0.0f)
+        {
+            return 1;
+        }
+
+        const float factor = std::floor(static_cast<float>(sampleRate) / (config.minRateRatio * maxFrequency));
+        const uint32_t limit = std::clamp<uint32_t>(config.maxFactor, 1, PolyphaseDecimator::kMaxFactor);
+        return factor < 1.0f ? 1 : std::min(static_cast<uint32_t>(factor), limit);
+    }
+
+    PolyphaseDecimator::PolyphaseDecimator(uint32_t factor)
+    {
+        Configure(factor);
+    }
+
+    void PolyphaseDecimator::Configure(uint32_t factor)
+    {
+        this->factor = std::clamp<uint32_t>(factor, 1, kMaxFactor);
+        reversedTaps.clear();
+        if (this->factor == 1)
+        {
+            return;
+        }
+
+        // Blackman-windowed sinc, normalized to unity DC gain (the window is symmetric, so reversal is a no-op)
+        const size_t taps = kTapsPerPhase * this->factor;
+        const double cutoff = static_cast<double>(kCutoffRatio) / this->factor; // Cycles per input sample
+        const double centre = 0.5 * static_cast<double>(taps - 1);
+        std::vector<double> response(taps);
+        double sum = 0.0;
+        for (size_t i = 0; i < taps; ++i)
+        {
+            const double t = static_cast<double>(i) - centre;
+            const double sinc = t == 0.0 ? 2.0 * cutoff
+                                         : std::sin(2.0 * std::numbers::pi * cutoff * t) / (std::numbers::pi * t);
+            const double phase = 2.0 * std::numbers::pi * static_cast<double>(i) / static_cast<double>(taps - 1);
+            const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+            response[i] = sinc * window;
+            sum += response[i];
+        }
+
+        reversedTaps.resize(taps);
+        for (size_t i = 0; i < taps; ++i)
+        {
+            reversedTaps[i] = static_cast<float>(response[taps - 1 - i] / sum);
+        }
+    }
+
+    size_t PolyphaseDecimator::Process(std::span<const float> signal, size_t start, std::span<float> output) const
+    {
+        // Looked up per call: the active level lives in another translation unit's static initialisation
+        return RunDecimation(SelectDot(GetActiveSimdLevel()), reversedTaps, factor, signal, start, output);
+    }
+
+    size_t PolyphaseDecimator::ProcessWith(SimdLevel level,
+        std::span<const float> signal,
+        size_t start,
+        std::span<float> output) const
+    {
+        const SimdLevel effective = IsSimdLevelSupported(level) ? level : SimdLevel::Scalar;
+        return RunDecimation(SelectDot(effective), reversedTaps, factor, signal, start, output);
+    }
+
+    float RefineFrequency(std::span<const float> window,
+        float sampleRate,
+        float frequency,
+        size_t radius,
+        size_t stride)
+    {
+        if (frequency <= 0.0f || sampleRate <= 0.0f)
+        {
+            return frequency;
+        }
+
+        // Lags [first, last] around the estimated period, stride apart, one extra step on each side for the parabola
+        stride = std::max<size_t>(stride, 1);
+        const auto period = static_cast<size_t>(std::lround(sampleRate / frequency));
+        const size_t reach = ((radius + stride - 1) / stride + 1) * stride;
+        const size_t first = period - std::min(reach, (period > 0 ? period - 1 : 0) / stride * stride);
+        const size_t last = period + reach;
+        if (period == 0 || 2 * last > window.size())
+        {
+            return frequency;
+        }
+
+        const size_t width = window.size() - last;
+        float best = 0.0f;
+        float before = 0.0f;
+        float after = 0.0f;
+        size_t bestLag = 0;
+        float previous = 0.0f;
+        for (size_t lag = first; lag <= last; lag += stride)
+        {
+            float difference = 0.0f;
+            for (size_t i = 0; i < width; i += stride)
+            {
+                const float delta = window[i] - window[i + lag];
+                difference += delta * delta;
+            }
+
+            if (bestLag != 0 && lag == bestLag + stride)
+            {
+                after = difference;
+            }
+            if (bestLag == 0 || difference < best)
+            {
+                best = difference;
+                bestLag = lag;
+                before = previous;
+            }
+            previous = difference;
+        }
+
+        // A minimum on the edge means the period lies outside the range: keep the estimate
+        if (bestLag == first || bestLag == last)
+        {
+            return frequency;
+        }
+
+        const float curvature = before - 2.0f * best + after;
+        const float offset = curvature > 0.0f ? 0.5f * (before - after) / curvature : 0.0f;
+        return sampleRate / (static_cast<float>(bestLag) + offset * static_cast<float>(stride));
+    }
+
+} // namespace PrecisionTuner::Audio
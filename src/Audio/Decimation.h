@@ -0,0 +1,139 @@
+#pragma once
+
+#include <InputConditioning.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PrecisionTuner::Audio
+{
+    /** Downsampling of the analysis window ahead of pitch detection */
+    struct DecimationConfig
+    {
+        bool enabled = true;        ///< Detect on a decimated window and refine at the full rate
+        float minRateRatio = 10.0f; ///< Decimated rate kept at least this multiple of the pitch ceiling
+        uint32_t maxFactor = 8;     ///< Upper bound for the decimation factor (PlanAnalysis() scales it to the rate)
+    };
+
+    /**
+     * @brief Picks the decimation factor for a detection band
+     *
+     * The largest factor that keeps the decimated rate at minRateRatio times the band's
+     * ceiling (so the detector still resolves its highest note and a few harmonics), clamped
+     * to [1, min(maxFactor, PolyphaseDecimator::kMaxFactor)]. A band limited to the low
+     * strings therefore decimates further than one reaching up to D6.
+     *
+     * @param config Decimation settings (1 when disabled)
+     * @param sampleRate Stream sample rate in Hz
+     * @param maxFrequency Highest frequency the detector has to find, in Hz
+     * @return Decimation factor
+     */
+    [[nodiscard]] uint32_t ChooseDecimationFactor(const DecimationConfig &config,
+        uint32_t sampleRate,
+        float maxFrequency);
+
+    /**
+     * @brief Anti-aliased integer-factor decimator for analysis windows
+     *
+     * A windowed-sinc low-pass (kTapsPerPhase taps per output phase, cutoff at 0.4 of the
+     * decimated rate) evaluated only at the kept samples, i.e. the polyphase form: each
+     * output costs one tapCount-long dot product and the discarded samples cost nothing.
+     * The dot products use the widest instruction set the CPU supports (same runtime
+     * dispatch as ConditionBlock()).
+     *
+     * Stateless between calls: the filter history comes from the samples in front of the
+     * decimated range, so a sliding window can be decimated as a whole every hop without
+     * streaming state that has to follow the window.
+     *
+     * Configure() designs the filter and allocates; Process() neither allocates nor locks.
+     */
+    class PolyphaseDecimator
+    {
+    public:
+        static constexpr uint32_t kMaxFactor = 32;  ///< Largest supported decimation factor (192 kHz to 6 kHz)
+        static constexpr size_t kTapsPerPhase = 16; ///< Filter length per unit of decimation factor
+        static constexpr float kCutoffRatio = 0.4f; ///< -6 dB point as a fraction of the decimated rate
+
+        /**
+         * @brief Constructs a decimator
+         * @param factor Decimation factor (1 passes samples through)
+         */
+        explicit PolyphaseDecimator(uint32_t factor = 1);
+
+        /**
+         * @brief Designs the anti-aliasing filter for a new factor
+         * @param factor Decimation factor, clamped to [1, kMaxFactor]
+         */
+        void Configure(uint32_t factor);
+
+        /**
+         * @brief Decimates the tail of a signal
+         *
+         * Output k is the filtered signal at index start + (k + 1) * factor - 1, so the last
+         * output lines up with the last input sample. Samples before start (up to
+         * TapCount() - 1 of them) are used as filter history; missing history counts as
+         * silence. Real-time safe: no allocation, no locking.
+         *
+         * @param signal Input samples
+         * @param start First sample of the decimated range
+         * @param output Destination, (signal.size() - start) / factor samples are written (fewer if it is smaller)
+         * @return Samples written
+         */
+        size_t Process(std::span<const float> signal, size_t start, std::span<float> output) const;
+
+        /**
+         * @brief Same as Process() but forces a specific instruction set
+         * Falls back to Scalar if the requested level is not supported. Intended for tests and benchmarks.
+         */
+        size_t ProcessWith(SimdLevel level,
+            std::span<const float> signal,
+            size_t start,
+            std::span<float> output) const;
+
+        /** @brief Gets the decimation factor */
+        [[nodiscard]] uint32_t Factor() const
+        {
+            return factor;
+        }
+
+        /** @brief Gets the filter length (samples of history a fully filtered output needs, plus one) */
+        [[nodiscard]] size_t TapCount() const
+        {
+            return reversedTaps.size();
+        }
+
+    private:
+        uint32_t factor = 1;             ///< Decimation factor
+        std::vector<float> reversedTaps; ///< Impulse response, oldest-sample tap first (empty for factor 1)
+    };
+
+    /**
+     * @brief Refines a pitch estimate on the full-rate signal
+     *
+     * Searches the squared-difference function of the window over the lags within radius
+     * samples of sampleRate / frequency and interpolates a parabola through the minimum, so
+     * an estimate made on a decimated window regains full-rate lag resolution. Costs
+     * (2 * radius + 3) passes over the window instead of a full lag sweep.
+     *
+     * With a stride above 1 the lags are searched stride samples apart and every pass sums
+     * every stride-th sample only: at a high stream rate the refinement then costs and
+     * resolves what it does at stride times lower rate (the parabola still interpolates
+     * between the searched lags).
+     *
+     * Real-time safe: no allocation, no locking.
+     *
+     * @param window Full-rate samples the estimate was made on
+     * @param sampleRate Sample rate of window in Hz
+     * @param frequency Estimate to refine in Hz
+     * @param radius Lag uncertainty of the estimate in full-rate samples
+     * @param stride Lag step and summation stride in full-rate samples
+     * @return Refined frequency, or frequency unchanged if the minimum lies on the edge of the search range
+     */
+    [[nodiscard]] float RefineFrequency(std::span<const float> window,
+        float sampleRate,
+        float frequency,
+        size_t radius,
+        size_t stride = 1);
+
+} // namespace PrecisionTuner::Audio
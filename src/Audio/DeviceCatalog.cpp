@@ -0,0 +1,233 @@
+/**
+ * Device Catalog
+ * Background audio device enumeration with cached snapshots and hotplug events
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "DeviceCatalog.h"
+#include <algorithm>
+#include <AudioDeviceManager.h>
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        /// Whether two entries describe the same physical device (IDs can be reused after a hotplug)
+        bool SameDevice(const GuitarIO::AudioDeviceInfo &a, const GuitarIO::AudioDeviceInfo &b)
+        {
+            return a.id == b.id && a.name == b.name;
+        }
+
+        /// Whether two lists differ in anything the UI shows or the layer relies on
+        bool ListsDiffer(const std::vector<GuitarIO::AudioDeviceInfo> &a,
+            const std::vector<GuitarIO::AudioDeviceInfo> &b)
+        {
+            return !std::ranges::equal(a, b, [](const auto &x, const auto &y) {
+                return SameDevice(x, y) && x.maxInputChannels == y.maxInputChannels &&
+                       x.maxOutputChannels == y.maxOutputChannels;
+            });
+        }
+    } // namespace
+
+    DeviceSource DeviceCatalog::SystemDeviceSource()
+    {
+        return DeviceSource{
+            .enumerate =
+                [] {
+                    auto &deviceManager = GuitarIO::AudioDeviceManager::Get();
+                    return DeviceSnapshot{
+                        .inputDevices = deviceManager.EnumerateInputDevices(),
+                        .outputDevices = deviceManager.EnumerateOutputDevices(),
+                        .defaultInputId = deviceManager.GetDefaultInputDevice(),
+                        .defaultOutputId = deviceManager.GetDefaultOutputDevice(),
+                    };
+                },
+            .describe = [](uint32_t deviceId) { return GuitarIO::AudioDeviceManager::Get().GetDeviceInfo(deviceId); },
+            .defaultDevice =
+                [](bool input) {
+                    auto &deviceManager = GuitarIO::AudioDeviceManager::Get();
+                    return input ? deviceManager.GetDefaultInputDevice() : deviceManager.GetDefaultOutputDevice();
+                },
+        };
+    }
+
+    DeviceCatalog::DeviceCatalog(std::chrono::milliseconds pollInterval, DeviceSource source)
+        : source(std::move(source)),
+          pollInterval(pollInterval),
+          snapshot(std::make_shared<const DeviceSnapshot>()),
+          scanCount(0),
+          refreshRequested(false)
+    {
+    }
+
+    DeviceCatalog::~DeviceCatalog()
+    {
+        Stop();
+    }
+
+    void DeviceCatalog::Start()
+    {
+        if (worker.joinable())
+        {
+            return;
+        }
+        worker = std::jthread([this](std::stop_token stopToken) { WorkerMain(stopToken); });
+    }
+
+    void DeviceCatalog::Stop()
+    {
+        if (!worker.joinable())
+        {
+            return;
+        }
+        // request_stop() wakes the condition_variable_any wait
+        worker.request_stop();
+        worker.join();
+    }
+
+    void DeviceCatalog::RequestRefresh()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            refreshRequested = true;
+        }
+        wakeWorker.notify_one();
+    }
+
+    std::shared_ptr<const DeviceSnapshot> DeviceCatalog::GetSnapshot() const
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        return snapshot;
+    }
+
+    GuitarIO::AudioDeviceInfo DeviceCatalog::GetDeviceInfo(uint32_t deviceId) const
+    {
+        const auto current = GetSnapshot();
+        for (const auto *devices : { &current->inputDevices, &current->outputDevices })
+        {
+            const auto it = std::ranges::find(*devices, deviceId, &GuitarIO::AudioDeviceInfo::id);
+            if (it != devices->end())
+            {
+                return *it;
+            }
+        }
+
+        // Not scanned yet (startup) or unknown ID: ask the source, never concurrently with a scan
+        std::lock_guard<std::mutex> lock(sourceMutex);
+        return source.describe(deviceId);
+    }
+
+    uint32_t DeviceCatalog::GetDefaultDevice(bool input) const
+    {
+        std::lock_guard<std::mutex> lock(sourceMutex);
+        return source.defaultDevice(input);
+    }
+
+    bool DeviceCatalog::WaitForGeneration(uint64_t generation, std::chrono::milliseconds timeout) const
+    {
+        std::unique_lock<std::mutex> lock(snapshotMutex);
+        return snapshotChanged.wait_for(lock, timeout, [&] { return snapshot->generation >= generation; });
+    }
+
+    uint64_t DeviceCatalog::GetScanCount() const
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        return scanCount;
+    }
+
+    void DeviceCatalog::WorkerMain(std::stop_token stopToken)
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        while (!stopToken.stop_requested())
+        {
+            refreshRequested = false;
+            lock.unlock();
+            Scan();
+            lock.lock();
+
+            wakeWorker.wait_for(lock, stopToken, pollInterval, [this] { return refreshRequested; });
+        }
+    }
+
+    void DeviceCatalog::Scan()
+    {
+        const auto scanStart = std::chrono::steady_clock::now();
+        DeviceSnapshot next;
+        {
+            std::lock_guard<std::mutex> lock(sourceMutex);
+            next = source.enumerate();
+        }
+        next.enumerationMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - scanStart).count();
+
+        const auto previous = GetSnapshot();
+        const bool changed = previous->generation == 0 || ListsDiffer(previous->inputDevices, next.inputDevices) ||
+                             ListsDiffer(previous->outputDevices, next.outputDevices) ||
+                             previous->defaultInputId != next.defaultInputId ||
+                             previous->defaultOutputId != next.defaultOutputId;
+        if (!changed)
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            ++scanCount;
+            return;
+        }
+
+        next.generation = previous->generation + 1;
+        std::vector<DeviceChangeEvent> events;
+        if (previous->generation != 0)
+        {
+            DiffDevices(previous->inputDevices, next.inputDevices, true, next.generation, events);
+            DiffDevices(previous->outputDevices, next.outputDevices, false, next.generation, events);
+        }
+
+        // Publish the snapshot before its events, so a drained event never refers to a newer list than GetSnapshot()
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex);
+            snapshot = std::make_shared<const DeviceSnapshot>(std::move(next));
+            ++scanCount;
+        }
+        if (!events.empty())
+        {
+            std::lock_guard<std::mutex> lock(changesMutex);
+            pendingChanges.insert(pendingChanges.end(), events.begin(), events.end());
+            if (pendingChanges.size() > kMaxPendingChanges)
+            {
+                // Nobody is draining: keep the most recent changes
+                pendingChanges.erase(pendingChanges.begin(),
+                    pendingChanges.end() - static_cast<std::ptrdiff_t>(kMaxPendingChanges));
+            }
+        }
+        snapshotChanged.notify_all();
+    }
+
+    void DeviceCatalog::DiffDevices(const std::vector<GuitarIO::AudioDeviceInfo> &before,
+        const std::vector<GuitarIO::AudioDeviceInfo> &after,
+        bool input,
+        uint64_t generation,
+        std::vector<DeviceChangeEvent> &events)
+    {
+        for (const auto &device : before)
+        {
+            if (std::ranges::none_of(after, [&](const auto &other) { return SameDevice(device, other); }))
+            {
+                events.push_back({ .change = DeviceChange::Removed,
+                    .input = input,
+                    .device = device,
+                    .generation = generation });
+            }
+        }
+        for (const auto &device : after)
+        {
+            if (std::ranges::none_of(before, [&](const auto &other) { return SameDevice(device, other); }))
+            {
+                events.push_back({ .change = DeviceChange::Added,
+                    .input = input,
+                    .device = device,
+                    .generation = generation });
+            }
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
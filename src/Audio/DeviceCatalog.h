@@ -0,0 +1,209 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+#include <AudioDevice.h>
+
+namespace PrecisionTuner::Audio
+{
+    /** One published result of a device enumeration; immutable once published */
+    struct DeviceSnapshot
+    {
+        std::vector<GuitarIO::AudioDeviceInfo> inputDevices;  ///< Devices with input channels
+        std::vector<GuitarIO::AudioDeviceInfo> outputDevices; ///< Devices with output channels
+        uint32_t defaultInputId = UINT32_MAX;                 ///< System default input device
+        uint32_t defaultOutputId = UINT32_MAX;                ///< System default output device
+        uint64_t generation = 0;                              ///< Bumped on every change (0 = not scanned yet)
+        double enumerationMs = 0.0;                           ///< Duration of the scan that produced this snapshot
+    };
+
+    /** Kind of device list change */
+    enum class DeviceChange : uint8_t
+    {
+        Added,  ///< Device appeared (plugged in)
+        Removed ///< Device disappeared (unplugged)
+    };
+
+    /** One device appearing or disappearing between two scans */
+    struct DeviceChangeEvent
+    {
+        DeviceChange change = DeviceChange::Added; ///< What happened
+        bool input = true;                         ///< Input (true) or output (false) device list
+        GuitarIO::AudioDeviceInfo device;          ///< Device that was added or removed
+        uint64_t generation = 0;                   ///< First snapshot generation reflecting the change
+    };
+
+    /** Where device information comes from: the system device manager, or a fake in tests */
+    struct DeviceSource
+    {
+        std::function<DeviceSnapshot()> enumerate;                   ///< Lists devices and defaults (may probe)
+        std::function<GuitarIO::AudioDeviceInfo(uint32_t)> describe; ///< Info for one device ID
+        std::function<uint32_t(bool)> defaultDevice;                 ///< Default input (true) or output device ID
+    };
+
+    /**
+     * @brief Cached audio device enumeration refreshed on a background thread
+     *
+     * Probing every device (ALSA in particular) can take a long time, so nothing on the UI
+     * or audio path enumerates directly. A worker scans the devices every poll interval (or
+     * immediately on RequestRefresh()), publishes the result as an immutable snapshot and
+     * queues add/remove events for every change against the previous scan. The first scan is
+     * the baseline and raises no events.
+     *
+     * All calls into the DeviceSource are serialized, so a source that is not thread-safe
+     * (such as a shared RtAudio instance) is only ever used by one thread at a time.
+     *
+     * THREAD SAFETY:
+     *  - GetSnapshot() never waits for a scan; it copies a shared pointer under a short lock
+     *  - DrainChanges() must only be called from one thread (normally the main thread)
+     *  - Start(), Stop() and the destructor must be called from the owning thread
+     */
+    class DeviceCatalog
+    {
+    public:
+        static constexpr size_t kMaxPendingChanges = 256; ///< Undrained events kept; older ones are dropped
+
+        /**
+         * @brief Gets the source backed by GuitarIO::AudioDeviceManager
+         * @return System device source
+         */
+        [[nodiscard]] static DeviceSource SystemDeviceSource();
+
+        /**
+         * @brief Constructs the catalog (no scan runs until Start())
+         * @param pollInterval Time between background scans
+         * @param source Device source to scan
+         */
+        explicit DeviceCatalog(std::chrono::milliseconds pollInterval, DeviceSource source = SystemDeviceSource());
+
+        ~DeviceCatalog();
+
+        DeviceCatalog(const DeviceCatalog &) = delete;
+        DeviceCatalog &operator=(const DeviceCatalog &) = delete;
+
+        /**
+         * @brief Starts the background worker; the first scan begins immediately
+         */
+        void Start();
+
+        /**
+         * @brief Stops and joins the background worker
+         */
+        void Stop();
+
+        /**
+         * @brief Asks the worker to scan now instead of waiting for the poll interval
+         * Returns immediately; the result shows up as a new snapshot generation if anything changed.
+         */
+        void RequestRefresh();
+
+        /**
+         * @brief Gets the latest published device lists
+         * @return Snapshot (generation 0 with empty lists until the first scan completes)
+         */
+        [[nodiscard]] std::shared_ptr<const DeviceSnapshot> GetSnapshot() const;
+
+        /**
+         * @brief Gets information for one device without probing if possible
+         * Served from the latest snapshot; only devices not in it are queried from the source.
+         * @param deviceId Device ID
+         * @return Device information
+         */
+        [[nodiscard]] GuitarIO::AudioDeviceInfo GetDeviceInfo(uint32_t deviceId) const;
+
+        /**
+         * @brief Gets the current system default device
+         * Asked from the source rather than the snapshot, so a default changed since the last scan is seen.
+         * @param input Default input (true) or output (false) device
+         * @return Device ID
+         */
+        [[nodiscard]] uint32_t GetDefaultDevice(bool input) const;
+
+        /**
+         * @brief Blocks until a snapshot of at least the given generation is published
+         * Intended for tests and tools; the UI should poll GetSnapshot() instead.
+         * @param generation Generation to wait for
+         * @param timeout Maximum time to wait
+         * @return true if such a snapshot is available, false on timeout
+         */
+        bool WaitForGeneration(uint64_t generation, std::chrono::milliseconds timeout) const;
+
+        /**
+         * @brief Gets the number of completed scans (changed or not)
+         * @return Scan count
+         */
+        [[nodiscard]] uint64_t GetScanCount() const;
+
+        /**
+         * @brief Hands every queued change event to a handler, oldest first
+         * @param handler Callable taking const DeviceChangeEvent&
+         * @return Number of events drained
+         */
+        template<typename Handler> size_t DrainChanges(Handler &&handler)
+        {
+            std::vector<DeviceChangeEvent> drained;
+            {
+                std::lock_guard<std::mutex> lock(changesMutex);
+                drained.swap(pendingChanges);
+            }
+            for (const DeviceChangeEvent &event : drained)
+            {
+                handler(event);
+            }
+            return drained.size();
+        }
+
+    private:
+        /**
+         * @brief Worker loop: scan, then sleep until the poll interval elapses or a refresh is requested
+         * @param stopToken Stop request from the owning std::jthread
+         */
+        void WorkerMain(std::stop_token stopToken);
+
+        /**
+         * @brief Runs one enumeration and publishes it if the device lists changed
+         */
+        void Scan();
+
+        /**
+         * @brief Appends add/remove events for one device list
+         * @param before Previous list
+         * @param after New list
+         * @param input Whether these are input devices
+         * @param generation Generation of the new snapshot
+         * @param events Destination
+         */
+        static void DiffDevices(const std::vector<GuitarIO::AudioDeviceInfo> &before,
+            const std::vector<GuitarIO::AudioDeviceInfo> &after,
+            bool input,
+            uint64_t generation,
+            std::vector<DeviceChangeEvent> &events);
+
+        DeviceSource source;                    ///< Device information provider
+        std::chrono::milliseconds pollInterval; ///< Time between background scans
+        mutable std::mutex sourceMutex;         ///< Serializes every call into source
+
+        mutable std::mutex snapshotMutex;                ///< Guards snapshot (pointer swap only)
+        mutable std::condition_variable snapshotChanged; ///< Signalled when a snapshot is published
+        std::shared_ptr<const DeviceSnapshot> snapshot;  ///< Latest published scan
+        uint64_t scanCount;                              ///< Completed scans (guarded by snapshotMutex)
+
+        std::mutex changesMutex;                       ///< Guards pendingChanges
+        std::vector<DeviceChangeEvent> pendingChanges; ///< Changes not yet drained (bounded)
+
+        std::mutex wakeMutex;                   ///< Guards refreshRequested
+        std::condition_variable_any wakeWorker; ///< Wakes the worker for a refresh or stop
+        bool refreshRequested;                  ///< Scan requested before the poll interval elapsed
+
+        std::jthread worker; ///< Background scanner (declared last: stopped before the rest is destroyed)
+    };
+
+} // namespace PrecisionTuner::Audio
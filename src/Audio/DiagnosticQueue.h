@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <SpscRingBuffer.h>
+
+namespace PrecisionTuner::Audio
+{
+    /** Diagnostic event types raised by the audio threads */
+    enum class DiagnosticCode : uint8_t
+    {
+        InputBufferOverflow,   ///< Device delivered more frames than pre-allocated (value0 = frames, value1 = capacity)
+        OutputChannelMismatch, ///< Output buffer not a multiple of channels (value0 = samples, value1 = channels)
+        AnalysisQueueOverrun,  ///< Analysis thread fell behind (value0 = dropped samples, value1 = queue capacity)
+        MonitoringOverrun,     ///< Monitoring ring full (value0 = dropped samples, value1 = ring capacity)
+        MonitoringUnderrun,    ///< Monitoring ring ran dry (value0 = missing samples, value1 = frames requested)
+        ThreadScheduling,      ///< Thread applied its scheduling policy (value0 = result Pack(), value1 = errno)
+        Count                  ///< Number of codes (not an event)
+    };
+
+    /** Thread that raised a diagnostic event */
+    enum class DiagnosticSource : uint8_t
+    {
+        InputCallback,  ///< Real-time input stream callback
+        OutputCallback, ///< Real-time output stream callback
+        AnalysisThread  ///< Pitch analysis worker
+    };
+
+    /** Number of distinct diagnostic codes */
+    inline constexpr size_t kDiagnosticCodeCount = static_cast<size_t>(DiagnosticCode::Count);
+
+    /**
+     * One diagnostic event: fixed-size and trivially copyable, so raising it is a plain copy
+     * The meaning of value0/value1 depends on the code (see DiagnosticCode).
+     */
+    struct DiagnosticEvent
+    {
+        DiagnosticCode code = DiagnosticCode::Count;               ///< What happened
+        DiagnosticSource source = DiagnosticSource::InputCallback; ///< Which thread raised it
+        uint64_t sampleTime = 0;                                   ///< Stream position (samples) of the raising thread
+        uint64_t value0 = 0;                                       ///< First code-specific payload value
+        uint64_t value1 = 0;                                       ///< Second code-specific payload value
+    };
+
+    /**
+     * @brief Gets a short human-readable name for a diagnostic code
+     * @param code Diagnostic code
+     * @return Static string
+     */
+    [[nodiscard]] constexpr const char *ToString(DiagnosticCode code)
+    {
+        switch (code)
+        {
+        case DiagnosticCode::InputBufferOverflow:
+            return "input buffer overflow";
+        case DiagnosticCode::OutputChannelMismatch:
+            return "output channel mismatch";
+        case DiagnosticCode::AnalysisQueueOverrun:
+            return "analysis queue overrun";
+        case DiagnosticCode::MonitoringOverrun:
+            return "monitoring overrun";
+        case DiagnosticCode::MonitoringUnderrun:
+            return "monitoring underrun";
+        case DiagnosticCode::ThreadScheduling:
+            return "thread scheduling";
+        case DiagnosticCode::Count:
+        default:
+            return "unknown";
+        }
+    }
+
+    /**
+     * @brief Gets a short human-readable name for a diagnostic source
+     * @param source Diagnostic source
+     * @return Static string
+     */
+    [[nodiscard]] constexpr const char *ToString(DiagnosticSource source)
+    {
+        switch (source)
+        {
+        case DiagnosticSource::InputCallback:
+            return "input callback";
+        case DiagnosticSource::OutputCallback:
+            return "output callback";
+        case DiagnosticSource::AnalysisThread:
+            return "analysis thread";
+        default:
+            return "unknown";
+        }
+    }
+
+    /**
+     * @brief Pre-allocated, lock-free event queue from one real-time thread to a drain thread
+     *
+     * Raising an event is a fixed-size copy into an SPSC ring: no formatting, no allocation,
+     * no locking. If the drain side falls behind, events that do not fit are not queued
+     * but are still counted per code, so a burst shows up as a count instead of vanishing.
+     *
+     * THREAD SAFETY:
+     *  - Push() must only be called from one thread (one queue per raising thread)
+     *  - Drain() must only be called from one thread (normally the main thread)
+     */
+    class DiagnosticQueue
+    {
+    public:
+        /**
+         * @brief Constructs the queue
+         * @param capacity Minimum number of events held before new ones are counted as dropped
+         */
+        explicit DiagnosticQueue(size_t capacity) : events(capacity), dropped()
+        {
+            for (auto &counter : dropped)
+            {
+                counter.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Raises an event (producer side, real-time safe)
+         * @param event Event to queue
+         * @return true if queued, false if the queue was full (the event is counted as dropped)
+         */
+        bool Push(const DiagnosticEvent &event)
+        {
+            if (events.Write(std::span<const DiagnosticEvent>(&event, 1)) == 1)
+            {
+                return true;
+            }
+
+            const size_t index = static_cast<size_t>(event.code);
+            if (index < kDiagnosticCodeCount)
+            {
+                dropped[index].fetch_add(1, std::memory_order_relaxed);
+            }
+            return false;
+        }
+
+        /**
+         * @brief Hands every queued event to a handler, oldest first (consumer side)
+         * @param handler Callable taking const DiagnosticEvent&
+         * @return Number of events drained
+         */
+        template<typename Handler> size_t Drain(Handler &&handler)
+        {
+            size_t drained = 0;
+            DiagnosticEvent event;
+            while (events.Read(std::span<DiagnosticEvent>(&event, 1)) == 1)
+            {
+                handler(event);
+                ++drained;
+            }
+            return drained;
+        }
+
+        /**
+         * @brief Returns and clears the number of events of a code dropped because the queue was full
+         * @param code Diagnostic code
+         * @return Dropped event count since the previous call
+         */
+        uint64_t TakeDropped(DiagnosticCode code)
+        {
+            const size_t index = static_cast<size_t>(code);
+            return index < kDiagnosticCodeCount ? dropped[index].exchange(0, std::memory_order_relaxed) : 0;
+        }
+
+    private:
+        SpscRingBuffer<DiagnosticEvent> events;                          ///< Queued events
+        std::array<std::atomic<uint64_t>, kDiagnosticCodeCount> dropped; ///< Per-code overflow counters
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Fixed-capacity history of the most recent values, one writer and many readers
+     *
+     * The writer overwrites the oldest slot on every Push(). Each slot carries a version
+     * (the 1-based index of the value it holds, 0 while being written), so a reader can
+     * check that the slot still holds the entry it wanted after copying it. Entries that
+     * were overwritten mid-copy are skipped instead of retried, which makes readers
+     * wait-free: a copy-out touches every slot at most once.
+     *
+     * THREAD SAFETY:
+     *  - Push() must only be called from one thread; it never allocates or blocks
+     *  - CopyLatest() and CopySince() may be called from any number of threads
+     *  - Reset() must only be called while no writer or reader is active
+     *
+     * @tparam T Trivially copyable element type
+     */
+    template<typename T> class HistoryRing
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "HistoryRing requires a trivially copyable element type");
+
+    public:
+        /**
+         * @brief Constructs the history
+         * @param minCapacity Minimum number of entries kept (rounded up to a power of two)
+         */
+        explicit HistoryRing(size_t minCapacity = 0) : slots(nullptr), capacity(0), mask(0), pushed(0)
+        {
+            Reset(minCapacity);
+        }
+
+        /**
+         * @brief Reallocates storage and forgets all entries
+         * @param minCapacity Minimum number of entries kept (rounded up to a power of two)
+         * @note Not thread-safe. Call only while no writer or reader is running.
+         */
+        void Reset(size_t minCapacity)
+        {
+            capacity = minCapacity > 0 ? std::bit_ceil(minCapacity) : 0;
+            mask = capacity > 0 ? capacity - 1 : 0;
+            slots = capacity > 0 ? std::make_unique<Slot[]>(capacity) : nullptr;
+            pushed.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Gets the number of entries the history can hold
+         * @return Capacity (power of two, or zero)
+         */
+        [[nodiscard]] size_t Capacity() const
+        {
+            return capacity;
+        }
+
+        /**
+         * @brief Gets the number of entries pushed since the last Reset()
+         * @return Total push count (entries older than Capacity() are gone)
+         */
+        [[nodiscard]] uint64_t TotalPushed() const
+        {
+            return pushed.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Appends a value, overwriting the oldest entry when full (writer side)
+         * @param value Value to append
+         */
+        void Push(const T &value)
+        {
+            if (capacity == 0)
+            {
+                return;
+            }
+
+            const uint64_t index = pushed.load(std::memory_order_relaxed);
+            Slot &slot = slots[index & mask];
+
+            slot.version.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            std::array<uint64_t, kWordCount> copy{};
+            std::memcpy(copy.data(), &value, sizeof(T));
+            for (size_t i = 0; i < kWordCount; ++i)
+            {
+                slot.words[i].store(copy[i], std::memory_order_relaxed);
+            }
+
+            slot.version.store(index + 1, std::memory_order_release);
+            pushed.store(index + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Copies the most recent entries, oldest first (reader side, wait-free)
+         * @param out Destination; at most out.size() of the newest entries are copied
+         * @return Number of entries copied
+         */
+        size_t CopyLatest(std::span<T> out) const
+        {
+            const uint64_t end = pushed.load(std::memory_order_acquire);
+            const uint64_t available = std::min<uint64_t>(end, capacity);
+            const uint64_t wanted = std::min<uint64_t>(available, out.size());
+            uint64_t cursor = end - wanted;
+            return CopyRange(cursor, end, out);
+        }
+
+        /**
+         * @brief Copies entries pushed after a cursor, oldest first (reader side, wait-free)
+         *
+         * The cursor is the total push count the caller has already consumed (start at 0).
+         * On return it is advanced past the copied entries. If the caller fell more than
+         * Capacity() entries behind, the overwritten entries are skipped.
+         *
+         * @param cursor In: entries already consumed. Out: new consumed count.
+         * @param out Destination buffer
+         * @return Number of entries copied
+         */
+        size_t CopySince(uint64_t &cursor, std::span<T> out) const
+        {
+            const uint64_t end = pushed.load(std::memory_order_acquire);
+            const uint64_t oldest = end > capacity ? end - capacity : 0;
+            cursor = std::clamp(cursor, oldest, end);
+            const uint64_t stop = std::min<uint64_t>(end, cursor + out.size());
+            return CopyRange(cursor, stop, out);
+        }
+
+    private:
+        static constexpr size_t kWordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        /** One history entry guarded by its version */
+        struct Slot
+        {
+            std::atomic<uint64_t> version{ 0 };                  ///< 1-based entry index, 0 while writing
+            std::array<std::atomic<uint64_t>, kWordCount> words; ///< Entry bytes
+        };
+
+        /**
+         * @brief Copies entries [cursor, stop) into out, skipping any overwritten mid-copy
+         * @param cursor First entry index; advanced to stop on return
+         * @param stop One past the last entry index
+         * @param out Destination buffer (must hold stop - cursor entries)
+         * @return Number of entries copied
+         */
+        size_t CopyRange(uint64_t &cursor, uint64_t stop, std::span<T> out) const
+        {
+            size_t copied = 0;
+            std::array<uint64_t, kWordCount> copy{};
+
+            for (; cursor < stop; ++cursor)
+            {
+                const Slot &slot = slots[cursor & mask];
+                const uint64_t before = slot.version.load(std::memory_order_acquire);
+                if (before != cursor + 1)
+                {
+                    continue; // Already overwritten by a newer entry
+                }
+
+                for (size_t i = 0; i < kWordCount; ++i)
+                {
+                    copy[i] = slot.words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (slot.version.load(std::memory_order_relaxed) != before)
+                {
+                    continue; // Overwritten while we were copying
+                }
+
+                std::memcpy(static_cast<void *>(&out[copied]), copy.data(), sizeof(T));
+                ++copied;
+            }
+
+            return copied;
+        }
+
+        std::unique_ptr<Slot[]> slots; ///< Entry storage
+        size_t capacity;               ///< Number of slots (power of two)
+        size_t mask;                   ///< capacity - 1, used for index wrapping
+        std::atomic<uint64_t> pushed;  ///< Total entries pushed (writer-owned)
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,749 @@
+/**
+ * Input Conditioning Kernels
+ * Single-pass conversion / gain / copy / mirror / peak / RMS with runtime ISA dispatch
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "InputConditioning.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Platform-specific includes (BEFORE namespace to avoid pollution)
+#if defined(__x86_64__) || defined(_M_X64)
+#define PRECISION_TUNER_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts AVX2 intrinsics in any function; the caller guarantees CPU support
+#define PRECISION_TUNER_TARGET_AVX2
+#else
+#define PRECISION_TUNER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        /// Kernel signature: (input, output, mirror or nullptr, count, gain)
+        using KernelFn = ConditioningStats (*)(const float *, float *, float *, size_t, float);
+
+        /// Converting kernel signature: (device samples, output, mirror or nullptr, count, gain / full scale)
+        using ConvertKernelFn = ConditioningStats (*)(const std::byte *, float *, float *, size_t, float);
+
+        /// Deinterleave signature: (interleaved input, one output per channel, channels, frames)
+        using DeinterleaveFn = void (*)(const float *, float *const *, size_t, size_t);
+
+        /// Maximum channels DeinterleaveBlock() splits (destination pointers live on the stack)
+        constexpr size_t kMaxDeinterleaveChannels = 64;
+
+        void ScalarDeinterleaveRange(const float *input,
+            float *const *outputs,
+            size_t channels,
+            size_t firstFrame,
+            size_t frames)
+        {
+            for (size_t channel = 0; channel < channels; ++channel)
+            {
+                float *output = outputs[channel];
+                for (size_t frame = firstFrame; frame < frames; ++frame)
+                {
+                    output[frame] = input[frame * channels + channel];
+                }
+            }
+        }
+
+        void ScalarDeinterleave(const float *input, float *const *outputs, size_t channels, size_t frames)
+        {
+            ScalarDeinterleaveRange(input, outputs, channels, 0, frames);
+        }
+
+        /// Integer value that maps to 1.0 (gain is divided by it, so conversion costs no extra multiply)
+        constexpr float FullScale(SampleFormat format)
+        {
+            switch (format)
+            {
+            case SampleFormat::Int16:
+                return 32768.0f;
+            case SampleFormat::Int24:
+                return 8388608.0f;
+            case SampleFormat::Int32:
+                return 2147483648.0f;
+            case SampleFormat::Float32:
+            default:
+                return 1.0f;
+            }
+        }
+
+        int32_t LoadInt24(const std::byte *input, size_t index)
+        {
+            const std::byte *bytes = input + index * 3;
+            const uint32_t value = std::to_integer<uint32_t>(bytes[0]) | (std::to_integer<uint32_t>(bytes[1]) << 8)
+                                   | (std::to_integer<uint32_t>(bytes[2]) << 16);
+            // Move the sign bit to the top, then shift back arithmetically to sign-extend
+            return static_cast<int32_t>(value << 8) >> 8;
+        }
+
+        /// Reads one integer device sample, unscaled
+        template<SampleFormat kFormat> float LoadSample(const std::byte *input, size_t index)
+        {
+            if constexpr (kFormat == SampleFormat::Int16)
+            {
+                int16_t value = 0;
+                std::memcpy(&value, input + index * sizeof(value), sizeof(value));
+                return static_cast<float>(value);
+            }
+            else if constexpr (kFormat == SampleFormat::Int24)
+            {
+                return static_cast<float>(LoadInt24(input, index));
+            }
+            else
+            {
+                int32_t value = 0;
+                std::memcpy(&value, input + index * sizeof(value), sizeof(value));
+                return static_cast<float>(value);
+            }
+        }
+
+        /// Converts samples [first, count) one at a time (vector kernel tails and the scalar kernel)
+        template<SampleFormat kFormat, bool kMirror>
+        void ConvertRange(const std::byte *input,
+            float *output,
+            float *mirror,
+            size_t first,
+            size_t count,
+            float scale,
+            ConditioningStats &stats)
+        {
+            for (size_t i = first; i < count; ++i)
+            {
+                const float sample = LoadSample<kFormat>(input, i) * scale;
+                output[i] = sample;
+                if constexpr (kMirror)
+                {
+                    mirror[i] = sample;
+                }
+                stats.peak = std::max(stats.peak, std::abs(sample));
+                stats.sumSquares += sample * sample;
+            }
+        }
+
+        template<SampleFormat kFormat, bool kMirror>
+        ConditioningStats ScalarConvertKernel(const std::byte *input,
+            float *output,
+            float *mirror,
+            size_t count,
+            float scale)
+        {
+            ConditioningStats stats;
+            ConvertRange<kFormat, kMirror>(input, output, mirror, 0, count, scale, stats);
+            stats.samples = count;
+            return stats;
+        }
+
+        template<bool kMirror>
+        ConditioningStats ScalarKernel(const float *input, float *output, float *mirror, size_t count, float gain)
+        {
+            ConditioningStats stats;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const float sample = input[i] * gain;
+                output[i] = sample;
+                if constexpr (kMirror)
+                {
+                    mirror[i] = sample;
+                }
+                stats.peak = std::max(stats.peak, std::abs(sample));
+                stats.sumSquares += sample * sample;
+            }
+            stats.samples = count;
+            return stats;
+        }
+
+#ifdef PRECISION_TUNER_X86_64
+        template<bool kMirror>
+        ConditioningStats Sse2Kernel(const float *input, float *output, float *mirror, size_t count, float gain)
+        {
+            const __m128 gainVec = _mm_set1_ps(gain);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            __m128 peakVec = _mm_setzero_ps();
+            __m128 sumVec = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 sample = _mm_mul_ps(_mm_loadu_ps(input + i), gainVec);
+                _mm_storeu_ps(output + i, sample);
+                if constexpr (kMirror)
+                {
+                    _mm_storeu_ps(mirror + i, sample);
+                }
+                peakVec = _mm_max_ps(peakVec, _mm_andnot_ps(signMask, sample));
+                sumVec = _mm_add_ps(sumVec, _mm_mul_ps(sample, sample));
+            }
+
+            alignas(16) std::array<float, 4> peakLanes{};
+            alignas(16) std::array<float, 4> sumLanes{};
+            _mm_store_ps(peakLanes.data(), peakVec);
+            _mm_store_ps(sumLanes.data(), sumVec);
+
+            ConditioningStats stats;
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                stats.peak = std::max(stats.peak, peakLanes[lane]);
+                stats.sumSquares += sumLanes[lane];
+            }
+
+            // Scalar tail (fewer than 4 samples)
+            for (; i < count; ++i)
+            {
+                const float sample = input[i] * gain;
+                output[i] = sample;
+                if constexpr (kMirror)
+                {
+                    mirror[i] = sample;
+                }
+                stats.peak = std::max(stats.peak, std::abs(sample));
+                stats.sumSquares += sample * sample;
+            }
+
+            stats.samples = count;
+            return stats;
+        }
+
+        template<bool kMirror>
+        PRECISION_TUNER_TARGET_AVX2 ConditioningStats Avx2Kernel(const float *input,
+            float *output,
+            float *mirror,
+            size_t count,
+            float gain)
+        {
+            const __m256 gainVec = _mm256_set1_ps(gain);
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            __m256 peakVec = _mm256_setzero_ps();
+            __m256 sumVec = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const __m256 sample = _mm256_mul_ps(_mm256_loadu_ps(input + i), gainVec);
+                _mm256_storeu_ps(output + i, sample);
+                if constexpr (kMirror)
+                {
+                    _mm256_storeu_ps(mirror + i, sample);
+                }
+                peakVec = _mm256_max_ps(peakVec, _mm256_andnot_ps(signMask, sample));
+                sumVec = _mm256_add_ps(sumVec, _mm256_mul_ps(sample, sample));
+            }
+
+            alignas(32) std::array<float, 8> peakLanes{};
+            alignas(32) std::array<float, 8> sumLanes{};
+            _mm256_store_ps(peakLanes.data(), peakVec);
+            _mm256_store_ps(sumLanes.data(), sumVec);
+
+            ConditioningStats stats;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                stats.peak = std::max(stats.peak, peakLanes[lane]);
+                stats.sumSquares += sumLanes[lane];
+            }
+
+            // Scalar tail (fewer than 8 samples)
+            for (; i < count; ++i)
+            {
+                const float sample = input[i] * gain;
+                output[i] = sample;
+                if constexpr (kMirror)
+                {
+                    mirror[i] = sample;
+                }
+                stats.peak = std::max(stats.peak, std::abs(sample));
+                stats.sumSquares += sample * sample;
+            }
+
+            stats.samples = count;
+            return stats;
+        }
+
+        /// Loads four integer device samples as sign-extended 32-bit lanes
+        template<SampleFormat kFormat> __m128i Sse2LoadInts(const std::byte *input, size_t index)
+        {
+            if constexpr (kFormat == SampleFormat::Int16)
+            {
+                // No 16-to-32 sign extension before SSE4.1: pair each sample with itself, shift the copy out
+                const __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(input + index * 2));
+                return _mm_srai_epi32(_mm_unpacklo_epi16(packed, packed), 16);
+            }
+            else if constexpr (kFormat == SampleFormat::Int24)
+            {
+                // No byte shuffle before SSSE3: assemble the packed samples lane by lane
+                return _mm_setr_epi32(LoadInt24(input, index),
+                    LoadInt24(input, index + 1),
+                    LoadInt24(input, index + 2),
+                    LoadInt24(input, index + 3));
+            }
+            else
+            {
+                return _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + index * 4));
+            }
+        }
+
+        template<SampleFormat kFormat, bool kMirror>
+        ConditioningStats Sse2ConvertKernel(const std::byte *input,
+            float *output,
+            float *mirror,
+            size_t count,
+            float scale)
+        {
+            const __m128 scaleVec = _mm_set1_ps(scale);
+            const __m128 signMask = _mm_set1_ps(-0.0f);
+            __m128 peakVec = _mm_setzero_ps();
+            __m128 sumVec = _mm_setzero_ps();
+
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 sample = _mm_mul_ps(_mm_cvtepi32_ps(Sse2LoadInts<kFormat>(input, i)), scaleVec);
+                _mm_storeu_ps(output + i, sample);
+                if constexpr (kMirror)
+                {
+                    _mm_storeu_ps(mirror + i, sample);
+                }
+                peakVec = _mm_max_ps(peakVec, _mm_andnot_ps(signMask, sample));
+                sumVec = _mm_add_ps(sumVec, _mm_mul_ps(sample, sample));
+            }
+
+            alignas(16) std::array<float, 4> peakLanes{};
+            alignas(16) std::array<float, 4> sumLanes{};
+            _mm_store_ps(peakLanes.data(), peakVec);
+            _mm_store_ps(sumLanes.data(), sumVec);
+
+            ConditioningStats stats;
+            for (size_t lane = 0; lane < 4; ++lane)
+            {
+                stats.peak = std::max(stats.peak, peakLanes[lane]);
+                stats.sumSquares += sumLanes[lane];
+            }
+
+            // Scalar tail (fewer than 4 samples)
+            ConvertRange<kFormat, kMirror>(input, output, mirror, i, count, scale, stats);
+            stats.samples = count;
+            return stats;
+        }
+
+        /// Samples one AVX2 iteration needs in the source: the 24-bit loads read 4 bytes past the 8 samples
+        template<SampleFormat kFormat> constexpr size_t kAvx2ConvertSpan = kFormat == SampleFormat::Int24 ? 10 : 8;
+
+        /// Loads eight integer device samples as sign-extended 32-bit lanes
+        template<SampleFormat kFormat> PRECISION_TUNER_TARGET_AVX2 __m256i Avx2LoadInts(const std::byte *input,
+            size_t index)
+        {
+            if constexpr (kFormat == SampleFormat::Int16)
+            {
+                return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(input + index * 2)));
+            }
+            else if constexpr (kFormat == SampleFormat::Int24)
+            {
+                // Samples 0-3 and 4-7 fill the low 12 bytes of one 16-byte load each; the in-lane byte shuffle
+                // moves every sample into the top three bytes of its lane, and the shift sign-extends it
+                const std::byte *bytes = input + index * 3;
+                const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes));
+                const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + 12));
+                const __m256i packed = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+                const __m256i spread = _mm256_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                    -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+                return _mm256_srai_epi32(_mm256_shuffle_epi8(packed, spread), 8);
+            }
+            else
+            {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input + index * 4));
+            }
+        }
+
+        template<SampleFormat kFormat, bool kMirror>
+        PRECISION_TUNER_TARGET_AVX2 ConditioningStats Avx2ConvertKernel(const std::byte *input,
+            float *output,
+            float *mirror,
+            size_t count,
+            float scale)
+        {
+            const __m256 scaleVec = _mm256_set1_ps(scale);
+            const __m256 signMask = _mm256_set1_ps(-0.0f);
+            __m256 peakVec = _mm256_setzero_ps();
+            __m256 sumVec = _mm256_setzero_ps();
+
+            size_t i = 0;
+            for (; i + kAvx2ConvertSpan<kFormat> <= count; i += 8)
+            {
+                const __m256 sample = _mm256_mul_ps(_mm256_cvtepi32_ps(Avx2LoadInts<kFormat>(input, i)), scaleVec);
+                _mm256_storeu_ps(output + i, sample);
+                if constexpr (kMirror)
+                {
+                    _mm256_storeu_ps(mirror + i, sample);
+                }
+                peakVec = _mm256_max_ps(peakVec, _mm256_andnot_ps(signMask, sample));
+                sumVec = _mm256_add_ps(sumVec, _mm256_mul_ps(sample, sample));
+            }
+
+            alignas(32) std::array<float, 8> peakLanes{};
+            alignas(32) std::array<float, 8> sumLanes{};
+            _mm256_store_ps(peakLanes.data(), peakVec);
+            _mm256_store_ps(sumLanes.data(), sumVec);
+
+            ConditioningStats stats;
+            for (size_t lane = 0; lane < 8; ++lane)
+            {
+                stats.peak = std::max(stats.peak, peakLanes[lane]);
+                stats.sumSquares += sumLanes[lane];
+            }
+
+            // Scalar tail (fewer than kAvx2ConvertSpan samples); the tail may be an out-of-line SSE function, so
+            // clear the upper halves first to avoid the AVX-to-SSE transition penalty
+            _mm256_zeroupper();
+            ConvertRange<kFormat, kMirror>(input, output, mirror, i, count, scale, stats);
+            stats.samples = count;
+            return stats;
+        }
+
+        void Sse2Deinterleave(const float *input, float *const *outputs, size_t channels, size_t frames)
+        {
+            size_t frame = 0;
+            if (channels == 2)
+            {
+                float *left = outputs[0];
+                float *right = outputs[1];
+                for (; frame + 4 <= frames; frame += 4)
+                {
+                    const __m128 first = _mm_loadu_ps(input + frame * 2);      // l0 r0 l1 r1
+                    const __m128 second = _mm_loadu_ps(input + frame * 2 + 4); // l2 r2 l3 r3
+                    _mm_storeu_ps(left + frame, _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(right + frame, _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+                }
+            }
+            else if (channels == 4)
+            {
+                for (; frame + 4 <= frames; frame += 4)
+                {
+                    // Four frames of four channels form a 4x4 matrix; its transpose is one vector per channel
+                    __m128 row0 = _mm_loadu_ps(input + frame * 4);
+                    __m128 row1 = _mm_loadu_ps(input + frame * 4 + 4);
+                    __m128 row2 = _mm_loadu_ps(input + frame * 4 + 8);
+                    __m128 row3 = _mm_loadu_ps(input + frame * 4 + 12);
+                    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+                    _mm_storeu_ps(outputs[0] + frame, row0);
+                    _mm_storeu_ps(outputs[1] + frame, row1);
+                    _mm_storeu_ps(outputs[2] + frame, row2);
+                    _mm_storeu_ps(outputs[3] + frame, row3);
+                }
+            }
+
+            // Other channel counts and the tail (fewer than 4 frames)
+            ScalarDeinterleaveRange(input, outputs, channels, frame, frames);
+        }
+
+        PRECISION_TUNER_TARGET_AVX2 void Avx2Deinterleave(const float *input,
+            float *const *outputs,
+            size_t channels,
+            size_t frames)
+        {
+            if (channels != 2)
+            {
+                Sse2Deinterleave(input, outputs, channels, frames);
+                return;
+            }
+
+            float *left = outputs[0];
+            float *right = outputs[1];
+            size_t frame = 0;
+            for (; frame + 8 <= frames; frame += 8)
+            {
+                const __m256 first = _mm256_loadu_ps(input + frame * 2);      // l0 r0 l1 r1 | l2 r2 l3 r3
+                const __m256 second = _mm256_loadu_ps(input + frame * 2 + 8); // l4 r4 l5 r5 | l6 r6 l7 r7
+
+                // In-lane shuffles give l0 l1 l4 l5 | l2 l3 l6 l7; swapping the middle pairs restores the order
+                const __m256 evens = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0));
+                const __m256 odds = _mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm256_storeu_ps(left + frame,
+                    _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(evens), _MM_SHUFFLE(3, 1, 2, 0))));
+                _mm256_storeu_ps(right + frame,
+                    _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odds), _MM_SHUFFLE(3, 1, 2, 0))));
+            }
+
+            // Scalar tail (fewer than 8 frames)
+            ScalarDeinterleaveRange(input, outputs, channels, frame, frames);
+        }
+
+        bool CpuSupportsAvx2()
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            std::array<int, 4> info{};
+            __cpuid(info.data(), 1);
+            const bool osUsesXsave = (info[2] & (1 << 27)) != 0;
+            const bool cpuHasAvx = (info[2] & (1 << 28)) != 0;
+            if (!osUsesXsave || !cpuHasAvx || (_xgetbv(0) & 0x6) != 0x6)
+            {
+                return false;
+            }
+            __cpuidex(info.data(), 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2") != 0;
+#endif
+        }
+#endif
+
+        SimdLevel DetectSimdLevel()
+        {
+#ifdef PRECISION_TUNER_X86_64
+            return CpuSupportsAvx2() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        KernelFn SelectKernel(SimdLevel level, bool withMirror)
+        {
+            switch (level)
+            {
+#ifdef PRECISION_TUNER_X86_64
+            case SimdLevel::AVX2:
+                return withMirror ? &Avx2Kernel<true> : &Avx2Kernel<false>;
+            case SimdLevel::SSE2:
+                return withMirror ? &Sse2Kernel<true> : &Sse2Kernel<false>;
+#endif
+            case SimdLevel::Scalar:
+            default:
+                return withMirror ? &ScalarKernel<true> : &ScalarKernel<false>;
+            }
+        }
+
+        template<SampleFormat kFormat> ConvertKernelFn SelectConvertKernel(SimdLevel level, bool withMirror)
+        {
+            switch (level)
+            {
+#ifdef PRECISION_TUNER_X86_64
+            case SimdLevel::AVX2:
+                return withMirror ? &Avx2ConvertKernel<kFormat, true> : &Avx2ConvertKernel<kFormat, false>;
+            case SimdLevel::SSE2:
+                return withMirror ? &Sse2ConvertKernel<kFormat, true> : &Sse2ConvertKernel<kFormat, false>;
+#endif
+            case SimdLevel::Scalar:
+            default:
+                return withMirror ? &ScalarConvertKernel<kFormat, true> : &ScalarConvertKernel<kFormat, false>;
+            }
+        }
+
+        ConditioningStats RunConvert(SimdLevel level,
+            std::span<const std::byte> input,
+            SampleFormat format,
+            float gain,
+            std::span<float> output,
+            std::span<float> mirror)
+        {
+            size_t count = std::min(input.size() / BytesPerSample(format), output.size());
+            float *mirrorData = nullptr;
+            if (!mirror.empty())
+            {
+                count = std::min(count, mirror.size());
+                mirrorData = mirror.data();
+            }
+
+            const float scale = gain / FullScale(format);
+            switch (format)
+            {
+            case SampleFormat::Int16:
+                return SelectConvertKernel<SampleFormat::Int16>(level, mirrorData != nullptr)(
+                    input.data(), output.data(), mirrorData, count, scale);
+            case SampleFormat::Int24:
+                return SelectConvertKernel<SampleFormat::Int24>(level, mirrorData != nullptr)(
+                    input.data(), output.data(), mirrorData, count, scale);
+            case SampleFormat::Int32:
+                return SelectConvertKernel<SampleFormat::Int32>(level, mirrorData != nullptr)(
+                    input.data(), output.data(), mirrorData, count, scale);
+            case SampleFormat::Float32:
+            default:
+                // Already float (device buffers are at least float-aligned)
+                return SelectKernel(level, mirrorData != nullptr)(
+                    reinterpret_cast<const float *>(input.data()), output.data(), mirrorData, count, scale);
+            }
+        }
+
+        DeinterleaveFn SelectDeinterleave(SimdLevel level)
+        {
+            switch (level)
+            {
+#ifdef PRECISION_TUNER_X86_64
+            case SimdLevel::AVX2:
+                return &Avx2Deinterleave;
+            case SimdLevel::SSE2:
+                return &Sse2Deinterleave;
+#endif
+            case SimdLevel::Scalar:
+            default:
+                return &ScalarDeinterleave;
+            }
+        }
+
+        size_t RunDeinterleave(DeinterleaveFn kernel,
+            std::span<const float> interleaved,
+            std::span<const std::span<float>> channels)
+        {
+            if (channels.empty())
+            {
+                return 0;
+            }
+
+            size_t frames = interleaved.size() / channels.size();
+            for (const std::span<float> &channel : channels)
+            {
+                frames = std::min(frames, channel.size());
+            }
+
+            if (channels.size() > kMaxDeinterleaveChannels)
+            {
+                // Beyond any real interface: no room for the pointer table, copy strided
+                for (size_t channel = 0; channel < channels.size(); ++channel)
+                {
+                    for (size_t frame = 0; frame < frames; ++frame)
+                    {
+                        channels[channel][frame] = interleaved[frame * channels.size() + channel];
+                    }
+                }
+                return frames;
+            }
+
+            std::array<float *, kMaxDeinterleaveChannels> outputs{};
+            for (size_t channel = 0; channel < channels.size(); ++channel)
+            {
+                outputs[channel] = channels[channel].data();
+            }
+            kernel(interleaved.data(), outputs.data(), channels.size(), frames);
+            return frames;
+        }
+
+        /// Detected once during static initialisation, before any audio stream can start
+        const SimdLevel kActiveLevel = DetectSimdLevel();
+        const KernelFn kActiveKernel = SelectKernel(kActiveLevel, false);
+        const KernelFn kActiveMirrorKernel = SelectKernel(kActiveLevel, true);
+        const DeinterleaveFn kActiveDeinterleave = SelectDeinterleave(kActiveLevel);
+    } // namespace
+
+    ConditioningStats ConditionBlock(std::span<const float> input,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror)
+    {
+        const size_t count = std::min(input.size(), output.size());
+        if (!mirror.empty())
+        {
+            return kActiveMirrorKernel(input.data(), output.data(), mirror.data(), std::min(count, mirror.size()), gain);
+        }
+        return kActiveKernel(input.data(), output.data(), nullptr, count, gain);
+    }
+
+    ConditioningStats ConditionBlockWith(SimdLevel level,
+        std::span<const float> input,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror)
+    {
+        const SimdLevel effective = IsSimdLevelSupported(level) ? level : SimdLevel::Scalar;
+        const size_t count = std::min(input.size(), output.size());
+        if (!mirror.empty())
+        {
+            return SelectKernel(effective, true)(
+                input.data(), output.data(), mirror.data(), std::min(count, mirror.size()), gain);
+        }
+        return SelectKernel(effective, false)(input.data(), output.data(), nullptr, count, gain);
+    }
+
+    ConditioningStats ConditionBlock(std::span<const std::byte> input,
+        SampleFormat format,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror)
+    {
+        return RunConvert(kActiveLevel, input, format, gain, output, mirror);
+    }
+
+    ConditioningStats ConditionBlockWith(SimdLevel level,
+        std::span<const std::byte> input,
+        SampleFormat format,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror)
+    {
+        const SimdLevel effective = IsSimdLevelSupported(level) ? level : SimdLevel::Scalar;
+        return RunConvert(effective, input, format, gain, output, mirror);
+    }
+
+    size_t DeinterleaveBlock(std::span<const float> interleaved, std::span<const std::span<float>> channels)
+    {
+        return RunDeinterleave(kActiveDeinterleave, interleaved, channels);
+    }
+
+    size_t DeinterleaveBlockWith(SimdLevel level,
+        std::span<const float> interleaved,
+        std::span<const std::span<float>> channels)
+    {
+        const SimdLevel effective = IsSimdLevelSupported(level) ? level : SimdLevel::Scalar;
+        return RunDeinterleave(SelectDeinterleave(effective), interleaved, channels);
+    }
+
+    bool IsSimdLevelSupported(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Scalar:
+            return true;
+#ifdef PRECISION_TUNER_X86_64
+        case SimdLevel::SSE2:
+            return true;
+        case SimdLevel::AVX2:
+            return kActiveLevel == SimdLevel::AVX2;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    SimdLevel GetActiveSimdLevel()
+    {
+        return kActiveLevel;
+    }
+
+    const char *ToString(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::Scalar:
+        default:
+            return "Scalar";
+        }
+    }
+
+    const char *ToString(SampleFormat format)
+    {
+        switch (format)
+        {
+        case SampleFormat::Int16:
+            return "int16";
+        case SampleFormat::Int24:
+            return "int24";
+        case SampleFormat::Int32:
+            return "int32";
+        case SampleFormat::Float32:
+        default:
+            return "float32";
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <span>
+
+namespace PrecisionTuner::Audio
+{
+    /** Instruction set used by the conditioning kernels */
+    enum class SimdLevel
+    {
+        Scalar, ///< Portable C++ loop
+        SSE2,   ///< 4-wide (x86-64 baseline)
+        AVX2    ///< 8-wide (selected at runtime when the CPU supports it)
+    };
+
+    /** Sample format of a captured block (little-endian, interleaved as delivered by the device) */
+    enum class SampleFormat
+    {
+        Float32, ///< 32-bit float, full scale +-1.0
+        Int16,   ///< 16-bit signed integer
+        Int24,   ///< 24-bit signed integer packed in 3 bytes
+        Int32    ///< 32-bit signed integer (also 24-bit samples left-justified in 32 bits)
+    };
+
+    /**
+     * @brief Gets the storage size of one sample
+     * @param format Sample format
+     * @return Bytes per sample
+     */
+    [[nodiscard]] constexpr size_t BytesPerSample(SampleFormat format)
+    {
+        switch (format)
+        {
+        case SampleFormat::Int16:
+            return 2;
+        case SampleFormat::Int24:
+            return 3;
+        case SampleFormat::Int32:
+        case SampleFormat::Float32:
+        default:
+            return 4;
+        }
+    }
+
+    /** Level statistics gathered while conditioning a block */
+    struct ConditioningStats
+    {
+        float peak = 0.0f;       ///< Maximum absolute sample value after gain
+        float sumSquares = 0.0f; ///< Sum of squared samples after gain
+        size_t samples = 0;      ///< Number of samples accumulated
+
+        /**
+         * @brief Combines statistics of two consecutive blocks
+         * @param other Statistics of the following block
+         */
+        void Merge(const ConditioningStats &other)
+        {
+            peak = std::max(peak, other.peak);
+            sumSquares += other.sumSquares;
+            samples += other.samples;
+        }
+
+        /**
+         * @brief Gets the true RMS level of the accumulated samples
+         * @return RMS value (0 for an empty block)
+         */
+        [[nodiscard]] float Rms() const
+        {
+            return samples > 0 ? std::sqrt(sumSquares / static_cast<float>(samples)) : 0.0f;
+        }
+    };
+
+    /**
+     * @brief Applies gain to a block of input in a single pass
+     *
+     * Writes input * gain to output and, if mirror is non-empty, to mirror as well (used
+     * for the monitoring ring), while accumulating peak and sum of squares. The widest
+     * instruction set supported by the CPU is picked once at startup.
+     *
+     * Real-time safe: no allocation, no locking.
+     *
+     * @param input Source samples
+     * @param gain Linear gain
+     * @param output Destination, must hold input.size() samples (may be the input itself)
+     * @param mirror Optional second destination, empty or input.size() samples
+     * @return Peak / sum-of-squares statistics of the gained block
+     */
+    ConditioningStats ConditionBlock(std::span<const float> input,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror = {});
+
+    /**
+     * @brief Same as ConditionBlock() but forces a specific instruction set
+     * Falls back to Scalar if the requested level is not supported. Intended for tests and benchmarks.
+     */
+    ConditioningStats ConditionBlockWith(SimdLevel level,
+        std::span<const float> input,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror = {});
+
+    /**
+     * @brief Converts a block of device samples to float and conditions it in a single pass
+     *
+     * Same as ConditionBlock(), with the conversion to full-scale float folded into the gain:
+     * each lane is sign-extended, converted and multiplied once by gain / full scale. Lets a
+     * stream opened in the device's native integer format skip the backend's conversion pass.
+     *
+     * Real-time safe: no allocation, no locking.
+     *
+     * @param input Source samples in format (a trailing partial sample is ignored)
+     * @param format Sample format of input
+     * @param gain Linear gain applied on top of the full-scale conversion
+     * @param output Destination, must hold one float per input sample
+     * @param mirror Optional second destination, empty or one float per input sample
+     * @return Peak / sum-of-squares statistics of the converted, gained block
+     */
+    ConditioningStats ConditionBlock(std::span<const std::byte> input,
+        SampleFormat format,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror = {});
+
+    /**
+     * @brief Same as ConditionBlock() for device samples but forces a specific instruction set
+     * Falls back to Scalar if the requested level is not supported. Intended for tests and benchmarks.
+     */
+    ConditioningStats ConditionBlockWith(SimdLevel level,
+        std::span<const std::byte> input,
+        SampleFormat format,
+        float gain,
+        std::span<float> output,
+        std::span<float> mirror = {});
+
+    /**
+     * @brief Splits interleaved frames into one contiguous block per channel
+     *
+     * Stereo and 4-channel input are shuffled with SIMD (same runtime dispatch as
+     * ConditionBlock()); other channel counts use a strided scalar loop.
+     *
+     * Real-time safe: no allocation, no locking.
+     *
+     * @param interleaved Source samples, channels.size() per frame (a trailing partial frame is ignored)
+     * @param channels One destination per channel
+     * @return Frames written to every destination (limited by the smallest destination)
+     */
+    size_t DeinterleaveBlock(std::span<const float> interleaved, std::span<const std::span<float>> channels);
+
+    /**
+     * @brief Same as DeinterleaveBlock() but forces a specific instruction set
+     * Falls back to Scalar if the requested level is not supported. Intended for tests and benchmarks.
+     */
+    size_t DeinterleaveBlockWith(SimdLevel level,
+        std::span<const float> interleaved,
+        std::span<const std::span<float>> channels);
+
+    /**
+     * @brief Checks whether the CPU (and build) supports an instruction set
+     * @param level Instruction set to query
+     * @return true if kernels for this level can run here
+     */
+    [[nodiscard]] bool IsSimdLevelSupported(SimdLevel level);
+
+    /**
+     * @brief Gets the instruction set ConditionBlock() dispatches to
+     * @return Widest supported level
+     */
+    [[nodiscard]] SimdLevel GetActiveSimdLevel();
+
+    /**
+     * @brief Gets a human-readable name for an instruction set
+     * @param level Instruction set
+     * @return Static string ("Scalar", "SSE2", "AVX2")
+     */
+    [[nodiscard]] const char *ToString(SimdLevel level);
+
+    /**
+     * @brief Gets a human-readable name for a sample format
+     * @param format Sample format
+     * @return Static string ("float32", "int16", "int24", "int32")
+     */
+    [[nodiscard]] const char *ToString(SampleFormat format);
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,161 @@
+/**
+ * Memory Arena
+ * One aligned, pre-faulted and locked block the real-time buffers are carved from
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "MemoryArena.h"
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        /// Size of an explicit (hugetlbfs) huge page; mappings must be a multiple of it
+        constexpr size_t kHugePageBytes = 2 * 1024 * 1024;
+
+        /// Rounds a size up to a multiple of a power-of-two granule
+        constexpr size_t RoundUp(size_t bytes, size_t granule)
+        {
+            return (bytes + granule - 1) & ~(granule - 1);
+        }
+    } // namespace
+
+    MemoryArena::~MemoryArena()
+    {
+        Release();
+    }
+
+    bool MemoryArena::Reserve(size_t bytes, const MemoryArenaConfig &config)
+    {
+        Release();
+        stats = MemoryArenaStats{};
+        if (bytes == 0)
+        {
+            return true;
+        }
+
+#if defined(__linux__)
+        const long pageSize = sysconf(_SC_PAGESIZE);
+        size_t mappedBytes = RoundUp(bytes, pageSize > 0 ? static_cast<size_t>(pageSize) : 4096);
+        void *block = MAP_FAILED;
+
+        if (config.hugePages)
+        {
+            // Explicit huge pages need a reserved hugetlbfs pool; transparent ones are only advice
+            const size_t hugeBytes = RoundUp(bytes, kHugePageBytes);
+            block = mmap(nullptr, hugeBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (block != MAP_FAILED)
+            {
+                mappedBytes = hugeBytes;
+                stats.hugePages = SchedulingOutcome::Granted;
+            }
+            else
+            {
+                stats.error = errno;
+            }
+        }
+
+        if (block == MAP_FAILED)
+        {
+            block = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (block == MAP_FAILED)
+            {
+                stats.error = errno;
+                return false;
+            }
+            if (config.hugePages)
+            {
+#if defined(MADV_HUGEPAGE)
+                if (madvise(block, mappedBytes, MADV_HUGEPAGE) == 0)
+                {
+                    stats.hugePages = SchedulingOutcome::FellBack;
+                }
+                else
+                {
+                    stats.hugePages = SchedulingOutcome::Denied;
+                    stats.error = errno;
+                }
+#else
+                stats.hugePages = SchedulingOutcome::Unsupported;
+#endif
+            }
+        }
+
+        base = static_cast<std::byte *>(block);
+        mapped = true;
+        stats.reservedBytes = mappedBytes;
+#else
+        base = static_cast<std::byte *>(::operator new(bytes, std::align_val_t{ kAlignment }, std::nothrow));
+        if (base == nullptr)
+        {
+            stats.error = ENOMEM;
+            return false;
+        }
+        stats.reservedBytes = bytes;
+        if (config.hugePages)
+        {
+            stats.hugePages = SchedulingOutcome::Unsupported;
+        }
+#endif
+        capacity = bytes;
+
+        // Touch every page now so the first real-time access does not fault it in
+        std::memset(base, 0, stats.reservedBytes);
+
+        if (config.lock)
+        {
+#if defined(__linux__)
+            if (mlock(base, stats.reservedBytes) == 0)
+            {
+                stats.locked = SchedulingOutcome::Granted;
+            }
+            else
+            {
+                stats.locked = SchedulingOutcome::Denied;
+                stats.error = errno;
+            }
+#else
+            stats.locked = SchedulingOutcome::Unsupported;
+#endif
+        }
+        return true;
+    }
+
+    void MemoryArena::Release()
+    {
+        if (base == nullptr)
+        {
+            return;
+        }
+
+#if defined(__linux__)
+        if (mapped)
+        {
+            if (stats.locked == SchedulingOutcome::Granted)
+            {
+                (void)munlock(base, stats.reservedBytes);
+            }
+            (void)munmap(base, stats.reservedBytes);
+        }
+#endif
+        if (!mapped)
+        {
+            ::operator delete(base, std::align_val_t{ kAlignment });
+        }
+
+        base = nullptr;
+        capacity = 0;
+        mapped = false;
+    }
+
+} // namespace PrecisionTuner::Audio
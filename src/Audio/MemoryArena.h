@@ -0,0 +1,120 @@
+#pragma once
+
+#include <CacheLine.h>
+#include <ThreadScheduling.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace PrecisionTuner::Audio
+{
+    /** How a MemoryArena backs its block */
+    struct MemoryArenaConfig
+    {
+        bool hugePages = false; ///< Back the block with huge pages (explicit, else transparent) where available
+        bool lock = true;       ///< mlock() the block so the audio threads never page-fault on it
+    };
+
+    /** What a MemoryArena reserved and how */
+    struct MemoryArenaStats
+    {
+        size_t reservedBytes = 0;                                      ///< Size of the block (whole pages)
+        size_t usedBytes = 0;                                          ///< Handed out so far, padding included
+        size_t allocations = 0;                                        ///< Buffers carved from the block
+        SchedulingOutcome hugePages = SchedulingOutcome::NotRequested; ///< Granted = MAP_HUGETLB, FellBack = THP
+        SchedulingOutcome locked = SchedulingOutcome::NotRequested;    ///< mlock() of the block
+        int32_t error = 0;                                             ///< errno of the last refused request
+    };
+
+    /**
+     * @brief One pre-faulted, optionally locked block of real-time memory carved into buffers
+     *
+     * The owner adds up the Footprint() of every buffer it needs, reserves that much once,
+     * and then hands out 64-byte aligned, zeroed buffers with a bump pointer. The block is
+     * mapped in one piece (optionally on huge pages), every page is touched before the first
+     * buffer is handed out, and it is mlock()ed, so buffers carved from it never page-fault
+     * and sit next to each other in cache and TLB. Nothing is freed individually: the whole
+     * block goes away with the arena.
+     *
+     * Outside Linux the block comes from aligned operator new, pre-faulted but not locked.
+     *
+     * THREAD SAFETY:
+     *  - Reserve() and Allocate() must only be called by the owner, before the buffers are shared
+     *  - Buffers handed out may then be used from any thread, under the owner's own protocol
+     */
+    class MemoryArena
+    {
+    public:
+        static constexpr size_t kAlignment = kCacheLineSize; ///< Alignment of every buffer (one cache line)
+
+        MemoryArena() = default;
+        ~MemoryArena();
+
+        MemoryArena(const MemoryArena &) = delete;
+        MemoryArena &operator=(const MemoryArena &) = delete;
+
+        /**
+         * @brief Gets the arena space a buffer takes
+         * @tparam T Element type
+         * @param count Number of elements
+         * @return Bytes, rounded up to kAlignment
+         */
+        template<typename T> [[nodiscard]] static constexpr size_t Footprint(size_t count)
+        {
+            return (count * sizeof(T) + kAlignment - 1) / kAlignment * kAlignment;
+        }
+
+        /**
+         * @brief Maps, pre-faults and locks the block (replaces any previous block)
+         * Huge pages and locking fall back silently; the outcome is reported by Stats().
+         * @param bytes Total Footprint() of the buffers to carve
+         * @param config Backing options
+         * @return false if no memory could be obtained at all
+         */
+        bool Reserve(size_t bytes, const MemoryArenaConfig &config);
+
+        /**
+         * @brief Carves a zeroed, kAlignment-aligned buffer from the block
+         * @tparam T Trivial element type
+         * @param count Number of elements
+         * @return Buffer, or an empty span if the reservation is exhausted
+         */
+        template<typename T> [[nodiscard]] std::span<T> Allocate(size_t count)
+        {
+            static_assert(std::is_trivial_v<T>, "MemoryArena hands out zeroed storage for trivial types only");
+
+            const size_t bytes = Footprint<T>(count);
+            if (count == 0 || base == nullptr || bytes > capacity - stats.usedBytes)
+            {
+                return {};
+            }
+
+            T *data = reinterpret_cast<T *>(base + stats.usedBytes);
+            std::uninitialized_value_construct_n(data, count);
+            stats.usedBytes += bytes;
+            ++stats.allocations;
+            return std::span<T>(data, count);
+        }
+
+        /**
+         * @brief Gets the size and backing of the block
+         * @return Statistics
+         */
+        [[nodiscard]] const MemoryArenaStats &Stats() const
+        {
+            return stats;
+        }
+
+    private:
+        /** Unlocks and unmaps (or deletes) the block */
+        void Release();
+
+        std::byte *base = nullptr; ///< Start of the block
+        size_t capacity = 0;       ///< Usable bytes (the requested reservation)
+        bool mapped = false;       ///< Block came from mmap() rather than operator new
+        MemoryArenaStats stats;    ///< Reservation, use and backing
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,120 @@
+/**
+ * Onset Detection
+ * Pluck onsets and time-to-lock measurement for the analysis threads
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "OnsetDetection.h"
+#include "SignalGate.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PrecisionTuner::Audio
+{
+    OnsetDetector::OnsetDetector(const OnsetDetectorConfig &config, float hopSeconds)
+    {
+        Configure(config, hopSeconds);
+    }
+
+    void OnsetDetector::Configure(const OnsetDetectorConfig &config, float hopSeconds)
+    {
+        this->config = config;
+        minIntervalHops =
+            hopSeconds > 0.0f ? static_cast<uint32_t>(std::ceil(config.minIntervalSeconds / hopSeconds)) : 0;
+        previousLevelsDb.fill(SignalGate::kSilenceDb);
+        hopsSinceOnset = minIntervalHops;
+    }
+
+    std::optional<size_t> OnsetDetector::Process(std::span<const float> hop, float levelDb, bool gateOpen)
+    {
+        const float referenceDb = std::min(previousLevelsDb[0], previousLevelsDb[1]);
+        previousLevelsDb[1] = previousLevelsDb[0];
+        previousLevelsDb[0] = levelDb;
+        if (hopsSinceOnset < minIntervalHops)
+        {
+            ++hopsSinceOnset;
+        }
+
+        const float thresholdDb = referenceDb + config.riseDb;
+        if (!gateOpen || levelDb < thresholdDb || hopsSinceOnset < minIntervalHops)
+        {
+            return std::nullopt;
+        }
+        hopsSinceOnset = 0;
+
+        // The attack starts in the first block that already clears the threshold on its own
+        for (size_t offset = 0; offset + kBlockSize <= hop.size(); offset += kBlockSize)
+        {
+            if (SignalGate::MeasureLevelDb(hop.subspan(offset, kBlockSize)) >= thresholdDb)
+            {
+                return offset;
+            }
+        }
+        return 0;
+    }
+
+    LockTimer::LockTimer(const LockTimerConfig &config, uint32_t sampleRate)
+    {
+        Configure(config, sampleRate);
+    }
+
+    void LockTimer::Configure(const LockTimerConfig &config, uint32_t sampleRate)
+    {
+        this->config = config;
+        this->config.frames = std::clamp<uint32_t>(config.frames, 1, kMaxFrames);
+        timeoutSamples = static_cast<uint64_t>(std::max(config.timeoutSeconds, 0.0f) * static_cast<float>(sampleRate));
+        recentCount = 0;
+        running = false;
+    }
+
+    void LockTimer::Start(uint64_t onsetSampleTime)
+    {
+        this->onsetSampleTime = onsetSampleTime;
+        recentCount = 0;
+        running = true;
+    }
+
+    std::optional<uint64_t> LockTimer::Update(bool detected, float frequency, uint64_t sampleTime)
+    {
+        if (!running || sampleTime <= onsetSampleTime)
+        {
+            return std::nullopt; // Frames whose window ends before the onset belong to the previous note
+        }
+        const uint64_t elapsed = sampleTime - onsetSampleTime;
+        if (elapsed > timeoutSamples)
+        {
+            running = false;
+            return std::nullopt;
+        }
+        if (!detected || frequency <= 0.0f)
+        {
+            recentCount = 0;
+            return std::nullopt;
+        }
+
+        // Keep the newest config.frames frequencies of the current run, newest last
+        if (recentCount == config.frames)
+        {
+            std::copy(recent.begin() + 1, recent.begin() + recentCount, recent.begin());
+            --recentCount;
+        }
+        recent[recentCount++] = frequency;
+        if (recentCount < config.frames)
+        {
+            return std::nullopt;
+        }
+
+        const bool agree = std::all_of(recent.begin(), recent.begin() + recentCount, [&](float previous) {
+            return std::abs(1200.0f * std::log2(previous / frequency)) <= config.toleranceCents;
+        });
+        if (!agree)
+        {
+            return std::nullopt;
+        }
+        running = false;
+        return elapsed;
+    }
+
+} // namespace PrecisionTuner::Audio
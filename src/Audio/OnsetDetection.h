@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace PrecisionTuner::Audio
+{
+    /** Pluck onset detection and attack handling (levels in dBFS RMS) */
+    struct OnsetDetectorConfig
+    {
+        bool reseedOnOnset = true;        ///< Reset the stabilizer and skip the attack at onsets (false = measure only)
+        float riseDb = 9.0f;              ///< Hop level jump over the quieter of the two previous hops
+        float minIntervalSeconds = 0.08f; ///< Onsets closer together than this are ignored
+        float attackSeconds = 0.015f;     ///< Transient left out of the first detection after an onset
+    };
+
+    /**
+     * @brief Energy-derivative onset detector for plucked strings
+     *
+     * Fed one hop at a time together with the hop level the signal gate measured. Flags an
+     * onset when the level jumps riseDb above the quieter of the two previous hops while the
+     * gate is open, then locates the attack within the hop on 64-sample blocks so the
+     * caller can start the next analysis window just after it. The two-hop reference catches
+     * attacks split across a hop boundary; minIntervalSeconds keeps one pluck from firing twice.
+     *
+     * Not thread-safe: owned by one analysis thread. Process() does not allocate.
+     */
+    class OnsetDetector
+    {
+    public:
+        static constexpr size_t kBlockSize = 64; ///< Resolution of the onset position within a hop
+
+        /**
+         * @brief Constructs a detector
+         * @param config Thresholds
+         * @param hopSeconds Duration of one hop in seconds
+         */
+        explicit OnsetDetector(const OnsetDetectorConfig &config = {}, float hopSeconds = 0.0f);
+
+        /**
+         * @brief Applies a new configuration and forgets the level history
+         * @param config Thresholds
+         * @param hopSeconds Duration of one hop in seconds
+         */
+        void Configure(const OnsetDetectorConfig &config, float hopSeconds);
+
+        /**
+         * @brief Checks one hop for an onset
+         * @param hop Newest samples
+         * @param levelDb RMS level of the hop (SignalGate::GetLevelDb())
+         * @param gateOpen Whether the hop passed the signal gate
+         * @return Offset of the onset within the hop, or nullopt if there is none
+         */
+        std::optional<size_t> Process(std::span<const float> hop, float levelDb, bool gateOpen);
+
+        /** @brief Gets the active configuration */
+        [[nodiscard]] const OnsetDetectorConfig &GetConfig() const
+        {
+            return config;
+        }
+
+    private:
+        OnsetDetectorConfig config;              ///< Active configuration
+        std::array<float, 2> previousLevelsDb{}; ///< Levels of the two previous hops, newest first
+        uint32_t minIntervalHops = 0;            ///< Re-trigger guard in hops
+        uint32_t hopsSinceOnset = 0;             ///< Hops since the last onset (saturating)
+    };
+
+    /** When a pitch counts as locked after an onset */
+    struct LockTimerConfig
+    {
+        float toleranceCents = 5.0f; ///< Spread allowed across the frames of a lock
+        uint32_t frames = 3;         ///< Consecutive detected frames that must agree (max LockTimer::kMaxFrames)
+        float timeoutSeconds = 2.0f; ///< Onsets that have not locked by then are given up on
+    };
+
+    /**
+     * @brief Measures time-to-lock: stream time from a pluck onset to a stable reading
+     *
+     * After Start(), every published frame is passed to Update(). The pitch is locked once
+     * the last `frames` frames were all detected and lie within toleranceCents of the
+     * newest; the time-to-lock is the stream time from the onset to the end of that frame's
+     * window, i.e. how long after the pluck the display holds a trustworthy value.
+     *
+     * Not thread-safe: owned by one analysis thread. Does not allocate.
+     */
+    class LockTimer
+    {
+    public:
+        static constexpr uint32_t kMaxFrames = 8; ///< Upper bound for LockTimerConfig::frames
+
+        /**
+         * @brief Constructs a timer
+         * @param config Lock criterion
+         * @param sampleRate Stream sample rate (converts the timeout to samples)
+         */
+        explicit LockTimer(const LockTimerConfig &config = {}, uint32_t sampleRate = 0);
+
+        /**
+         * @brief Applies a new lock criterion and cancels any running measurement
+         * @param config Lock criterion
+         * @param sampleRate Stream sample rate
+         */
+        void Configure(const LockTimerConfig &config, uint32_t sampleRate);
+
+        /**
+         * @brief Starts timing from an onset (restarts a measurement still running)
+         * @param onsetSampleTime Stream position of the onset
+         */
+        void Start(uint64_t onsetSampleTime);
+
+        /**
+         * @brief Feeds one published frame
+         * @param detected Whether the frame carries a pitch
+         * @param frequency Published frequency in Hz
+         * @param sampleTime Stream position of the end of the frame's window
+         * @return Samples from the onset to this frame if it completes the lock, otherwise nullopt
+         */
+        std::optional<uint64_t> Update(bool detected, float frequency, uint64_t sampleTime);
+
+        /** @brief Whether a measurement is running (started, not yet locked or timed out) */
+        [[nodiscard]] bool IsRunning() const
+        {
+            return running;
+        }
+
+    private:
+        LockTimerConfig config;                 ///< Active criterion
+        uint64_t timeoutSamples = 0;            ///< timeoutSeconds in samples
+        uint64_t onsetSampleTime = 0;           ///< Stream position of the running onset
+        std::array<float, kMaxFrames> recent{}; ///< Frequencies of the current run of detected frames
+        uint32_t recentCount = 0;               ///< Valid entries in recent
+        bool running = false;                   ///< Measurement in progress
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,338 @@
+/**
+ * Analysis Pre-Filter Chain
+ * Block-vectorized biquads (DC blocker, high-pass, low-pass, hum notch) with per-stage cost accounting
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "PreFilter.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+// Platform-specific includes (BEFORE namespace to avoid pollution)
+#if defined(__x86_64__) || defined(_M_X64)
+#define PRECISION_TUNER_X86_64 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+// MSVC accepts AVX2 intrinsics in any function; the caller guarantees CPU support
+#define PRECISION_TUNER_TARGET_AVX2
+#else
+#define PRECISION_TUNER_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        constexpr size_t kBlock = Biquad::kBlockSize;
+
+        /// Butterworth quality for the 2nd-order high- and low-pass
+        constexpr float kButterworthQ = std::numbers::sqrt2_v<float> / 2.0f;
+
+        /// State below this is flushed to zero so silence never decays into denormals
+        constexpr float kDenormalThreshold = 1e-20f;
+
+        /// One column of output weights per source sample (see Biquad::columns)
+        using BlockMatrix = std::array<std::array<float, kBlock>, kBlock + 4>;
+
+        /// Block kernel signature: (block matrix, sources x[-2] x[-1] y[-2] y[-1] x[0..7], outputs)
+        using BlockFn = void (*)(const BlockMatrix &, const float *, float *);
+
+        void ScalarBlock(const BlockMatrix &columns, const float *sources, float *outputs)
+        {
+            for (size_t k = 0; k < kBlock; ++k)
+            {
+                float sum = 0.0f;
+                for (size_t column = 0; column < columns.size(); ++column)
+                {
+                    sum += columns[column][k] * sources[column];
+                }
+                outputs[k] = sum;
+            }
+        }
+
+#ifdef PRECISION_TUNER_X86_64
+        void Sse2Block(const BlockMatrix &columns, const float *sources, float *outputs)
+        {
+            __m128 low = _mm_setzero_ps();
+            __m128 high = _mm_setzero_ps();
+            for (size_t column = 0; column < columns.size(); ++column)
+            {
+                const __m128 source = _mm_set1_ps(sources[column]);
+                low = _mm_add_ps(low, _mm_mul_ps(_mm_load_ps(columns[column].data()), source));
+                high = _mm_add_ps(high, _mm_mul_ps(_mm_load_ps(columns[column].data() + 4), source));
+            }
+            _mm_storeu_ps(outputs, low);
+            _mm_storeu_ps(outputs + 4, high);
+        }
+
+        PRECISION_TUNER_TARGET_AVX2 void Avx2Block(const BlockMatrix &columns, const float *sources, float *outputs)
+        {
+            // Two accumulators hide the add latency
+            __m256 even = _mm256_setzero_ps();
+            __m256 odd = _mm256_setzero_ps();
+            for (size_t column = 0; column < columns.size(); column += 2)
+            {
+                even = _mm256_add_ps(even,
+                    _mm256_mul_ps(_mm256_load_ps(columns[column].data()), _mm256_set1_ps(sources[column])));
+                odd = _mm256_add_ps(odd,
+                    _mm256_mul_ps(_mm256_load_ps(columns[column + 1].data()), _mm256_set1_ps(sources[column + 1])));
+            }
+            _mm256_storeu_ps(outputs, _mm256_add_ps(even, odd));
+        }
+#endif
+
+        BlockFn SelectBlock(SimdLevel level)
+        {
+            switch (level)
+            {
+#ifdef PRECISION_TUNER_X86_64
+            case SimdLevel::AVX2:
+                return &Avx2Block;
+            case SimdLevel::SSE2:
+                return &Sse2Block;
+#endif
+            case SimdLevel::Scalar:
+            default:
+                return &ScalarBlock;
+            }
+        }
+
+        float FlushDenormal(float value)
+        {
+            return std::abs(value) < kDenormalThreshold ? 0.0f : value;
+        }
+
+        /// Keeps a corner frequency inside (0, Nyquist) so the designs stay stable
+        double ClampFrequency(float frequency, float sampleRate)
+        {
+            return std::clamp(static_cast<double>(frequency), 1.0, 0.45 * static_cast<double>(sampleRate));
+        }
+
+        BiquadCoefficients Normalize(double b0, double b1, double b2, double a0, double a1, double a2)
+        {
+            return { .b0 = static_cast<float>(b0 / a0),
+                .b1 = static_cast<float>(b1 / a0),
+                .b2 = static_cast<float>(b2 / a0),
+                .a1 = static_cast<float>(a1 / a0),
+                .a2 = static_cast<float>(a2 / a0) };
+        }
+    } // namespace
+
+    bool PreFilterConfig::IsEnabled(PreFilterStage stage) const
+    {
+        switch (stage)
+        {
+        case PreFilterStage::DcBlocker:
+            return dcBlocker;
+        case PreFilterStage::HighPass:
+            return highPass;
+        case PreFilterStage::LowPass:
+            return lowPass;
+        case PreFilterStage::HumNotch:
+            return humNotch;
+        case PreFilterStage::Count:
+        default:
+            return false;
+        }
+    }
+
+    BiquadCoefficients BiquadCoefficients::DcBlocker(float cutoffHz, float sampleRate)
+    {
+        const double pole = std::exp(-2.0 * std::numbers::pi * ClampFrequency(cutoffHz, sampleRate) / sampleRate);
+        return { .b0 = 1.0f, .b1 = -1.0f, .b2 = 0.0f, .a1 = static_cast<float>(-pole), .a2 = 0.0f };
+    }
+
+    BiquadCoefficients BiquadCoefficients::HighPass(float cutoffHz, float q, float sampleRate)
+    {
+        const double omega = 2.0 * std::numbers::pi * ClampFrequency(cutoffHz, sampleRate) / sampleRate;
+        const double alpha = std::sin(omega) / (2.0 * q);
+        const double cosine = std::cos(omega);
+        return Normalize(
+            (1.0 + cosine) / 2.0, -(1.0 + cosine), (1.0 + cosine) / 2.0, 1.0 + alpha, -2.0 * cosine, 1.0 - alpha);
+    }
+
+    BiquadCoefficients BiquadCoefficients::LowPass(float cutoffHz, float q, float sampleRate)
+    {
+        const double omega = 2.0 * std::numbers::pi * ClampFrequency(cutoffHz, sampleRate) / sampleRate;
+        const double alpha = std::sin(omega) / (2.0 * q);
+        const double cosine = std::cos(omega);
+        return Normalize(
+            (1.0 - cosine) / 2.0, 1.0 - cosine, (1.0 - cosine) / 2.0, 1.0 + alpha, -2.0 * cosine, 1.0 - alpha);
+    }
+
+    BiquadCoefficients BiquadCoefficients::Notch(float centreHz, float q, float sampleRate)
+    {
+        const double omega = 2.0 * std::numbers::pi * ClampFrequency(centreHz, sampleRate) / sampleRate;
+        const double alpha = std::sin(omega) / (2.0 * q);
+        const double cosine = std::cos(omega);
+        return Normalize(1.0, -2.0 * cosine, 1.0, 1.0 + alpha, -2.0 * cosine, 1.0 - alpha);
+    }
+
+    Biquad::Biquad()
+    {
+        SetCoefficients({});
+    }
+
+    void Biquad::SetCoefficients(const BiquadCoefficients &coefficients)
+    {
+        this->coefficients = coefficients;
+
+        // Run the recursion once per source sample with that sample set to one and everything else to zero
+        for (size_t column = 0; column < kColumns; ++column)
+        {
+            std::array<double, kBlock + 2> x{}; // x[-2], x[-1], x[0] ..
+            std::array<double, kBlock + 2> y{}; // y[-2], y[-1], y[0] ..
+            switch (column)
+            {
+            case 0:
+                x[0] = 1.0;
+                break;
+            case 1:
+                x[1] = 1.0;
+                break;
+            case 2:
+                y[0] = 1.0;
+                break;
+            case 3:
+                y[1] = 1.0;
+                break;
+            default:
+                x[column - 2] = 1.0;
+                break;
+            }
+
+            for (size_t k = 2; k < kBlock + 2; ++k)
+            {
+                y[k] = coefficients.b0 * x[k] + coefficients.b1 * x[k - 1] + coefficients.b2 * x[k - 2]
+                       - coefficients.a1 * y[k - 1] - coefficients.a2 * y[k - 2];
+                columns[column][k - 2] = static_cast<float>(y[k]);
+            }
+        }
+    }
+
+    void Biquad::Reset()
+    {
+        x1 = x2 = y1 = y2 = 0.0f;
+    }
+
+    void Biquad::Process(std::span<float> block)
+    {
+        // Looked up per call: the active level lives in another translation unit's static initialisation
+        ProcessWith(GetActiveSimdLevel(), block);
+    }
+
+    void Biquad::ProcessWith(SimdLevel level, std::span<float> block)
+    {
+        if (level == SimdLevel::Scalar || !IsSimdLevelSupported(level))
+        {
+            ProcessScalar(block);
+            return;
+        }
+
+        const BlockFn kernel = SelectBlock(level);
+        size_t offset = 0;
+        for (; offset + kBlock <= block.size(); offset += kBlock)
+        {
+            float *samples = block.data() + offset;
+            alignas(32) std::array<float, kColumns> sources{ x2, x1, y2, y1 };
+            std::copy_n(samples, kBlock, sources.begin() + 4);
+            kernel(columns, sources.data(), samples);
+
+            x2 = sources[kColumns - 2];
+            x1 = sources[kColumns - 1];
+            y2 = samples[kBlock - 2];
+            y1 = samples[kBlock - 1];
+        }
+
+        // Scalar tail (fewer than kBlockSize samples)
+        ProcessScalar(block.subspan(offset));
+    }
+
+    void Biquad::ProcessScalar(std::span<float> block)
+    {
+        for (float &sample : block)
+        {
+            const float input = sample;
+            const float output = coefficients.b0 * input + coefficients.b1 * x1 + coefficients.b2 * x2
+                                 - coefficients.a1 * y1 - coefficients.a2 * y2;
+            x2 = x1;
+            x1 = input;
+            y2 = y1;
+            y1 = output;
+            sample = output;
+        }
+        x1 = FlushDenormal(x1);
+        x2 = FlushDenormal(x2);
+        y1 = FlushDenormal(y1);
+        y2 = FlushDenormal(y2);
+    }
+
+    void PreFilterChain::Configure(const PreFilterConfig &config, uint32_t sampleRate)
+    {
+        this->config = config;
+        const auto rate = static_cast<float>(sampleRate);
+        const std::array<BiquadCoefficients, kStageCount> designs = {
+            BiquadCoefficients::DcBlocker(config.dcCutoffHz, rate),
+            BiquadCoefficients::HighPass(config.highPassHz, kButterworthQ, rate),
+            BiquadCoefficients::LowPass(config.lowPassHz, kButterworthQ, rate),
+            BiquadCoefficients::Notch(config.humFrequencyHz, std::max(config.humQ, 0.1f), rate),
+        };
+
+        for (size_t stage = 0; stage < kStageCount; ++stage)
+        {
+            const bool wasEnabled = enabled[stage];
+            enabled[stage] = config.IsEnabled(static_cast<PreFilterStage>(stage));
+            if (!(designs[stage] == stages[stage].GetCoefficients()))
+            {
+                // A moved corner keeps the state, so the signal does not jump
+                stages[stage].SetCoefficients(designs[stage]);
+            }
+            if (enabled[stage] && !wasEnabled)
+            {
+                stages[stage].Reset();
+            }
+            lastNanoseconds[stage] = 0;
+        }
+    }
+
+    void PreFilterChain::Process(std::span<float> block)
+    {
+        for (size_t stage = 0; stage < kStageCount; ++stage)
+        {
+            if (!enabled[stage])
+            {
+                lastNanoseconds[stage] = 0;
+                continue;
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            stages[stage].Process(block);
+            lastNanoseconds[stage] = static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    const char *ToString(PreFilterStage stage)
+    {
+        switch (stage)
+        {
+        case PreFilterStage::DcBlocker:
+            return "DC blocker";
+        case PreFilterStage::HighPass:
+            return "High-pass";
+        case PreFilterStage::LowPass:
+            return "Low-pass";
+        case PreFilterStage::HumNotch:
+            return "Hum notch";
+        case PreFilterStage::Count:
+        default:
+            return "Unknown";
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
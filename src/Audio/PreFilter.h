@@ -0,0 +1,187 @@
+#pragma once
+
+#include <InputConditioning.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace PrecisionTuner::Audio
+{
+    /** Stages of the pre-filter chain, in processing order */
+    enum class PreFilterStage : uint32_t
+    {
+        DcBlocker, ///< One-pole DC blocker (interface offset)
+        HighPass,  ///< 2nd-order Butterworth high-pass (rumble, handling noise)
+        LowPass,   ///< 2nd-order Butterworth low-pass (hiss above the useful harmonics)
+        HumNotch,  ///< Notch at the mains frequency
+        Count
+    };
+
+    /** Filters applied to every analysis hop before the signal gate and the detector */
+    struct PreFilterConfig
+    {
+        bool dcBlocker = true;        ///< Remove DC offset
+        float dcCutoffHz = 5.0f;      ///< DC blocker corner frequency
+        bool highPass = true;         ///< Remove rumble below the lowest string
+        float highPassHz = 40.0f;     ///< High-pass corner frequency
+        bool lowPass = true;          ///< Remove hiss well above the pitch range
+        float lowPassHz = 5000.0f;    ///< Low-pass corner frequency
+        bool humNotch = true;         ///< Remove mains hum
+        float humFrequencyHz = 50.0f; ///< Mains frequency (50 or 60 Hz)
+        float humQ = 8.0f;            ///< Notch quality (higher = narrower)
+
+        /**
+         * @brief Checks whether a stage is switched on
+         * @param stage Stage to query
+         * @return true if the stage filters the signal
+         */
+        [[nodiscard]] bool IsEnabled(PreFilterStage stage) const;
+    };
+
+    /** Normalized biquad coefficients (a0 = 1) */
+    struct BiquadCoefficients
+    {
+        float b0 = 1.0f; ///< Feed-forward, current input
+        float b1 = 0.0f; ///< Feed-forward, previous input
+        float b2 = 0.0f; ///< Feed-forward, input before that
+        float a1 = 0.0f; ///< Feedback, previous output
+        float a2 = 0.0f; ///< Feedback, output before that
+
+        /** @brief One-pole DC blocker y = x - x[-1] + R y[-1] with its corner at cutoffHz */
+        static BiquadCoefficients DcBlocker(float cutoffHz, float sampleRate);
+
+        /** @brief RBJ cookbook high-pass */
+        static BiquadCoefficients HighPass(float cutoffHz, float q, float sampleRate);
+
+        /** @brief RBJ cookbook low-pass */
+        static BiquadCoefficients LowPass(float cutoffHz, float q, float sampleRate);
+
+        /** @brief RBJ cookbook notch */
+        static BiquadCoefficients Notch(float centreHz, float q, float sampleRate);
+
+        bool operator==(const BiquadCoefficients &) const = default;
+    };
+
+    /**
+     * @brief Biquad filter processed kBlockSize samples at a time with SIMD
+     *
+     * A recursive filter cannot be vectorized sample by sample, but each output of a block
+     * is a fixed linear combination of the block's inputs and the four samples of filter
+     * state in front of it. SetCoefficients() precomputes those combinations (one column
+     * per input or state sample), so a block costs kBlockSize + 4 vector multiply-adds
+     * instead of 5 * kBlockSize scalar ones. Blocks run on the widest instruction set the
+     * CPU supports (same runtime dispatch as ConditionBlock()); a trailing partial block
+     * and the Scalar level run the direct-form I recursion.
+     *
+     * Not thread-safe: owned by one analysis thread. Nothing allocates.
+     */
+    class Biquad
+    {
+    public:
+        static constexpr size_t kBlockSize = 8; ///< Outputs computed together
+
+        /** @brief Constructs a pass-through filter */
+        Biquad();
+
+        /**
+         * @brief Sets new coefficients and precomputes the block matrix (keeps the state)
+         * @param coefficients Normalized coefficients
+         */
+        void SetCoefficients(const BiquadCoefficients &coefficients);
+
+        /** @brief Clears the filter state */
+        void Reset();
+
+        /**
+         * @brief Filters a block in place
+         * @param block Samples to filter
+         */
+        void Process(std::span<float> block);
+
+        /**
+         * @brief Same as Process() but forces a specific instruction set
+         * Falls back to Scalar if the requested level is not supported. Intended for tests and benchmarks.
+         */
+        void ProcessWith(SimdLevel level, std::span<float> block);
+
+        /** @brief Gets the active coefficients */
+        [[nodiscard]] const BiquadCoefficients &GetCoefficients() const
+        {
+            return coefficients;
+        }
+
+    private:
+        /// Block matrix columns: x[-2], x[-1], y[-2], y[-1], then x[0] .. x[kBlockSize - 1]
+        static constexpr size_t kColumns = kBlockSize + 4;
+
+        void ProcessScalar(std::span<float> block);
+
+        /// Block matrix: the weight of each source sample in each of the block's outputs
+        alignas(32) std::array<std::array<float, kBlockSize>, kColumns> columns{};
+        BiquadCoefficients coefficients; ///< Active coefficients
+        float x1 = 0.0f;                 ///< Previous input
+        float x2 = 0.0f;                 ///< Input before that
+        float y1 = 0.0f;                 ///< Previous output
+        float y2 = 0.0f;                 ///< Output before that
+    };
+
+    /**
+     * @brief Cascade of the configured pre-filter stages with per-stage cost accounting
+     *
+     * Stages run in PreFilterStage order over the whole block, one pass each, so the time
+     * spent in every stage can be measured per block. Configure() may be called between
+     * blocks to switch stages or move frequencies: it only recomputes coefficients and
+     * clears the state of stages that were switched on, and never allocates.
+     *
+     * Not thread-safe: owned by one analysis thread.
+     */
+    class PreFilterChain
+    {
+    public:
+        static constexpr size_t kStageCount = static_cast<size_t>(PreFilterStage::Count);
+
+        /**
+         * @brief Applies a configuration
+         * @param config Stages and frequencies (frequencies are clamped below Nyquist)
+         * @param sampleRate Stream sample rate in Hz
+         */
+        void Configure(const PreFilterConfig &config, uint32_t sampleRate);
+
+        /**
+         * @brief Filters a block in place through every enabled stage
+         * @param block Samples to filter
+         */
+        void Process(std::span<float> block);
+
+        /** @brief Gets the active configuration */
+        [[nodiscard]] const PreFilterConfig &GetConfig() const
+        {
+            return config;
+        }
+
+        /**
+         * @brief Gets what a stage cost on the last block
+         * @param stage Stage to query
+         * @return Nanoseconds spent in the stage by the last Process() (0 if disabled)
+         */
+        [[nodiscard]] uint64_t GetLastStageNanoseconds(PreFilterStage stage) const
+        {
+            return lastNanoseconds[static_cast<size_t>(stage)];
+        }
+
+    private:
+        PreFilterConfig config;                              ///< Active configuration
+        std::array<Biquad, kStageCount> stages;              ///< One filter per stage
+        std::array<bool, kStageCount> enabled{};             ///< Stages in the cascade
+        std::array<uint64_t, kStageCount> lastNanoseconds{}; ///< Cost of each stage on the last block
+    };
+
+    /**
+     * @brief Gets a human-readable name for a pre-filter stage
+     * @param stage Stage
+     * @return Static string
+     */
+    [[nodiscard]] const char *ToString(PreFilterStage stage);
+
+} // namespace PrecisionTuner::Audio
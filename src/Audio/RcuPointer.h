@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Single-writer, single-reader RCU-style handoff of a heap object
+     *
+     * The writer builds a replacement on its own thread and publishes it; the reader swaps
+     * it in with one atomic exchange at a point of its choosing (e.g. between two blocks)
+     * and hands the instance it was using back to the writer, which destroys it. The reader
+     * therefore never allocates or frees, and never sees an object being built or destroyed.
+     *
+     * Handoff uses two single-pointer mailboxes:
+     *  - pending: published by the writer, taken by the reader. Publishing again before the
+     *    reader took the previous value destroys that value (the reader never saw it).
+     *  - retired: filled by the reader, emptied by Reclaim(). The reader only takes a pending
+     *    value once retired is empty, so an unreclaimed instance delays the next swap instead
+     *    of being freed on the reader thread.
+     *
+     * THREAD SAFETY:
+     *  - Publish() and Reclaim() must only be called from one thread (the writer)
+     *  - Acquire() and Current() must only be called from one thread (the reader)
+     *  - The destructor must run after the reader stopped; it destroys every instance held
+     *
+     * @tparam T Object type
+     */
+    template<typename T> class RcuPointer
+    {
+    public:
+        /**
+         * @brief Constructs the handoff with the instance the reader starts with
+         * @param initial Instance returned by Current() until the first swap (may be null)
+         */
+        explicit RcuPointer(std::unique_ptr<T> initial = nullptr)
+            : current(initial.release()), pending(nullptr), retired(nullptr)
+        {
+        }
+
+        ~RcuPointer()
+        {
+            delete current;
+            delete pending.load(std::memory_order_acquire);
+            delete retired.load(std::memory_order_acquire);
+        }
+
+        RcuPointer(const RcuPointer &) = delete;
+        RcuPointer &operator=(const RcuPointer &) = delete;
+
+        /**
+         * @brief Offers a replacement to the reader (writer side)
+         * A replacement published earlier and not yet taken is destroyed here.
+         * @param next Fully built replacement
+         */
+        void Publish(std::unique_ptr<T> next)
+        {
+            std::unique_ptr<T> stale(pending.exchange(next.release(), std::memory_order_acq_rel));
+        }
+
+        /**
+         * @brief Takes back the instance the reader swapped out (writer side)
+         * @return Retired instance to destroy, or null if the reader has not swapped since the last call
+         */
+        [[nodiscard]] std::unique_ptr<T> Reclaim()
+        {
+            return std::unique_ptr<T>(retired.exchange(nullptr, std::memory_order_acquire));
+        }
+
+        /**
+         * @brief Checks whether a published replacement is still waiting for the reader
+         * @return true until the reader has taken the last published value
+         */
+        [[nodiscard]] bool HasPending() const
+        {
+            return pending.load(std::memory_order_acquire) != nullptr;
+        }
+
+        /**
+         * @brief Swaps in a published replacement if there is one (reader side)
+         * Wait-free; never allocates or frees.
+         * @return Instance to use from now on
+         */
+        T *Acquire()
+        {
+            if (pending.load(std::memory_order_relaxed) == nullptr
+                || retired.load(std::memory_order_acquire) != nullptr)
+            {
+                return current;
+            }
+
+            T *next = pending.exchange(nullptr, std::memory_order_acq_rel);
+            if (next != nullptr)
+            {
+                retired.store(current, std::memory_order_release);
+                current = next;
+            }
+            return current;
+        }
+
+        /**
+         * @brief Gets the instance in use without checking for a replacement (reader side)
+         * @return Instance returned by the last Acquire()
+         */
+        [[nodiscard]] T *Current() const
+        {
+            return current;
+        }
+
+    private:
+        T *current;               ///< Instance in use (reader only)
+        std::atomic<T *> pending; ///< Published by the writer, not yet taken
+        std::atomic<T *> retired; ///< Swapped out by the reader, not yet reclaimed
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,243 @@
+/**
+ * Real-Time Safety Checks
+ * Flags allocations and mutex locks made on threads tagged as real-time
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "RealtimeSafety.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer)
+#define PRECISION_TUNER_RT_SANITIZED 1
+#endif
+#endif
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define PRECISION_TUNER_RT_SANITIZED 1
+#endif
+
+// The sanitizers interpose malloc and pthread themselves; defining them again would break their bookkeeping
+#if defined(PRECISION_TUNER_RT_CHECKS) && defined(__GLIBC__) && !defined(PRECISION_TUNER_RT_SANITIZED)
+#define PRECISION_TUNER_RT_INTERPOSE 1
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        std::atomic<uint64_t> violationCount{ 0 }; ///< Every violation, recorded or not
+
+#if defined(PRECISION_TUNER_RT_CHECKS)
+        thread_local const char *tRealtimeThread = nullptr; ///< Name of the innermost open RealtimeScope
+#endif
+
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+        thread_local bool tReporting = false; ///< Guards against the capture itself being reported
+
+        std::array<RealtimeViolation, kMaxRecordedRealtimeViolations> records; ///< Written once per slot
+        std::array<std::atomic<bool>, kMaxRecordedRealtimeViolations> recordReady{}; ///< Slot fully written
+        std::atomic<size_t> nextRecord{ 0 };                                         ///< Next slot to claim
+        size_t drainedRecords = 0; ///< Slots already handed out (draining thread only)
+
+        /// backtrace() loads its unwinder (and allocates) on first use; do that before any audio thread runs
+        [[maybe_unused]] const bool backtraceReady = [] {
+            std::array<void *, 1> frame{};
+            return backtrace(frame.data(), static_cast<int>(frame.size())) >= 0;
+        }();
+
+        /// Counts a violation if the calling thread is inside a RealtimeScope (real-time safe)
+        void ReportViolation(RealtimeViolationKind kind)
+        {
+            const char *thread = tRealtimeThread;
+            if (thread == nullptr || tReporting)
+            {
+                return;
+            }
+            tReporting = true;
+
+            violationCount.fetch_add(1, std::memory_order_relaxed);
+            const size_t slot = nextRecord.fetch_add(1, std::memory_order_relaxed);
+            if (slot < records.size())
+            {
+                RealtimeViolation &record = records[slot];
+                record.kind = kind;
+                record.thread = thread;
+                const int depth = backtrace(record.frames.data(), static_cast<int>(record.frames.size()));
+                record.depth = depth > 0 ? static_cast<size_t>(depth) : 0;
+                recordReady[slot].store(true, std::memory_order_release);
+            }
+
+            tReporting = false;
+        }
+
+        using MutexLockFn = int (*)(pthread_mutex_t *);
+
+        /// Next pthread_mutex_lock in the lookup order (libc); resolved without a static guard, which itself locks
+        MutexLockFn RealMutexLock()
+        {
+            static std::atomic<MutexLockFn> real{ nullptr };
+            MutexLockFn function = real.load(std::memory_order_acquire);
+            if (function == nullptr)
+            {
+                function = reinterpret_cast<MutexLockFn>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+                real.store(function, std::memory_order_release);
+            }
+            return function;
+        }
+#endif
+    } // namespace
+
+#if defined(PRECISION_TUNER_RT_CHECKS)
+    RealtimeScope::RealtimeScope(const char *threadName) : previous(tRealtimeThread)
+    {
+        tRealtimeThread = threadName;
+    }
+
+    RealtimeScope::~RealtimeScope()
+    {
+        tRealtimeThread = previous;
+    }
+#endif
+
+    bool IsRealtimeCheckingActive()
+    {
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    uint64_t GetRealtimeViolationCount()
+    {
+        return violationCount.load(std::memory_order_relaxed);
+    }
+
+    size_t DrainRealtimeViolations([[maybe_unused]] const std::function<void(const RealtimeViolation &)> &handler)
+    {
+        size_t drained = 0;
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+        // Slots are filled in claim order but may complete out of order; stop at the first unfinished one
+        while (drainedRecords < records.size() && recordReady[drainedRecords].load(std::memory_order_acquire))
+        {
+            handler(records[drainedRecords]);
+            ++drainedRecords;
+            ++drained;
+        }
+#endif
+        return drained;
+    }
+
+    std::vector<std::string> SymbolizeRealtimeViolation([[maybe_unused]] const RealtimeViolation &violation)
+    {
+        std::vector<std::string> lines;
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+        char **symbols = backtrace_symbols(violation.frames.data(), static_cast<int>(violation.depth));
+        if (symbols != nullptr)
+        {
+            lines.assign(symbols, symbols + violation.depth);
+            std::free(symbols);
+        }
+#endif
+        return lines;
+    }
+
+    void ResetRealtimeViolations()
+    {
+        violationCount.store(0, std::memory_order_relaxed);
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+        for (auto &ready : recordReady)
+        {
+            ready.store(false, std::memory_order_relaxed);
+        }
+        nextRecord.store(0, std::memory_order_relaxed);
+        drainedRecords = 0;
+#endif
+    }
+
+} // namespace PrecisionTuner::Audio
+
+#if defined(PRECISION_TUNER_RT_INTERPOSE)
+/*
+ * glibc interposers: definitions in the executable take precedence over libc for every caller,
+ * including libstdc++ (operator new/delete, std::mutex) and spdlog. Each one reports and then
+ * forwards to the glibc implementation.
+ */
+extern "C"
+{
+    void *__libc_malloc(size_t size);
+    void *__libc_calloc(size_t count, size_t size);
+    void *__libc_realloc(void *pointer, size_t size);
+    void *__libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void *pointer);
+
+    void *malloc(size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        return __libc_malloc(size);
+    }
+
+    void *calloc(size_t count, size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        return __libc_calloc(count, size);
+    }
+
+    void *realloc(void *pointer, size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        return __libc_realloc(pointer, size);
+    }
+
+    void *memalign(size_t alignment, size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        return __libc_memalign(alignment, size);
+    }
+
+    void *aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void **result, size_t alignment, size_t size) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+        if (alignment % sizeof(void *) != 0 || (alignment & (alignment - 1)) != 0)
+        {
+            return EINVAL;
+        }
+        void *pointer = __libc_memalign(alignment, size);
+        if (pointer == nullptr)
+        {
+            return ENOMEM;
+        }
+        *result = pointer;
+        return 0;
+    }
+
+    void free(void *pointer) noexcept
+    {
+        if (pointer != nullptr)
+        {
+            PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::Deallocation);
+        }
+        __libc_free(pointer);
+    }
+
+    int pthread_mutex_lock(pthread_mutex_t *mutex) noexcept
+    {
+        PrecisionTuner::Audio::ReportViolation(PrecisionTuner::Audio::RealtimeViolationKind::MutexLock);
+        const auto realLock = PrecisionTuner::Audio::RealMutexLock();
+        return realLock != nullptr ? realLock(mutex) : EINVAL;
+    }
+}
+#endif
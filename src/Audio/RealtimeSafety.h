@@ -0,0 +1,123 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace PrecisionTuner::Audio
+{
+    /** Kind of call that is not allowed on a real-time audio thread */
+    enum class RealtimeViolationKind : uint8_t
+    {
+        Allocation,   ///< malloc/calloc/realloc/aligned allocation (includes operator new)
+        Deallocation, ///< free (includes operator delete)
+        MutexLock     ///< pthread_mutex_lock (includes std::mutex and logging)
+    };
+
+    /** One recorded violation, with the raw call stack captured on the offending thread */
+    struct RealtimeViolation
+    {
+        static constexpr size_t kMaxFrames = 24; ///< Stack frames captured per violation
+
+        RealtimeViolationKind kind = RealtimeViolationKind::Allocation; ///< Offending call
+        const char *thread = "";                                        ///< Scope name of the offending thread
+        size_t depth = 0;                                               ///< Valid entries in frames
+        std::array<void *, kMaxFrames> frames{};                        ///< Return addresses, innermost first
+    };
+
+    /**
+     * @brief Tags the calling thread as real-time for the lifetime of the scope
+     *
+     * Audio callbacks open one of these on entry. In builds with PRECISION_TUNER_RT_CHECKS
+     * (CMake option ENABLE_RT_SAFETY_CHECKS), allocation, deallocation and mutex locking are
+     * intercepted process-wide and counted as violations while any scope is open on the
+     * calling thread; the stack of the first kMaxRecordedRealtimeViolations is kept for
+     * DrainRealtimeViolations(). Otherwise this is an empty object.
+     *
+     * Interception needs glibc and is disabled under AddressSanitizer/ThreadSanitizer, which
+     * interpose the same functions; IsRealtimeCheckingActive() tells whether it is live.
+     */
+    class RealtimeScope
+    {
+    public:
+#if defined(PRECISION_TUNER_RT_CHECKS)
+        /**
+         * @brief Opens the scope
+         * @param threadName Static name reported with violations (e.g. "input callback")
+         */
+        explicit RealtimeScope(const char *threadName);
+
+        ~RealtimeScope();
+#else
+        explicit RealtimeScope([[maybe_unused]] const char *threadName)
+        {
+        }
+#endif
+
+        RealtimeScope(const RealtimeScope &) = delete;
+        RealtimeScope &operator=(const RealtimeScope &) = delete;
+
+#if defined(PRECISION_TUNER_RT_CHECKS)
+    private:
+        const char *previous; ///< Enclosing scope's name (scopes nest)
+#endif
+    };
+
+    /** Violations whose call stacks are kept; later ones are only counted */
+    inline constexpr size_t kMaxRecordedRealtimeViolations = 32;
+
+    /**
+     * @brief Whether allocations and locks are actually being intercepted in this build
+     * @return true if violations can be detected
+     */
+    [[nodiscard]] bool IsRealtimeCheckingActive();
+
+    /**
+     * @brief Gets the number of violations raised since startup (or the last reset)
+     * @return Violation count
+     */
+    [[nodiscard]] uint64_t GetRealtimeViolationCount();
+
+    /**
+     * @brief Hands every recorded violation not yet drained to a handler, oldest first
+     * Call from one (non-real-time) thread only.
+     * @param handler Receives each violation
+     * @return Number of violations drained
+     */
+    size_t DrainRealtimeViolations(const std::function<void(const RealtimeViolation &)> &handler);
+
+    /**
+     * @brief Resolves a violation's frames to printable symbols (allocates; never call on a real-time thread)
+     * @param violation Recorded violation
+     * @return One line per frame
+     */
+    [[nodiscard]] std::vector<std::string> SymbolizeRealtimeViolation(const RealtimeViolation &violation);
+
+    /**
+     * @brief Clears the count and the recorded violations (tests only; no scope may be open)
+     */
+    void ResetRealtimeViolations();
+
+    /**
+     * @brief Gets a short human-readable name for a violation kind
+     * @param kind Violation kind
+     * @return Static string
+     */
+    [[nodiscard]] constexpr const char *ToString(RealtimeViolationKind kind)
+    {
+        switch (kind)
+        {
+        case RealtimeViolationKind::Allocation:
+            return "allocation";
+        case RealtimeViolationKind::Deallocation:
+            return "deallocation";
+        case RealtimeViolationKind::MutexLock:
+        default:
+            return "mutex lock";
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
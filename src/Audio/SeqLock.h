@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Single-writer sequence lock publishing a small trivially copyable value
+     *
+     * The writer bumps the sequence to an odd value, stores the payload and bumps it to
+     * the next even value. Readers copy the payload and retry if the sequence changed or
+     * was odd while they copied, so a reader never observes a half-written value.
+     *
+     * The payload is stored as relaxed atomic words, which keeps the concurrent copy free
+     * of data races while still compiling down to plain loads and stores.
+     *
+     * THREAD SAFETY:
+     *  - Store() must only be called from one thread at a time; it never blocks
+     *  - Load() may be called from any number of threads; it retries while a store is in flight
+     *
+     * @tparam T Trivially copyable payload type
+     */
+    template<typename T> class SeqLock
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable payload");
+
+    public:
+        /**
+         * @brief Constructs the lock with an initial value
+         * @param initial Value returned by Load() before the first Store()
+         */
+        explicit SeqLock(const T &initial = T{}) : sequence(0), words()
+        {
+            WriteWords(initial);
+        }
+
+        /**
+         * @brief Publishes a new value (writer side)
+         * @param value Value to publish
+         */
+        void Store(const T &value)
+        {
+            const uint64_t seq = sequence.load(std::memory_order_relaxed);
+            sequence.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            WriteWords(value);
+
+            sequence.store(seq + 2, std::memory_order_release);
+        }
+
+        /**
+         * @brief Reads a consistent snapshot of the last published value (reader side)
+         * @return Copy of the value
+         */
+        [[nodiscard]] T Load() const
+        {
+            std::array<uint64_t, kWordCount> copy{};
+            uint64_t before = 0;
+            uint64_t after = 0;
+
+            do
+            {
+                before = sequence.load(std::memory_order_acquire);
+                for (size_t i = 0; i < kWordCount; ++i)
+                {
+                    copy[i] = words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                after = sequence.load(std::memory_order_relaxed);
+            } while ((before & 1) != 0 || before != after);
+
+            T value;
+            std::memcpy(static_cast<void *>(&value), copy.data(), sizeof(T));
+            return value;
+        }
+
+    private:
+        static constexpr size_t kWordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        void WriteWords(const T &value)
+        {
+            std::array<uint64_t, kWordCount> copy{};
+            std::memcpy(copy.data(), &value, sizeof(T));
+            for (size_t i = 0; i < kWordCount; ++i)
+            {
+                words[i].store(copy[i], std::memory_order_relaxed);
+            }
+        }
+
+        std::atomic<uint64_t> sequence;                       ///< Even = stable, odd = write in progress
+        std::array<std::atomic<uint64_t>, kWordCount> words; ///< Payload bytes
+    };
+
+} // namespace PrecisionTuner::Audio
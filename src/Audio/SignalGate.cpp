@@ -0,0 +1,97 @@
+/**
+ * Signal Gate
+ * Energy gate with hysteresis and an auto-calibrated noise floor for the analysis threads
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "SignalGate.h"
+#include <algorithm>
+#include <cmath>
+
+namespace PrecisionTuner::Audio
+{
+    SignalGate::SignalGate(const SignalGateConfig &config, float hopSeconds)
+    {
+        Configure(config, hopSeconds);
+    }
+
+    void SignalGate::Configure(const SignalGateConfig &config, float hopSeconds)
+    {
+        this->config = config;
+        const auto hopsIn = [hopSeconds](float seconds) {
+            return hopSeconds > 0.0f ? static_cast<uint32_t>(std::ceil(seconds / hopSeconds)) : 0u;
+        };
+        calibrationHopsLeft = std::max(hopsIn(config.calibrationSeconds), 1u);
+        holdHops = hopsIn(config.holdSeconds);
+        holdHopsLeft = 0;
+        closedRiseDb = config.floorRiseDbPerSecond * hopSeconds;
+        openRiseDb = config.openFloorRiseDbPerSecond * hopSeconds;
+        noiseFloorDb = config.maxFloorDb; // Lowered to the quietest hop during calibration
+        levelDb = kSilenceDb;
+        open = !config.enabled;
+    }
+
+    bool SignalGate::Process(std::span<const float> hop)
+    {
+        if (!config.enabled)
+        {
+            return true;
+        }
+
+        levelDb = MeasureLevelDb(hop);
+
+        // Track the floor: follow quieter hops at once, louder ones only slowly (not while calibrating)
+        if (calibrationHopsLeft > 0)
+        {
+            --calibrationHopsLeft;
+            noiseFloorDb = std::min(noiseFloorDb, levelDb);
+        }
+        else if (levelDb < noiseFloorDb)
+        {
+            noiseFloorDb = levelDb;
+        }
+        else
+        {
+            noiseFloorDb = std::min(levelDb, noiseFloorDb + (open ? openRiseDb : closedRiseDb));
+        }
+        noiseFloorDb = std::clamp(noiseFloorDb, config.minFloorDb, config.maxFloorDb);
+
+        // Hysteresis: open above floor + openMargin, close only after holding below floor + closeMargin
+        if (levelDb >= noiseFloorDb + config.openMarginDb)
+        {
+            open = true;
+            holdHopsLeft = holdHops;
+        }
+        else if (open && levelDb < noiseFloorDb + config.closeMarginDb)
+        {
+            if (holdHopsLeft == 0)
+            {
+                open = false;
+            }
+            else
+            {
+                --holdHopsLeft;
+            }
+        }
+        return open;
+    }
+
+    float SignalGate::MeasureLevelDb(std::span<const float> samples)
+    {
+        if (samples.empty())
+        {
+            return kSilenceDb;
+        }
+
+        float sumSquares = 0.0f;
+        for (const float sample : samples)
+        {
+            sumSquares += sample * sample;
+        }
+        const float meanSquare = sumSquares / static_cast<float>(samples.size());
+        return meanSquare > 0.0f ? std::max(10.0f * std::log10(meanSquare), kSilenceDb) : kSilenceDb;
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace PrecisionTuner::Audio
+{
+    /** Thresholds and noise floor tracking of a SignalGate (levels in dBFS RMS) */
+    struct SignalGateConfig
+    {
+        bool enabled = true;                   ///< false = gate always open (every window analyzed)
+        float openMarginDb = 10.0f;            ///< Opens when a hop is this far above the noise floor
+        float closeMarginDb = 5.0f;            ///< Closes when a hop falls below floor + this (hysteresis)
+        float minFloorDb = -80.0f;             ///< Lowest noise floor (digital silence must still be exceeded)
+        float maxFloorDb = -40.0f;             ///< Highest noise floor (a loud room cannot gate out played notes)
+        float calibrationSeconds = 0.5f;       ///< Initial period over which the floor is measured from scratch
+        float floorRiseDbPerSecond = 6.0f;     ///< Upward floor tracking while closed (noise getting louder)
+        float openFloorRiseDbPerSecond = 0.5f; ///< Upward floor tracking while open (recovers from a stuck gate)
+        float holdSeconds = 0.02f;             ///< Time the gate stays open after the level drops below close
+    };
+
+    /**
+     * @brief Energy gate with hysteresis and an auto-calibrated noise floor
+     *
+     * Fed one hop of samples at a time; reports whether the hop carries enough energy above
+     * the background to be worth running pitch detection on. The noise floor starts from the
+     * quietest hop seen during calibration, follows any quieter hop immediately and creeps up
+     * slowly otherwise, so it adapts to the room without a manual threshold.
+     *
+     * Not thread-safe: owned by one analysis thread. Process() does not allocate.
+     */
+    class SignalGate
+    {
+    public:
+        static constexpr float kSilenceDb = -200.0f; ///< Level reported for an all-zero block
+
+        /**
+         * @brief Constructs a gate
+         * @param config Thresholds and tracking rates
+         * @param hopSeconds Duration of one Process() call's hop (converts rates to per-hop steps)
+         */
+        explicit SignalGate(const SignalGateConfig &config = {}, float hopSeconds = 0.0f);
+
+        /**
+         * @brief Applies a new configuration and restarts calibration
+         * @param config Thresholds and tracking rates
+         * @param hopSeconds Duration of one hop in seconds
+         */
+        void Configure(const SignalGateConfig &config, float hopSeconds);
+
+        /**
+         * @brief Measures one hop and updates the gate
+         * @param hop Newest samples
+         * @return true if the gate is open (analysis should run)
+         */
+        bool Process(std::span<const float> hop);
+
+        /** @brief Whether the gate was open after the last Process() */
+        [[nodiscard]] bool IsOpen() const
+        {
+            return open;
+        }
+
+        /** @brief Whether the initial noise floor measurement is still running */
+        [[nodiscard]] bool IsCalibrating() const
+        {
+            return calibrationHopsLeft > 0;
+        }
+
+        /** @brief Current noise floor estimate (dBFS RMS) */
+        [[nodiscard]] float GetNoiseFloorDb() const
+        {
+            return noiseFloorDb;
+        }
+
+        /** @brief Level of the last hop (dBFS RMS) */
+        [[nodiscard]] float GetLevelDb() const
+        {
+            return levelDb;
+        }
+
+        /**
+         * @brief Gets the level of a block of samples
+         * @param samples Block to measure
+         * @return RMS level in dBFS (kSilenceDb for silence or an empty block)
+         */
+        [[nodiscard]] static float MeasureLevelDb(std::span<const float> samples);
+
+    private:
+        SignalGateConfig config;          ///< Active configuration
+        uint32_t calibrationHopsLeft = 0; ///< Calibration hops still to go
+        uint32_t holdHops = 0;            ///< Hops the gate stays open below the close threshold
+        uint32_t holdHopsLeft = 0;        ///< Hold hops still to go
+        float closedRiseDb = 0.0f;        ///< Floor rise per hop while closed
+        float openRiseDb = 0.0f;          ///< Floor rise per hop while open
+        float noiseFloorDb = 0.0f;        ///< Current floor estimate
+        float levelDb = kSilenceDb;       ///< Level of the last hop
+        bool open = false;                ///< Gate state
+    };
+
+} // namespace PrecisionTuner::Audio
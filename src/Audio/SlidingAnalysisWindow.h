@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Overlapping analysis window advanced in fixed hops
+     *
+     * Holds the most recent windowSize samples of the input stream. Each AdvanceHop()
+     * shifts the window left by hopSize samples and hands back the freed tail so the caller
+     * can fill it straight from the sample queue. The window length is therefore independent
+     * of whatever buffer size the audio device delivers.
+     *
+     * Storage is allocated once in Configure(); AdvanceHop() never allocates.
+     */
+    class SlidingAnalysisWindow
+    {
+    public:
+        /**
+         * @brief Constructs the window
+         * @param windowSize Window length in samples
+         * @param hopSize Samples between successive windows (clamped to [1, windowSize])
+         */
+        explicit SlidingAnalysisWindow(size_t windowSize = 0, size_t hopSize = 0)
+            : samples({}), hopSize(0), filled(0), samplesConsumed(0)
+        {
+            Configure(windowSize, hopSize);
+        }
+
+        /**
+         * @brief Reallocates the window and clears its contents
+         * @param windowSize Window length in samples
+         * @param hopSize Samples between successive windows (clamped to [1, windowSize])
+         */
+        void Configure(size_t windowSize, size_t hopSize)
+        {
+            samples.assign(windowSize, 0.0f);
+            this->hopSize = windowSize > 0 ? std::clamp<size_t>(hopSize, 1, windowSize) : 0;
+            filled = 0;
+            samplesConsumed = 0;
+        }
+
+        /**
+         * @brief Shifts the window by one hop
+         * @return Span of the last hopSize samples, which the caller must overwrite with new input
+         */
+        [[nodiscard]] std::span<float> AdvanceHop()
+        {
+            std::copy(samples.begin() + static_cast<std::ptrdiff_t>(hopSize), samples.end(), samples.begin());
+            filled = std::min(filled + hopSize, samples.size());
+            samplesConsumed += hopSize;
+            return std::span<float>(samples).last(hopSize);
+        }
+
+        /**
+         * @brief Checks whether the window holds windowSize real samples (no zero padding)
+         * @return true once at least windowSize samples have been pushed
+         */
+        [[nodiscard]] bool IsFull() const
+        {
+            return filled == samples.size() && !samples.empty();
+        }
+
+        /**
+         * @brief Gets the current window contents, oldest sample first
+         * @return Read-only view of the window
+         */
+        [[nodiscard]] std::span<const float> View() const
+        {
+            return samples;
+        }
+
+        /** @brief Gets the window length in samples */
+        [[nodiscard]] size_t WindowSize() const
+        {
+            return samples.size();
+        }
+
+        /** @brief Gets the hop size in samples */
+        [[nodiscard]] size_t HopSize() const
+        {
+            return hopSize;
+        }
+
+        /**
+         * @brief Gets the total number of samples pushed through the window
+         * @return Stream position (in samples) of the end of the current window
+         */
+        [[nodiscard]] uint64_t SamplesConsumed() const
+        {
+            return samplesConsumed;
+        }
+
+    private:
+        std::vector<float> samples; ///< Window contents, oldest first
+        size_t hopSize;             ///< Samples per advance
+        size_t filled;              ///< Real (non-padding) samples currently held
+        uint64_t samplesConsumed;   ///< Total samples pushed since Configure()
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+#include <CacheLine.h>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Lock-free single-producer / single-consumer ring buffer
+     *
+     * Capacity is rounded up to a power of two so positions wrap with a mask instead
+     * of a modulo. Read and write positions grow monotonically; the difference between
+     * them is the fill level, which makes "full" and "empty" unambiguous.
+     *
+     * THREAD SAFETY:
+     *  - Exactly one thread may call the producer methods (Write, PrepareWrite, CommitWrite, AvailableToWrite)
+     *  - Exactly one thread may call the consumer methods (Read, Discard, AvailableToRead)
+     *  - Reset() must only be called while neither side is active
+     *
+     * Storage is either owned (allocated by Reset(size_t)) or provided by the caller, e.g.
+     * carved from a MemoryArena, through Reset(std::span<T>).
+     *  - Write() and Read() never allocate and never block
+     *
+     * @tparam T Trivially copyable element type (copied with memcpy)
+     */
+    template<typename T> class SpscRingBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "SpscRingBuffer requires a trivially copyable element type");
+
+    public:
+        /**
+         * @brief Constructs the ring buffer
+         * @param minCapacity Minimum number of elements (rounded up to a power of two)
+         */
+        explicit SpscRingBuffer(size_t minCapacity = 0)
+            : owned({}), buffer({}), mask(0), writeIndex(0), readIndex(0)
+        {
+            Reset(minCapacity);
+        }
+
+        /**
+         * @brief Reallocates storage and clears positions
+         * @param minCapacity Minimum number of elements (rounded up to a power of two)
+         * @note Not thread-safe. Call only while no producer or consumer is running.
+         */
+        void Reset(size_t minCapacity)
+        {
+            owned.assign(CapacityFor(minCapacity), T{});
+            Attach(owned);
+        }
+
+        /**
+         * @brief Switches to caller-provided storage and clears positions
+         * Only the largest power-of-two prefix of storage is used; any owned storage is freed.
+         * @param storage Element storage; must outlive the ring or the next Reset()
+         * @note Not thread-safe. Call only while no producer or consumer is running.
+         */
+        void Reset(std::span<T> storage)
+        {
+            owned = {};
+            Attach(storage);
+        }
+
+        /**
+         * @brief Gets the capacity Reset() rounds a minimum capacity up to
+         * @param minCapacity Minimum number of elements
+         * @return Power-of-two capacity (or zero)
+         */
+        [[nodiscard]] static constexpr size_t CapacityFor(size_t minCapacity)
+        {
+            return minCapacity > 0 ? std::bit_ceil(minCapacity) : 0;
+        }
+
+        /**
+         * @brief Gets the element capacity
+         * @return Capacity (always a power of two, or zero)
+         */
+        [[nodiscard]] size_t Capacity() const
+        {
+            return buffer.size();
+        }
+
+        /**
+         * @brief Gets the number of elements ready to be read (consumer side)
+         * @return Readable element count
+         */
+        [[nodiscard]] size_t AvailableToRead() const
+        {
+            const size_t write = writeIndex.load(std::memory_order_acquire);
+            const size_t read = readIndex.load(std::memory_order_relaxed);
+            return write - read;
+        }
+
+        /**
+         * @brief Gets the number of free slots (producer side)
+         * @return Writable element count
+         */
+        [[nodiscard]] size_t AvailableToWrite() const
+        {
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            return buffer.size() - (write - read);
+        }
+
+        /**
+         * @brief Writes as many elements as fit (producer side)
+         * @param data Elements to append
+         * @return Number of elements actually written
+         */
+        size_t Write(std::span<const T> data)
+        {
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            const size_t count = std::min(data.size(), buffer.size() - (write - read));
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            // Copy in at most two contiguous spans (before and after the wrap point)
+            const size_t start = write & mask;
+            const size_t firstPart = std::min(count, buffer.size() - start);
+            std::memcpy(buffer.data() + start, data.data(), firstPart * sizeof(T));
+            std::memcpy(buffer.data(), data.data() + firstPart, (count - firstPart) * sizeof(T));
+
+            writeIndex.store(write + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Exposes free storage for in-place writing (producer side)
+         *
+         * Lets a producer generate data straight into the ring instead of staging it in a
+         * separate buffer first. Fill the returned spans in order, then publish with
+         * CommitWrite(). Nothing becomes visible to the consumer before the commit.
+         *
+         * @param maxCount Maximum number of elements the caller wants to write
+         * @return Up to two contiguous spans (before and after the wrap point) totalling
+         *         min(maxCount, AvailableToWrite()) elements; the second may be empty
+         */
+        [[nodiscard]] std::array<std::span<T>, 2> PrepareWrite(size_t maxCount)
+        {
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            const size_t read = readIndex.load(std::memory_order_acquire);
+            const size_t count = std::min(maxCount, buffer.size() - (write - read));
+            if (count == 0)
+            {
+                return {};
+            }
+
+            const size_t start = write & mask;
+            const size_t firstPart = std::min(count, buffer.size() - start);
+            return { std::span<T>(buffer.data() + start, firstPart), std::span<T>(buffer.data(), count - firstPart) };
+        }
+
+        /**
+         * @brief Publishes elements written into the spans from PrepareWrite() (producer side)
+         * @param count Number of elements written (must not exceed the prepared total)
+         */
+        void CommitWrite(size_t count)
+        {
+            const size_t write = writeIndex.load(std::memory_order_relaxed);
+            writeIndex.store(write + count, std::memory_order_release);
+        }
+
+        /**
+         * @brief Reads up to out.size() elements (consumer side)
+         * @param out Destination buffer
+         * @return Number of elements actually read
+         */
+        size_t Read(std::span<T> out)
+        {
+            const size_t read = readIndex.load(std::memory_order_relaxed);
+            const size_t write = writeIndex.load(std::memory_order_acquire);
+            const size_t count = std::min(out.size(), write - read);
+            if (count == 0)
+            {
+                return 0;
+            }
+
+            const size_t start = read & mask;
+            const size_t firstPart = std::min(count, buffer.size() - start);
+            std::memcpy(out.data(), buffer.data() + start, firstPart * sizeof(T));
+            std::memcpy(out.data() + firstPart, buffer.data(), (count - firstPart) * sizeof(T));
+
+            readIndex.store(read + count, std::memory_order_release);
+            return count;
+        }
+
+        /**
+         * @brief Drops up to count elements without copying them (consumer side)
+         * @param count Number of elements to skip
+         * @return Number of elements actually discarded
+         */
+        size_t Discard(size_t count)
+        {
+            const size_t read = readIndex.load(std::memory_order_relaxed);
+            const size_t write = writeIndex.load(std::memory_order_acquire);
+            const size_t skipped = std::min(count, write - read);
+            readIndex.store(read + skipped, std::memory_order_release);
+            return skipped;
+        }
+
+    private:
+        /** Uses the largest power-of-two prefix of storage and clears positions */
+        void Attach(std::span<T> storage)
+        {
+            const size_t capacity = storage.empty() ? 0 : std::bit_floor(storage.size());
+            buffer = storage.first(capacity);
+            mask = capacity > 0 ? capacity - 1 : 0;
+            writeIndex.store(0, std::memory_order_relaxed);
+            readIndex.store(0, std::memory_order_relaxed);
+        }
+
+        std::vector<T> owned; ///< Storage allocated by Reset(size_t), empty for caller-provided storage
+        std::span<T> buffer;  ///< Element storage in use (power-of-two size)
+        size_t mask;          ///< Capacity - 1, used for index wrapping
+
+        alignas(kCacheLineSize) std::atomic<size_t> writeIndex; ///< Total elements written (producer-owned)
+        alignas(kCacheLineSize) std::atomic<size_t> readIndex;  ///< Total elements read (consumer-owned)
+    };
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Hands ownership of real-time state from a running stream to its successor at a buffer boundary
+     *
+     * Two streams of the same direction (the one being replaced and the one replacing it) can
+     * run at the same time while a device switch is in flight, but state such as the producer
+     * side of an SPSC queue must only ever be touched by one of them. Each stream is assigned a
+     * slot; only the callbacks of the active slot may touch the shared state.
+     *
+     * Once the successor is running, Offer() announces it. The active stream picks this up at
+     * the start of its next callback (Successor()), processes that buffer (typically fading out)
+     * and calls HandOff() at the end, so ownership moves between two complete buffers and the
+     * old callback never touches the shared state again. If the old stream stalls, the switching
+     * thread stops it (no callback in flight any more) and calls Complete() to force the swap.
+     *
+     * THREAD SAFETY:
+     *  - Offer() and Complete() are called by the switching thread, one switch at a time
+     *  - Successor() and HandOff() are called by the callback of the active slot
+     *  - IsActive() and Active() may be called from any thread
+     */
+    class StreamHandoff
+    {
+    public:
+        static constexpr uint32_t kNoSlot = UINT32_MAX; ///< No successor waiting
+
+        /**
+         * @brief Constructs the handoff with one active slot
+         * @param initialSlot Slot that owns the shared state initially
+         */
+        explicit StreamHandoff(uint32_t initialSlot = 0) : active(initialSlot), pending(kNoSlot)
+        {
+        }
+
+        /**
+         * @brief Gets the slot that currently owns the shared state
+         * @return Active slot
+         */
+        [[nodiscard]] uint32_t Active() const
+        {
+            return active.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Checks whether a slot owns the shared state (callback entry check)
+         * @param slot Slot of the calling stream
+         * @return true if the caller may touch the shared state
+         */
+        [[nodiscard]] bool IsActive(uint32_t slot) const
+        {
+            return active.load(std::memory_order_acquire) == slot;
+        }
+
+        /**
+         * @brief Announces a started successor (switching thread)
+         * @param slot Slot of the successor stream
+         */
+        void Offer(uint32_t slot)
+        {
+            pending.store(slot, std::memory_order_release);
+        }
+
+        /**
+         * @brief Gets the successor the active stream should hand off to after this buffer
+         * @param slot Slot of the calling (active) stream
+         * @return Successor slot, or kNoSlot if no handoff is due
+         */
+        [[nodiscard]] uint32_t Successor(uint32_t slot) const
+        {
+            const uint32_t next = pending.load(std::memory_order_acquire);
+            return next == slot ? kNoSlot : next;
+        }
+
+        /**
+         * @brief Transfers ownership at the end of the active stream's buffer
+         * @param successor Value returned by Successor() at the start of the same callback
+         */
+        void HandOff(uint32_t successor)
+        {
+            if (successor != kNoSlot)
+            {
+                active.store(successor, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Makes a slot active and clears the offer (switching thread)
+         * The previous stream must have handed off or been stopped before this is called.
+         * @param slot Slot to make active
+         */
+        void Complete(uint32_t slot)
+        {
+            active.store(slot, std::memory_order_release);
+            pending.store(kNoSlot, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<uint32_t> active;  ///< Slot whose callbacks own the shared state
+        std::atomic<uint32_t> pending; ///< Started successor waiting for the handoff
+    };
+
+    /**
+     * @brief Multiplies interleaved frames by a linear gain ramp
+     * Used for the short fade-out/fade-in around a stream handoff, so swapping devices
+     * does not produce a click.
+     * @param samples Interleaved samples (whole frames)
+     * @param channels Samples per frame
+     * @param startGain Gain applied to the first frame
+     * @param endGain Gain the ramp reaches after the last frame
+     */
+    inline void ApplyGainRamp(std::span<float> samples, size_t channels, float startGain, float endGain)
+    {
+        const size_t frames = samples.size() / std::max<size_t>(channels, 1);
+        if (frames == 0)
+        {
+            return;
+        }
+
+        const float step = (endGain - startGain) / static_cast<float>(frames);
+        float gain = startGain;
+        for (size_t frame = 0; frame < frames; ++frame)
+        {
+            for (size_t channel = 0; channel < channels; ++channel)
+            {
+                samples[frame * channels + channel] *= gain;
+            }
+            gain += step;
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
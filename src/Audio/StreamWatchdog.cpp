@@ -0,0 +1,114 @@
+/**
+ * Stream Watchdog
+ * Heartbeat-based stall detection and paced recovery of the audio streams
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "StreamWatchdog.h"
+#include <algorithm>
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+        /// Longest backoff doubling applied (keeps the shift in range)
+        constexpr uint32_t kMaxBackoffDoublings = 16;
+
+        double Milliseconds(StreamWatchdog::Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::milli>(duration).count();
+        }
+    } // namespace
+
+    StreamWatchdog::StreamWatchdog(const StreamWatchdogConfig &config, std::chrono::nanoseconds bufferPeriod)
+        : config(config), stallTimeout(bufferPeriod * std::max(config.stallBuffers, 1u))
+    {
+    }
+
+    void StreamWatchdog::Arm(Clock::time_point now)
+    {
+        if (!config.enabled)
+        {
+            return;
+        }
+        health.status = StreamStatus::Running;
+        health.attempts = 0;
+        lastProgress = now;
+        deadline = now + std::chrono::milliseconds(config.startupMs);
+    }
+
+    void StreamWatchdog::Disarm()
+    {
+        health.status = StreamStatus::Idle;
+        health.attempts = 0;
+    }
+
+    WatchdogAction StreamWatchdog::Observe(uint64_t heartbeats, Clock::time_point now)
+    {
+        if (heartbeats != health.heartbeats)
+        {
+            health.heartbeats = heartbeats;
+            if (health.status == StreamStatus::Stalled)
+            {
+                ++health.recoveries;
+                health.lastOutageMs = Milliseconds(now - lastProgress);
+                health.lastRecoveryMs = Milliseconds(now - stallDetected);
+                health.maxRecoveryMs = std::max(health.maxRecoveryMs, health.lastRecoveryMs);
+                health.attempts = 0;
+            }
+            if (config.enabled)
+            {
+                health.status = StreamStatus::Running;
+            }
+            lastProgress = now;
+            deadline = now + stallTimeout;
+            return WatchdogAction::None;
+        }
+
+        switch (health.status)
+        {
+        case StreamStatus::Idle:
+            return WatchdogAction::None;
+        case StreamStatus::Running:
+            if (now < deadline)
+            {
+                return WatchdogAction::None;
+            }
+            health.status = StreamStatus::Stalled;
+            ++health.stalls;
+            stallDetected = now;
+            nextAttempt = now; // First restart right away
+            break;
+        case StreamStatus::Stalled:
+        default:
+            break;
+        }
+
+        if (now < nextAttempt)
+        {
+            return WatchdogAction::None;
+        }
+
+        // Each attempt gets the startup time to deliver a buffer, plus a growing backoff after failures
+        const uint32_t failures = health.attempts;
+        ++health.attempts;
+        uint64_t backoffMs = 0;
+        if (failures > 0)
+        {
+            backoffMs = std::min<uint64_t>(static_cast<uint64_t>(config.backoffMs)
+                                               << std::min(failures - 1, kMaxBackoffDoublings),
+                config.maxBackoffMs);
+        }
+        nextAttempt = now + std::chrono::milliseconds(config.startupMs + backoffMs);
+
+        if (health.attempts > config.restartAttempts)
+        {
+            ++health.fallbacks;
+            return WatchdogAction::FallBack;
+        }
+        return WatchdogAction::Restart;
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace PrecisionTuner::Audio
+{
+    /** When a StreamWatchdog declares a stream stalled and how it retries */
+    struct StreamWatchdogConfig
+    {
+        bool enabled = false;         ///< Watch the streams (off for drivers whose callbacks are fed by hand)
+        uint32_t stallBuffers = 8;    ///< Buffer periods without a callback before a running stream is stalled
+        uint32_t startupMs = 1000;    ///< Time a (re)started stream gets to deliver its first buffer
+        uint32_t restartAttempts = 2; ///< Restarts on the same device before falling back to the default one
+        uint32_t backoffMs = 250;     ///< Extra wait after the first failed attempt, doubled after each failure
+        uint32_t maxBackoffMs = 8000; ///< Longest extra wait between attempts
+    };
+
+    /** Health of one watched stream */
+    enum class StreamStatus : uint8_t
+    {
+        Idle,    ///< Not watched: no buffer delivered yet and not armed by the owner
+        Running, ///< Delivering buffers
+        Stalled  ///< No buffer within the deadline; being recovered
+    };
+
+    /** What the owner of a stream should do after an observation */
+    enum class WatchdogAction : uint8_t
+    {
+        None,    ///< Nothing
+        Restart, ///< Reopen the stream on its current device
+        FallBack ///< Reopen the stream on the system default device
+    };
+
+    /** Status and recovery metrics of one watched stream */
+    struct StreamHealth
+    {
+        StreamStatus status = StreamStatus::Idle; ///< Current status
+        uint64_t heartbeats = 0;                  ///< Buffers delivered, as of the last observation
+        uint64_t stalls = 0;                      ///< Stalls detected
+        uint64_t recoveries = 0;                  ///< Stalls that ended with the stream delivering buffers again
+        uint64_t fallbacks = 0;                   ///< Recovery attempts that moved to the default device
+        uint32_t attempts = 0;                    ///< Recovery attempts in the current stall (0 while running)
+        double lastOutageMs = 0.0;                ///< Last stall: last buffer seen to first buffer afterwards
+        double lastRecoveryMs = 0.0;              ///< Last stall: detection to first buffer afterwards
+        double maxRecoveryMs = 0.0;               ///< Longest detection-to-recovery time so far
+    };
+
+    /**
+     * @brief Detects a stream that stopped calling back and paces its recovery
+     *
+     * The stream's callback bumps a heartbeat counter on every buffer; the owner passes the
+     * counter to Observe() from its update loop. A running stream whose counter has not moved
+     * for stallBuffers buffer periods is stalled, and Observe() asks for a restart on the same
+     * device right away, then again after a growing backoff, and after restartAttempts failed
+     * restarts for a fall back to the default device. Whatever brings the counter back to life
+     * ends the stall and is recorded as a recovery.
+     *
+     * Nothing is measured inside the callback: the heartbeat is the only thing it provides.
+     *
+     * THREAD SAFETY:
+     *  - Not thread-safe: owned and called by one (non-real-time) thread
+     */
+    class StreamWatchdog
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Constructs an idle watchdog
+         * @param config Deadlines and retry pacing
+         * @param bufferPeriod Duration of one device buffer
+         */
+        explicit StreamWatchdog(const StreamWatchdogConfig &config = {},
+            std::chrono::nanoseconds bufferPeriod = std::chrono::nanoseconds(0));
+
+        /**
+         * @brief Starts watching a stream that was just (re)opened by its owner
+         * The stream gets startupMs for its first buffer. Ends a stall without counting a recovery.
+         * @param now Current time
+         */
+        void Arm(Clock::time_point now);
+
+        /**
+         * @brief Stops watching (stream closed on purpose, or owned by another watchdog)
+         */
+        void Disarm();
+
+        /**
+         * @brief Checks the stream's progress
+         * @param heartbeats Current value of the stream's heartbeat counter
+         * @param now Current time
+         * @return Recovery step the owner should take now
+         */
+        WatchdogAction Observe(uint64_t heartbeats, Clock::time_point now);
+
+        /**
+         * @brief Gets the status and recovery metrics
+         * @return Health as of the last call
+         */
+        [[nodiscard]] const StreamHealth &Health() const
+        {
+            return health;
+        }
+
+        /**
+         * @brief Gets the time a running stream may go without a buffer
+         * @return stallBuffers buffer periods
+         */
+        [[nodiscard]] std::chrono::nanoseconds StallTimeout() const
+        {
+            return stallTimeout;
+        }
+
+    private:
+        StreamWatchdogConfig config;           ///< Deadlines and retry pacing
+        std::chrono::nanoseconds stallTimeout; ///< stallBuffers buffer periods
+        StreamHealth health;                   ///< Status and metrics
+        Clock::time_point deadline;            ///< Running: stalled if no heartbeat by then
+        Clock::time_point lastProgress;        ///< When the counter was last seen moving
+        Clock::time_point stallDetected;       ///< When the current stall was detected
+        Clock::time_point nextAttempt;         ///< Stalled: next recovery attempt is due
+    };
+
+    /**
+     * @brief Gets a short human-readable name for a stream status
+     * @param status Status
+     * @return Static string
+     */
+    [[nodiscard]] constexpr const char *ToString(StreamStatus status)
+    {
+        switch (status)
+        {
+        case StreamStatus::Running:
+            return "running";
+        case StreamStatus::Stalled:
+            return "stalled";
+        case StreamStatus::Idle:
+        default:
+            return "idle";
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,171 @@
+/**
+ * Thread Scheduling
+ * Real-time priority, CPU affinity and memory locking for the audio and analysis threads
+ *
+ * Copyright (c) 2025
+ * Licensed under the MIT License
+ */
+
+#include "ThreadScheduling.h"
+#include <algorithm>
+#include <cerrno>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace PrecisionTuner::Audio
+{
+    namespace
+    {
+#if defined(__linux__) || defined(__APPLE__)
+        /// Tries SCHED_FIFO at the requested priority, then at the ceiling an unprivileged process is allowed
+        void ApplyPriority(int requested, ThreadSchedulingResult &result)
+        {
+            const int clamped =
+                std::clamp(requested, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+            sched_param param{};
+            param.sched_priority = clamped;
+            int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+            if (error == 0)
+            {
+                result.priority = clamped == requested ? SchedulingOutcome::Granted : SchedulingOutcome::FellBack;
+                result.grantedPriority = clamped;
+                return;
+            }
+
+#if defined(__linux__)
+            // Without CAP_SYS_NICE, SCHED_FIFO is still allowed up to RLIMIT_RTPRIO (set by limits.conf / rtkit)
+            rlimit limit{};
+            if (error == EPERM && getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY
+                && static_cast<int>(limit.rlim_cur) >= sched_get_priority_min(SCHED_FIFO)
+                && static_cast<int>(limit.rlim_cur) < clamped)
+            {
+                param.sched_priority = static_cast<int>(limit.rlim_cur);
+                if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0)
+                {
+                    result.priority = SchedulingOutcome::FellBack;
+                    result.grantedPriority = param.sched_priority;
+                    result.error = error;
+                    return;
+                }
+            }
+#endif
+
+            result.priority = SchedulingOutcome::Denied;
+            result.error = error;
+        }
+#endif
+
+#if defined(__linux__)
+        /// Pins the thread to the configured CPUs; the kernel drops CPUs that are offline or outside our cpuset
+        void ApplyAffinity(const std::vector<uint32_t> &cpus, ThreadSchedulingResult &result)
+        {
+            // No sysconf() here: glibc answers _SC_NPROCESSORS_* by reading /sys, which allocates
+            cpu_set_t requested;
+            CPU_ZERO(&requested);
+            bool skipped = false;
+            for (const uint32_t cpu : cpus)
+            {
+                if (cpu < CPU_SETSIZE)
+                {
+                    CPU_SET(cpu, &requested);
+                }
+                else
+                {
+                    skipped = true;
+                }
+            }
+
+            const int requestedCount = CPU_COUNT(&requested);
+            if (requestedCount == 0)
+            {
+                result.affinity = SchedulingOutcome::Denied;
+                result.error = EINVAL;
+                return;
+            }
+
+            const int error = pthread_setaffinity_np(pthread_self(), sizeof(requested), &requested);
+            if (error != 0)
+            {
+                result.affinity = SchedulingOutcome::Denied;
+                result.error = error;
+                return;
+            }
+
+            // Read back: CPUs that do not exist or are outside the allowed set are silently left out
+            cpu_set_t effective;
+            CPU_ZERO(&effective);
+            const int pinned = pthread_getaffinity_np(pthread_self(), sizeof(effective), &effective) == 0
+                                   ? CPU_COUNT(&effective)
+                                   : requestedCount;
+            result.pinnedCpus = static_cast<uint32_t>(pinned);
+            result.affinity = !skipped && pinned == requestedCount ? SchedulingOutcome::Granted
+                                                                    : SchedulingOutcome::FellBack;
+        }
+#endif
+    } // namespace
+
+    ThreadSchedulingResult ApplyThreadScheduling(const ThreadSchedulingPolicy &policy)
+    {
+        ThreadSchedulingResult result;
+        result.applied = true;
+
+        if (policy.realtime)
+        {
+#if defined(__linux__) || defined(__APPLE__)
+            ApplyPriority(policy.priority, result);
+#else
+            result.priority = SchedulingOutcome::Unsupported;
+#endif
+        }
+
+        if (!policy.cpus.empty())
+        {
+#if defined(__linux__)
+            ApplyAffinity(policy.cpus, result);
+#else
+            result.affinity = SchedulingOutcome::Unsupported;
+#endif
+        }
+
+        return result;
+    }
+
+    MemoryLockResult LockProcessMemory(bool lock)
+    {
+        if (!lock)
+        {
+            return {};
+        }
+
+#if defined(__linux__)
+        // MCL_FUTURE under a finite RLIMIT_MEMLOCK makes later allocations fail once the limit is hit,
+        // so only lock future pages when the limit cannot be reached
+        rlimit limit{};
+        const bool unlimited =
+            geteuid() == 0 || (getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY);
+        if (unlimited && mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+        {
+            return { .outcome = SchedulingOutcome::Granted };
+        }
+
+        const int futureError = unlimited ? errno : ENOMEM;
+        if (mlockall(MCL_CURRENT) == 0)
+        {
+            return { .outcome = SchedulingOutcome::FellBack, .error = futureError };
+        }
+        return { .outcome = SchedulingOutcome::Denied, .error = errno };
+#else
+        return { .outcome = SchedulingOutcome::Unsupported };
+#endif
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace PrecisionTuner::Audio
+{
+    /** Result of one scheduling request (priority, affinity or memory locking) */
+    enum class SchedulingOutcome : uint8_t
+    {
+        NotRequested, ///< Setting left at the OS default
+        Granted,      ///< Applied exactly as configured
+        FellBack,     ///< Applied in a reduced form (lower priority, fewer CPUs, current pages only)
+        Denied,       ///< Refused by the OS (permissions, resource limits, unknown CPUs)
+        Unsupported   ///< Not available on this platform
+    };
+
+    /** How one class of threads (audio callbacks, analysis workers) should be scheduled */
+    struct ThreadSchedulingPolicy
+    {
+        bool realtime = false;      ///< Request SCHED_FIFO
+        int priority = 0;           ///< SCHED_FIFO priority (clamped to the range the OS reports)
+        std::vector<uint32_t> cpus; ///< CPUs to pin to (empty = no pinning)
+
+        /**
+         * @brief Whether anything is requested at all
+         * @return true if realtime scheduling or pinning is configured
+         */
+        [[nodiscard]] bool IsRequested() const
+        {
+            return realtime || !cpus.empty();
+        }
+    };
+
+    /**
+     * Outcome of applying a ThreadSchedulingPolicy to one thread
+     *
+     * Trivially copyable and packable into two 64-bit words, so audio threads can report it
+     * through a DiagnosticQueue without allocating.
+     */
+    struct ThreadSchedulingResult
+    {
+        SchedulingOutcome priority = SchedulingOutcome::NotRequested; ///< SCHED_FIFO request
+        SchedulingOutcome affinity = SchedulingOutcome::NotRequested; ///< CPU pinning request
+        bool applied = false;                                         ///< Whether the thread has run the policy yet
+        int32_t grantedPriority = 0;                                  ///< SCHED_FIFO priority in effect (0 = none)
+        uint32_t pinnedCpus = 0;                                      ///< CPUs in the affinity mask that was set
+        int32_t error = 0;                                            ///< errno of the last refused request
+
+        /**
+         * @brief Packs the outcome into one word (error travels separately)
+         * @return Packed value
+         */
+        [[nodiscard]] uint64_t Pack() const
+        {
+            return static_cast<uint64_t>(priority) | (static_cast<uint64_t>(affinity) << 8)
+                   | (static_cast<uint64_t>(static_cast<uint8_t>(grantedPriority)) << 16)
+                   | (static_cast<uint64_t>(pinnedCpus) << 32);
+        }
+
+        /**
+         * @brief Rebuilds a result from Pack() and error
+         * @param packed Value returned by Pack()
+         * @param error errno carried alongside
+         * @return Applied result
+         */
+        [[nodiscard]] static ThreadSchedulingResult Unpack(uint64_t packed, uint64_t error)
+        {
+            return ThreadSchedulingResult{ .priority = static_cast<SchedulingOutcome>(packed & 0xFF),
+                .affinity = static_cast<SchedulingOutcome>((packed >> 8) & 0xFF),
+                .applied = true,
+                .grantedPriority = static_cast<int32_t>((packed >> 16) & 0xFF),
+                .pinnedCpus = static_cast<uint32_t>(packed >> 32),
+                .error = static_cast<int32_t>(error) };
+        }
+    };
+
+    /** Outcome of locking the process memory */
+    struct MemoryLockResult
+    {
+        SchedulingOutcome outcome = SchedulingOutcome::NotRequested; ///< mlockall request
+        int32_t error = 0;                                           ///< errno if refused or reduced
+    };
+
+    /**
+     * @brief Applies a scheduling policy to the calling thread
+     *
+     * Requests SCHED_FIFO at the configured priority; if that is refused, retries at the
+     * RLIMIT_RTPRIO ceiling (FellBack). Pins the thread to the configured CPUs, skipping CPUs
+     * that do not exist (FellBack) and failing if none remain (Denied). Affinity is Linux-only.
+     *
+     * Real-time safe: system calls only, no allocation, no locking. Intended to run once,
+     * from the thread itself (audio callbacks do not belong to us, so they apply it on
+     * their first buffer).
+     *
+     * @param policy Policy to apply
+     * @return Per-setting outcome
+     */
+    ThreadSchedulingResult ApplyThreadScheduling(const ThreadSchedulingPolicy &policy);
+
+    /**
+     * @brief Locks all current and future pages of the process into RAM (mlockall)
+     * Falls back to locking only the current pages if MCL_FUTURE is refused.
+     * @param lock Whether locking is requested at all
+     * @return Outcome
+     */
+    MemoryLockResult LockProcessMemory(bool lock);
+
+    /**
+     * @brief Gets a short human-readable name for a scheduling outcome
+     * @param outcome Outcome
+     * @return Static string
+     */
+    [[nodiscard]] constexpr const char *ToString(SchedulingOutcome outcome)
+    {
+        switch (outcome)
+        {
+        case SchedulingOutcome::NotRequested:
+            return "not requested";
+        case SchedulingOutcome::Granted:
+            return "granted";
+        case SchedulingOutcome::FellBack:
+            return "fell back";
+        case SchedulingOutcome::Denied:
+            return "denied";
+        case SchedulingOutcome::Unsupported:
+        default:
+            return "unsupported";
+        }
+    }
+
+} // namespace PrecisionTuner::Audio
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <CacheLine.h>
+
+namespace PrecisionTuner::Audio
+{
+    /**
+     * @brief Single-writer, single-reader triple buffer for a parameter block
+     *
+     * The writer fills its private back slot and publishes it by swapping it with the shared
+     * middle slot; the reader, when it chooses to (e.g. once per audio buffer), swaps its
+     * front slot with the middle one if a new value was published. Neither side ever waits,
+     * the reader always sees a complete value, and intermediate values the reader did not
+     * pick up in time are simply skipped.
+     *
+     * The middle slot index and a "new value" flag share one atomic word, so each swap is a
+     * single exchange. Each slot, the middle index and the reader's front index sit on cache
+     * lines of their own, so filling the back slot never invalidates what the reader uses.
+     *
+     * THREAD SAFETY:
+     *  - Write() must only be called from one thread at a time (the writer)
+     *  - Update() and Read() must only be called from one thread at a time (the reader); the
+     *    reader role may move to another thread if the handover itself synchronizes
+     *
+     * @tparam T Copyable payload type
+     */
+    template<typename T> class TripleBuffer
+    {
+    public:
+        /**
+         * @brief Constructs the buffer with every slot holding the same value
+         * @param initial Value returned by Read() before the first Update()
+         */
+        explicit TripleBuffer(const T &initial = T{})
+            : slots{ Slot{ initial }, Slot{ initial }, Slot{ initial } }, back(0), middle(1), front(2)
+        {
+        }
+
+        /**
+         * @brief Publishes a new value (writer side)
+         * @param value Value the reader picks up at its next Update()
+         */
+        void Write(const T &value)
+        {
+            slots[back].value = value;
+            back = middle.exchange(back | kFresh, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        /**
+         * @brief Picks up the latest published value, if any (reader side)
+         * Wait-free; never allocates.
+         * @return true if Read() now returns a value not seen before
+         */
+        bool Update()
+        {
+            if ((middle.load(std::memory_order_relaxed) & kFresh) == 0)
+            {
+                return false;
+            }
+            front = middle.exchange(front, std::memory_order_acq_rel) & kIndexMask;
+            return true;
+        }
+
+        /**
+         * @brief Gets the value picked up by the last Update() (reader side)
+         * @return Current value; stays valid and unchanged until the next Update()
+         */
+        [[nodiscard]] const T &Read() const
+        {
+            return slots[front].value;
+        }
+
+    private:
+        static constexpr uint32_t kIndexMask = 0x3; ///< Slot index bits of middle
+        static constexpr uint32_t kFresh = 0x4;     ///< Middle holds a value the reader has not taken
+
+        /** One value, padded to whole cache lines */
+        struct alignas(kCacheLineSize) Slot
+        {
+            T value;
+        };
+
+        std::array<Slot, 3> slots;                            ///< Back, middle and front values (roles rotate)
+        uint32_t back;                                        ///< Slot the writer fills next (writer only)
+        alignas(kCacheLineSize) std::atomic<uint32_t> middle; ///< Slot last published, plus kFresh
+        alignas(kCacheLineSize) uint32_t front;               ///< Slot the reader uses (reader only)
+    };
+
+} // namespace PrecisionTuner::Audio
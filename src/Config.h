@@ -4,6 +4,7 @@
 #include <cstring>
 #include <filesystem>
 #include <optional>
+#include <vector>
 
 namespace PrecisionTuner
 {
@@ -41,6 +42,86 @@ namespace PrecisionTuner
         NLOHMANN_DEFINE_TYPE_INTRUSIVE(WindowConfig, width, height, posX, posY, isMaximized)
     };
 
+    /**
+     * Real-time scheduling of the audio and analysis threads
+     *
+     * Everything is off by default; on Linux, SCHED_FIFO needs CAP_SYS_NICE or an RLIMIT_RTPRIO
+     * (e.g. the audio group in limits.conf), and locking future pages an unlimited RLIMIT_MEMLOCK.
+     */
+    struct SchedulingConfig
+    {
+        bool lockMemory = false;       ///< mlockall() the process so page faults never hit the audio path
+        bool realtimeAudio = false;    ///< SCHED_FIFO for the audio callback threads
+        int audioPriority = 80;        ///< SCHED_FIFO priority of the audio callback threads
+        std::vector<int> audioCpus;    ///< CPUs to pin the audio callback threads to (empty = any)
+        bool realtimeAnalysis = false; ///< SCHED_FIFO for the pitch analysis threads
+        int analysisPriority = 60;     ///< SCHED_FIFO priority of the analysis threads (below audio)
+        std::vector<int> analysisCpus; ///< CPUs to pin the analysis threads to (empty = any)
+        bool hugePages = false;        ///< Back the audio buffer arenas with huge pages
+
+        // Custom JSON serialization to handle missing keys gracefully
+        friend void to_json(nlohmann::json &j, const SchedulingConfig &p)
+        {
+            j = nlohmann::json{ { "lockMemory", p.lockMemory },
+                { "realtimeAudio", p.realtimeAudio },
+                { "audioPriority", p.audioPriority },
+                { "audioCpus", p.audioCpus },
+                { "realtimeAnalysis", p.realtimeAnalysis },
+                { "analysisPriority", p.analysisPriority },
+                { "analysisCpus", p.analysisCpus },
+                { "hugePages", p.hugePages } };
+        }
+
+        friend void from_json(const nlohmann::json &j, SchedulingConfig &p)
+        {
+            p.lockMemory = j.value("lockMemory", SchedulingConfig{}.lockMemory);
+            p.realtimeAudio = j.value("realtimeAudio", SchedulingConfig{}.realtimeAudio);
+            p.audioPriority = j.value("audioPriority", SchedulingConfig{}.audioPriority);
+            p.audioCpus = j.value("audioCpus", SchedulingConfig{}.audioCpus);
+            p.realtimeAnalysis = j.value("realtimeAnalysis", SchedulingConfig{}.realtimeAnalysis);
+            p.analysisPriority = j.value("analysisPriority", SchedulingConfig{}.analysisPriority);
+            p.analysisCpus = j.value("analysisCpus", SchedulingConfig{}.analysisCpus);
+            p.hugePages = j.value("hugePages", SchedulingConfig{}.hugePages);
+        }
+    };
+
+    /**
+     * Stall detection and recovery of the audio streams
+     *
+     * A stream that delivers no buffer for stallBuffers buffer periods is restarted, and after
+     * restartAttempts failed restarts moved to the system default device.
+     */
+    struct WatchdogConfig
+    {
+        bool enabled = true;     ///< Watch the audio streams
+        int stallBuffers = 8;    ///< Buffer periods without a callback before a stream counts as stalled
+        int startupMs = 1000;    ///< Time a (re)started stream gets to deliver its first buffer
+        int restartAttempts = 2; ///< Restarts on the same device before falling back to the default one
+        int backoffMs = 250;     ///< Extra wait after the first failed attempt, doubled after each failure
+        int maxBackoffMs = 8000; ///< Longest extra wait between attempts
+
+        // Custom JSON serialization to handle missing keys gracefully
+        friend void to_json(nlohmann::json &j, const WatchdogConfig &p)
+        {
+            j = nlohmann::json{ { "enabled", p.enabled },
+                { "stallBuffers", p.stallBuffers },
+                { "startupMs", p.startupMs },
+                { "restartAttempts", p.restartAttempts },
+                { "backoffMs", p.backoffMs },
+                { "maxBackoffMs", p.maxBackoffMs } };
+        }
+
+        friend void from_json(const nlohmann::json &j, WatchdogConfig &p)
+        {
+            p.enabled = j.value("enabled", WatchdogConfig{}.enabled);
+            p.stallBuffers = j.value("stallBuffers", WatchdogConfig{}.stallBuffers);
+            p.startupMs = j.value("startupMs", WatchdogConfig{}.startupMs);
+            p.restartAttempts = j.value("restartAttempts", WatchdogConfig{}.restartAttempts);
+            p.backoffMs = j.value("backoffMs", WatchdogConfig{}.backoffMs);
+            p.maxBackoffMs = j.value("maxBackoffMs", WatchdogConfig{}.maxBackoffMs);
+        }
+    };
+
     /**
      * Audio device configuration with feedback settings
      */
@@ -48,10 +129,11 @@ namespace PrecisionTuner
     {
         int deviceId = -1;      ///< Input device ID (-1 means default)
         std::string deviceName; ///< Input device name for display/matching
-        int sampleRate = 48000; ///< Sample rate in Hz
+        int sampleRate = 48000; ///< Sample rate in Hz the streams open at (the analysis is planned for it)
         int bufferSize =
             256; ///< Buffer size in frames (256 ~= 5.3ms @ 48kHz). Lower (128) = better latency but higher CPU load.
-        int inputChannel = 0;        ///< Input channel index (0-based)
+        int inputChannel = 0;        ///< Input channel index (0-based) the tuner display follows
+        int inputChannelCount = 1;   ///< Channels captured, each with its own pitch pipeline
         bool autoSelectInput = true; ///< Automatically select first available input channel
 
         // Output device configuration
@@ -71,6 +153,9 @@ namespace PrecisionTuner
         // Advanced feedback modes
         bool enableDroneMode = false;      ///< Enable continuous reference tone (drone)
         bool enablePolyphonicMode = false; ///< Enable polyphonic chord playback
+
+        SchedulingConfig scheduling; ///< Real-time priorities, CPU pinning and memory locking
+        WatchdogConfig watchdog;     ///< Restart or fall back when a stream stops calling back
     };
 
     // Custom JSON serialization for AudioConfig to handle missing keys gracefully
@@ -78,6 +163,9 @@ namespace PrecisionTuner
     {
         j = nlohmann::json{ { "deviceId", config.deviceId },
             { "deviceName", config.deviceName },
+            { "sampleRate", config.sampleRate },
+            { "inputChannel", config.inputChannel },
+            { "inputChannelCount", config.inputChannelCount },
             { "outputDeviceId", config.outputDeviceId },
             { "outputDeviceName", config.outputDeviceName },
             { "enableBeep", config.enableBeep },
@@ -89,13 +177,18 @@ namespace PrecisionTuner
             { "monitoringVolume", config.monitoringVolume },
             { "inputGain", config.inputGain },
             { "enableDroneMode", config.enableDroneMode },
-            { "enablePolyphonicMode", config.enablePolyphonicMode } };
+            { "enablePolyphonicMode", config.enablePolyphonicMode },
+            { "scheduling", config.scheduling },
+            { "watchdog", config.watchdog } };
     }
 
     inline void from_json(const nlohmann::json &j, AudioConfig &config)
     {
         config.deviceId = j.value("deviceId", AudioConfig{}.deviceId);
         config.deviceName = j.value("deviceName", AudioConfig{}.deviceName);
+        config.sampleRate = j.value("sampleRate", AudioConfig{}.sampleRate);
+        config.inputChannel = j.value("inputChannel", AudioConfig{}.inputChannel);
+        config.inputChannelCount = j.value("inputChannelCount", AudioConfig{}.inputChannelCount);
         config.outputDeviceId = j.value("outputDeviceId", AudioConfig{}.outputDeviceId);
         config.outputDeviceName = j.value("outputDeviceName", AudioConfig{}.outputDeviceName);
         config.enableBeep = j.value("enableBeep", AudioConfig{}.enableBeep);
@@ -108,6 +201,8 @@ namespace PrecisionTuner
         config.inputGain = j.value("inputGain", AudioConfig{}.inputGain);
         config.enableDroneMode = j.value("enableDroneMode", AudioConfig{}.enableDroneMode);
         config.enablePolyphonicMode = j.value("enablePolyphonicMode", AudioConfig{}.enablePolyphonicMode);
+        config.scheduling = j.value("scheduling", AudioConfig{}.scheduling);
+        config.watchdog = j.value("watchdog", AudioConfig{}.watchdog);
     }
     struct TuningConfig
     {
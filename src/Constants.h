@@ -18,6 +18,30 @@ namespace PrecisionTuner::Constants
     /// Buffer allocation safety margin multiplier
     static constexpr uint32_t kuBufferSafetyMultiplier = 4;
 
+    /// Largest device buffer (frames) the callback buffers are grown for; bigger buffers stay truncated
+    static constexpr uint32_t kuMaxDeviceBufferFrames = 65536;
+
+    /// Capacity of the callback-to-analysis sample queue, in multiples of max(device buffer, analysis window)
+    static constexpr uint32_t kuAnalysisQueueBlocks = 8;
+
+    /// Device buffers of kuMaxDeviceBufferFrames the analysis queue holds at least (it is never regrown)
+    static constexpr uint32_t kuAnalysisQueueMaxBuffers = 2;
+
+    /// Events each audio thread can queue for the main thread before further events are only counted
+    static constexpr uint32_t kuDiagnosticQueueCapacity = 64;
+
+    /// Most input channels captured at once (each gets its own analysis thread)
+    static constexpr uint32_t kuMaxInputChannels = 16;
+
+    /// Minimum interval between two log lines for the same diagnostic code (ms); repeats are summarized
+    static constexpr uint32_t kuDiagnosticLogIntervalMs = 1000;
+
+    /// Time a background device switch waits for the running stream to hand over before stopping it (ms)
+    static constexpr uint32_t kuDeviceSwitchHandoffTimeoutMs = 250;
+
+    /// Interval between background device scans that detect hotplugged devices (ms)
+    static constexpr uint32_t kuDeviceScanIntervalMs = 2000;
+
     // ===== Tuner Visualization Constants =====
 
     /// Threshold for "in tune" indication (cents)
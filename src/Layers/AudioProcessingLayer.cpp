@@ -2,42 +2,109 @@
 #include "Constants.h"
 #include <Logger.h>
 #include <algorithm>
-#include <AudioDeviceManager.h>
+#include <cmath>
+#include <cstring>
+#include <string>
 #include <RtAudioDevice.h>
 
 namespace PrecisionTuner::Layers
 {
+    namespace
+    {
+        /** Milliseconds elapsed since a steady_clock time point */
+        double MillisecondsSince(std::chrono::steady_clock::time_point start)
+        {
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+
+        /** Pitch detector for one analysis pipeline */
+        std::unique_ptr<GuitarDSP::HybridPitchDetector> CreatePitchDetector(const PitchTrackingConfig &config)
+        {
+            return std::make_unique<GuitarDSP::HybridPitchDetector>(
+                GuitarDSP::HybridPitchDetectorConfig{ .yinConfidenceThreshold = 0.8f,
+                    .enableHarmonicRejection = true,
+                    .harmonicTolerance = 0.05f,
+                    .yinConfig = { .threshold = 0.10f,
+                        .minFrequency = config.minFrequency,
+                        .maxFrequency = config.maxFrequency },
+                    .mpmConfig = { .threshold = 0.93f,
+                        .minFrequency = config.minFrequency,
+                        .maxFrequency = config.maxFrequency } });
+        }
+
+        /** Pitch stabilizer selected by config.stabilizerType (nullptr for None) */
+        std::unique_ptr<GuitarDSP::PitchStabilizer> CreateStabilizer(const PitchTrackingConfig &config)
+        {
+            switch (config.stabilizerType)
+            {
+            case StabilizerType::EMA:
+                return std::make_unique<GuitarDSP::ExponentialMovingAverage>(
+                    GuitarDSP::EMAConfig{ .alpha = config.emaAlpha });
+            case StabilizerType::Median:
+                return std::make_unique<GuitarDSP::MedianFilter>(
+                    GuitarDSP::MedianFilterConfig{ .windowSize = config.medianWindowSize });
+            case StabilizerType::Hybrid:
+                return std::make_unique<GuitarDSP::HybridStabilizer>(GuitarDSP::HybridStabilizerConfig{
+                    .baseAlpha = config.emaAlpha, .windowSize = config.medianWindowSize });
+            case StabilizerType::None:
+            default:
+                return nullptr;
+            }
+        }
+
+        /** The pitch tracking fields of a layer configuration */
+        PitchTrackingConfig PitchTrackingFrom(const AudioProcessingLayerConfig &config)
+        {
+            return PitchTrackingConfig{ .minFrequency = config.minFrequency,
+                .maxFrequency = config.maxFrequency,
+                .stabilizerType = config.stabilizerType,
+                .emaAlpha = config.emaAlpha,
+                .medianWindowSize = config.medianWindowSize };
+        }
+
+        /// Duration of one device buffer at the configured rate
+        std::chrono::nanoseconds BufferPeriod(const AudioProcessingLayerConfig &config)
+        {
+            return std::chrono::nanoseconds(
+                static_cast<uint64_t>(config.bufferSize) * 1'000'000'000ull / std::max(config.sampleRate, 1u));
+        }
+    } // namespace
+
     AudioProcessingLayer::AudioProcessingLayer(const AudioProcessingLayerConfig &config)
         : AudioProcessingLayer(config,
               std::make_unique<GuitarIO::RtAudioDevice>(),
-              std::make_unique<GuitarIO::RtAudioDevice>())
+              std::make_unique<GuitarIO::RtAudioDevice>(),
+              []() -> std::unique_ptr<GuitarIO::AudioDevice> { return std::make_unique<GuitarIO::RtAudioDevice>(); })
     {
     }
 
     AudioProcessingLayer::AudioProcessingLayer(const AudioProcessingLayerConfig &config,
         std::unique_ptr<GuitarIO::AudioDevice> inputDevice,
-        std::unique_ptr<GuitarIO::AudioDevice> outputDevice)
+        std::unique_ptr<GuitarIO::AudioDevice> outputDevice,
+        AudioDeviceFactory deviceFactory)
         : config(config), inputDevice(std::move(inputDevice)), outputDevice(std::move(outputDevice)),
-          pitchDetector(std::make_unique<GuitarDSP::HybridPitchDetector>(
-              GuitarDSP::HybridPitchDetectorConfig{ .yinConfidenceThreshold = 0.8f,
-                  .enableHarmonicRejection = true,
-                  .harmonicTolerance = 0.05f,
-                  .yinConfig = { .threshold = 0.10f,
-                      .minFrequency = config.minFrequency,
-                      .maxFrequency = config.maxFrequency },
-                  .mpmConfig = { .threshold = 0.93f,
-                      .minFrequency = config.minFrequency,
-                      .maxFrequency = config.maxFrequency } })),
-          pitchStabilizer(nullptr), latestFrequency(0.0f), latestConfidence(0.0f), pitchDetected(false),
-          bufferOverflowDetected(false), processingBuffer({}), outputScratchBuffer({}),
-          currentInputDeviceId(static_cast<uint32_t>(-1)), currentOutputDeviceId(static_cast<uint32_t>(-1)),
-          outputChannels(1), monitoringRingBuffer({}), monitoringWritePos(0), monitoringReadPos(0),
+          inputDiagnostics(Constants::kuDiagnosticQueueCapacity),
+          outputDiagnostics(Constants::kuDiagnosticQueueCapacity), diagnosticLog({}), realtimeViolationsUnrecorded(0),
+          inputBuffers(), outputBuffers(), provisionedBufferFrames(0), currentInputDeviceId(static_cast<uint32_t>(-1)),
+          currentOutputDeviceId(static_cast<uint32_t>(-1)), duplexActive(false),
+          deviceCatalog(std::chrono::milliseconds(Constants::kuDeviceScanIntervalMs)), deviceListLogged(false),
+          deviceFactory(std::move(deviceFactory)),
+          inputStreams{ StreamContext{ .layer = this, .slot = 0 }, StreamContext{ .layer = this, .slot = 1 } },
+          outputStreams{ StreamContext{ .layer = this, .slot = 0 }, StreamContext{ .layer = this, .slot = 1 } },
+          inputHandoff(0), outputHandoff(0), deviceSwitch(nullptr), queuedInputSwitch(), queuedOutputSwitch(),
+          inputWatchdog(config.watchdog, BufferPeriod(config)), outputWatchdog(config.watchdog, BufferPeriod(config)),
+          callbackMemory(nullptr), monitoringTargetFill(0), retiredCallbackMemory(),
+          preFilterSettings(config.preFilter), preFilterVersion(0), analysisMemory(), pipelines(),
+          pitchTracking(PitchTrackingFrom(config)), pitchTrackingGeneration(0), monitoredChannel(0),
+          inputMonitoringEnabled(false), inputGain(1.0f), inputStalled(false), feedbackDraft(),
+          feedbackParameters(feedbackDraft),
+          currentInputLevel(0.0f), currentInputRms(0.0f), bufferOverflowDetected(false), oversizedBufferFrames(0),
+          monitoringOverruns(0), monitoringDroppedSamples(0), inputHeartbeats(0),
           beepGenerator(static_cast<double>(config.sampleRate)),
           referenceGenerator(static_cast<double>(config.sampleRate)),
-          polyphonicGenerator(static_cast<double>(config.sampleRate)), beepEnabled(false), referenceEnabled(false),
-          inputMonitoringEnabled(false), droneEnabled(false), polyphonicEnabled(false), beepVolume(0.5f),
-          referenceVolume(0.5f), monitoringVolume(0.5f), inputGain(1.0f), referenceFrequency(440.0f),
-          currentInputLevel(0.0f)
+          polyphonicGenerator(static_cast<double>(config.sampleRate)), monitoringUnderruns(0),
+          monitoringMissingSamples(0), monitoringLatencyTrims(0), monitoringTrimmedSamples(0),
+          feedbackVersionApplied(0), outputHeartbeats(0), outputFramesRendered(0)
     {
         /**
          * REAL-TIME AUDIO THREAD SAFETY:
@@ -52,174 +119,275 @@ namespace PrecisionTuner::Layers
          *  - Sample rate conversion edge cases
          *  - Hardware-specific quirks
          *
-         * If bufferOverflowDetected flag is set, the main thread will log an error
-         * indicating that the safety margin was insufficient.
+         * If a device still delivers a larger buffer, the callback truncates it and the main
+         * thread grows the buffers (see ReprovisionBuffers()).
+         *
+         * Every captured channel gets its own pipeline: sample queue, overlapping window,
+         * detector, stabilizer, published results and worker thread. The input callback
+         * deinterleaves into the channel scratch (pre-allocated here) and feeds each queue.
+         *
+         * Input monitoring ring: the output callback holds it near monitoringTargetFill so
+         * pass-through latency stays bounded even if the two streams drift apart.
          */
-        processingBuffer.resize(config.bufferSize * Constants::kuBufferSafetyMultiplier);
-        outputScratchBuffer.resize(config.bufferSize * Constants::kuBufferSafetyMultiplier);
+        this->config.inputChannels = std::clamp<uint32_t>(config.inputChannels, 1, Constants::kuMaxInputChannels);
+        this->config.primaryChannel = std::min(config.primaryChannel, this->config.inputChannels - 1);
+        monitoredChannel.store(this->config.primaryChannel, std::memory_order_relaxed);
+        const uint32_t channelCount = this->config.inputChannels;
+        monitoringTargetFill = config.monitoringTargetFill > 0 ? config.monitoringTargetFill : config.bufferSize;
+        if (!ProvisionBuffers(config.bufferSize))
+        {
+            LOG_ERROR("Callback buffers could not be reserved: {}", std::strerror(callbackMemory->arena.Stats().error));
+        }
+        LOG_INFO("Input monitoring: target fill {} frames ({:.1f} ms), ring capacity {} frames",
+            monitoringTargetFill,
+            1000.0 * static_cast<double>(monitoringTargetFill) / config.sampleRate,
+            callbackMemory->monitoringRing.Capacity());
 
-        // Pre-allocate ring buffer for input monitoring (4x buffer size for safety)
-        monitoringRingBuffer.resize(config.bufferSize * Constants::kuBufferSafetyMultiplier);
+        LOG_INFO("Input conditioning kernel: {}", Audio::ToString(Audio::GetActiveSimdLevel()));
+        LOG_INFO("Input channels: {} (primary channel {})", channelCount, this->config.primaryChannel);
 
-        LOG_INFO("AudioProcessingLayer - Initializing audio I/O");
+        /**
+         * Pitch detection runs on dedicated analysis threads, not on the real-time input
+         * callback. InputCallback conditions each buffer and pushes every channel into its
+         * pipeline's queue; each analysis thread pulls one hop at a time into an overlapping
+         * window, so the detector sees analysisWindowSize samples every analysisHopSize
+         * samples regardless of the device buffer size.
+         * Both sizes are planned for the rate the streams open at, so they keep their duration
+         * (and decimation keeps the detector's work per second) at 44.1, 96 or 192 kHz alike.
+         * Detectors and stabilizers are built here and handed to the threads through an
+         * RcuPointer, the same way SetPitchTrackingConfig() replaces them later, so they are
+         * only ever touched by their pipeline's thread while in use.
+         */
+        analysisPlan = PlanAnalysis(pitchTracking);
+        for (uint32_t channel = 0; channel < channelCount; ++channel)
+        {
+            auto pipeline = std::make_unique<ChannelPipeline>(channel, Constants::kuDiagnosticQueueCapacity);
+            auto tracker = CreatePitchTracker(pitchTracking, pitchTrackingGeneration);
+            pipeline->decimationFactor.store(tracker->decimator.Factor(), std::memory_order_relaxed);
+            pipeline->tracker.Publish(std::move(tracker));
+
+            pipeline->window.Configure(analysisPlan.windowSize, analysisPlan.hopSize);
+            pipeline->preFilter.Configure(config.preFilter, config.sampleRate);
+            const float hopSeconds =
+                static_cast<float>(pipeline->window.HopSize()) / static_cast<float>(config.sampleRate);
+            pipeline->gate.Configure(config.signalGate, hopSeconds);
+            pipeline->onsets.Configure(config.onsetDetector, hopSeconds);
+            pipeline->lockTimer.Configure(config.lockTimer, config.sampleRate);
+
+            // One history entry per hop; the ring is allocated here and never grows
+            const double framesPerSecond = static_cast<double>(config.sampleRate) / pipeline->window.HopSize();
+            pipeline->history.Reset(static_cast<size_t>(std::max(1.0, config.pitchHistorySeconds * framesPerSecond)));
+            pipelines.push_back(std::move(pipeline));
+        }
+
+        // Sample queues of all channels live in one arena, next to each other. Queues are never
+        // regrown, so they also take the largest buffers ReprovisionBuffers() grows the callback for.
+        const size_t queueBlock = std::max<size_t>(config.bufferSize, pipelines.front()->window.WindowSize());
+        const size_t queueCapacity = Audio::SpscRingBuffer<float>::CapacityFor(
+            std::max<size_t>(queueBlock * Constants::kuAnalysisQueueBlocks,
+                static_cast<size_t>(Constants::kuMaxDeviceBufferFrames) * Constants::kuAnalysisQueueMaxBuffers));
+        if (!analysisMemory.Reserve(Audio::MemoryArena::Footprint<float>(queueCapacity) * channelCount,
+                config.memoryArena))
+        {
+            LOG_ERROR("Analysis queues could not be reserved: {}", std::strerror(analysisMemory.Stats().error));
+        }
+        for (auto &pipeline : pipelines)
+        {
+            pipeline->queue.Reset(analysisMemory.Allocate<float>(queueCapacity));
+        }
+        LogMemoryFootprint();
 
-        auto &deviceManager = GuitarIO::AudioDeviceManager::Get();
+        LOG_INFO("HybridPitchDetector initialized with YIN+MPM and harmonic rejection");
+        LogPitchTracking(pitchTracking);
+
+        const ChannelPipeline &primary = *pipelines[this->config.primaryChannel];
+        const double framesPerSecond = static_cast<double>(config.sampleRate) / primary.window.HopSize();
+        LOG_INFO("Analysis window: {} samples ({:.1f} ms), hop {} samples ({:.1f} ms) at {} Hz",
+            primary.window.WindowSize(),
+            1000.0 * static_cast<double>(primary.window.WindowSize()) / config.sampleRate,
+            primary.window.HopSize(),
+            1000.0 * static_cast<double>(primary.window.HopSize()) / config.sampleRate,
+            config.sampleRate);
+        LOG_INFO("Pitch history: {} frames ({:.1f} s) per channel",
+            primary.history.Capacity(),
+            static_cast<double>(primary.history.Capacity()) / framesPerSecond);
+        LogPreFilter(config.preFilter);
+        if (config.signalGate.enabled)
+        {
+            LOG_INFO("Signal gate: opens {:.0f} dB / closes {:.0f} dB above the noise floor ({:.0f} to {:.0f} dBFS)",
+                config.signalGate.openMarginDb,
+                config.signalGate.closeMarginDb,
+                config.signalGate.minFloorDb,
+                config.signalGate.maxFloorDb);
+        }
+        else
+        {
+            LOG_INFO("Signal gate: Disabled");
+        }
+        LOG_INFO("Onset detection: {:.0f} dB rise, {:.0f} ms attack skipped ({})",
+            config.onsetDetector.riseDb,
+            1000.0f * config.onsetDetector.attackSeconds,
+            config.onsetDetector.reseedOnOnset ? "stabilizer reseeded at each pluck" : "time-to-lock measured only");
 
-        // ===== INPUT DEVICE SETUP =====
-        auto inputDevices = deviceManager.EnumerateInputDevices();
-        LOG_INFO("Available input devices ({} found):", inputDevices.size());
-        for (const auto &device : inputDevices)
+        /**
+         * Lock memory once every buffer above is allocated and before any audio or analysis
+         * thread runs. Thread priorities and CPU pinning are applied by the threads themselves
+         * (analysis workers on start, audio callbacks on their first buffer) and reported back
+         * through the diagnostic queues.
+         */
+        schedulingReport.memoryLock = Audio::LockProcessMemory(config.lockMemory);
+        if (config.lockMemory)
+        {
+            const Audio::MemoryLockResult &memoryLock = schedulingReport.memoryLock;
+            if (memoryLock.outcome == Audio::SchedulingOutcome::Granted)
+            {
+                LOG_INFO("Memory locking: {} (current and future pages)", Audio::ToString(memoryLock.outcome));
+            }
+            else
+            {
+                LOG_WARN("Memory locking: {} ({})",
+                    Audio::ToString(memoryLock.outcome),
+                    memoryLock.outcome == Audio::SchedulingOutcome::FellBack ? "current pages only"
+                                                                             : std::strerror(memoryLock.error));
+            }
+        }
+        schedulingReport.analysisThreads.resize(pipelines.size());
+
+        for (auto &pipeline : pipelines)
         {
-            LOG_INFO("  [{}] {} - {} input channels", device.id, device.name, device.maxInputChannels);
+            ChannelPipeline &owned = *pipeline;
+            owned.worker =
+                std::jthread([this, &owned](std::stop_token stopToken) { AnalysisThreadMain(owned, stopToken); });
         }
 
-        uint32_t defaultInputId = deviceManager.GetDefaultInputDevice();
-        auto defaultInputInfo = deviceManager.GetDeviceInfo(defaultInputId);
+        // Generators start from the constructor's feedback block; later blocks are applied by the output callback
+        ApplyFeedbackParameters(feedbackParameters.Read(), true);
+
+        LOG_INFO("AudioProcessingLayer - Initializing audio I/O");
+        OpenInitialStreams();
+        ArmWatchdogs();
+        LOG_INFO("  Sample Rate: {} Hz", config.sampleRate);
+        LOG_INFO("  Buffer Size: {} frames", config.bufferSize);
+        LOG_INFO("  Frequency Range: {:.1f} - {:.1f} Hz", config.minFrequency, config.maxFrequency);
+
+        // Device lists are enumerated in the background from here on; OnUpdate() logs them once available
+        deviceCatalog.Start();
+    }
+
+    void AudioProcessingLayer::OpenInitialStreams()
+    {
+        // Only the default devices are queried here: probing every device is left to the device catalog
+
+        // ===== INPUT DEVICE SETUP =====
+        uint32_t defaultInputId = deviceCatalog.GetDefaultDevice(true);
+        auto defaultInputInfo = deviceCatalog.GetDeviceInfo(defaultInputId);
         LOG_INFO("Using default input device: [{}] {}", defaultInputId, defaultInputInfo.name);
         currentInputDeviceId = defaultInputId;
 
+        // ===== FULL-DUPLEX SETUP =====
+        // One stream for input and output when both are the same device: no ring, one buffer of latency
+        const uint32_t defaultOutputId = deviceCatalog.GetDefaultDevice(false);
+        if (WantsDuplex(defaultInputId, defaultOutputId) && OpenDuplexStream(defaultInputId))
+        {
+            return;
+        }
+
         // Configure input stream (input-only)
-        GuitarIO::AudioStreamConfig inputConfig{
-            .sampleRate = config.sampleRate, .bufferSize = config.bufferSize, .inputChannels = 1, .outputChannels = 0
-        };
+        GuitarIO::AudioStreamConfig inputConfig{ .sampleRate = config.sampleRate,
+            .bufferSize = config.bufferSize,
+            .inputChannels = CaptureChannels(defaultInputInfo),
+            .outputChannels = 0 };
+        inputStreams[inputHandoff.Active()].inputChannels = inputConfig.inputChannels;
+        monitoredChannel.store(MonitoredChannel(inputConfig.inputChannels), std::memory_order_relaxed);
 
-        if (!this->inputDevice->OpenDefault(inputConfig, InputCallback, this))
+        if (!inputDevice->OpenDefault(inputConfig, InputCallback, &inputStreams[inputHandoff.Active()]))
         {
-            LOG_ERROR("Failed to open input device: {}", this->inputDevice->GetLastError());
+            LOG_ERROR("Failed to open input device: {}", inputDevice->GetLastError());
             return;
         }
 
-        if (!this->inputDevice->Start())
+        if (!inputDevice->Start())
         {
-            LOG_ERROR("Failed to start input stream: {}", this->inputDevice->GetLastError());
+            LOG_ERROR("Failed to start input stream: {}", inputDevice->GetLastError());
             return;
         }
 
         LOG_INFO("Input stream started successfully");
 
         // ===== OUTPUT DEVICE SETUP =====
-        auto outputDevices = deviceManager.EnumerateOutputDevices();
-        LOG_INFO("Available output devices ({} found):", outputDevices.size());
-        for (const auto &device : outputDevices)
-        {
-            LOG_INFO("  [{}] {} - {} output channels", device.id, device.name, device.maxOutputChannels);
-        }
-
         // Configure output stream (output-only)
         GuitarIO::AudioStreamConfig outputConfig{
             .sampleRate = config.sampleRate, .bufferSize = config.bufferSize, .inputChannels = 0, .outputChannels = 1
         };
 
-        bool outputDeviceOpened = false;
+        StreamContext &outputStream = outputStreams[outputHandoff.Active()];
 
-        if (!outputDevices.empty())
-        {
-            // Try to open the first available output device
-            for (const auto &device : outputDevices)
-            {
-                LOG_INFO("Trying to open output device: [{}] {}", device.id, device.name);
+        auto tryOpenOutput = [&](const GuitarIO::AudioDeviceInfo &device) -> bool {
+            LOG_INFO("Trying to open output device: [{}] {}", device.id, device.name);
 
-                // Prefer stereo if available
-                uint32_t channels = (device.maxOutputChannels >= 2) ? 2 : 1;
-                this->outputChannels = channels;
-                outputConfig.outputChannels = channels;
+            // Prefer stereo if available
+            uint32_t channels = (device.maxOutputChannels >= 2) ? 2 : 1;
+            outputStream.outputChannels = channels;
+            outputConfig.outputChannels = channels;
 
-                if (this->outputDevice->Open(device.id, outputConfig, OutputCallback, this))
-                {
-                    if (this->outputDevice->Start())
-                    {
-                        currentOutputDeviceId = device.id;
-                        outputDeviceOpened = true;
-                        LOG_INFO("Successfully opened output device: [{}] {} with {} channels",
-                            device.id,
-                            device.name,
-                            channels);
-                        break;
-                    }
-                    else
-                    {
-                        LOG_WARN("Failed to start output device [{}] {}: {}",
-                            device.id,
-                            device.name,
-                            this->outputDevice->GetLastError());
-                        this->outputDevice->Close();
-                    }
-                }
-                else
+            if (outputDevice->Open(device.id, outputConfig, OutputCallback, &outputStream))
+            {
+                if (outputDevice->Start())
                 {
-                    LOG_WARN("Failed to open output device [{}] {}: {}",
+                    currentOutputDeviceId = device.id;
+                    LOG_INFO("Successfully opened output device: [{}] {} with {} channels",
                         device.id,
                         device.name,
-                        this->outputDevice->GetLastError());
+                        channels);
+                    return true;
+                }
+                LOG_WARN("Failed to start output device [{}] {}: {}",
+                    device.id,
+                    device.name,
+                    outputDevice->GetLastError());
+                outputDevice->Close();
+                return false;
+            }
 
-                    // Fallback to mono if stereo failed
-                    if (channels > 1)
+            LOG_WARN("Failed to open output device [{}] {}: {}", device.id, device.name, outputDevice->GetLastError());
+
+            // Fallback to mono if stereo failed
+            if (channels > 1)
+            {
+                LOG_WARN("Retrying with mono output...");
+                outputConfig.outputChannels = 1;
+                outputStream.outputChannels = 1;
+                if (outputDevice->Open(device.id, outputConfig, OutputCallback, &outputStream))
+                {
+                    if (outputDevice->Start())
                     {
-                        LOG_WARN("Retrying with mono output...");
-                        outputConfig.outputChannels = 1;
-                        this->outputChannels = 1;
-                        if (this->outputDevice->Open(device.id, outputConfig, OutputCallback, this))
-                        {
-                            if (this->outputDevice->Start())
-                            {
-                                currentOutputDeviceId = device.id;
-                                outputDeviceOpened = true;
-                                LOG_INFO("Successfully opened output device (Mono): [{}] {}", device.id, device.name);
-                                break;
-                            }
-                            this->outputDevice->Close();
-                        }
+                        currentOutputDeviceId = device.id;
+                        LOG_INFO("Successfully opened output device (Mono): [{}] {}", device.id, device.name);
+                        return true;
                     }
+                    outputDevice->Close();
                 }
             }
-        }
+            return false;
+        };
 
-        if (!outputDeviceOpened)
+        // Only the default device is tried here; DrainDeviceChanges() tries the others once the catalog lists them
+        if (!tryOpenOutput(deviceCatalog.GetDeviceInfo(defaultOutputId)))
         {
-            LOG_WARN("No working output device found - audio feedback features will be disabled");
+            LOG_WARN("Default output device unavailable - audio feedback features are disabled until one opens");
             currentOutputDeviceId = static_cast<uint32_t>(-1);
         }
-
-        LOG_INFO("  Sample Rate: {} Hz", config.sampleRate);
-        LOG_INFO("  Buffer Size: {} frames", config.bufferSize);
-        LOG_INFO("  Frequency Range: {:.1f} - {:.1f} Hz", config.minFrequency, config.maxFrequency);
-
-        // Pre-allocate HybridPitchDetector internal buffer
-        std::vector<float> dummyBuffer(config.bufferSize, 0.0f);
-        (void)pitchDetector->Detect(dummyBuffer, static_cast<float>(config.sampleRate));
-        LOG_INFO("HybridPitchDetector initialized with YIN+MPM and harmonic rejection");
-
-        // Initialize pitch stabilizer based on configuration
-        switch (config.stabilizerType)
-        {
-        case StabilizerType::EMA:
-            pitchStabilizer =
-                std::make_unique<GuitarDSP::ExponentialMovingAverage>(GuitarDSP::EMAConfig{ .alpha = config.emaAlpha });
-            LOG_INFO("Pitch stabilization: EMA (alpha={})", config.emaAlpha);
-            break;
-
-        case StabilizerType::Median:
-            pitchStabilizer = std::make_unique<GuitarDSP::MedianFilter>(
-                GuitarDSP::MedianFilterConfig{ .windowSize = config.medianWindowSize });
-            LOG_INFO("Pitch stabilization: Median Filter (window={})", config.medianWindowSize);
-            break;
-
-        case StabilizerType::Hybrid:
-            pitchStabilizer = std::make_unique<GuitarDSP::HybridStabilizer>(GuitarDSP::HybridStabilizerConfig{
-                .baseAlpha = config.emaAlpha, .windowSize = config.medianWindowSize });
-            LOG_INFO("Pitch stabilization: Hybrid (alpha={}, window={})", config.emaAlpha, config.medianWindowSize);
-            break;
-
-        case StabilizerType::None:
-        default:
-            pitchStabilizer = nullptr;
-            LOG_INFO("Pitch stabilization: Disabled");
-            break;
-        }
     }
 
     AudioProcessingLayer::~AudioProcessingLayer()
     {
+        // Let a switch in flight finish (its worker stops waiting for the handoff) so both devices are owned here again
+        if (deviceSwitch)
+        {
+            deviceSwitch->worker.request_stop();
+            FinishDeviceSwitch();
+        }
+
         if (inputDevice)
         {
             if (inputDevice->IsRunning())
@@ -245,407 +413,2080 @@ namespace PrecisionTuner::Layers
                 outputDevice->Close();
             }
         }
+
+        // Streams are stopped, so nothing can push into the analysis queues any more
+        for (auto &pipeline : pipelines)
+        {
+            if (pipeline->worker.joinable())
+            {
+                pipeline->worker.request_stop();
+                pipeline->wakeups.fetch_add(1, std::memory_order_release);
+                pipeline->wakeups.notify_one();
+                pipeline->worker.join();
+            }
+        }
     }
 
     void AudioProcessingLayer::OnUpdate([[maybe_unused]] float deltaTime)
     {
-        // Check for buffer overflow errors from audio thread
-        if (CheckBufferOverflow())
+        // Audio threads only queue events; all formatting and logging happens here
+        DrainDiagnostics();
+        DrainRealtimeViolations();
+
+        // Device switches run in the background; pick up the result once the worker is done
+        PollDeviceSwitch();
+
+        // Streams that stopped calling back are restarted, or moved to the default device
+        WatchStreams();
+
+        // Pitch trackers replaced by SetPitchTrackingConfig() are freed here, never on the analysis threads
+        ReclaimPitchTrackers();
+
+        // Oversized device buffers reported by the input callback get larger buffers here
+        ReprovisionBuffers();
+
+        DrainDeviceChanges();
+    }
+
+    void AudioProcessingLayer::DrainDeviceChanges()
+    {
+        if (!deviceListLogged)
         {
-            LOG_ERROR(
-                "Audio buffer overflow detected! Input buffer exceeded pre-allocated size ({} frames). "
-                "Consider increasing buffer size or safety margin.",
-                config.bufferSize * Constants::kuBufferSafetyMultiplier);
+            const auto snapshot = deviceCatalog.GetSnapshot();
+            if (snapshot->generation == 0)
+            {
+                return; // First scan still running
+            }
+            deviceListLogged = true;
+
+            LOG_INFO("Available input devices ({} found, scan took {:.1f} ms):",
+                snapshot->inputDevices.size(),
+                snapshot->enumerationMs);
+            for (const auto &device : snapshot->inputDevices)
+            {
+                LOG_INFO("  [{}] {} - {} input channels", device.id, device.name, device.maxInputChannels);
+            }
+            LOG_INFO("Available output devices ({} found):", snapshot->outputDevices.size());
+            for (const auto &device : snapshot->outputDevices)
+            {
+                LOG_INFO("  [{}] {} - {} output channels", device.id, device.name, device.maxOutputChannels);
+            }
+
+            // Startup only tried the default output device
+            OpenMissingOutputDevice(snapshot->outputDevices, snapshot->defaultOutputId);
         }
+
+        (void)deviceCatalog.DrainChanges([this](const Audio::DeviceChangeEvent &event) {
+            const char *direction = event.input ? "input" : "output";
+            if (event.change == Audio::DeviceChange::Added)
+            {
+                LOG_INFO("Audio {} device connected: [{}] {}", direction, event.device.id, event.device.name);
+                if (!event.input)
+                {
+                    OpenMissingOutputDevice({ &event.device, 1 }, static_cast<uint32_t>(-1));
+                }
+                return;
+            }
+
+            const uint32_t activeId = event.input ? currentInputDeviceId : currentOutputDeviceId;
+            if (event.device.id == activeId)
+            {
+                LOG_WARN("Active audio {} device disconnected: [{}] {}", direction, event.device.id, event.device.name);
+            }
+            else
+            {
+                LOG_INFO("Audio {} device disconnected: [{}] {}", direction, event.device.id, event.device.name);
+            }
+        });
     }
 
-    PitchData AudioProcessingLayer::GetLatestPitch() const
+    void AudioProcessingLayer::OpenMissingOutputDevice(std::span<const GuitarIO::AudioDeviceInfo> devices,
+        uint32_t skipId)
     {
-        PitchData data;
-        data.detected = pitchDetected.load(std::memory_order_relaxed);
-        data.frequency = latestFrequency.load(std::memory_order_relaxed);
-        data.confidence = latestConfidence.load(std::memory_order_relaxed);
-        return data;
+        // Only when no output device could be opened at all; a stalled one is the watchdog's to recover
+        if (currentOutputDeviceId != static_cast<uint32_t>(-1) || duplexActive || deviceSwitch ||
+            IsOutputDeviceAvailable())
+        {
+            return;
+        }
+
+        for (const auto &device : devices)
+        {
+            if (device.id == skipId || device.maxOutputChannels == 0)
+            {
+                continue;
+            }
+            LOG_INFO("No output device open - trying [{}] {}", device.id, device.name);
+            // A background switch reports its own outcome; an in-place one has already opened or failed
+            if (SwitchOutputDevice(device.id) && (deviceSwitch || IsOutputDeviceAvailable()))
+            {
+                return;
+            }
+        }
     }
 
-    bool AudioProcessingLayer::IsInputDeviceAvailable() const
+    void AudioProcessingLayer::DrainDiagnostics()
     {
-        return inputDevice->IsRunning();
+        const auto now = std::chrono::steady_clock::now();
+        const auto interval = std::chrono::milliseconds(Constants::kuDiagnosticLogIntervalMs);
+
+        auto handleEvent = [&](const Audio::DiagnosticEvent &event, uint32_t channel) {
+            const size_t index = static_cast<size_t>(event.code);
+            if (index >= diagnosticLog.size())
+            {
+                return;
+            }
+
+            DiagnosticLogState &state = diagnosticLog[index];
+            ++state.total;
+            state.lastEvent = event;
+
+            if (event.code == Audio::DiagnosticCode::ThreadScheduling)
+            {
+                RecordScheduling(event, channel); // Once per thread start: never throttled
+                return;
+            }
+
+            if (now - state.lastLogged < interval)
+            {
+                ++state.suppressed; // Reported in the next summary line
+                return;
+            }
+
+            LogDiagnostic(event);
+            state.lastLogged = now;
+        };
+
+        (void)inputDiagnostics.Drain([&](const Audio::DiagnosticEvent &event) { handleEvent(event, 0); });
+        (void)outputDiagnostics.Drain([&](const Audio::DiagnosticEvent &event) { handleEvent(event, 0); });
+        for (auto &pipeline : pipelines)
+        {
+            (void)pipeline->diagnostics.Drain(
+                [&](const Audio::DiagnosticEvent &event) { handleEvent(event, pipeline->channel); });
+        }
+
+        for (size_t index = 0; index < diagnosticLog.size(); ++index)
+        {
+            const auto code = static_cast<Audio::DiagnosticCode>(index);
+            DiagnosticLogState &state = diagnosticLog[index];
+
+            // Events that did not fit into a full queue are still counted
+            uint64_t dropped = inputDiagnostics.TakeDropped(code) + outputDiagnostics.TakeDropped(code);
+            for (auto &pipeline : pipelines)
+            {
+                dropped += pipeline->diagnostics.TakeDropped(code);
+            }
+            state.total += dropped;
+            state.suppressed += dropped;
+
+            if (state.suppressed > 0 && now - state.lastLogged >= interval)
+            {
+                LOG_WARN("Audio diagnostic '{}' repeated {} more times since last report (latest: {}, {} @ {})",
+                    Audio::ToString(code),
+                    state.suppressed,
+                    state.lastEvent.value0,
+                    Audio::ToString(state.lastEvent.source),
+                    state.lastEvent.sampleTime);
+                state.suppressed = 0;
+                state.lastLogged = now;
+            }
+        }
     }
 
-    bool AudioProcessingLayer::IsOutputDeviceAvailable() const
+    void AudioProcessingLayer::RecordScheduling(const Audio::DiagnosticEvent &event, uint32_t channel)
+    {
+        const auto result = Audio::ThreadSchedulingResult::Unpack(event.value0, event.value1);
+        std::string thread;
+        switch (event.source)
+        {
+        case Audio::DiagnosticSource::InputCallback:
+            schedulingReport.inputThread = result;
+            thread = "audio input thread";
+            break;
+        case Audio::DiagnosticSource::OutputCallback:
+            schedulingReport.outputThread = result;
+            thread = "audio output thread";
+            break;
+        case Audio::DiagnosticSource::AnalysisThread:
+        default:
+            if (channel < schedulingReport.analysisThreads.size())
+            {
+                schedulingReport.analysisThreads[channel] = result;
+            }
+            thread = "analysis thread (channel " + std::to_string(channel) + ")";
+            break;
+        }
+
+        const auto isShortfall = [](Audio::SchedulingOutcome outcome) {
+            return outcome == Audio::SchedulingOutcome::FellBack || outcome == Audio::SchedulingOutcome::Denied
+                   || outcome == Audio::SchedulingOutcome::Unsupported;
+        };
+        if (isShortfall(result.priority) || isShortfall(result.affinity))
+        {
+            const bool unsupported = result.priority == Audio::SchedulingOutcome::Unsupported
+                                     || result.affinity == Audio::SchedulingOutcome::Unsupported;
+            const char *reason = result.error != 0 ? std::strerror(result.error)
+                                 : unsupported     ? "not available on this platform"
+                                                   : "reduced to what the system allows";
+            LOG_WARN("Scheduling for {}: SCHED_FIFO {} (priority {}), CPU affinity {} ({} CPUs) - {}",
+                thread,
+                Audio::ToString(result.priority),
+                result.grantedPriority,
+                Audio::ToString(result.affinity),
+                result.pinnedCpus,
+                reason);
+        }
+        else
+        {
+            LOG_INFO("Scheduling for {}: SCHED_FIFO {} (priority {}), CPU affinity {} ({} CPUs)",
+                thread,
+                Audio::ToString(result.priority),
+                result.grantedPriority,
+                Audio::ToString(result.affinity),
+                result.pinnedCpus);
+        }
+    }
+
+    void AudioProcessingLayer::DrainRealtimeViolations()
     {
-        return outputDevice->IsRunning();
+        (void)Audio::DrainRealtimeViolations([](const Audio::RealtimeViolation &violation) {
+            LOG_ERROR("Real-time violation: {} on the {} thread", Audio::ToString(violation.kind), violation.thread);
+            for (const auto &frame : Audio::SymbolizeRealtimeViolation(violation))
+            {
+                LOG_ERROR("    {}", frame);
+            }
+        });
+
+        // Past kMaxRecordedRealtimeViolations only the count moves; summarize instead of going silent
+        const uint64_t total = Audio::GetRealtimeViolationCount();
+        const uint64_t unrecorded =
+            total > Audio::kMaxRecordedRealtimeViolations ? total - Audio::kMaxRecordedRealtimeViolations : 0;
+        if (unrecorded > realtimeViolationsUnrecorded)
+        {
+            LOG_ERROR("{} more real-time violations (stacks not recorded)", unrecorded - realtimeViolationsUnrecorded);
+            realtimeViolationsUnrecorded = unrecorded;
+        }
     }
 
-    std::vector<std::string> AudioProcessingLayer::GetAvailableInputDevices() const
+    void AudioProcessingLayer::LogDiagnostic(const Audio::DiagnosticEvent &event) const
     {
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        auto devices = manager.EnumerateInputDevices();
-        std::vector<std::string> deviceNames;
-        deviceNames.reserve(devices.size());
-        for (const auto &device : devices)
+        const char *source = Audio::ToString(event.source);
+
+        switch (event.code)
         {
-            deviceNames.push_back(device.name);
+        case Audio::DiagnosticCode::InputBufferOverflow:
+            LOG_ERROR("Audio buffer overflow detected! Input buffer of {} frames exceeded pre-allocated size ({} frames). "
+                      "Consider increasing buffer size or safety margin. [{} @ sample {}]",
+                event.value0,
+                event.value1,
+                source,
+                event.sampleTime);
+            break;
+
+        case Audio::DiagnosticCode::OutputChannelMismatch:
+            LOG_ERROR("Output buffer size {} not aligned with {} channels [{} @ frame {}]",
+                event.value0,
+                event.value1,
+                source,
+                event.sampleTime);
+            break;
+
+        case Audio::DiagnosticCode::AnalysisQueueOverrun:
+            LOG_WARN("Analysis queue full - pitch detection is falling behind the input stream, {} samples dropped "
+                     "({} frames queue capacity) [{} @ sample {}]",
+                event.value0,
+                event.value1,
+                source,
+                event.sampleTime);
+            break;
+
+        case Audio::DiagnosticCode::MonitoringOverrun:
+            LOG_WARN("Input monitoring ring full - {} samples dropped ({} frames capacity) [{} @ sample {}]",
+                event.value0,
+                event.value1,
+                source,
+                event.sampleTime);
+            break;
+
+        case Audio::DiagnosticCode::MonitoringUnderrun:
+            LOG_WARN("Input monitoring ran dry - {} of {} frames filled with silence [{} @ frame {}]",
+                event.value0,
+                event.value1,
+                source,
+                event.sampleTime);
+            break;
+
+        case Audio::DiagnosticCode::Count:
+        default:
+            LOG_WARN("Unknown audio diagnostic event {} [{} @ {}]",
+                static_cast<int>(event.code),
+                source,
+                event.sampleTime);
+            break;
         }
-        return deviceNames;
     }
 
-    std::vector<GuitarIO::AudioDeviceInfo> AudioProcessingLayer::GetAvailableInputDeviceInfo() const
+    uint64_t AudioProcessingLayer::GetDiagnosticCount(Audio::DiagnosticCode code) const
     {
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        return manager.EnumerateInputDevices();
+        const size_t index = static_cast<size_t>(code);
+        return index < diagnosticLog.size() ? diagnosticLog[index].total : 0;
     }
 
-    uint32_t AudioProcessingLayer::GetCurrentInputDeviceId() const
+    const SchedulingReport &AudioProcessingLayer::GetSchedulingReport() const
     {
-        return currentInputDeviceId;
+        return schedulingReport;
     }
 
-    std::vector<std::string> AudioProcessingLayer::GetAvailableOutputDevices() const
+    PitchFrame AudioProcessingLayer::GetLatestPitch() const
     {
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        auto devices = manager.EnumerateOutputDevices();
-        std::vector<std::string> deviceNames;
-        deviceNames.reserve(devices.size());
-        for (const auto &device : devices)
+        return GetLatestPitch(monitoredChannel.load(std::memory_order_relaxed));
+    }
+
+    PitchFrame AudioProcessingLayer::GetLatestPitch(uint32_t channel) const
+    {
+        if (channel >= pipelines.size())
+        {
+            return PitchFrame{ .channel = channel };
+        }
+
+        // The last frame of a stalled stream is not a reading of the string any more
+        PitchFrame frame = pipelines[channel]->latest.Load();
+        if (inputStalled.load(std::memory_order_relaxed))
+        {
+            frame.detected = false;
+        }
+        return frame;
+    }
+
+    uint32_t AudioProcessingLayer::GetInputChannelCount() const
+    {
+        return static_cast<uint32_t>(pipelines.size());
+    }
+
+    uint32_t AudioProcessingLayer::GetPrimaryChannel() const
+    {
+        return monitoredChannel.load(std::memory_order_relaxed);
+    }
+
+    uint64_t AudioProcessingLayer::GetStreamSampleTime() const
+    {
+        const ChannelPipeline &primary = *pipelines[monitoredChannel.load(std::memory_order_relaxed)];
+        return primary.samplesQueued.load(std::memory_order_relaxed);
+    }
+
+    size_t AudioProcessingLayer::CopyPitchHistory(std::span<PitchFrame> out) const
+    {
+        return pipelines[monitoredChannel.load(std::memory_order_relaxed)]->history.CopyLatest(out);
+    }
+
+    size_t AudioProcessingLayer::CopyPitchHistory(uint32_t channel, std::span<PitchFrame> out) const
+    {
+        return channel < pipelines.size() ? pipelines[channel]->history.CopyLatest(out) : 0;
+    }
+
+    size_t AudioProcessingLayer::ReadPitchHistorySince(uint64_t &lastSequence, std::span<PitchFrame> out) const
+    {
+        // Every published frame is pushed, so "frames consumed" and "last sequence seen" coincide
+        return pipelines[monitoredChannel.load(std::memory_order_relaxed)]->history.CopySince(lastSequence, out);
+    }
+
+    size_t AudioProcessingLayer::GetPitchHistoryCapacity() const
+    {
+        return pipelines[monitoredChannel.load(std::memory_order_relaxed)]->history.Capacity();
+    }
+
+    bool AudioProcessingLayer::FlushAnalysis(std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+        for (const auto &pipeline : pipelines)
+        {
+            // Samples short of a full hop stay queued until more input arrives
+            const uint64_t hopSize = pipeline->window.HopSize();
+            const uint64_t target = pipeline->samplesQueued.load(std::memory_order_acquire) / hopSize * hopSize;
+
+            while (pipeline->samplesAnalyzed.load(std::memory_order_acquire) < target)
+            {
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    return false;
+                }
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        return true;
+    }
+
+    bool AudioProcessingLayer::IsInputDeviceAvailable() const
+    {
+        // A stream the watchdog found stalled may still report running
+        if (inputStalled.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        // While a switch is in flight the device belongs to the worker; the old stream keeps running until the handoff
+        return inputDevice ? inputDevice->IsRunning() : deviceSwitch->previousRunning;
+    }
+
+    bool AudioProcessingLayer::IsOutputDeviceAvailable() const
+    {
+        // In duplex mode the output channels belong to the input device's stream
+        if (duplexActive)
+        {
+            return inputDevice->IsRunning();
+        }
+        return outputDevice ? outputDevice->IsRunning() : deviceSwitch->previousRunning;
+    }
+
+    bool AudioProcessingLayer::IsDuplexActive() const
+    {
+        return duplexActive;
+    }
+
+    std::vector<std::string> AudioProcessingLayer::GetAvailableInputDevices() const
+    {
+        // Cached by the device catalog; empty until its first background scan completes
+        const auto devices = deviceCatalog.GetSnapshot()->inputDevices;
+        std::vector<std::string> deviceNames;
+        deviceNames.reserve(devices.size());
+        for (const auto &device : devices)
+        {
+            deviceNames.push_back(device.name);
+        }
+        return deviceNames;
+    }
+
+    std::vector<GuitarIO::AudioDeviceInfo> AudioProcessingLayer::GetAvailableInputDeviceInfo() const
+    {
+        return deviceCatalog.GetSnapshot()->inputDevices;
+    }
+
+    uint32_t AudioProcessingLayer::GetCurrentInputDeviceId() const
+    {
+        return currentInputDeviceId;
+    }
+
+    std::vector<std::string> AudioProcessingLayer::GetAvailableOutputDevices() const
+    {
+        // Cached by the device catalog; empty until its first background scan completes
+        const auto devices = deviceCatalog.GetSnapshot()->outputDevices;
+        std::vector<std::string> deviceNames;
+        deviceNames.reserve(devices.size());
+        for (const auto &device : devices)
+        {
+            deviceNames.push_back(device.name);
+        }
+        return deviceNames;
+    }
+
+    std::vector<GuitarIO::AudioDeviceInfo> AudioProcessingLayer::GetAvailableOutputDeviceInfo() const
+    {
+        return deviceCatalog.GetSnapshot()->outputDevices;
+    }
+
+    Audio::DeviceCatalog &AudioProcessingLayer::GetDeviceCatalog()
+    {
+        return deviceCatalog;
+    }
+
+    uint32_t AudioProcessingLayer::GetCurrentOutputDeviceId() const
+    {
+        return currentOutputDeviceId;
+    }
+
+    bool AudioProcessingLayer::SwitchInputDevice(uint32_t deviceId)
+    {
+        LOG_INFO("Switching to input device ID: {}", deviceId);
+
+        if (deviceSwitch)
+        {
+            // One switch at a time; the latest request runs when the one in flight completes
+            LOG_INFO("Device switch in progress - input device {} queued", deviceId);
+            queuedInputSwitch = deviceId;
+            return true;
+        }
+
+        if (deviceId == currentInputDeviceId && inputDevice->IsRunning())
+        {
+            LOG_INFO("Input device {} is already active", deviceId);
+            return true;
+        }
+
+        // Leaving or entering duplex changes both streams at once
+        const uint32_t outputId = config.duplexMode == DuplexMode::Always ? deviceId : currentOutputDeviceId;
+        const bool reopenBoth = duplexActive || WantsDuplex(deviceId, outputId);
+        if (!reopenBoth && deviceFactory)
+        {
+            return StartDeviceSwitch(false, deviceId);
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        const bool switched = reopenBoth ? ReopenStreams(deviceId, outputId) : OpenInputStream(deviceId);
+        LOG_INFO("Input device switch took {:.1f} ms (in place, audio stopped meanwhile)", MillisecondsSince(started));
+        ArmWatchdogs();
+        return switched;
+    }
+
+    bool AudioProcessingLayer::OpenInputStream(uint32_t deviceId)
+    {
+        if (inputDevice->IsRunning())
+        {
+            LOG_INFO("Stopping current input stream...");
+            if (!inputDevice->Stop())
+            {
+                LOG_ERROR("Failed to stop input stream: {}", inputDevice->GetLastError());
+                return false;
+            }
+        }
+
+        if (inputDevice->IsOpen())
+        {
+            LOG_INFO("Closing current input device...");
+            inputDevice->Close();
+        }
+
+        GuitarIO::AudioStreamConfig inputConfig{ .sampleRate = config.sampleRate,
+            .bufferSize = config.bufferSize,
+            .inputChannels = CaptureChannels(deviceCatalog.GetDeviceInfo(deviceId)),
+            .outputChannels = 0 };
+
+        StreamContext *inputStream = &inputStreams[inputHandoff.Active()];
+        inputStream->inputChannels = inputConfig.inputChannels;
+        monitoredChannel.store(MonitoredChannel(inputConfig.inputChannels), std::memory_order_relaxed);
+        inputStream->fadeIn = false;
+        inputStream->scheduled = false;
+
+        LOG_INFO("Opening new input device...");
+        if (!inputDevice->Open(deviceId, inputConfig, InputCallback, inputStream))
+        {
+            LOG_ERROR("Failed to open input device: {}", inputDevice->GetLastError());
+
+            // Fallback to default (mono: every input device offers at least one channel)
+            LOG_WARN("Attempting to reopen default input device...");
+            inputConfig.inputChannels = 1;
+            inputStream->inputChannels = 1;
+            monitoredChannel.store(MonitoredChannel(1), std::memory_order_relaxed);
+            if (inputDevice->OpenDefault(inputConfig, InputCallback, inputStream))
+            {
+                inputDevice->Start();
+                currentInputDeviceId = static_cast<uint32_t>(-1);
+                LOG_INFO("Fallback to default input device successful");
+            }
+            return false;
+        }
+
+        LOG_INFO("Starting new input stream...");
+        if (!inputDevice->Start())
+        {
+            LOG_ERROR("Failed to start input stream: {}", inputDevice->GetLastError());
+            inputDevice->Close();
+
+            // Fallback to default (mono: every input device offers at least one channel)
+            LOG_WARN("Attempting to reopen default input device...");
+            inputConfig.inputChannels = 1;
+            inputStream->inputChannels = 1;
+            monitoredChannel.store(MonitoredChannel(1), std::memory_order_relaxed);
+            if (inputDevice->OpenDefault(inputConfig, InputCallback, inputStream))
+            {
+                inputDevice->Start();
+                currentInputDeviceId = static_cast<uint32_t>(-1);
+                LOG_INFO("Fallback to default input device successful");
+            }
+            return false;
+        }
+
+        currentInputDeviceId = deviceId;
+
+        auto deviceInfo = deviceCatalog.GetDeviceInfo(deviceId);
+        LOG_INFO("Successfully switched to input device: [{}] {}", deviceId, deviceInfo.name);
+
+        return true;
+    }
+
+    bool AudioProcessingLayer::SwitchOutputDevice(uint32_t deviceId)
+    {
+        LOG_INFO("Switching to output device ID: {}", deviceId);
+
+        if (deviceSwitch)
+        {
+            // One switch at a time; the latest request runs when the one in flight completes
+            LOG_INFO("Device switch in progress - output device {} queued", deviceId);
+            queuedOutputSwitch = deviceId;
+            return true;
+        }
+
+        if (deviceId == currentOutputDeviceId && IsOutputDeviceAvailable())
+        {
+            LOG_INFO("Output device {} is already active", deviceId);
+            return true;
+        }
+
+        // Leaving or entering duplex changes both streams at once
+        const uint32_t inputId = config.duplexMode == DuplexMode::Always ? deviceId : currentInputDeviceId;
+        const bool reopenBoth = duplexActive || WantsDuplex(inputId, deviceId);
+        if (!reopenBoth && deviceFactory)
+        {
+            return StartDeviceSwitch(true, deviceId);
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        const bool switched = reopenBoth ? ReopenStreams(inputId, deviceId) : OpenOutputStream(deviceId);
+        LOG_INFO("Output device switch took {:.1f} ms (in place, audio stopped meanwhile)", MillisecondsSince(started));
+        ArmWatchdogs();
+        return switched;
+    }
+
+    bool AudioProcessingLayer::OpenOutputStream(uint32_t deviceId)
+    {
+        if (outputDevice->IsRunning())
+        {
+            LOG_INFO("Stopping current output stream...");
+            if (!outputDevice->Stop())
+            {
+                LOG_ERROR("Failed to stop output stream: {}", outputDevice->GetLastError());
+                return false;
+            }
+        }
+
+        if (outputDevice->IsOpen())
+        {
+            LOG_INFO("Closing current output device...");
+            outputDevice->Close();
+        }
+
+        auto deviceInfo = deviceCatalog.GetDeviceInfo(deviceId);
+
+        // Prefer stereo if available
+        uint32_t channels = (deviceInfo.maxOutputChannels >= 2) ? 2 : 1;
+        StreamContext *outputStream = &outputStreams[outputHandoff.Active()];
+        outputStream->outputChannels = channels;
+        outputStream->fadeIn = false;
+        outputStream->scheduled = false;
+
+        GuitarIO::AudioStreamConfig outputConfig{ .sampleRate = config.sampleRate,
+            .bufferSize = config.bufferSize,
+            .inputChannels = 0,
+            .outputChannels = channels };
+
+        LOG_INFO("Opening new output device with {} channels...", channels);
+        if (!outputDevice->Open(deviceId, outputConfig, OutputCallback, outputStream))
+        {
+            LOG_ERROR("Failed to open output device: {}", outputDevice->GetLastError());
+
+            // Fallback to default
+            LOG_WARN("Attempting to reopen default output device...");
+            // Reset to mono for fallback if needed, or query default device info
+            // For simplicity, try mono fallback first
+            outputConfig.outputChannels = 1;
+            outputStream->outputChannels = 1;
+
+            if (outputDevice->OpenDefault(outputConfig, OutputCallback, outputStream))
+            {
+                outputDevice->Start();
+                currentOutputDeviceId = static_cast<uint32_t>(-1);
+                LOG_INFO("Fallback to default output device successful (Mono)");
+            }
+            return false;
+        }
+
+        LOG_INFO("Starting new output stream...");
+        if (!outputDevice->Start())
+        {
+            LOG_ERROR("Failed to start output stream: {}", outputDevice->GetLastError());
+            outputDevice->Close();
+
+            // Fallback to default
+            LOG_WARN("Attempting to reopen default output device...");
+            outputConfig.outputChannels = 1;
+            outputStream->outputChannels = 1;
+
+            if (outputDevice->OpenDefault(outputConfig, OutputCallback, outputStream))
+            {
+                outputDevice->Start();
+                currentOutputDeviceId = static_cast<uint32_t>(-1);
+                LOG_INFO("Fallback to default output device successful (Mono)");
+            }
+            return false;
+        }
+
+        currentOutputDeviceId = deviceId;
+        LOG_INFO("Successfully switched to output device: [{}] {}", deviceId, deviceInfo.name);
+
+        return true;
+    }
+
+    bool AudioProcessingLayer::WantsDuplex(uint32_t inputId, uint32_t outputId) const
+    {
+        switch (config.duplexMode)
+        {
+        case DuplexMode::Always:
+            return true;
+        case DuplexMode::Auto:
+            return inputId == outputId && inputId != static_cast<uint32_t>(-1);
+        case DuplexMode::Off:
+        default:
+            return false;
+        }
+    }
+
+    bool AudioProcessingLayer::OpenDuplexStream(uint32_t deviceId)
+    {
+        auto deviceInfo = deviceCatalog.GetDeviceInfo(deviceId);
+
+        if (config.duplexMode == DuplexMode::Auto
+            && (deviceInfo.maxInputChannels == 0 || deviceInfo.maxOutputChannels == 0))
+        {
+            LOG_INFO("Device [{}] {} is not full-duplex capable", deviceId, deviceInfo.name);
+            return false;
+        }
+
+        // Prefer stereo if available
+        uint32_t channels = (deviceInfo.maxOutputChannels >= 2) ? 2 : 1;
+
+        GuitarIO::AudioStreamConfig duplexConfig{ .sampleRate = config.sampleRate,
+            .bufferSize = config.bufferSize,
+            .inputChannels = CaptureChannels(deviceInfo),
+            .outputChannels = channels };
+
+        // The callback reads the channel counts, so set them before the stream starts
+        StreamContext *duplexStream = &inputStreams[inputHandoff.Active()];
+        duplexStream->inputChannels = duplexConfig.inputChannels;
+        monitoredChannel.store(MonitoredChannel(duplexConfig.inputChannels), std::memory_order_relaxed);
+        duplexStream->outputChannels = channels;
+        duplexStream->fadeIn = false;
+        duplexStream->scheduled = false;
+
+        LOG_INFO("Opening full-duplex stream on [{}] {} ({} in / {} out)...",
+            deviceId,
+            deviceInfo.name,
+            duplexConfig.inputChannels,
+            channels);
+        if (!inputDevice->Open(deviceId, duplexConfig, DuplexCallback, duplexStream))
+        {
+            LOG_WARN("Failed to open full-duplex stream: {}", inputDevice->GetLastError());
+            return false;
+        }
+
+        if (!inputDevice->Start())
+        {
+            LOG_WARN("Failed to start full-duplex stream: {}", inputDevice->GetLastError());
+            inputDevice->Close();
+            return false;
+        }
+
+        duplexActive = true;
+        currentInputDeviceId = deviceId;
+        currentOutputDeviceId = deviceId;
+        LOG_INFO("Full-duplex stream started: input monitoring latency is one buffer ({} frames, {:.1f} ms)",
+            config.bufferSize,
+            1000.0 * static_cast<double>(config.bufferSize) / config.sampleRate);
+        return true;
+    }
+
+    bool AudioProcessingLayer::ReopenStreams(uint32_t inputId, uint32_t outputId)
+    {
+        for (GuitarIO::AudioDevice *device : { inputDevice.get(), outputDevice.get() })
+        {
+            if (device->IsRunning() && !device->Stop())
+            {
+                LOG_ERROR("Failed to stop stream: {}", device->GetLastError());
+                return false;
+            }
+            if (device->IsOpen())
+            {
+                device->Close();
+            }
+        }
+        duplexActive = false;
+
+        if (WantsDuplex(inputId, outputId) && OpenDuplexStream(inputId))
+        {
+            return true;
+        }
+
+        // Different devices (or duplex failed): one stream per device, monitoring goes through the ring
+        LOG_INFO("Using separate input and output streams");
+        const bool inputOpened = OpenInputStream(inputId);
+        const bool outputOpened = OpenOutputStream(outputId);
+        return inputOpened && outputOpened;
+    }
+
+    bool AudioProcessingLayer::StartDeviceSwitch(bool output, uint32_t deviceId)
+    {
+        auto job = std::make_unique<DeviceSwitch>();
+        job->output = output;
+        job->deviceId = deviceId;
+        job->slot = 1 - (output ? outputHandoff : inputHandoff).Active();
+
+        if (output)
+        {
+            // Prefer stereo if available
+            const auto deviceInfo = deviceCatalog.GetDeviceInfo(deviceId);
+            job->streamConfig = { .sampleRate = config.sampleRate,
+                .bufferSize = config.bufferSize,
+                .inputChannels = 0,
+                .outputChannels = (deviceInfo.maxOutputChannels >= 2) ? 2u : 1u };
+        }
+        else
+        {
+            job->streamConfig = { .sampleRate = config.sampleRate,
+                .bufferSize = config.bufferSize,
+                .inputChannels = CaptureChannels(deviceCatalog.GetDeviceInfo(deviceId)),
+                .outputChannels = 0 };
+        }
+
+        job->next = deviceFactory();
+        if (!job->next)
+        {
+            LOG_ERROR("Failed to create a device for the {} switch", output ? "output" : "input");
+            return false;
+        }
+
+        // The worker owns both devices until the switch completes; the old stream keeps running meanwhile
+        std::unique_ptr<GuitarIO::AudioDevice> &current = output ? outputDevice : inputDevice;
+        job->previousRunning = current->IsRunning();
+        job->previous = std::move(current);
+
+        DeviceSwitch &running = *job;
+        job->worker =
+            std::jthread([this, &running](std::stop_token stopToken) { RunDeviceSwitch(running, stopToken); });
+        deviceSwitch = std::move(job);
+
+        LOG_INFO("Opening {} device {} in the background", output ? "output" : "input", deviceId);
+        return true;
+    }
+
+    void AudioProcessingLayer::RunDeviceSwitch(DeviceSwitch &job, std::stop_token stopToken)
+    {
+        // Never logs: the main thread reports the outcome from FinishDeviceSwitch()
+        Audio::StreamHandoff &handoff = job.output ? outputHandoff : inputHandoff;
+        StreamContext &stream = (job.output ? outputStreams : inputStreams)[job.slot];
+        const GuitarIO::AudioCallback callback = job.output ? OutputCallback : InputCallback;
+        const auto openStarted = std::chrono::steady_clock::now();
+
+        // The slot is idle: its previous stream was closed when the last switch completed
+        stream.inputChannels = std::max(job.streamConfig.inputChannels, 1u);
+        stream.outputChannels = job.streamConfig.outputChannels;
+        stream.fadeIn = true;
+        stream.scheduled = false; // The replacement runs on a new callback thread
+
+        bool opened = job.next->Open(job.deviceId, job.streamConfig, callback, &stream);
+        if (!opened && job.streamConfig.outputChannels > 1)
+        {
+            // Fallback to mono if stereo failed
+            job.streamConfig.outputChannels = 1;
+            stream.outputChannels = 1;
+            opened = job.next->Open(job.deviceId, job.streamConfig, callback, &stream);
+        }
+
+        if (!opened || !job.next->Start())
+        {
+            job.error = job.next->GetLastError();
+            if (job.next->IsOpen())
+            {
+                job.next->Close();
+            }
+            job.done.store(true, std::memory_order_release);
+            return;
+        }
+        job.openMs = MillisecondsSince(openStarted);
+
+        // The running stream hands over at the end of its next buffer
+        const auto handoffStarted = std::chrono::steady_clock::now();
+        handoff.Offer(job.slot);
+        if (job.previousRunning)
+        {
+            const auto deadline = handoffStarted + std::chrono::milliseconds(Constants::kuDeviceSwitchHandoffTimeoutMs);
+            while (!handoff.IsActive(job.slot) && !stopToken.stop_requested()
+                   && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+        job.handedOff = handoff.IsActive(job.slot);
+
+        // Stop() returns only once no callback of the old stream is in flight, so forcing the swap after it is safe
+        if (job.previous->IsRunning())
+        {
+            job.previous->Stop();
+        }
+        if (job.previous->IsOpen())
+        {
+            job.previous->Close();
+        }
+        handoff.Complete(job.slot);
+
+        job.handoffMs = MillisecondsSince(handoffStarted);
+        job.succeeded = true;
+        job.done.store(true, std::memory_order_release);
+    }
+
+    void AudioProcessingLayer::PollDeviceSwitch()
+    {
+        if (deviceSwitch)
+        {
+            if (!deviceSwitch->done.load(std::memory_order_acquire))
+            {
+                return;
+            }
+            FinishDeviceSwitch();
+            ArmWatchdogs();
+        }
+
+        // Requests that arrived while the switch was in flight (latest per direction)
+        if (queuedInputSwitch && !deviceSwitch)
+        {
+            const uint32_t deviceId = *queuedInputSwitch;
+            queuedInputSwitch.reset();
+            (void)SwitchInputDevice(deviceId);
+        }
+        if (queuedOutputSwitch && !deviceSwitch)
+        {
+            const uint32_t deviceId = *queuedOutputSwitch;
+            queuedOutputSwitch.reset();
+            (void)SwitchOutputDevice(deviceId);
+        }
+    }
+
+    void AudioProcessingLayer::FinishDeviceSwitch()
+    {
+        std::unique_ptr<DeviceSwitch> job = std::move(deviceSwitch);
+        if (job->worker.joinable())
+        {
+            job->worker.join();
+        }
+
+        const char *direction = job->output ? "output" : "input";
+        std::unique_ptr<GuitarIO::AudioDevice> &device = job->output ? outputDevice : inputDevice;
+        const auto deviceInfo = deviceCatalog.GetDeviceInfo(job->deviceId);
+
+        if (!job->succeeded)
+        {
+            // The old stream never stopped, so the tuner kept running on it
+            device = std::move(job->previous);
+            LOG_ERROR("Failed to switch {} device to [{}] {}: {} - keeping the current device",
+                direction,
+                job->deviceId,
+                deviceInfo.name,
+                job->error);
+            return;
+        }
+
+        device = std::move(job->next);
+        if (!job->output)
+        {
+            monitoredChannel.store(MonitoredChannel(std::max(job->streamConfig.inputChannels, 1u)),
+                std::memory_order_relaxed);
+        }
+        uint32_t &currentDeviceId = job->output ? currentOutputDeviceId : currentInputDeviceId;
+        currentDeviceId = job->deviceId;
+        LOG_INFO("Switched {} device to [{}] {} in {:.1f} ms (stream start {:.1f} ms, handoff {:.1f} ms, {})",
+            direction,
+            job->deviceId,
+            deviceInfo.name,
+            job->openMs + job->handoffMs,
+            job->openMs,
+            job->handoffMs,
+            job->handedOff ? "swapped at a buffer boundary" : "old stream stopped before the swap");
+    }
+
+    void AudioProcessingLayer::WatchStreams()
+    {
+        // A switch in flight owns one of the devices; ArmWatchdogs() runs when it ends
+        if (!config.watchdog.enabled || deviceSwitch)
+        {
+            return;
+        }
+
+        const auto now = Audio::StreamWatchdog::Clock::now();
+        const Audio::StreamStatus inputBefore = inputWatchdog.Health().status;
+        const Audio::StreamStatus outputBefore = outputWatchdog.Health().status;
+
+        const Audio::WatchdogAction inputAction =
+            inputWatchdog.Observe(inputHeartbeats.load(std::memory_order_relaxed), now);
+        Audio::WatchdogAction outputAction = Audio::WatchdogAction::None;
+        if (duplexActive)
+        {
+            // The duplex stream conditions input on every buffer, so its input heartbeat covers both directions
+            outputWatchdog.Disarm();
+        }
+        else
+        {
+            outputAction = outputWatchdog.Observe(outputHeartbeats.load(std::memory_order_relaxed), now);
+        }
+
+        const auto logTransition = [this](const char *direction,
+                                       Audio::StreamStatus before,
+                                       const Audio::StreamWatchdog &watchdog) {
+            const Audio::StreamHealth &health = watchdog.Health();
+            if (health.status == Audio::StreamStatus::Stalled && before != Audio::StreamStatus::Stalled)
+            {
+                LOG_WARN("{} stream stalled: no buffer for {:.0f} ms (stall {})",
+                    direction,
+                    std::chrono::duration<double, std::milli>(watchdog.StallTimeout()).count(),
+                    health.stalls);
+            }
+            else if (health.status == Audio::StreamStatus::Running && before == Audio::StreamStatus::Stalled)
+            {
+                LOG_INFO("{} stream recovered {:.1f} ms after the stall was detected (audio lost for {:.1f} ms)",
+                    direction,
+                    health.lastRecoveryMs,
+                    health.lastOutageMs);
+            }
+        };
+        logTransition("Input", inputBefore, inputWatchdog);
+        logTransition("Output", outputBefore, outputWatchdog);
+        inputStalled.store(inputWatchdog.Health().status == Audio::StreamStatus::Stalled, std::memory_order_relaxed);
+
+        if (inputAction != Audio::WatchdogAction::None)
+        {
+            RecoverStream(false, inputAction);
+        }
+        if (outputAction != Audio::WatchdogAction::None)
+        {
+            RecoverStream(true, outputAction);
+        }
+    }
+
+    void AudioProcessingLayer::RecoverStream(bool output, Audio::WatchdogAction action)
+    {
+        constexpr uint32_t kNoDevice = static_cast<uint32_t>(-1);
+        const bool fallBack = action == Audio::WatchdogAction::FallBack;
+        const auto snapshot = deviceCatalog.GetSnapshot();
+
+        // Streams opened through OpenDefault() have no ID: restarting them means reopening the default
+        const auto targetId = [&](bool outputSide) {
+            const uint32_t current = outputSide ? currentOutputDeviceId : currentInputDeviceId;
+            if (!fallBack && current != kNoDevice)
+            {
+                return current;
+            }
+            const uint32_t listed = outputSide ? snapshot->defaultOutputId : snapshot->defaultInputId;
+            if (listed != kNoDevice)
+            {
+                return listed;
+            }
+            return deviceCatalog.GetDefaultDevice(!outputSide);
+        };
+
+        const Audio::StreamHealth &health = (output ? outputWatchdog : inputWatchdog).Health();
+        const uint32_t deviceId = targetId(output);
+        LOG_WARN("Recovering stalled {} stream (attempt {}): {} device [{}]",
+            output ? "output" : "input",
+            health.attempts,
+            fallBack ? "falling back to the default" : "restarting the",
+            deviceId);
+
+        // The stall may be a device that went away; have the catalog notice before the user looks
+        deviceCatalog.RequestRefresh();
+
+        // Always in place: a stalled stream has no audio left to hand over, and a background switch would
+        // rearm the watchdog and lose track of the attempts made so far
+        const auto started = std::chrono::steady_clock::now();
+        bool reopened = false;
+        if (duplexActive)
+        {
+            reopened = ReopenStreams(targetId(false), targetId(true));
+        }
+        else
+        {
+            reopened = output ? OpenOutputStream(deviceId) : OpenInputStream(deviceId);
+        }
+        if (reopened)
+        {
+            LOG_INFO("{} stream reopened in {:.1f} ms; waiting for its first buffer",
+                output ? "Output" : "Input",
+                MillisecondsSince(started));
+        }
+        else
+        {
+            LOG_WARN("{} stream could not be reopened on device [{}]; the watchdog retries after its backoff",
+                output ? "Output" : "Input",
+                deviceId);
+        }
+    }
+
+    void AudioProcessingLayer::ArmWatchdogs()
+    {
+        const auto now = Audio::StreamWatchdog::Clock::now();
+        if (inputDevice && inputDevice->IsRunning())
+        {
+            inputWatchdog.Arm(now);
+        }
+        else
+        {
+            inputWatchdog.Disarm();
+        }
+
+        if (!duplexActive && outputDevice && outputDevice->IsRunning())
+        {
+            outputWatchdog.Arm(now);
+        }
+        else
+        {
+            outputWatchdog.Disarm();
+        }
+        inputStalled.store(false, std::memory_order_relaxed);
+    }
+
+    bool AudioProcessingLayer::IsDeviceSwitchPending() const
+    {
+        return deviceSwitch != nullptr || queuedInputSwitch.has_value() || queuedOutputSwitch.has_value();
+    }
+
+    bool AudioProcessingLayer::WaitForDeviceSwitch(std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        PollDeviceSwitch();
+        while (IsDeviceSwitchPending() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            PollDeviceSwitch();
+        }
+        return !IsDeviceSwitchPending();
+    }
+
+    void AudioProcessingLayer::UpdateAudioFeedback(const AudioConfig &audioConfig)
+    {
+        // Input side: the input callback reads these on every buffer
+        inputMonitoringEnabled.store(audioConfig.enableInputMonitoring, std::memory_order_relaxed);
+        inputGain.store(audioConfig.inputGain, std::memory_order_relaxed);
+
+        // Output side: one new block, applied by the output callback at its next buffer boundary
+        feedbackDraft.beepEnabled = audioConfig.enableBeep;
+        feedbackDraft.beepVolume = audioConfig.beepVolume;
+        feedbackDraft.referenceEnabled = audioConfig.enableReference;
+        feedbackDraft.referenceVolume = audioConfig.referenceVolume;
+        feedbackDraft.referenceFrequency = audioConfig.referenceFrequency;
+        feedbackDraft.monitoringEnabled = audioConfig.enableInputMonitoring;
+        feedbackDraft.monitoringVolume = audioConfig.monitoringVolume;
+
+        // Advanced modes
+        feedbackDraft.droneEnabled = audioConfig.enableDroneMode;
+        feedbackDraft.polyphonicEnabled = audioConfig.enablePolyphonicMode;
+
+        // Note: Polyphonic frequencies are set by SetPolyphonicFrequencies() called from SettingsLayer
+        ++feedbackDraft.version;
+        feedbackParameters.Write(feedbackDraft);
+    }
+
+    uint64_t AudioProcessingLayer::GetAppliedFeedbackVersion() const
+    {
+        return feedbackVersionApplied.load(std::memory_order_acquire);
+    }
+
+    bool AudioProcessingLayer::CheckBufferOverflow()
+    {
+        // Atomically check and clear the overflow flag
+        return bufferOverflowDetected.exchange(false, std::memory_order_relaxed);
+    }
+
+    void AudioProcessingLayer::SetPolyphonicFrequencies(const std::array<float, 6> &frequencies)
+    {
+        feedbackDraft.polyphonicFrequencies = frequencies;
+        ++feedbackDraft.version;
+        feedbackParameters.Write(feedbackDraft);
+    }
+
+    float AudioProcessingLayer::GetInputLevel() const
+    {
+        return inputStalled.load(std::memory_order_relaxed) ? 0.0f : currentInputLevel.load(std::memory_order_relaxed);
+    }
+
+    MonitoringStats AudioProcessingLayer::GetMonitoringStats() const
+    {
+        MonitoringStats stats;
+        stats.overruns = monitoringOverruns.load(std::memory_order_relaxed);
+        stats.droppedSamples = monitoringDroppedSamples.load(std::memory_order_relaxed);
+        stats.underruns = monitoringUnderruns.load(std::memory_order_relaxed);
+        stats.missingSamples = monitoringMissingSamples.load(std::memory_order_relaxed);
+        stats.latencyTrims = monitoringLatencyTrims.load(std::memory_order_relaxed);
+        stats.trimmedSamples = monitoringTrimmedSamples.load(std::memory_order_relaxed);
+        stats.fillLevel = callbackMemory->monitoringRing.AvailableToRead();
+        stats.targetFill = monitoringTargetFill;
+        stats.capacity = callbackMemory->monitoringRing.Capacity();
+        stats.duplex = duplexActive;
+        const size_t latencySamples = duplexActive ? config.bufferSize : stats.fillLevel;
+        stats.latencyMs = 1000.0f * static_cast<float>(latencySamples) / static_cast<float>(config.sampleRate);
+        return stats;
+    }
+
+    AnalysisStats AudioProcessingLayer::GetAnalysisStats(uint32_t channel) const
+    {
+        if (channel >= pipelines.size())
+        {
+            return {};
+        }
+        const ChannelPipeline &pipeline = *pipelines[channel];
+        const auto toMs = [this](double samples) {
+            return static_cast<float>(1000.0 * samples / static_cast<double>(config.sampleRate));
+        };
+        const uint64_t locks = pipeline.locksMeasured.load(std::memory_order_relaxed);
+        const uint64_t lockSamplesTotal = pipeline.lockSamplesTotal.load(std::memory_order_relaxed);
+        return AnalysisStats{ .frames = pipeline.framesAnalyzed.load(std::memory_order_relaxed),
+            .gatedFrames = pipeline.framesGated.load(std::memory_order_relaxed),
+            .noiseFloorDb = pipeline.noiseFloorDb.load(std::memory_order_relaxed),
+            .levelDb = pipeline.levelDb.load(std::memory_order_relaxed),
+            .gateOpen = pipeline.gateOpen.load(std::memory_order_relaxed),
+            .onsets = pipeline.onsetsDetected.load(std::memory_order_relaxed),
+            .locks = locks,
+            .lastTimeToLockMs = toMs(static_cast<double>(pipeline.lastLockSamples.load(std::memory_order_relaxed))),
+            .meanTimeToLockMs = locks > 0 ? toMs(static_cast<double>(lockSamplesTotal) / static_cast<double>(locks))
+                                          : 0.0f,
+            .decimationFactor = pipeline.decimationFactor.load(std::memory_order_relaxed),
+            .pitchTrackingGeneration = pipeline.trackerGeneration.load(std::memory_order_relaxed) };
+    }
+
+    const Audio::AnalysisPlan &AudioProcessingLayer::GetAnalysisPlan() const
+    {
+        return analysisPlan;
+    }
+
+    void AudioProcessingLayer::LogPreFilter(const Audio::PreFilterConfig &preFilter)
+    {
+        const auto state = [](bool enabled) { return enabled ? "on" : "off"; };
+        LOG_INFO("Pre-filter: DC blocker {} ({:.0f} Hz), high-pass {} ({:.0f} Hz), low-pass {} ({:.0f} Hz), "
+                 "hum notch {} ({:.0f} Hz, Q {:.1f})",
+            state(preFilter.dcBlocker),
+            preFilter.dcCutoffHz,
+            state(preFilter.highPass),
+            preFilter.highPassHz,
+            state(preFilter.lowPass),
+            preFilter.lowPassHz,
+            state(preFilter.humNotch),
+            preFilter.humFrequencyHz,
+            preFilter.humQ);
+    }
+
+    void AudioProcessingLayer::SetPreFilterConfig(const Audio::PreFilterConfig &preFilter)
+    {
+        preFilterSettings.Store(preFilter);
+        preFilterVersion.fetch_add(1, std::memory_order_release);
+        LogPreFilter(preFilter);
+    }
+
+    Audio::PreFilterConfig AudioProcessingLayer::GetPreFilterConfig() const
+    {
+        return preFilterSettings.Load();
+    }
+
+    PreFilterStats AudioProcessingLayer::GetPreFilterStats(uint32_t channel) const
+    {
+        if (channel >= pipelines.size())
+        {
+            return {};
+        }
+        const ChannelPipeline &pipeline = *pipelines[channel];
+        const Audio::PreFilterConfig preFilter = preFilterSettings.Load();
+        PreFilterStats stats;
+        for (size_t stage = 0; stage < stats.stages.size(); ++stage)
+        {
+            const PreFilterCost &cost = pipeline.preFilterCost[stage];
+            const uint64_t blocks = cost.blocks.load(std::memory_order_relaxed);
+            const auto totalNanoseconds = static_cast<double>(cost.totalNanoseconds.load(std::memory_order_relaxed));
+            stats.stages[stage] = { .enabled = preFilter.IsEnabled(static_cast<Audio::PreFilterStage>(stage)),
+                .blocks = blocks,
+                .lastMicroseconds = static_cast<float>(cost.lastNanoseconds.load(std::memory_order_relaxed)) / 1000.0f,
+                .meanMicroseconds =
+                    blocks > 0 ? static_cast<float>(totalNanoseconds / static_cast<double>(blocks) / 1000.0) : 0.0f };
+        }
+        return stats;
+    }
+
+    Audio::AnalysisPlan AudioProcessingLayer::PlanAnalysis(const PitchTrackingConfig &pitchTracking) const
+    {
+        // A window that follows the device buffer is already in stream samples: nothing to scale
+        Audio::AnalysisTiming timing{ .windowSize = config.analysisWindowSize,
+            .hopSize = config.analysisHopSize,
+            .referenceRate = config.analysisReferenceRate };
+        if (timing.windowSize == 0)
+        {
+            timing.windowSize = config.bufferSize;
+            timing.referenceRate = 0;
+        }
+        return Audio::PlanAnalysis(config.sampleRate,
+            timing,
+            config.decimation,
+            pitchTracking.minFrequency,
+            pitchTracking.maxFrequency);
+    }
+
+    std::unique_ptr<AudioProcessingLayer::PitchTracker> AudioProcessingLayer::CreatePitchTracker(
+        const PitchTrackingConfig &pitchTracking,
+        uint32_t generation) const
+    {
+        auto tracker = std::make_unique<PitchTracker>();
+        tracker->settings = pitchTracking;
+        tracker->generation = generation;
+
+        /**
+         * Low registers do not need the full sample rate: the detector runs on the window
+         * decimated to about ten times the pitch ceiling, which shrinks both the window and
+         * the lag range it searches by the decimation factor, and a short lag search on the
+         * full-rate window restores the precision lost to the coarser lag grid. The factor
+         * follows the stream rate, so the detector sees about the same window at any rate.
+         */
+        tracker->plan = PlanAnalysis(pitchTracking);
+        tracker->decimator.Configure(tracker->plan.decimationFactor);
+        tracker->decimated.resize(tracker->plan.decimatedWindowSize);
+
+        // Pre-allocate HybridPitchDetector internal buffer for the (decimated) analysis window length
+        tracker->detector = CreatePitchDetector(pitchTracking);
+        const std::vector<float> dummyBuffer(tracker->decimated.size(), 0.0f);
+        (void)tracker->detector->Detect(dummyBuffer, tracker->plan.detectionRate);
+        tracker->stabilizer = CreateStabilizer(pitchTracking);
+        return tracker;
+    }
+
+    void AudioProcessingLayer::ReclaimPitchTrackers()
+    {
+        for (auto &pipeline : pipelines)
+        {
+            pipeline->tracker.Reclaim().reset();
+        }
+    }
+
+    void AudioProcessingLayer::LogPitchTracking(const PitchTrackingConfig &pitchTracking) const
+    {
+        LOG_INFO("Pitch range: {:.1f} - {:.1f} Hz", pitchTracking.minFrequency, pitchTracking.maxFrequency);
+
+        const Audio::AnalysisPlan plan = PlanAnalysis(pitchTracking);
+        LOG_INFO("Detector lags: {} - {} samples at {:.0f} Hz over a {}-sample window",
+            plan.minLag,
+            plan.maxLag,
+            plan.detectionRate,
+            plan.decimatedWindowSize);
+        if (plan.decimationFactor > 1)
+        {
+            LOG_INFO("Decimation: x{} ahead of detection ({:.0f} Hz analysis rate, {} taps), refined at {} Hz "
+                     "(lag step {})",
+                plan.decimationFactor,
+                plan.detectionRate,
+                plan.decimationFactor * Audio::PolyphaseDecimator::kTapsPerPhase,
+                config.sampleRate,
+                plan.refineStride);
+        }
+        else
+        {
+            LOG_INFO("Decimation: disabled (detection at {} Hz)", config.sampleRate);
+        }
+
+        switch (pitchTracking.stabilizerType)
+        {
+        case StabilizerType::EMA:
+            LOG_INFO("Pitch stabilization: EMA (alpha={})", pitchTracking.emaAlpha);
+            break;
+        case StabilizerType::Median:
+            LOG_INFO("Pitch stabilization: Median Filter (window={})", pitchTracking.medianWindowSize);
+            break;
+        case StabilizerType::Hybrid:
+            LOG_INFO("Pitch stabilization: Hybrid (alpha={}, window={})",
+                pitchTracking.emaAlpha,
+                pitchTracking.medianWindowSize);
+            break;
+        case StabilizerType::None:
+        default:
+            LOG_INFO("Pitch stabilization: Disabled");
+            break;
+        }
+    }
+
+    bool AudioProcessingLayer::ProvisionBuffers(size_t deviceFrames)
+    {
+        const size_t frames = deviceFrames * Constants::kuBufferSafetyMultiplier;
+        const size_t channelCount = config.inputChannels;
+
+        // Ring capacity leaves room for the target fill plus two device buffers of jitter
+        const size_t ringCapacity =
+            MonitoringRing::CapacityFor(std::max(frames, monitoringTargetFill + 2 * deviceFrames));
+
+        // Processing buffer, one scratch block per channel, mixing scratch and ring storage, back to back
+        auto memory = std::make_unique<CallbackMemory>();
+        const size_t arenaBytes = Audio::MemoryArena::Footprint<float>(frames) * (channelCount + 2)
+                                  + Audio::MemoryArena::Footprint<float>(ringCapacity);
+        const bool reserved = memory->arena.Reserve(arenaBytes, config.memoryArena);
+        if (!reserved && callbackMemory)
+        {
+            return false; // Keep the buffers in use
+        }
+        memory->monitoringRing.Reset(memory->arena.Allocate<float>(ringCapacity));
+
+        auto input = std::make_unique<InputBuffers>();
+        input->processing = memory->arena.Allocate<float>(frames);
+        input->frames = input->processing.size();
+        for (size_t channel = 0; channel < channelCount; ++channel)
+        {
+            input->channelViews.push_back(memory->arena.Allocate<float>(frames));
+        }
+        input->monitoringRing = &memory->monitoringRing;
+
+        auto output = std::make_unique<OutputBuffers>();
+        output->scratch = memory->arena.Allocate<float>(frames);
+        output->monitoringRing = &memory->monitoringRing;
+
+        inputBuffers.Publish(std::move(input));
+        outputBuffers.Publish(std::move(output));
+        if (callbackMemory)
+        {
+            retiredCallbackMemory.push_back(std::move(callbackMemory));
+        }
+        callbackMemory = std::move(memory);
+        provisionedBufferFrames = deviceFrames;
+        return reserved;
+    }
+
+    void AudioProcessingLayer::ReprovisionBuffers()
+    {
+        inputBuffers.Reclaim().reset();
+        outputBuffers.Reclaim().reset();
+
+        // Retired memory may still be used by the input or the output callback until both have swapped.
+        // An output callback that cannot run holds none of it: it takes the pending set on its first buffer.
+        const bool outputSwapped = !outputBuffers.HasPending() || !OutputCallbackMayRun();
+        if (!retiredCallbackMemory.empty() && !inputBuffers.HasPending() && outputSwapped)
+        {
+            retiredCallbackMemory.clear();
+        }
+
+        const size_t oversized = oversizedBufferFrames.exchange(0, std::memory_order_relaxed);
+        const size_t deviceFrames = std::min<size_t>(oversized, Constants::kuMaxDeviceBufferFrames);
+        if (deviceFrames <= provisionedBufferFrames)
+        {
+            return;
+        }
+
+        const size_t previousFrames = provisionedBufferFrames;
+        if (!ProvisionBuffers(deviceFrames))
+        {
+            LOG_ERROR("Input device delivered {} frames per buffer, but larger callback buffers could not be "
+                      "reserved: {}",
+                oversized,
+                std::strerror(callbackMemory->arena.Stats().error));
+            return;
+        }
+        LOG_WARN("Input device delivered {} frames per buffer; callback buffers grown from {} to {} frames "
+                 "(monitoring ring {} frames, {} KiB arena)",
+            oversized,
+            previousFrames * Constants::kuBufferSafetyMultiplier,
+            deviceFrames * Constants::kuBufferSafetyMultiplier,
+            callbackMemory->monitoringRing.Capacity(),
+            callbackMemory->arena.Stats().reservedBytes / 1024);
+    }
+
+    bool AudioProcessingLayer::OutputCallbackMayRun() const
+    {
+        // A switch worker starts its stream without the main thread; Stop() waits for the callback in flight
+        if (deviceSwitch)
+        {
+            return true;
+        }
+        const std::unique_ptr<GuitarIO::AudioDevice> &device = duplexActive ? inputDevice : outputDevice;
+        return device && device->IsRunning();
+    }
+
+    void AudioProcessingLayer::LogMemoryFootprint() const
+    {
+        const MemoryFootprint footprint = GetMemoryFootprint();
+        LOG_INFO("Real-time memory: {} KiB in two arenas (callback buffers {} KiB, analysis queues {} KiB), "
+                 "{}-byte aligned and pre-faulted",
+            footprint.TotalBytes() / 1024,
+            footprint.callbackBuffers.reservedBytes / 1024,
+            footprint.analysisQueues.reservedBytes / 1024,
+            Audio::MemoryArena::kAlignment);
+
+        for (const Audio::MemoryArenaStats *arena : { &footprint.callbackBuffers, &footprint.analysisQueues })
+        {
+            const bool lockFailed = config.memoryArena.lock && arena->locked != Audio::SchedulingOutcome::Granted;
+            const bool hugePagesFailed = config.memoryArena.hugePages
+                                         && arena->hugePages != Audio::SchedulingOutcome::Granted
+                                         && arena->hugePages != Audio::SchedulingOutcome::FellBack;
+            if (lockFailed || hugePagesFailed)
+            {
+                LOG_WARN("Real-time memory arena of {} KiB: mlock {}, huge pages {} ({})",
+                    arena->reservedBytes / 1024,
+                    Audio::ToString(arena->locked),
+                    Audio::ToString(arena->hugePages),
+                    std::strerror(arena->error));
+                return;
+            }
+        }
+        LOG_INFO("Real-time memory locking: {}, huge pages: {}",
+            Audio::ToString(footprint.callbackBuffers.locked),
+            Audio::ToString(footprint.callbackBuffers.hugePages));
+    }
+
+    MemoryFootprint AudioProcessingLayer::GetMemoryFootprint() const
+    {
+        MemoryFootprint footprint{ .callbackBuffers = callbackMemory->arena.Stats(),
+            .analysisQueues = analysisMemory.Stats() };
+        for (const auto &retired : retiredCallbackMemory)
+        {
+            footprint.retiredBytes += retired->arena.Stats().reservedBytes;
+        }
+        return footprint;
+    }
+
+    WatchdogReport AudioProcessingLayer::GetWatchdogReport() const
+    {
+        return WatchdogReport{ .input = inputWatchdog.Health(), .output = outputWatchdog.Health() };
+    }
+
+    void AudioProcessingLayer::SetPitchTrackingConfig(const PitchTrackingConfig &pitchTracking)
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        // Free what the threads swapped out since the last call, so each has room to take the new tracker
+        ReclaimPitchTrackers();
+
+        this->pitchTracking = pitchTracking;
+        ++pitchTrackingGeneration;
+        for (auto &pipeline : pipelines)
         {
-            deviceNames.push_back(device.name);
+            // A tracker published earlier and not yet picked up is dropped here (its thread never saw it)
+            pipeline->tracker.Publish(CreatePitchTracker(pitchTracking, pitchTrackingGeneration));
         }
-        return deviceNames;
+
+        LOG_INFO("Pitch tracking reconfigured (generation {}, built in {:.1f} ms)",
+            pitchTrackingGeneration,
+            MillisecondsSince(start));
+        LogPitchTracking(pitchTracking);
     }
 
-    std::vector<GuitarIO::AudioDeviceInfo> AudioProcessingLayer::GetAvailableOutputDeviceInfo() const
+    PitchTrackingConfig AudioProcessingLayer::GetPitchTrackingConfig() const
     {
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        return manager.EnumerateOutputDevices();
+        return pitchTracking;
     }
 
-    uint32_t AudioProcessingLayer::GetCurrentOutputDeviceId() const
+    float AudioProcessingLayer::GetInputRmsLevel() const
     {
-        return currentOutputDeviceId;
+        return inputStalled.load(std::memory_order_relaxed) ? 0.0f : currentInputRms.load(std::memory_order_relaxed);
     }
 
-    bool AudioProcessingLayer::SwitchInputDevice(uint32_t deviceId)
+    int AudioProcessingLayer::InputCallback(std::span<const float> inputBuffer,
+        [[maybe_unused]] std::span<float> outputBuffer,
+        void *userData)
     {
-        LOG_INFO("Switching to input device ID: {}", deviceId);
-
-        if (deviceId == currentInputDeviceId && inputDevice->IsRunning())
+        const Audio::RealtimeScope realtime("input callback");
+        auto *stream = static_cast<StreamContext *>(userData);
+        if (!stream || !stream->layer || inputBuffer.empty())
         {
-            LOG_INFO("Input device {} is already active", deviceId);
-            return true;
+            return 1; // Stop stream
         }
+        auto *layer = stream->layer;
 
-        if (inputDevice->IsRunning())
+        // A replacement still warming up, or a stream that already handed over, must not touch
+        // the single-producer state (analysis queue, monitoring ring)
+        if (!layer->inputHandoff.IsActive(stream->slot))
         {
-            LOG_INFO("Stopping current input stream...");
-            if (!inputDevice->Stop())
-            {
-                LOG_ERROR("Failed to stop input stream: {}", inputDevice->GetLastError());
-                return false;
-            }
+            return 0;
+        }
+        if (!stream->scheduled)
+        {
+            layer->ScheduleAudioThread(*stream, layer->inputDiagnostics, Audio::DiagnosticSource::InputCallback);
         }
 
-        if (inputDevice->IsOpen())
+        // Hand over at the end of this buffer if a replacement stream is running
+        const uint32_t successor = layer->inputHandoff.Successor(stream->slot);
+        HandoffFade fade = HandoffFade::None;
+        if (successor != Audio::StreamHandoff::kNoSlot)
         {
-            LOG_INFO("Closing current input device...");
-            inputDevice->Close();
+            fade = HandoffFade::Out;
         }
+        else if (stream->fadeIn)
+        {
+            fade = HandoffFade::In;
+        }
+        stream->fadeIn = false;
 
-        GuitarIO::AudioStreamConfig inputConfig{
-            .sampleRate = config.sampleRate, .bufferSize = config.bufferSize, .inputChannels = 1, .outputChannels = 0
-        };
+        (void)layer->ConditionInput(inputBuffer, stream->inputChannels, true, fade);
 
-        LOG_INFO("Opening new input device...");
-        if (!inputDevice->Open(deviceId, inputConfig, InputCallback, this))
-        {
-            LOG_ERROR("Failed to open input device: {}", inputDevice->GetLastError());
+        layer->inputHandoff.HandOff(successor);
+        return 0; // Continue stream
+    }
 
-            // Fallback to default
-            LOG_WARN("Attempting to reopen default input device...");
-            if (inputDevice->OpenDefault(inputConfig, InputCallback, this))
-            {
-                inputDevice->Start();
-                currentInputDeviceId = static_cast<uint32_t>(-1);
-                LOG_INFO("Fallback to default input device successful");
-            }
-            return false;
+    int AudioProcessingLayer::DuplexCallback(std::span<const float> inputBuffer,
+        std::span<float> outputBuffer,
+        void *userData)
+    {
+        const Audio::RealtimeScope realtime("duplex callback");
+        auto *stream = static_cast<StreamContext *>(userData);
+        if (!stream || !stream->layer || inputBuffer.empty() || outputBuffer.empty())
+        {
+            return 1; // Stop stream
         }
-
-        LOG_INFO("Starting new input stream...");
-        if (!inputDevice->Start())
+        auto *layer = stream->layer;
+        if (!stream->scheduled)
         {
-            LOG_ERROR("Failed to start input stream: {}", inputDevice->GetLastError());
-            inputDevice->Close();
-
-            // Fallback to default
-            LOG_WARN("Attempting to reopen default input device...");
-            if (inputDevice->OpenDefault(inputConfig, InputCallback, this))
-            {
-                inputDevice->Start();
-                currentInputDeviceId = static_cast<uint32_t>(-1);
-                LOG_INFO("Fallback to default input device successful");
-            }
-            return false;
+            layer->ScheduleAudioThread(*stream, layer->inputDiagnostics, Audio::DiagnosticSource::InputCallback);
         }
 
-        currentInputDeviceId = deviceId;
-
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        auto deviceInfo = manager.GetDeviceInfo(deviceId);
-        LOG_INFO("Successfully switched to input device: [{}] {}", deviceId, deviceInfo.name);
+        // Monitoring reads the freshly conditioned input directly: no ring, no second clock
+        const size_t conditioned = layer->ConditionInput(inputBuffer, stream->inputChannels, false);
+        layer->MixFeedback(outputBuffer,
+            stream->outputChannels,
+            std::span<const float>(layer->inputBuffers.Current()->processing.data(), conditioned));
 
-        return true;
+        return 0; // Continue stream
     }
 
-    bool AudioProcessingLayer::SwitchOutputDevice(uint32_t deviceId)
+    size_t AudioProcessingLayer::ConditionInput(std::span<const float> inputBuffer,
+        uint32_t inputChannels,
+        bool writeMonitoringRing,
+        HandoffFade fade)
     {
-        LOG_INFO("Switching to output device ID: {}", deviceId);
+        // Proof of life for the input watchdog (see WatchStreams())
+        inputHeartbeats.fetch_add(1, std::memory_order_relaxed);
 
-        if (deviceId == currentOutputDeviceId && outputDevice->IsRunning())
-        {
-            LOG_INFO("Output device {} is already active", deviceId);
-            return true;
-        }
+        // Apply input gain and copy to processing buffer
+        float gain = inputGain.load(std::memory_order_relaxed);
 
-        if (outputDevice->IsRunning())
+        // The stream never captures more channels than there are pipelines (see CaptureChannels())
+        const size_t channels = std::clamp<size_t>(inputChannels, 1, pipelines.size());
+        const size_t frames = inputBuffer.size() / channels;
+        const uint32_t monitored = MonitoredChannel(static_cast<uint32_t>(channels));
+        ChannelPipeline &primary = *pipelines[monitored];
+
+        // Buffers grown by the main thread are swapped in here, at the start of a buffer
+        InputBuffers &buffers = *inputBuffers.Acquire();
+        std::span<float> processingBuffer(buffers.processing);
+        MonitoringRing &ring = *buffers.monitoringRing;
+
+        // Check if buffer is sufficient
+        if (buffers.frames < frames)
         {
-            LOG_INFO("Stopping current output stream...");
-            if (!outputDevice->Stop())
+            // CRITICAL: Cannot resize in audio callback!
+            // Set flag for main thread to log warning and grow the buffers (ReprovisionBuffers())
+            bufferOverflowDetected.store(true, std::memory_order_relaxed);
+            if (frames > oversizedBufferFrames.load(std::memory_order_relaxed))
             {
-                LOG_ERROR("Failed to stop output stream: {}", outputDevice->GetLastError());
-                return false;
+                oversizedBufferFrames.store(frames, std::memory_order_relaxed);
             }
+            (void)inputDiagnostics.Push({ .code = Audio::DiagnosticCode::InputBufferOverflow,
+                .source = Audio::DiagnosticSource::InputCallback,
+                .sampleTime = primary.samplesQueued.load(std::memory_order_relaxed),
+                .value0 = frames,
+                .value1 = buffers.frames });
+            // Process only what fits in the pre-allocated buffer
         }
 
-        if (outputDevice->IsOpen())
+        size_t samplesToProcess = std::min(frames, buffers.frames);
+        std::span<const float> rawBuffer = inputBuffer.first(samplesToProcess);
+        if (channels > 1)
         {
-            LOG_INFO("Closing current output device...");
-            outputDevice->Close();
+            // Split into per-channel scratch blocks; each channel is then conditioned on its own
+            (void)Audio::DeinterleaveBlock(inputBuffer.first(samplesToProcess * channels),
+                std::span<const std::span<float>>(buffers.channelViews).first(channels));
+            rawBuffer = buffers.channelViews[monitored].first(samplesToProcess);
         }
+        std::span<const float> gainedBuffer(processingBuffer.data(), samplesToProcess);
 
-        auto &manager = GuitarIO::AudioDeviceManager::Get();
-        auto deviceInfo = manager.GetDeviceInfo(deviceId);
-
-        // Prefer stereo if available
-        uint32_t channels = (deviceInfo.maxOutputChannels >= 2) ? 2 : 1;
-        this->outputChannels = channels;
-
-        GuitarIO::AudioStreamConfig outputConfig{ .sampleRate = config.sampleRate,
-            .bufferSize = config.bufferSize,
-            .inputChannels = 0,
-            .outputChannels = channels };
-
-        LOG_INFO("Opening new output device with {} channels...", channels);
-        if (!outputDevice->Open(deviceId, outputConfig, OutputCallback, this))
+        /**
+         * Gain, monitoring copy, peak and RMS are computed in a single pass by the SIMD
+         * conditioning kernel. When monitoring is enabled the kernel writes straight into
+         * the free space of the monitoring ring (at most two spans, split at the wrap point).
+         */
+        Audio::ConditioningStats stats;
+        size_t conditioned = 0;
+        if (writeMonitoringRing && inputMonitoringEnabled.load(std::memory_order_relaxed))
         {
-            LOG_ERROR("Failed to open output device: {}", outputDevice->GetLastError());
+            for (std::span<float> region : ring.PrepareWrite(samplesToProcess))
+            {
+                stats.Merge(Audio::ConditionBlock(rawBuffer.subspan(conditioned, region.size()),
+                    gain,
+                    processingBuffer.subspan(conditioned, region.size()),
+                    region));
 
-            // Fallback to default
-            LOG_WARN("Attempting to reopen default output device...");
-            // Reset to mono for fallback if needed, or query default device info
-            // For simplicity, try mono fallback first
-            outputConfig.outputChannels = 1;
-            this->outputChannels = 1;
+                if (fade != HandoffFade::None)
+                {
+                    // Fade the monitored signal across a device handoff; analysis keeps the unfaded samples
+                    const float total = static_cast<float>(samplesToProcess);
+                    const float rampStart = static_cast<float>(conditioned) / total;
+                    const float rampEnd = static_cast<float>(conditioned + region.size()) / total;
+                    if (fade == HandoffFade::In)
+                    {
+                        Audio::ApplyGainRamp(region, 1, rampStart, rampEnd);
+                    }
+                    else
+                    {
+                        Audio::ApplyGainRamp(region, 1, 1.0f - rampStart, 1.0f - rampEnd);
+                    }
+                }
+                conditioned += region.size();
+            }
+            ring.CommitWrite(conditioned);
 
-            if (outputDevice->OpenDefault(outputConfig, OutputCallback, this))
+            if (conditioned < samplesToProcess)
             {
-                outputDevice->Start();
-                currentOutputDeviceId = static_cast<uint32_t>(-1);
-                LOG_INFO("Fallback to default output device successful (Mono)");
+                // Ring full: the output side has stalled or runs slower than the input
+                monitoringOverruns.fetch_add(1, std::memory_order_relaxed);
+                monitoringDroppedSamples.fetch_add(samplesToProcess - conditioned, std::memory_order_relaxed);
+                (void)inputDiagnostics.Push({ .code = Audio::DiagnosticCode::MonitoringOverrun,
+                    .source = Audio::DiagnosticSource::InputCallback,
+                    .sampleTime = primary.samplesQueued.load(std::memory_order_relaxed),
+                    .value0 = samplesToProcess - conditioned,
+                    .value1 = ring.Capacity() });
             }
-            return false;
         }
 
-        LOG_INFO("Starting new output stream...");
-        if (!outputDevice->Start())
+        if (conditioned < samplesToProcess)
         {
-            LOG_ERROR("Failed to start output stream: {}", outputDevice->GetLastError());
-            outputDevice->Close();
-
-            // Fallback to default
-            LOG_WARN("Attempting to reopen default output device...");
-            outputConfig.outputChannels = 1;
-            this->outputChannels = 1;
+            stats.Merge(Audio::ConditionBlock(rawBuffer.subspan(conditioned),
+                gain,
+                processingBuffer.subspan(conditioned, samplesToProcess - conditioned)));
+        }
 
-            if (outputDevice->OpenDefault(outputConfig, OutputCallback, this))
+        // Hand the gained signals to the analysis threads (pitch detection never runs here)
+        QueueForAnalysis(primary, gainedBuffer);
+        for (size_t channel = 0; channel < channels; ++channel)
+        {
+            if (channel != monitored)
             {
-                outputDevice->Start();
-                currentOutputDeviceId = static_cast<uint32_t>(-1);
-                LOG_INFO("Fallback to default output device successful (Mono)");
+                // Secondary channels are neither metered nor monitored: gain in place and queue
+                std::span<float> samples = buffers.channelViews[channel].first(samplesToProcess);
+                (void)Audio::ConditionBlock(samples, gain, samples);
+                QueueForAnalysis(*pipelines[channel], samples);
             }
-            return false;
         }
 
-        currentOutputDeviceId = deviceId;
-        LOG_INFO("Successfully switched to output device: [{}] {}", deviceId, deviceInfo.name);
+        currentInputLevel.store(stats.peak, std::memory_order_relaxed);
+        currentInputRms.store(stats.Rms(), std::memory_order_relaxed);
 
-        return true;
+        return samplesToProcess;
     }
 
-    void AudioProcessingLayer::UpdateAudioFeedback(const AudioConfig &audioConfig)
+    void AudioProcessingLayer::QueueForAnalysis(ChannelPipeline &pipeline, std::span<const float> samples)
     {
-        beepEnabled.store(audioConfig.enableBeep, std::memory_order_relaxed);
-        beepVolume.store(audioConfig.beepVolume, std::memory_order_relaxed);
-        referenceEnabled.store(audioConfig.enableReference, std::memory_order_relaxed);
-        referenceVolume.store(audioConfig.referenceVolume, std::memory_order_relaxed);
-        referenceFrequency.store(audioConfig.referenceFrequency, std::memory_order_relaxed);
-        inputMonitoringEnabled.store(audioConfig.enableInputMonitoring, std::memory_order_relaxed);
-        monitoringVolume.store(audioConfig.monitoringVolume, std::memory_order_relaxed);
-        inputGain.store(audioConfig.inputGain, std::memory_order_relaxed);
-
-        // Advanced modes
-        droneEnabled.store(audioConfig.enableDroneMode, std::memory_order_relaxed);
-        polyphonicEnabled.store(audioConfig.enablePolyphonicMode, std::memory_order_relaxed);
-
-        // Update generator frequencies
-        beepGenerator.SetFrequency(880.0); // A5 for beep
-        referenceGenerator.SetFrequency(static_cast<double>(audioConfig.referenceFrequency));
-
-        // Note: Polyphonic frequencies are set by SetPolyphonicFrequencies() called from SettingsLayer
+        const size_t queued = pipeline.queue.Write(samples);
+        if (queued < samples.size())
+        {
+            (void)inputDiagnostics.Push({ .code = Audio::DiagnosticCode::AnalysisQueueOverrun,
+                .source = Audio::DiagnosticSource::InputCallback,
+                .sampleTime = pipeline.samplesQueued.load(std::memory_order_relaxed),
+                .value0 = samples.size() - queued,
+                .value1 = pipeline.queue.Capacity() });
+        }
+        pipeline.samplesQueued.fetch_add(queued, std::memory_order_release);
+        pipeline.wakeups.fetch_add(1, std::memory_order_release);
+        pipeline.wakeups.notify_one();
     }
 
-    bool AudioProcessingLayer::CheckBufferOverflow()
+    void AudioProcessingLayer::ScheduleAudioThread(StreamContext &stream,
+        Audio::DiagnosticQueue &diagnostics,
+        Audio::DiagnosticSource source)
     {
-        // Atomically check and clear the overflow flag
-        return bufferOverflowDetected.exchange(false, std::memory_order_relaxed);
+        stream.scheduled = true;
+        if (!config.audioThreadScheduling.IsRequested())
+        {
+            return;
+        }
+
+        const auto result = Audio::ApplyThreadScheduling(config.audioThreadScheduling);
+        (void)diagnostics.Push({ .code = Audio::DiagnosticCode::ThreadScheduling,
+            .source = source,
+            .sampleTime = 0,
+            .value0 = result.Pack(),
+            .value1 = static_cast<uint64_t>(result.error) });
     }
 
-    void AudioProcessingLayer::SetPolyphonicFrequencies(const std::array<float, 6> &frequencies)
+    uint32_t AudioProcessingLayer::MonitoredChannel(uint32_t capturedChannels) const
     {
-        polyphonicGenerator.SetVoiceFrequencies(frequencies);
-        polyphonicGenerator.SetGlobalVolume(referenceVolume.load(std::memory_order_relaxed));
+        // A stream with fewer channels than the primary one (device limit, mono fallback) is tuned on channel 0
+        return config.primaryChannel < capturedChannels ? config.primaryChannel : 0;
     }
 
-    float AudioProcessingLayer::GetInputLevel() const
+    uint32_t AudioProcessingLayer::CaptureChannels(const GuitarIO::AudioDeviceInfo &deviceInfo) const
     {
-        return currentInputLevel.load(std::memory_order_relaxed);
+        // No channel count reported (unknown device, headless CI): request the configured count and let Open() decide
+        if (deviceInfo.maxInputChannels == 0)
+        {
+            return config.inputChannels;
+        }
+        return std::min(config.inputChannels, deviceInfo.maxInputChannels);
     }
 
-    int AudioProcessingLayer::InputCallback(std::span<const float> inputBuffer,
-        [[maybe_unused]] std::span<float> outputBuffer,
+    int AudioProcessingLayer::OutputCallback([[maybe_unused]] std::span<const float> inputBuffer,
+        std::span<float> outputBuffer,
         void *userData)
     {
-        auto *layer = static_cast<AudioProcessingLayer *>(userData);
-        if (!layer || inputBuffer.empty())
+        const Audio::RealtimeScope realtime("output callback");
+        auto *stream = static_cast<StreamContext *>(userData);
+        if (!stream || !stream->layer || outputBuffer.empty())
         {
             return 1; // Stop stream
         }
+        auto *layer = stream->layer;
 
-        // Apply input gain and copy to processing buffer
-        float gain = layer->inputGain.load(std::memory_order_relaxed);
-
-        // Check if buffer is sufficient
-        if (layer->processingBuffer.size() < inputBuffer.size())
+        // Only the owning stream reads the monitoring ring and advances the generators; the other one plays silence
+        if (!layer->outputHandoff.IsActive(stream->slot))
         {
-            // CRITICAL: Cannot resize in audio callback!
-            // Set flag for main thread to log warning and handle error
-            layer->bufferOverflowDetected.store(true, std::memory_order_relaxed);
-            // Process only what fits in the pre-allocated buffer
+            GuitarIO::AudioMixer::Clear(outputBuffer);
+            return 0;
+        }
+        if (!stream->scheduled)
+        {
+            layer->ScheduleAudioThread(*stream, layer->outputDiagnostics, Audio::DiagnosticSource::OutputCallback);
         }
 
-        size_t samplesToProcess = std::min(inputBuffer.size(), layer->processingBuffer.size());
+        // Hand over at the end of this buffer if a replacement stream is running
+        const uint32_t successor = layer->outputHandoff.Successor(stream->slot);
+
+        // Mix feedback audio
+        layer->MixFeedback(outputBuffer, stream->outputChannels);
 
-        for (size_t i = 0; i < samplesToProcess; ++i)
+        // Fade out on the old device and in on the new one so the swap does not click
+        if (successor != Audio::StreamHandoff::kNoSlot)
+        {
+            Audio::ApplyGainRamp(outputBuffer, stream->outputChannels, 1.0f, 0.0f);
+        }
+        else if (stream->fadeIn)
         {
-            layer->processingBuffer[i] = inputBuffer[i] * gain;
+            Audio::ApplyGainRamp(outputBuffer, stream->outputChannels, 0.0f, 1.0f);
         }
+        stream->fadeIn = false;
 
-        std::span<const float> gainedBuffer(layer->processingBuffer.data(), samplesToProcess);
+        layer->outputHandoff.HandOff(successor);
+        return 0; // Continue stream
+    }
 
-        // Write to ring buffer for input monitoring (with gain applied)
-        if (layer->inputMonitoringEnabled.load(std::memory_order_relaxed))
+    void AudioProcessingLayer::AnalysisThreadMain(ChannelPipeline &pipeline, std::stop_token stopToken)
+    {
+        if (config.analysisThreadScheduling.IsRequested())
         {
-            size_t writePos = layer->monitoringWritePos.load(std::memory_order_relaxed);
-            size_t bufferSize = layer->monitoringRingBuffer.size();
+            const auto result = Audio::ApplyThreadScheduling(config.analysisThreadScheduling);
+            (void)pipeline.diagnostics.Push({ .code = Audio::DiagnosticCode::ThreadScheduling,
+                .source = Audio::DiagnosticSource::AnalysisThread,
+                .sampleTime = 0,
+                .value0 = result.Pack(),
+                .value1 = static_cast<uint64_t>(result.error) });
+        }
+
+        const size_t hopSize = pipeline.window.HopSize();
+        uint32_t observedWakeups = pipeline.wakeups.load(std::memory_order_acquire);
 
-            for (const float sample : gainedBuffer)
+        while (!stopToken.stop_requested())
+        {
+            while (pipeline.queue.AvailableToRead() >= hopSize)
             {
-                layer->monitoringRingBuffer[writePos] = sample;
-                writePos = (writePos + 1) % bufferSize;
+                // A tracker published by SetPitchTrackingConfig() takes over at a hop boundary (pointer swap only)
+                PitchTracker &tracker = *pipeline.tracker.Acquire();
+                if (tracker.generation != pipeline.trackerGeneration.load(std::memory_order_relaxed))
+                {
+                    pipeline.trackerGeneration.store(tracker.generation, std::memory_order_relaxed);
+                    pipeline.decimationFactor.store(tracker.decimator.Factor(), std::memory_order_relaxed);
+                }
+
+                const std::span<float> hop = pipeline.window.AdvanceHop();
+                (void)pipeline.queue.Read(hop);
+                PreFilterHop(pipeline, hop);
+
+                // The gate sees every hop so the noise floor calibrates while the window fills
+                const bool gateOpen = pipeline.gate.Process(hop);
+                pipeline.noiseFloorDb.store(pipeline.gate.GetNoiseFloorDb(), std::memory_order_relaxed);
+                pipeline.levelDb.store(pipeline.gate.GetLevelDb(), std::memory_order_relaxed);
+                pipeline.gateOpen.store(gateOpen, std::memory_order_relaxed);
+
+                // A pluck restarts the stabilizer and the time-to-lock clock; the attack itself is not analyzed
+                const auto onsetOffset = pipeline.onsets.Process(hop, pipeline.gate.GetLevelDb(), gateOpen);
+                if (onsetOffset.has_value())
+                {
+                    const uint64_t onsetSampleTime = pipeline.window.SamplesConsumed() - hop.size() + *onsetOffset;
+                    pipeline.onsetsDetected.fetch_add(1, std::memory_order_relaxed);
+                    pipeline.lockTimer.Start(onsetSampleTime);
+                    if (config.onsetDetector.reseedOnOnset)
+                    {
+                        if (tracker.stabilizer)
+                        {
+                            tracker.stabilizer->Reset();
+                        }
+                        pipeline.attackEndSampleTime = onsetSampleTime
+                                                       + static_cast<uint64_t>(config.onsetDetector.attackSeconds
+                                                                               * static_cast<float>(config.sampleRate));
+                    }
+                }
+
+                // Wait for a full window of real input before the first detection
+                if (pipeline.window.IsFull())
+                {
+                    ProcessAudio(pipeline, pipeline.window.View(), gateOpen);
+                }
+                pipeline.samplesAnalyzed.fetch_add(hopSize, std::memory_order_release);
             }
 
-            layer->monitoringWritePos.store(writePos, std::memory_order_release);
+            // Sleep until InputCallback queues more samples (or the destructor wakes us to stop)
+            pipeline.wakeups.wait(observedWakeups, std::memory_order_acquire);
+            observedWakeups = pipeline.wakeups.load(std::memory_order_acquire);
         }
+    }
 
-        // Process audio (pitch detection) with gained signal
-        layer->ProcessAudio(gainedBuffer);
+    void AudioProcessingLayer::PreFilterHop(ChannelPipeline &pipeline, std::span<float> hop)
+    {
+        // Settings changed by SetPreFilterConfig() take effect at a hop boundary (coefficients only, no allocation)
+        const uint32_t version = preFilterVersion.load(std::memory_order_acquire);
+        if (version != pipeline.preFilterVersion)
+        {
+            pipeline.preFilter.Configure(preFilterSettings.Load(), config.sampleRate);
+            pipeline.preFilterVersion = version;
+        }
 
-        // Calculate peak level for metering
-        float maxVal = 0.0f;
-        for (float sample : gainedBuffer)
+        pipeline.preFilter.Process(hop);
+        for (size_t stage = 0; stage < Audio::PreFilterChain::kStageCount; ++stage)
         {
-            float absVal = std::abs(sample);
-            if (absVal > maxVal)
+            if (!pipeline.preFilter.GetConfig().IsEnabled(static_cast<Audio::PreFilterStage>(stage)))
             {
-                maxVal = absVal;
+                continue;
             }
+            const uint64_t nanoseconds =
+                pipeline.preFilter.GetLastStageNanoseconds(static_cast<Audio::PreFilterStage>(stage));
+            PreFilterCost &cost = pipeline.preFilterCost[stage];
+            cost.totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+            cost.lastNanoseconds.store(nanoseconds, std::memory_order_relaxed);
+            cost.blocks.fetch_add(1, std::memory_order_relaxed);
         }
-        layer->currentInputLevel.store(maxVal, std::memory_order_relaxed);
-
-        return 0; // Continue stream
     }
 
-    int AudioProcessingLayer::OutputCallback([[maybe_unused]] std::span<const float> inputBuffer,
-        std::span<float> outputBuffer,
-        void *userData)
+    void AudioProcessingLayer::ProcessAudio(ChannelPipeline &pipeline,
+        std::span<const float> inputBuffer,
+        bool gateOpen)
     {
-        auto *layer = static_cast<AudioProcessingLayer *>(userData);
-        if (!layer || outputBuffer.empty())
+        pipeline.framesAnalyzed.fetch_add(1, std::memory_order_relaxed);
+        PitchTracker &tracker = *pipeline.tracker.Current();
+
+        PitchFrame frame;
+        frame.channel = pipeline.channel;
+        frame.sequence = ++pipeline.frameSequence;
+        frame.streamSampleTime = pipeline.window.SamplesConsumed();
+
+        // After an onset, analyze only what follows the attack until the window no longer reaches back past it
+        std::span<const float> analysisSpan = inputBuffer;
+        const uint64_t windowEnd = frame.streamSampleTime;
+        if (pipeline.attackEndSampleTime + inputBuffer.size() > windowEnd)
         {
-            return 1; // Stop stream
+            const uint64_t postAttack =
+                windowEnd > pipeline.attackEndSampleTime ? windowEnd - pipeline.attackEndSampleTime : 0;
+            analysisSpan = postAttack >= tracker.plan.minDetectionSamples
+                               ? inputBuffer.last(static_cast<size_t>(postAttack))
+                               : std::span<const float>();
         }
 
-        // Mix feedback audio
-        layer->MixFeedback(outputBuffer);
-
-        return 0; // Continue stream
-    }
-
-    void AudioProcessingLayer::ProcessAudio(std::span<const float> inputBuffer)
-    {
-        // Detect pitch using YIN algorithm
-        auto result = pitchDetector->Detect(inputBuffer, static_cast<float>(config.sampleRate));
+        // Silence and the noise floor never reach the detector; the frame is published as undetected
+        std::optional<GuitarDSP::PitchResult> result;
+        if (!gateOpen)
+        {
+            pipeline.framesGated.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (!analysisSpan.empty())
+        {
+            result = DetectPitch(tracker, inputBuffer, analysisSpan.size());
+        }
 
         if (result.has_value())
         {
             GuitarDSP::PitchResult stabilized = result.value();
 
             // Apply stabilization if enabled
-            if (pitchStabilizer)
+            if (tracker.stabilizer)
             {
-                pitchStabilizer->Update(result.value());
-                stabilized = pitchStabilizer->GetStabilized();
+                tracker.stabilizer->Update(result.value());
+                stabilized = tracker.stabilizer->GetStabilized();
             }
 
-            latestFrequency.store(stabilized.frequency, std::memory_order_relaxed);
-            latestConfidence.store(stabilized.confidence, std::memory_order_relaxed);
-            pitchDetected.store(true, std::memory_order_relaxed);
+            frame.frequency = stabilized.frequency;
+            frame.confidence = stabilized.confidence;
+            frame.detected = true;
         }
-        else
+
+        // Publish all fields at once so readers never pair values from different windows
+        pipeline.latest.Store(frame);
+        pipeline.history.Push(frame);
+
+        const auto lockSamples = pipeline.lockTimer.Update(frame.detected, frame.frequency, frame.streamSampleTime);
+        if (lockSamples.has_value())
+        {
+            pipeline.lockSamplesTotal.fetch_add(*lockSamples, std::memory_order_relaxed);
+            pipeline.lastLockSamples.store(*lockSamples, std::memory_order_relaxed);
+            pipeline.locksMeasured.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    std::optional<GuitarDSP::PitchResult> AudioProcessingLayer::DetectPitch(PitchTracker &tracker,
+        std::span<const float> window,
+        size_t analysisSamples)
+    {
+        const auto sampleRate = static_cast<float>(config.sampleRate);
+        const uint32_t factor = tracker.decimator.Factor();
+        if (factor <= 1)
+        {
+            return tracker.detector->Detect(window.last(analysisSamples), sampleRate);
+        }
+
+        // Only fully filtered samples reach the detector, so the oldest taps of the window are history only
+        const size_t history = tracker.decimator.TapCount() - 1;
+        const size_t filtered = std::min(analysisSamples, window.size() > history ? window.size() - history : 0);
+        const size_t used = filtered - filtered % factor;
+        const size_t decimated = tracker.decimator.Process(window, window.size() - used, tracker.decimated);
+
+        auto result = tracker.detector->Detect(std::span<const float>(tracker.decimated).first(decimated),
+            tracker.plan.detectionRate);
+        if (result.has_value())
+        {
+            // The coarse estimate is good to about one decimated sample of lag
+            result->frequency = Audio::RefineFrequency(window.last(used),
+                sampleRate,
+                result->frequency,
+                tracker.plan.refineRadius,
+                tracker.plan.refineStride);
+        }
+        return result;
+    }
+
+    void AudioProcessingLayer::ApplyFeedbackParameters(const FeedbackParameters &feedback, bool voicesChanged)
+    {
+        beepGenerator.SetFrequency(880.0); // A5 for beep
+        beepGenerator.SetAmplitude(static_cast<double>(feedback.beepVolume));
+        referenceGenerator.SetFrequency(static_cast<double>(feedback.referenceFrequency));
+        referenceGenerator.SetAmplitude(static_cast<double>(feedback.referenceVolume));
+        if (voicesChanged)
         {
-            pitchDetected.store(false, std::memory_order_relaxed);
+            polyphonicGenerator.SetVoiceFrequencies(feedback.polyphonicFrequencies);
         }
+        polyphonicGenerator.SetGlobalVolume(feedback.referenceVolume);
+        feedbackVersionApplied.store(feedback.version, std::memory_order_release);
     }
 
-    void AudioProcessingLayer::MixFeedback(std::span<float> outputBuffer)
+    void AudioProcessingLayer::MixFeedback(std::span<float> outputBuffer,
+        uint32_t channels,
+        std::optional<std::span<const float>> directMonitor)
     {
+        // Proof of life for the output watchdog (see WatchStreams())
+        outputHeartbeats.fetch_add(1, std::memory_order_relaxed);
+
         if (outputBuffer.empty())
         {
             return;
         }
 
         // Validate buffer alignment with channel count
-        if (outputBuffer.size() % outputChannels != 0)
+        if (outputBuffer.size() % channels != 0)
         {
-            LOG_ERROR("Output buffer size {} not aligned with {} channels", outputBuffer.size(), outputChannels);
+            // Never log from the real-time thread; OnUpdate reports this
+            (void)outputDiagnostics.Push({ .code = Audio::DiagnosticCode::OutputChannelMismatch,
+                .source = Audio::DiagnosticSource::OutputCallback,
+                .sampleTime = outputFramesRendered,
+                .value0 = outputBuffer.size(),
+                .value1 = channels });
             return;
         }
 
         // Clear output buffer
         GuitarIO::AudioMixer::Clear(outputBuffer);
 
-        size_t frames = outputBuffer.size() / outputChannels;
+        size_t frames = outputBuffer.size() / channels;
+
+        // Buffers grown by the main thread are swapped in here, at the start of a buffer
+        OutputBuffers &buffers = *outputBuffers.Acquire();
+        std::span<float> outputScratchBuffer = buffers.scratch;
+        MonitoringRing &ring = *buffers.monitoringRing;
 
         // Safety check for scratch buffer
         if (frames > outputScratchBuffer.size())
@@ -653,46 +2494,78 @@ namespace PrecisionTuner::Layers
             frames = outputScratchBuffer.size();
         }
 
-        // Mix input monitoring from ring buffer
-        if (inputMonitoringEnabled.load(std::memory_order_relaxed))
+        // Feedback changes apply from the start of a buffer, all at once (chord voices only when they moved)
+        const std::array<float, 6> voices = feedbackParameters.Read().polyphonicFrequencies;
+        if (feedbackParameters.Update())
+        {
+            const FeedbackParameters &next = feedbackParameters.Read();
+            ApplyFeedbackParameters(next, next.polyphonicFrequencies != voices);
+        }
+        const FeedbackParameters &feedback = feedbackParameters.Read();
+
+        // Mix input monitoring: straight from this callback's input in duplex mode, otherwise from the ring
+        if (feedback.monitoringEnabled)
         {
-            size_t readPos = monitoringReadPos.load(std::memory_order_acquire);
-            size_t writePos = monitoringWritePos.load(std::memory_order_relaxed);
-            size_t bufferSize = monitoringRingBuffer.size();
+            std::span<const float> monitorSamples;
+
+            if (directMonitor.has_value())
+            {
+                monitorSamples = directMonitor->first(std::min(frames, directMonitor->size()));
+            }
+            else
+            {
+                // Skip ahead if the queue has grown past the target by more than a device buffer of jitter
+                const size_t available = ring.AvailableToRead();
+                const size_t wantedFill = monitoringTargetFill + frames;
+                if (available > wantedFill + config.bufferSize)
+                {
+                    const size_t trimmed = ring.Discard(available - wantedFill);
+                    monitoringLatencyTrims.fetch_add(1, std::memory_order_relaxed);
+                    monitoringTrimmedSamples.fetch_add(trimmed, std::memory_order_relaxed);
+                }
 
-            // Calculate available samples
-            size_t available = (writePos >= readPos) ? (writePos - readPos) : (bufferSize - readPos + writePos);
-            size_t samplesToRead = std::min(available, frames);
+                std::span<float> monitorSpan(outputScratchBuffer.data(), frames);
+                const size_t samplesRead = ring.Read(monitorSpan);
+                if (samplesRead < frames)
+                {
+                    monitoringUnderruns.fetch_add(1, std::memory_order_relaxed);
+                    monitoringMissingSamples.fetch_add(frames - samplesRead, std::memory_order_relaxed);
+                    (void)outputDiagnostics.Push({ .code = Audio::DiagnosticCode::MonitoringUnderrun,
+                        .source = Audio::DiagnosticSource::OutputCallback,
+                        .sampleTime = outputFramesRendered,
+                        .value0 = frames - samplesRead,
+                        .value1 = frames });
+                }
+                monitorSamples = monitorSpan.first(samplesRead);
+            }
 
-            float vol = monitoringVolume.load(std::memory_order_relaxed);
+            float vol = feedback.monitoringVolume;
 
-            for (size_t i = 0; i < samplesToRead; ++i)
+            for (size_t i = 0; i < monitorSamples.size(); ++i)
             {
-                float sample = monitoringRingBuffer[readPos] * vol;
+                float sample = monitorSamples[i] * vol;
 
-                if (outputChannels == 1)
+                if (channels == 1)
                 {
                     outputBuffer[i] += sample;
                 }
-                else if (outputChannels == 2)
+                else if (channels == 2)
                 {
                     outputBuffer[i * 2] += sample;     // Left
                     outputBuffer[i * 2 + 1] += sample; // Right
                 }
-
-                readPos = (readPos + 1) % bufferSize;
             }
-
-            monitoringReadPos.store(readPos, std::memory_order_release);
+        }
+        else
+        {
+            // Drop anything left over so re-enabling monitoring starts from fresh input
+            (void)ring.Discard(ring.AvailableToRead());
         }
 
         // Mix drone mode (continuous reference tone) - takes priority over single reference
-        bool droneMode = droneEnabled.load(std::memory_order_relaxed);
-        if (droneMode)
+        if (feedback.droneEnabled)
         {
-            referenceGenerator.SetAmplitude(static_cast<double>(referenceVolume.load(std::memory_order_relaxed)));
-
-            if (outputChannels == 1)
+            if (channels == 1)
             {
                 referenceGenerator.Generate(outputBuffer, true);
             }
@@ -710,11 +2583,9 @@ namespace PrecisionTuner::Layers
             }
         }
         // Mix polyphonic mode (chord playback) - takes priority over single reference
-        else if (polyphonicEnabled.load(std::memory_order_relaxed))
+        else if (feedback.polyphonicEnabled)
         {
-            polyphonicGenerator.SetGlobalVolume(referenceVolume.load(std::memory_order_relaxed));
-
-            if (outputChannels == 1)
+            if (channels == 1)
             {
                 polyphonicGenerator.Generate(outputBuffer, true);
             }
@@ -732,11 +2603,9 @@ namespace PrecisionTuner::Layers
             }
         }
         // Mix reference tone (normal single-shot mode)
-        else if (referenceEnabled.load(std::memory_order_relaxed))
+        else if (feedback.referenceEnabled)
         {
-            referenceGenerator.SetAmplitude(static_cast<double>(referenceVolume.load(std::memory_order_relaxed)));
-
-            if (outputChannels == 1)
+            if (channels == 1)
             {
                 referenceGenerator.Generate(outputBuffer, true);
             }
@@ -757,10 +2626,12 @@ namespace PrecisionTuner::Layers
         }
 
         // Note: Beep generator not yet implemented
-        // The beepEnabled flag is reserved for future in-tune notification feature
+        // The beepEnabled parameter is reserved for future in-tune notification feature
 
         // Apply limiting to prevent clipping
         GuitarIO::AudioMixer::Limit(outputBuffer);
+
+        outputFramesRendered += outputBuffer.size() / channels;
     }
 
 } // namespace PrecisionTuner::Layers
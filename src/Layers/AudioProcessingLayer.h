@@ -4,16 +4,42 @@
 #include "PolyphonicGenerator.h"
 #include "SineWaveGenerator.h"
 #include <Layer.h>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <span>
+#include <string>
+#include <thread>
 #include <vector>
 #include <AudioDevice.h>
 #include <AudioDeviceManager.h>
+#include <AnalysisPlan.h>
+#include <CacheLine.h>
 #include <Config.h>
+#include <Decimation.h>
+#include <DeviceCatalog.h>
+#include <DiagnosticQueue.h>
+#include <HistoryRing.h>
 #include <HybridPitchDetector.h>
+#include <InputConditioning.h>
+#include <MemoryArena.h>
+#include <OnsetDetection.h>
 #include <PitchStabilizer.h>
+#include <PreFilter.h>
+#include <RcuPointer.h>
+#include <RealtimeSafety.h>
+#include <SeqLock.h>
+#include <SignalGate.h>
+#include <SlidingAnalysisWindow.h>
+#include <SpscRingBuffer.h>
+#include <StreamHandoff.h>
+#include <StreamWatchdog.h>
+#include <ThreadScheduling.h>
+#include <TripleBuffer.h>
 
 namespace PrecisionTuner::Layers
 {
@@ -26,28 +52,205 @@ namespace PrecisionTuner::Layers
         Hybrid  ///< Hybrid (median + confidence-weighted EMA) - recommended
     };
 
-    /** Result of pitch detection (lock‑free) */
-    struct PitchData
+    /**
+     * Result of one analysis window, published as a single consistent snapshot
+     *
+     * sequence increases by one for every analysed window, so consumers can tell a new
+     * result from one they have already seen. streamSampleTime is the stream position of
+     * the last sample in the window; comparing it with GetStreamSampleTime() gives the
+     * analysis latency in samples. Each input channel has its own sequence.
+     */
+    struct PitchFrame
+    {
+        float frequency = 0.0f;        ///< Detected frequency in Hz (0 if not detected)
+        float confidence = 0.0f;       ///< Detection confidence [0.0, 1.0] (0 if not detected)
+        bool detected = false;         ///< Whether a pitch was detected
+        uint32_t channel = 0;          ///< Input channel the window was taken from
+        uint64_t sequence = 0;         ///< Frame counter (0 = no frame published yet)
+        uint64_t streamSampleTime = 0; ///< Stream position (samples) of the end of the analysis window
+    };
+
+    /** How input and output streams are opened */
+    enum class DuplexMode
     {
-        float frequency = 0.0f;  ///< Detected frequency in Hz
-        float confidence = 0.0f; ///< Detection confidence [0.0, 1.0]
-        bool detected = false;   ///< Whether a pitch was detected
+        Off,    ///< Always separate input and output streams (monitoring through the ring)
+        Auto,   ///< One full-duplex stream when input and output are the same device - recommended
+        Always  ///< One full-duplex stream on the input device; the output follows the input device
+    };
+
+    /**
+     * Input monitoring ring health, for display and diagnostics
+     *
+     * Counters are cumulative since construction. fillLevel is the number of samples
+     * queued between the input and output callbacks, i.e. the current monitoring latency.
+     */
+    struct MonitoringStats
+    {
+        uint64_t overruns = 0;       ///< Input callbacks that found the ring too full for the whole block
+        uint64_t droppedSamples = 0; ///< Samples lost to overruns
+        uint64_t underruns = 0;      ///< Output callbacks that found fewer samples than frames requested
+        uint64_t missingSamples = 0; ///< Samples replaced by silence because of underruns
+        uint64_t latencyTrims = 0;   ///< Times the reader skipped ahead to return to the target fill
+        uint64_t trimmedSamples = 0; ///< Samples skipped by latency trims
+        size_t fillLevel = 0;        ///< Samples currently queued
+        size_t targetFill = 0;       ///< Configured target fill (samples)
+        size_t capacity = 0;         ///< Ring capacity (samples)
+        float latencyMs = 0.0f;      ///< Monitoring latency in milliseconds (one buffer in duplex mode)
+        bool duplex = false;         ///< Monitoring runs inside one full-duplex callback (ring unused)
+    };
+
+    /**
+     * Analysis workload of one channel pipeline, for verifying the signal gate
+     *
+     * Counters are cumulative since construction and count full analysis windows (one
+     * PitchFrame each); gated frames were published as undetected without running the detector.
+     * Time-to-lock is measured in stream time from each pluck onset to the first stable reading
+     * (see Audio::LockTimer); onsets that never lock are counted in onsets but not in locks.
+     */
+    struct AnalysisStats
+    {
+        uint64_t frames = 0;                  ///< Full windows that reached the analysis stage
+        uint64_t gatedFrames = 0;             ///< Windows skipped by the signal gate (detector not run)
+        float noiseFloorDb = 0.0f;            ///< Current noise floor estimate (dBFS RMS)
+        float levelDb = 0.0f;                 ///< Level of the newest hop (dBFS RMS)
+        bool gateOpen = false;                ///< Whether the last hop passed the gate
+        uint64_t onsets = 0;                  ///< Pluck onsets detected
+        uint64_t locks = 0;                   ///< Onsets that reached a stable reading
+        float lastTimeToLockMs = 0.0f;        ///< Time-to-lock of the most recent lock
+        float meanTimeToLockMs = 0.0f;        ///< Mean time-to-lock over all locks
+        uint32_t decimationFactor = 1;        ///< Downsampling ahead of the detector (1 = full rate)
+        uint32_t pitchTrackingGeneration = 0; ///< Settings in use: 0 = from the config, +1 per SetPitchTrackingConfig
+
+        /**
+         * @brief Gets the share of frames the gate skipped
+         * @return Fraction in [0, 1] (0 before the first frame)
+         */
+        [[nodiscard]] float GatedShare() const
+        {
+            return frames > 0 ? static_cast<float>(gatedFrames) / static_cast<float>(frames) : 0.0f;
+        }
+    };
+
+    /** Cost of one pre-filter stage on one channel */
+    struct PreFilterStageStats
+    {
+        bool enabled = false;          ///< Stage currently in the cascade
+        uint64_t blocks = 0;           ///< Hops the stage has filtered
+        float lastMicroseconds = 0.0f; ///< Time spent on the most recent hop
+        float meanMicroseconds = 0.0f; ///< Mean time per hop
+    };
+
+    /** Per-stage cost of the analysis pre-filter of one channel, indexed by Audio::PreFilterStage */
+    struct PreFilterStats
+    {
+        std::array<PreFilterStageStats, Audio::PreFilterChain::kStageCount> stages{}; ///< One entry per stage
+    };
+
+    /**
+     * Outcome of the configured real-time scheduling, for verification on production machines
+     *
+     * Thread entries stay at applied = false until the thread has run with a requested policy.
+     * A full-duplex stream reports as the input thread.
+     */
+    struct SchedulingReport
+    {
+        Audio::MemoryLockResult memoryLock;                         ///< mlockall at startup
+        Audio::ThreadSchedulingResult inputThread;                  ///< Input (or duplex) callback thread
+        Audio::ThreadSchedulingResult outputThread;                 ///< Output callback thread
+        std::vector<Audio::ThreadSchedulingResult> analysisThreads; ///< Analysis workers, indexed by channel
+    };
+
+    /**
+     * Real-time memory reserved by the layer (see Audio::MemoryArena)
+     *
+     * The callback buffers and the monitoring ring share one arena, rebuilt when the buffers
+     * grow; the sample queues of all channel pipelines share another, reserved at construction.
+     */
+    struct MemoryFootprint
+    {
+        Audio::MemoryArenaStats callbackBuffers; ///< Processing, channel and mixing scratch, monitoring ring
+        Audio::MemoryArenaStats analysisQueues;  ///< Callback-to-analysis sample queues of every channel
+        size_t retiredBytes = 0;                 ///< Callback arenas replaced by a grow, not freed yet
+
+        /**
+         * @brief Gets the memory reserved by both arenas and the retired callback arenas
+         * @return Bytes (whole pages)
+         */
+        [[nodiscard]] size_t TotalBytes() const
+        {
+            return callbackBuffers.reservedBytes + analysisQueues.reservedBytes + retiredBytes;
+        }
+    };
+
+    /** Health of the device streams as seen by the stream watchdogs */
+    struct WatchdogReport
+    {
+        Audio::StreamHealth input;  ///< Input stream (the single stream while duplex is active)
+        Audio::StreamHealth output; ///< Output stream (idle while duplex is active)
+    };
+
+    /**
+     * Detector range and stabilizer settings, changeable while the layer runs
+     *
+     * Starts out as the matching AudioProcessingLayerConfig fields; see
+     * AudioProcessingLayer::SetPitchTrackingConfig().
+     */
+    struct PitchTrackingConfig
+    {
+        float minFrequency = 80.0f;                             ///< Minimum detectable frequency (E2)
+        float maxFrequency = 1200.0f;                           ///< Maximum detectable frequency (D6)
+        StabilizerType stabilizerType = StabilizerType::Hybrid; ///< Stabilization algorithm
+        float emaAlpha = 0.3f;                                  ///< EMA smoothing factor [0.0, 1.0]
+        uint32_t medianWindowSize = 5;                          ///< Median filter window size
     };
 
     /** Configuration for the audio processing layer */
     struct AudioProcessingLayerConfig
     {
         uint32_t sampleRate = 48000;  ///< Sample rate (Hz)
-        uint32_t bufferSize = 2048;   ///< Buffer size (frames) – larger for better pitch accuracy
+        uint32_t bufferSize = 2048;   ///< Device buffer size (frames)
         float minFrequency = 80.0f;   ///< Minimum detectable frequency (E2)
         float maxFrequency = 1200.0f; ///< Maximum detectable frequency (D6)
 
+        // Multi-channel capture (one analysis pipeline per captured channel)
+        uint32_t inputChannels = 1;  ///< Input channels captured from the device (capped by the device)
+        uint32_t primaryChannel = 0; ///< Channel behind GetLatestPitch(), the level meters and monitoring
+
+        // Analysis window configuration (independent of the device buffer size; sizes keep their duration at any rate)
+        uint32_t analysisWindowSize = 4096;     ///< Samples per detection window at the reference rate (0 = one buffer)
+        uint32_t analysisHopSize = 512;         ///< Samples between successive windows at the reference rate
+        uint32_t analysisReferenceRate = 48000; ///< Rate the analysis sizes are given at (0 = used as is at any rate)
+        float pitchHistorySeconds = 10.0f;      ///< Length of the pitch frame history kept for readers (seconds)
+        Audio::DecimationConfig decimation;     ///< Detect on a downsampled window, refine at the full rate
+
+        // Analysis pre-filtering, gating and pluck onsets (per hop, on the analysis threads)
+        Audio::PreFilterConfig preFilter;         ///< DC, rumble, hiss and hum removal (see SetPreFilterConfig)
+        Audio::SignalGateConfig signalGate;       ///< Skips detection on silence and the noise floor
+        Audio::OnsetDetectorConfig onsetDetector; ///< Pluck onsets: stabilizer reset and attack skipping
+        Audio::LockTimerConfig lockTimer;         ///< Criterion of the time-to-lock metric
+
+        // Input monitoring
+        DuplexMode duplexMode = DuplexMode::Auto; ///< Single full-duplex stream vs. separate input/output streams
+        uint32_t monitoringTargetFill = 0;        ///< Target monitoring queue fill (frames) – 0 = one device buffer
+
+        // Stream supervision (run from OnUpdate)
+        Audio::StreamWatchdogConfig watchdog; ///< Restart or fall back when a stream stops calling back
+
+        // Real-time scheduling, applied as the streams and analysis threads start
+        bool lockMemory = false;                                ///< mlockall() so page faults never hit audio
+        Audio::ThreadSchedulingPolicy audioThreadScheduling;    ///< Audio callback threads (first buffer)
+        Audio::ThreadSchedulingPolicy analysisThreadScheduling; ///< Per-channel analysis workers
+        Audio::MemoryArenaConfig memoryArena;                   ///< Huge pages and mlock() of the buffer arenas
+
         // Pitch stabilization configuration
         StabilizerType stabilizerType = StabilizerType::Hybrid; ///< Stabilization algorithm
         float emaAlpha = 0.3f;                                  ///< EMA smoothing factor [0.0, 1.0]
         uint32_t medianWindowSize = 5;                          ///< Median filter window size
     };
 
+    /** Creates a new, unopened audio device (used to bring up a replacement stream during a device switch) */
+    using AudioDeviceFactory = std::function<std::unique_ptr<GuitarIO::AudioDevice>()>;
+
     /**
      * @brief Audio processing layer - Manages audio I/O and pitch detection
      *
@@ -60,9 +263,16 @@ namespace PrecisionTuner::Layers
      *
      * THREAD SAFETY:
      *  - Runs audio I/O callbacks on a high-priority real-time thread
+     *  - The input callback only deinterleaves and conditions samples and pushes each channel
+     *    into its own lock-free SPSC queue; pitch detection and stabilization run on one
+     *    analysis thread per captured channel
      *  - Uses std::atomic for lock-free communication with UI thread
-     *  - Pre-allocates all buffers to avoid malloc() in audio callbacks
-     *  - bufferOverflowDetected flag signals if OS sends unexpectedly large buffers
+     *  - Pre-allocates all buffers to avoid malloc() in audio callbacks; builds with
+     *    ENABLE_RT_SAFETY_CHECKS flag any allocation or mutex lock made inside a callback
+     *  - Audio threads never log: they push fixed-size diagnostic events into per-thread
+     *    lock-free queues, which OnUpdate() drains into the logger on the main thread
+     *  - Device switches open and start the new stream on a background thread while the old
+     *    stream keeps running; the old stream hands over at a buffer boundary (StreamHandoff)
      *
      * IMPORTANT: Never call blocking operations or allocate memory in audio callbacks
      *            to prevent audio glitches and dropouts.
@@ -81,21 +291,145 @@ namespace PrecisionTuner::Layers
          * @param config Layer configuration
          * @param inputDevice Injected input device
          * @param outputDevice Injected output device
+         * @param deviceFactory Creates devices for background switches; empty switches devices in place (blocking)
          */
         AudioProcessingLayer(const AudioProcessingLayerConfig &config,
             std::unique_ptr<GuitarIO::AudioDevice> inputDevice,
-            std::unique_ptr<GuitarIO::AudioDevice> outputDevice);
+            std::unique_ptr<GuitarIO::AudioDevice> outputDevice,
+            AudioDeviceFactory deviceFactory = nullptr);
 
         ~AudioProcessingLayer() override;
 
         void OnUpdate(float deltaTime) override;
 
         /**
-         * @brief Gets the latest detected pitch data
-         * Thread-safe method to retrieve pitch information from the audio callback.
-         * @return Latest pitch data (frequency, confidence, detection status)
+         * @brief Gets the latest detected pitch frame of the primary channel
+         * Thread-safe method to retrieve pitch information from the analysis thread.
+         * All fields come from the same analysis window (no torn reads).
+         * @return Latest pitch frame (frequency, confidence, detection status, sequence, stream time)
+         */
+        [[nodiscard]] PitchFrame GetLatestPitch() const;
+
+        /**
+         * @brief Gets the latest detected pitch frame of one input channel
+         * @param channel Input channel index (0-based)
+         * @return Latest frame of that channel (a default frame for channels that are not captured)
+         */
+        [[nodiscard]] PitchFrame GetLatestPitch(uint32_t channel) const;
+
+        /**
+         * @brief Gets the number of input channels with their own analysis pipeline
+         * @return Channel count (the configured inputChannels)
+         */
+        [[nodiscard]] uint32_t GetInputChannelCount() const;
+
+        /**
+         * @brief Gets the channel behind GetLatestPitch(), the level meters and monitoring
+         * @return Primary channel index, or 0 while the input stream captures fewer channels than it needs
+         */
+        [[nodiscard]] uint32_t GetPrimaryChannel() const;
+
+        /**
+         * @brief Gets the current stream position of the analysis timeline
+         * @return Total samples handed from the input callback to the analysis thread
          */
-        [[nodiscard]] PitchData GetLatestPitch() const;
+        [[nodiscard]] uint64_t GetStreamSampleTime() const;
+
+        /**
+         * @brief Copies the most recent pitch frames, oldest first
+         * Wait-free; safe to call from any number of threads concurrently with analysis.
+         * @param out Destination; receives at most out.size() of the newest frames
+         * @return Number of frames copied
+         */
+        size_t CopyPitchHistory(std::span<PitchFrame> out) const;
+
+        /**
+         * @brief Copies the most recent pitch frames of one input channel, oldest first
+         * @param channel Input channel index (0-based)
+         * @param out Destination; receives at most out.size() of the newest frames
+         * @return Number of frames copied (0 for channels that are not captured)
+         */
+        size_t CopyPitchHistory(uint32_t channel, std::span<PitchFrame> out) const;
+
+        /**
+         * @brief Gets the analysis workload of one input channel
+         * Safe to call from any thread; fields are read individually, not as one snapshot.
+         * @param channel Input channel index (0-based)
+         * @return Frame and gated-frame counters and the gate state (all zero for channels not captured)
+         */
+        [[nodiscard]] AnalysisStats GetAnalysisStats(uint32_t channel) const;
+
+        /**
+         * @brief Gets the window, hop, decimation and lag bounds fitted to the stream rate
+         * Planned once at construction for the configured detection band; a band set later by
+         * SetPitchTrackingConfig() may decimate differently (see AnalysisStats::decimationFactor).
+         * @return Analysis plan (immutable, safe to read from any thread)
+         */
+        [[nodiscard]] const Audio::AnalysisPlan &GetAnalysisPlan() const;
+
+        /**
+         * @brief Switches pre-filter stages or moves their frequencies while running
+         * Every analysis thread picks the change up before its next hop; only coefficients are
+         * recomputed, so nothing allocates. Call from one thread at a time (the main thread).
+         * @param preFilter New pre-filter settings
+         */
+        void SetPreFilterConfig(const Audio::PreFilterConfig &preFilter);
+
+        /**
+         * @brief Gets the pre-filter settings last applied
+         * @return Settings from the config or the last SetPreFilterConfig()
+         */
+        [[nodiscard]] Audio::PreFilterConfig GetPreFilterConfig() const;
+
+        /**
+         * @brief Gets what each pre-filter stage costs per hop on one input channel
+         * Safe to call from any thread; fields are read individually, not as one snapshot.
+         * @param channel Input channel index (0-based)
+         * @return Per-stage hop counts and timings (all zero for channels not captured)
+         */
+        [[nodiscard]] PreFilterStats GetPreFilterStats(uint32_t channel) const;
+
+        /**
+         * @brief Retunes the detector and stabilizer of every channel while running
+         * Builds a new detector, stabilizer and decimator per channel on the calling thread (the main
+         * thread) and publishes them; each analysis thread swaps its set in with one atomic exchange
+         * before its next hop, and the set it used is destroyed by a later OnUpdate() or
+         * SetPitchTrackingConfig(). Streams keep running and analysis threads never allocate.
+         * The new stabilizer starts empty. Call from the main thread only.
+         * @param pitchTracking New detector range and stabilizer settings
+         */
+        void SetPitchTrackingConfig(const PitchTrackingConfig &pitchTracking);
+
+        /**
+         * @brief Gets the pitch tracking settings last requested (main thread)
+         * @return Settings from the config or the last SetPitchTrackingConfig()
+         */
+        [[nodiscard]] PitchTrackingConfig GetPitchTrackingConfig() const;
+
+        /**
+         * @brief Copies pitch frames newer than a given sequence number, oldest first
+         * Wait-free; intended for readers that want every frame (graphs, recorders).
+         * Frames older than the history length are skipped if the reader falls behind.
+         * @param lastSequence In: sequence of the last frame already consumed (0 = none).
+         *                     Out: sequence of the last frame consumed after this call.
+         * @param out Destination buffer
+         * @return Number of frames copied
+         */
+        size_t ReadPitchHistorySince(uint64_t &lastSequence, std::span<PitchFrame> out) const;
+
+        /**
+         * @brief Gets the number of frames the pitch history holds
+         * @return History capacity in frames
+         */
+        [[nodiscard]] size_t GetPitchHistoryCapacity() const;
+
+        /**
+         * @brief Blocks until every complete analysis hop queued so far has been processed (all channels)
+         * Intended for tests and offline processing; never call from an audio callback.
+         * @param timeout Maximum time to wait
+         * @return true if the analysis thread caught up, false on timeout
+         */
+        bool FlushAnalysis(std::chrono::milliseconds timeout = std::chrono::milliseconds(2000));
 
         /**
          * @brief Checks if input device is available and running
@@ -109,6 +443,12 @@ namespace PrecisionTuner::Layers
          */
         [[nodiscard]] bool IsOutputDeviceAvailable() const;
 
+        /**
+         * @brief Checks if input and output share one full-duplex stream
+         * @return true if monitoring runs inside a single callback, false for separate streams
+         */
+        [[nodiscard]] bool IsDuplexActive() const;
+
         // Input device methods
 
         /**
@@ -119,6 +459,7 @@ namespace PrecisionTuner::Layers
 
         /**
          * @brief Gets detailed information for all available input devices
+         * Served from the device catalog cache; empty until its first background scan completes.
          * @return Vector of audio device info structures
          */
         [[nodiscard]] std::vector<GuitarIO::AudioDeviceInfo> GetAvailableInputDeviceInfo() const;
@@ -131,8 +472,11 @@ namespace PrecisionTuner::Layers
 
         /**
          * @brief Switches the active input device
+         * The new stream is opened in the background while the current one keeps feeding the
+         * tuner; the outcome and duration are logged when OnUpdate() completes the switch.
+         * Full-duplex changes and layers without a device factory switch in place (blocking).
          * @param deviceId ID of the device to switch to
-         * @return true if switch was successful, false otherwise
+         * @return true if the switch was started (or queued behind one in flight) or completed, false on failure
          */
         [[nodiscard]] bool SwitchInputDevice(uint32_t deviceId);
 
@@ -144,6 +488,7 @@ namespace PrecisionTuner::Layers
 
         /**
          * @brief Gets detailed information for all available output devices
+         * Served from the device catalog cache; empty until its first background scan completes.
          * @return Vector of audio device info structures
          */
         [[nodiscard]] std::vector<GuitarIO::AudioDeviceInfo> GetAvailableOutputDeviceInfo() const;
@@ -156,18 +501,83 @@ namespace PrecisionTuner::Layers
 
         /**
          * @brief Switches the active output device
+         * Like SwitchInputDevice(): opened in the background, then swapped at a buffer boundary
+         * with a one-buffer fade-out on the old device and fade-in on the new one.
          * @param deviceId ID of the device to switch to
-         * @return true if switch was successful, false otherwise
+         * @return true if the switch was started (or queued behind one in flight) or completed, false on failure
          */
         [[nodiscard]] bool SwitchOutputDevice(uint32_t deviceId);
 
+        /**
+         * @brief Checks if a background device switch is in flight
+         * @return true between a SwitchInputDevice()/SwitchOutputDevice() call and its completion
+         */
+        [[nodiscard]] bool IsDeviceSwitchPending() const;
+
+        /**
+         * @brief Blocks until background device switches (including queued ones) have completed
+         * Intended for tests and shutdown paths; OnUpdate() completes switches without blocking.
+         * @param timeout Maximum time to wait
+         * @return true if no switch is pending any more, false on timeout
+         */
+        bool WaitForDeviceSwitch(std::chrono::milliseconds timeout = std::chrono::milliseconds(2000));
+
+        /**
+         * @brief Gets the background device catalog
+         * Device lists are enumerated on the catalog's worker and read from its snapshot, so
+         * callers on the UI thread never wait for a device probe.
+         * @return Device catalog
+         */
+        [[nodiscard]] Audio::DeviceCatalog &GetDeviceCatalog();
+
         /**
          * @brief Updates audio feedback settings
-         * Applies changes to beep, reference tone, and monitoring parameters.
+         * Publishes beep, reference tone, drone, polyphonic and monitoring parameters as one new
+         * version of the feedback parameter block; the output callback picks the newest version up
+         * at the start of its next buffer, so a change never applies halfway. Input gain takes
+         * effect on the next input buffer. Call from the main thread only.
          * @param audioConfig New audio configuration
          */
         void UpdateAudioFeedback(const PrecisionTuner::AudioConfig &audioConfig);
 
+        /**
+         * @brief Gets the feedback parameter version the output callback is playing
+         * @return 0 until the output callback picked up a block, then the version of the last
+         *         UpdateAudioFeedback() or SetPolyphonicFrequencies() it applied (counted from 1)
+         */
+        [[nodiscard]] uint64_t GetAppliedFeedbackVersion() const;
+
+        /**
+         * @brief Gets how many diagnostic events of a kind the audio threads have raised
+         * Includes events dropped because a diagnostic queue was full. Updated by OnUpdate();
+         * call from the main thread only.
+         * @param code Diagnostic code
+         * @return Event count since construction
+         */
+        [[nodiscard]] uint64_t GetDiagnosticCount(Audio::DiagnosticCode code) const;
+
+        /**
+         * @brief Gets what the OS granted for memory locking, priorities and CPU pinning
+         * Audio and analysis threads report through the diagnostic queues, so thread entries are
+         * updated by OnUpdate(); call from the main thread only.
+         * @return Per-thread scheduling outcomes
+         */
+        [[nodiscard]] const SchedulingReport &GetSchedulingReport() const;
+
+        /**
+         * @brief Gets the real-time memory reserved for the callback buffers and analysis queues
+         * The callback arena is replaced when OnUpdate() grows the buffers; call from the main thread only.
+         * @return Size and backing of each arena
+         */
+        [[nodiscard]] MemoryFootprint GetMemoryFootprint() const;
+
+        /**
+         * @brief Gets the status and recovery metrics of the device streams
+         * Updated by OnUpdate(); call from the main thread only.
+         * @return Health of the input and output streams
+         */
+        [[nodiscard]] WatchdogReport GetWatchdogReport() const;
+
         /**
          * @brief Checks if a buffer overflow occurred and clears the flag
          * @return true if overflow was detected since last check
@@ -177,94 +587,632 @@ namespace PrecisionTuner::Layers
 
         /**
          * @brief Sets frequencies for polyphonic chord playback
+         * Published as a new feedback parameter version (see UpdateAudioFeedback()). Call from the main thread only.
          * @param frequencies Array of 6 frequencies (Hz), 0 = disabled voice
          */
         void SetPolyphonicFrequencies(const std::array<float, 6> &frequencies);
 
         /**
          * @brief Gets the current input signal level
-         * @return RMS level of the input signal (0.0 to 1.0)
+         * @return Peak level of the last input buffer (0.0 to 1.0)
          */
         [[nodiscard]] float GetInputLevel() const;
 
+        /**
+         * @brief Gets input monitoring ring counters and current fill
+         * Safe to call from any thread; counters are read individually, not as one snapshot.
+         * @return Overrun/underrun/trim counters, fill level and latency
+         */
+        [[nodiscard]] MonitoringStats GetMonitoringStats() const;
+
+        /**
+         * @brief Gets the current input RMS level
+         * @return True RMS level of the last input buffer (0.0 to 1.0)
+         */
+        [[nodiscard]] float GetInputRmsLevel() const;
+
     private:
+        /**
+         * userData of one device stream. Each direction has two, so a replacement stream can
+         * run next to the old one during a switch; the StreamHandoff of the direction decides
+         * which of them may touch the shared real-time state. Each sits on a cache line of its
+         * own, since the callbacks of different streams write their fadeIn and scheduled flags.
+         */
+        struct alignas(Audio::kCacheLineSize) StreamContext
+        {
+            AudioProcessingLayer *layer = nullptr; ///< Owning layer
+            uint32_t slot = 0;                     ///< Slot index in the direction's StreamHandoff
+            uint32_t inputChannels = 1;            ///< Interleaved input channels (set before the stream starts)
+            uint32_t outputChannels = 1;           ///< Interleaved output channels (set before the stream starts)
+            bool fadeIn = false;                   ///< Ramp the first owned buffer up from silence (callback clears)
+            bool scheduled = false;                ///< Callback thread applied audioThreadScheduling (callback sets)
+        };
+
+        /** Gain ramp applied to a stream's buffer around a handoff */
+        enum class HandoffFade
+        {
+            None, ///< Normal buffer
+            In,   ///< First buffer of the new stream (0 -> 1)
+            Out   ///< Last buffer of the old stream (1 -> 0)
+        };
+
+        /**
+         * Everything the output callback needs to render feedback, published as one immutable block
+         *
+         * The main thread edits its own copy and publishes it through a TripleBuffer; the output
+         * callback takes the newest block at the start of a buffer and applies it to the generators.
+         */
+        struct FeedbackParameters
+        {
+            uint64_t version = 0;                         ///< Bumped by every publish (0 = constructor's)
+            bool beepEnabled = false;                     ///< Beep feedback enabled
+            bool referenceEnabled = false;                ///< Reference tone enabled
+            bool monitoringEnabled = false;               ///< Input monitoring mixed into the output
+            bool droneEnabled = false;                    ///< Drone mode enabled
+            bool polyphonicEnabled = false;               ///< Polyphonic mode enabled
+            float beepVolume = 0.5f;                      ///< Beep volume
+            float referenceVolume = 0.5f;                 ///< Reference, drone and chord volume
+            float monitoringVolume = 0.5f;                ///< Monitoring volume
+            float referenceFrequency = 440.0f;            ///< Reference and drone frequency (Hz)
+            std::array<float, 6> polyphonicFrequencies{}; ///< Chord voices (Hz), 0 = voice off
+        };
+
+        /** Running cost of one pre-filter stage (written by the pipeline's worker) */
+        struct PreFilterCost
+        {
+            std::atomic<uint64_t> blocks{ 0 };           ///< Hops filtered by the stage
+            std::atomic<uint64_t> totalNanoseconds{ 0 }; ///< Time spent over all hops
+            std::atomic<uint64_t> lastNanoseconds{ 0 };  ///< Time spent on the most recent hop
+        };
+
+        /**
+         * Detector, stabilizer and decimator built for one PitchTrackingConfig
+         *
+         * Built on the main thread with every buffer pre-allocated, used by one analysis thread
+         * only, and destroyed on the main thread again (see Audio::RcuPointer).
+         */
+        struct PitchTracker
+        {
+            PitchTrackingConfig settings;                             ///< Settings the tracker was built for
+            uint32_t generation = 0;                                  ///< pitchTrackingGeneration at build time
+            std::unique_ptr<GuitarDSP::HybridPitchDetector> detector; ///< Pitch detection
+            std::unique_ptr<GuitarDSP::PitchStabilizer> stabilizer;   ///< Pitch stabilization (or null)
+            Audio::AnalysisPlan plan;                                 ///< Decimation, lag bounds and refinement
+            Audio::PolyphaseDecimator decimator;                      ///< Anti-aliasing downsampler ahead of detection
+            std::vector<float> decimated;                             ///< Decimated analysis span
+        };
+
+        /** Gained input queued by the input callback for the output callback */
+        using MonitoringRing = Audio::SpscRingBuffer<float>;
+
+        /**
+         * Memory behind one set of callback buffers, all carved from a single arena
+         *
+         * Owned by the main thread; freed only once neither callback can still be using it.
+         */
+        struct CallbackMemory
+        {
+            Audio::MemoryArena arena;      ///< Block every buffer and the ring storage come from
+            MonitoringRing monitoringRing; ///< Gained input queued for pass-through (storage in arena)
+        };
+
+        /**
+         * Input callback scratch, sized for one device buffer with the safety margin
+         *
+         * Built on the main thread and swapped in by the input callback at the start of a
+         * buffer (see ProvisionBuffers()), so it can grow while the stream runs.
+         */
+        struct InputBuffers
+        {
+            size_t frames = 0;                          ///< Frames each buffer below holds
+            std::span<float> processing;                ///< Conditioned primary channel
+            std::vector<std::span<float>> channelViews; ///< Deinterleaved input, one span per channel
+            MonitoringRing *monitoringRing = nullptr;   ///< Ring to queue monitored input on
+        };
+
+        /** Output callback scratch, swapped in alongside InputBuffers */
+        struct OutputBuffers
+        {
+            std::span<float> scratch;                 ///< Mixing scratch (frames)
+            MonitoringRing *monitoringRing = nullptr; ///< Ring to read monitored input from
+        };
+
+        /**
+         * Pitch analysis of one input channel: the callback queues the channel's conditioned
+         * samples, the pipeline's worker thread slides the window over them and runs its own
+         * detector and stabilizer, and the results are published for readers on any thread.
+         */
+        struct ChannelPipeline
+        {
+            explicit ChannelPipeline(uint32_t channel, size_t diagnosticCapacity)
+                : channel(channel), queue(0), latest(PitchFrame{}), history(0), diagnostics(diagnosticCapacity)
+            {
+            }
+
+            uint32_t channel;                                 ///< Input channel index (0-based)
+            Audio::RcuPointer<PitchTracker> tracker;          ///< Detector and stabilizer (worker reads)
+            Audio::SpscRingBuffer<float> queue;               ///< Conditioned samples from the input callback
+            Audio::SlidingAnalysisWindow window;              ///< Overlapping detection window (worker only)
+            Audio::PreFilterChain preFilter;                  ///< Biquad cascade applied to each hop (worker)
+            uint32_t preFilterVersion = 0;                    ///< preFilterVersion the chain was configured at
+            Audio::SignalGate gate;                           ///< Noise floor gate before detection (worker)
+            Audio::OnsetDetector onsets;                      ///< Pluck onsets (worker only)
+            Audio::LockTimer lockTimer;                       ///< Time-to-lock after each onset (worker only)
+            uint64_t attackEndSampleTime = 0;                 ///< Detection starts here after an onset (worker)
+            Audio::SeqLock<PitchFrame> latest;                ///< Latest result (written by the worker only)
+            uint64_t frameSequence = 0;                       ///< Sequence of the last published frame (worker)
+            Audio::HistoryRing<PitchFrame> history;           ///< Last pitchHistorySeconds of frames
+            Audio::DiagnosticQueue diagnostics;               ///< Raised by the worker
+
+            // Written by the input callback on every buffer (cache lines of its own)
+            alignas(Audio::kCacheLineSize) std::atomic<uint32_t> wakeups{ 0 }; ///< Bumped to wake the worker
+            std::atomic<uint64_t> samplesQueued{ 0 }; ///< Total samples pushed into queue
+
+            // Written by the worker on every hop, read by any thread (cache lines of their own)
+            alignas(Audio::kCacheLineSize) std::atomic<uint64_t> samplesAnalyzed{ 0 }; ///< Samples consumed
+            std::atomic<uint64_t> framesAnalyzed{ 0 };    ///< Full windows seen by ProcessAudio
+            std::atomic<uint64_t> framesGated{ 0 };       ///< Windows the gate kept from the detector
+            std::atomic<float> noiseFloorDb{ 0.0f };      ///< Gate noise floor (published by the worker)
+            std::atomic<float> levelDb{ 0.0f };           ///< Gate level of the newest hop
+            std::atomic<bool> gateOpen{ false };          ///< Gate state after the newest hop
+            std::atomic<uint64_t> onsetsDetected{ 0 };    ///< Pluck onsets seen by the worker
+            std::atomic<uint64_t> locksMeasured{ 0 };     ///< Onsets that locked before the timeout
+            std::atomic<uint64_t> lockSamplesTotal{ 0 };  ///< Sum of time-to-lock over locksMeasured
+            std::atomic<uint64_t> lastLockSamples{ 0 };   ///< Time-to-lock of the latest lock
+            std::atomic<uint32_t> trackerGeneration{ 0 }; ///< Generation of the tracker in use
+            std::atomic<uint32_t> decimationFactor{ 1 };  ///< Decimation of the tracker in use
+            std::array<PreFilterCost, Audio::PreFilterChain::kStageCount> preFilterCost; ///< Per-stage cost
+            std::jthread worker;                          ///< Thread running AnalysisThreadMain
+        };
+
+        /** One background device switch: created on the main thread, run by its worker */
+        struct DeviceSwitch
+        {
+            bool output = false;                             ///< Output stream (true) or input stream (false)
+            uint32_t deviceId = 0;                           ///< Device being switched to
+            uint32_t slot = 0;                               ///< Stream slot of the new stream
+            GuitarIO::AudioStreamConfig streamConfig;        ///< Configuration of the new stream
+            bool previousRunning = false;                    ///< Old stream was running when the switch started
+            std::unique_ptr<GuitarIO::AudioDevice> previous; ///< Stream being replaced (stopped by the worker)
+            std::unique_ptr<GuitarIO::AudioDevice> next;     ///< Stream being brought up
+            bool succeeded = false;                          ///< New stream running and active
+            bool handedOff = false;                          ///< Swapped at a buffer boundary (not after a forced stop)
+            std::string error;                               ///< Device error if the new stream failed
+            double openMs = 0.0;                             ///< Time to open and start the new stream
+            double handoffMs = 0.0;                          ///< Time from start until the old stream was closed
+            std::atomic<bool> done{ false };                 ///< Worker finished; results may be read
+            std::jthread worker;                             ///< Background task running RunDeviceSwitch
+        };
+
         /**
          * @brief Audio input callback
          * Processes incoming audio for pitch detection and monitoring.
          * @param inputBuffer Input audio samples
          * @param outputBuffer Output audio samples (unused for input callback)
-         * @param userData Pointer to AudioProcessingLayer instance
+         * @param userData Pointer to the StreamContext of the stream
          * @return 0 to continue
          */
         static int InputCallback(std::span<const float> inputBuffer, std::span<float> outputBuffer, void *userData);
 
+        /**
+         * @brief Full-duplex audio callback
+         * Conditions the input and mixes feedback into the output of the same stream; input
+         * monitoring uses the conditioned input directly instead of the monitoring ring.
+         * @param inputBuffer Input audio samples (mono)
+         * @param outputBuffer Output audio samples to fill (interleaved, outputChannels)
+         * @param userData Pointer to the StreamContext of the stream
+         * @return 0 to continue
+         */
+        static int DuplexCallback(std::span<const float> inputBuffer, std::span<float> outputBuffer, void *userData);
+
+        /**
+         * @brief Splits the input into channels, applies gain and hands each channel to its pipeline
+         * Shared by InputCallback and DuplexCallback; runs on the real-time thread. The primary
+         * channel is also metered and (optionally) copied into the monitoring ring.
+         * @param inputBuffer Input audio samples (interleaved, inputChannels)
+         * @param inputChannels Interleaved channels of inputBuffer
+         * @param writeMonitoringRing Also queue the conditioned primary channel for a separate output stream
+         * @param fade Ramp applied to the monitoring copy around a device handoff
+         * @return Number of primary-channel samples conditioned into the processing buffer
+         */
+        size_t ConditionInput(std::span<const float> inputBuffer,
+            uint32_t inputChannels,
+            bool writeMonitoringRing,
+            HandoffFade fade = HandoffFade::None);
+
+        /**
+         * @brief Queues conditioned samples of one channel and wakes its worker (real-time thread)
+         * @param pipeline Pipeline of the channel
+         * @param samples Conditioned samples
+         */
+        void QueueForAnalysis(ChannelPipeline &pipeline, std::span<const float> samples);
+
         /**
          * @brief Audio output callback
          * Generates audio feedback (beeps, reference tones).
          * @param inputBuffer Input audio samples (unused for output callback)
          * @param outputBuffer Output audio samples to fill
-         * @param userData Pointer to AudioProcessingLayer instance
+         * @param userData Pointer to the StreamContext of the stream
          * @return 0 to continue
          */
         static int OutputCallback(std::span<const float> inputBuffer, std::span<float> outputBuffer, void *userData);
 
+        /**
+         * @brief Analysis thread entry point (one thread per channel pipeline)
+         * Drains the pipeline's sample queue one hop at a time, passes each hop through the signal
+         * gate and the onset detector and runs ProcessAudio on each full window.
+         * @param pipeline Pipeline owned by this thread
+         * @param stopToken Stop request from the owning std::jthread
+         */
+        void AnalysisThreadMain(ChannelPipeline &pipeline, std::stop_token stopToken);
+
+        /**
+         * @brief Runs the pipeline's pre-filter over a new hop, in place (analysis thread)
+         * Applies settings published by SetPreFilterConfig() first, then adds each stage's
+         * time to the pipeline's cost counters.
+         * @param pipeline Pipeline the hop belongs to
+         * @param hop Newest samples of the pipeline's window
+         */
+        void PreFilterHop(ChannelPipeline &pipeline, std::span<float> hop);
+
+        /**
+         * @brief Logs which pre-filter stages are on and at what frequencies
+         * @param preFilter Settings to describe
+         */
+        static void LogPreFilter(const Audio::PreFilterConfig &preFilter);
+
         /**
          * @brief Processes input audio for pitch detection
-         * Runs the pitch detection algorithm on the provided buffer.
+         * Runs the pipeline's detector and stabilizer on the provided buffer, or publishes an
+         * undetected frame without running them when the gate is closed. Right after an onset only
+         * the part of the window past the attack is analyzed, and nothing until that part is long
+         * enough for the lowest string. Called on the pipeline's thread only.
+         * @param pipeline Pipeline the window belongs to
          * @param inputBuffer Audio samples to process
+         * @param gateOpen Whether the newest hop passed the signal gate
+         */
+        void ProcessAudio(ChannelPipeline &pipeline, std::span<const float> inputBuffer, bool gateOpen);
+
+        /**
+         * @brief Runs a pitch tracker's detector on the newest samples of a window
+         * With decimation the detector sees the analyzed samples downsampled (the samples in front of
+         * them feed the anti-aliasing filter), and its estimate is refined on the full-rate samples.
+         * @param tracker Detector and decimator of the window's pipeline
+         * @param window Full analysis window
+         * @param analysisSamples Newest samples of the window to analyze
+         * @return Detected pitch at full-rate precision, or nullopt
+         */
+        std::optional<GuitarDSP::PitchResult> DetectPitch(PitchTracker &tracker,
+            std::span<const float> window,
+            size_t analysisSamples);
+
+        /**
+         * @brief Fits the analysis to the stream rate for a detection band
+         * @param pitchTracking Detector range
+         * @return Plan for config.sampleRate
+         */
+        [[nodiscard]] Audio::AnalysisPlan PlanAnalysis(const PitchTrackingConfig &pitchTracking) const;
+
+        /**
+         * @brief Builds a pitch tracker for the layer's stream (main thread; allocates)
+         * Plans the analysis for the band, designs the decimator and runs one detection on
+         * silence so the detector's buffers are allocated here.
+         * @param pitchTracking Detector range and stabilizer settings
+         * @param generation Generation reported once analysis threads use it
+         * @return Tracker ready to hand to an analysis thread
+         */
+        [[nodiscard]] std::unique_ptr<PitchTracker> CreatePitchTracker(const PitchTrackingConfig &pitchTracking,
+            uint32_t generation) const;
+
+        /**
+         * @brief Destroys the trackers the analysis threads swapped out (main thread)
+         */
+        void ReclaimPitchTrackers();
+
+        /**
+         * @brief Logs the detector range, decimation and stabilizer a pitch tracker is built with
+         * @param pitchTracking Settings to describe
+         */
+        void LogPitchTracking(const PitchTrackingConfig &pitchTracking) const;
+
+        /**
+         * @brief Builds callback buffers and a monitoring ring in one arena for a device buffer size and publishes them
+         * The callbacks swap them in at their next buffer; see ReprovisionBuffers() for the old ones.
+         * @param deviceFrames Device buffer size (frames) to provision for, before the safety margin
+         * @return false if the memory could not be reserved (the buffers in use, if any, stay)
+         */
+        bool ProvisionBuffers(size_t deviceFrames);
+
+        /**
+         * @brief Logs the size of the real-time memory arenas and how they are backed
+         */
+        void LogMemoryFootprint() const;
+
+        /**
+         * @brief Grows the callback buffers after an oversized device buffer and frees retired ones (main thread)
+         * Buffer descriptions are freed once the callback has swapped them out; the memory behind
+         * them once both callbacks use the newest set. A stopped output stream does not hold
+         * it back: its callback swaps in the newest set before it touches any buffer.
+         */
+        void ReprovisionBuffers();
+
+        /**
+         * @brief Checks whether MixFeedback() may run on a callback (main thread)
+         * @return true while the output stream (or the duplex stream) runs, or a device switch is in flight
+         */
+        [[nodiscard]] bool OutputCallbackMayRun() const;
+
+        /**
+         * @brief Gets the number of channels to capture from a device
+         * @param deviceInfo Device to open
+         * @return config.inputChannels limited to what the device reports (if it reports anything)
+         */
+        [[nodiscard]] uint32_t CaptureChannels(const GuitarIO::AudioDeviceInfo &deviceInfo) const;
+
+        /**
+         * @brief Gets the channel ConditionInput() meters and monitors on a stream
+         * @param capturedChannels Channels the stream delivers
+         * @return config.primaryChannel if the stream carries it, channel 0 otherwise
+         */
+        [[nodiscard]] uint32_t MonitoredChannel(uint32_t capturedChannels) const;
+
+        /**
+         * @brief Applies audioThreadScheduling on a stream's first owned buffer (real-time thread)
+         * The callback thread belongs to the audio backend, so this is the first point we run on it.
+         * @param stream Stream whose callback is running
+         * @param diagnostics Queue of the calling thread, receives the outcome
+         * @param source Calling thread
+         */
+        void ScheduleAudioThread(StreamContext &stream,
+            Audio::DiagnosticQueue &diagnostics,
+            Audio::DiagnosticSource source);
+
+        /**
+         * @brief Drains the diagnostic queues into the logger (main thread)
+         * Logs the first event of each code immediately and summarizes repeats at most once
+         * per kuDiagnosticLogIntervalMs, so error bursts cannot flood the log.
+         */
+        void DrainDiagnostics();
+
+        /**
+         * @brief Records and logs one ThreadScheduling diagnostic event (main thread)
+         * @param event Event raised by an audio or analysis thread
+         * @param channel Pipeline channel for analysis threads
+         */
+        void RecordScheduling(const Audio::DiagnosticEvent &event, uint32_t channel);
+
+        /**
+         * @brief Logs allocations and locks caught on the audio threads (main thread)
+         * Only reports anything in builds with ENABLE_RT_SAFETY_CHECKS.
+         */
+        void DrainRealtimeViolations();
+
+        /**
+         * @brief Logs device list changes published by the device catalog (main thread)
+         * Logs the full lists once after the first scan, then every device added or removed.
+         * Without an output device, the listed and later connected output devices are tried.
+         */
+        void DrainDeviceChanges();
+
+        /**
+         * @brief Switches to the first of the given devices that opens, if no output device is open (main thread)
+         * @param devices Candidate devices (ones without output channels are skipped)
+         * @param skipId Device already known to fail (the default one at startup)
+         */
+        void OpenMissingOutputDevice(std::span<const GuitarIO::AudioDeviceInfo> devices, uint32_t skipId);
+
+        /**
+         * @brief Opens the default input and output devices (constructor)
+         * Only the defaults are queried; the device catalog is started afterwards, so its first
+         * scan never runs concurrently with this.
+         */
+        void OpenInitialStreams();
+
+        /**
+         * @brief Formats and logs one diagnostic event (main thread)
+         * @param event Event to log
+         */
+        void LogDiagnostic(const Audio::DiagnosticEvent &event) const;
+
+        /**
+         * @brief Checks whether a device pair should share one full-duplex stream
+         * @param inputId Input device ID
+         * @param outputId Output device ID
+         * @return true if duplexMode asks for a single stream for this pair
+         */
+        [[nodiscard]] bool WantsDuplex(uint32_t inputId, uint32_t outputId) const;
+
+        /**
+         * @brief Opens and starts one stream with input and output channels on a device
+         * Uses inputDevice; outputDevice stays closed while duplex is active.
+         * @param deviceId Device to open
+         * @return true on success, false if the caller should fall back to separate streams
+         */
+        bool OpenDuplexStream(uint32_t deviceId);
+
+        /**
+         * @brief Closes both streams and reopens them for a new device pair
+         * Tries a full-duplex stream first (if wanted), then falls back to separate streams.
+         * @param inputId Input device ID
+         * @param outputId Output device ID
+         * @return true if audio I/O is running on the requested devices
+         */
+        bool ReopenStreams(uint32_t inputId, uint32_t outputId);
+
+        /**
+         * @brief Opens an input-only stream on inputDevice (separate-stream mode)
+         * @param deviceId Device to open; falls back to the default input on failure
+         * @return true if switched to deviceId
          */
-        void ProcessAudio(std::span<const float> inputBuffer);
+        bool OpenInputStream(uint32_t deviceId);
+
+        /**
+         * @brief Opens an output-only stream on outputDevice (separate-stream mode)
+         * @param deviceId Device to open; falls back to the default output on failure
+         * @return true if switched to deviceId
+         */
+        bool OpenOutputStream(uint32_t deviceId);
+
+        /**
+         * @brief Starts a background switch of one stream (main thread)
+         * Moves the current device into the switch and launches the worker; the old stream keeps running.
+         * @param output Switch the output stream (true) or the input stream (false)
+         * @param deviceId Device to switch to
+         * @return true if the worker was started
+         */
+        bool StartDeviceSwitch(bool output, uint32_t deviceId);
+
+        /**
+         * @brief Worker body of a background switch
+         * Opens and starts the new stream, offers it to the running stream, waits for the handoff
+         * (or stops the old stream after kuDeviceSwitchHandoffTimeoutMs) and closes the old stream.
+         * @param job Switch to run; only job fields and the job's stream slot are touched
+         * @param stopToken Stop request (destruction); cuts the handoff wait short
+         */
+        void RunDeviceSwitch(DeviceSwitch &job, std::stop_token stopToken);
+
+        /**
+         * @brief Completes a finished background switch and starts queued requests (main thread)
+         */
+        void PollDeviceSwitch();
+
+        /**
+         * @brief Joins the worker, installs the resulting device and logs the outcome (main thread)
+         */
+        void FinishDeviceSwitch();
+
+        /**
+         * @brief Feeds the callback heartbeats to the stream watchdogs and recovers stalled streams (main thread)
+         * Skipped while a background switch is in flight; the switch rearms the watchdogs when it ends.
+         */
+        void WatchStreams();
+
+        /**
+         * @brief Reopens a stalled stream on its device or on the system default device (main thread)
+         * @param output Output stream (true) or input stream (false)
+         * @param action Restart or FallBack, as asked for by the stream's watchdog
+         */
+        void RecoverStream(bool output, Audio::WatchdogAction action);
+
+        /**
+         * @brief Restarts the stall deadlines after the streams were (re)opened (main thread)
+         * Running streams get the startup time for their first buffer; closed ones are not watched.
+         */
+        void ArmWatchdogs();
+
+        /**
+         * @brief Applies a newly picked-up feedback parameter block to the generators (output thread)
+         * @param feedback Block to apply
+         * @param voicesChanged Chord voices differ from the previous block (voices are only set then)
+         */
+        void ApplyFeedbackParameters(const FeedbackParameters &feedback, bool voicesChanged);
 
         /**
          * @brief Mixes audio feedback into the output buffer
          * Adds beep, reference tone, and monitoring signal to the output.
          * @param outputBuffer Buffer to mix audio into
+         * @param channels Interleaved channels of outputBuffer
+         * @param directMonitor Conditioned input of the same duplex callback; std::nullopt reads
+         *                      monitoring audio from the ring filled by a separate input stream
          */
-        void MixFeedback(std::span<float> outputBuffer);
+        void MixFeedback(std::span<float> outputBuffer,
+            uint32_t channels,
+            std::optional<std::span<const float>> directMonitor = std::nullopt);
 
-        AudioProcessingLayerConfig config;                             ///< Layer configuration
-        std::unique_ptr<GuitarIO::AudioDevice> inputDevice;            ///< Audio input device
-        std::unique_ptr<GuitarIO::AudioDevice> outputDevice;           ///< Audio output device
-        std::unique_ptr<GuitarDSP::HybridPitchDetector> pitchDetector; ///< Pitch detection algorithm
-        std::unique_ptr<GuitarDSP::PitchStabilizer> pitchStabilizer;   ///< Pitch stabilization filter
+        /** Per-code diagnostic logging state (main thread only) */
+        struct DiagnosticLogState
+        {
+            uint64_t total = 0;                               ///< Events seen (queued + dropped)
+            uint64_t suppressed = 0;                          ///< Events not yet reported in a log line
+            Audio::DiagnosticEvent lastEvent;                 ///< Most recent event of this code
+            std::chrono::steady_clock::time_point lastLogged; ///< When this code was last logged
+        };
 
-        // Lock‑free communication
-        std::atomic<float> latestFrequency;       ///< Latest detected frequency (Hz)
-        std::atomic<float> latestConfidence;      ///< Latest detection confidence [0.0, 1.0]
-        std::atomic<bool> pitchDetected;          ///< Whether pitch was detected in last frame
-        std::atomic<bool> bufferOverflowDetected; ///< Flag set if audio buffer overflow occurs
+        AudioProcessingLayerConfig config;                   ///< Layer configuration
+        std::unique_ptr<GuitarIO::AudioDevice> inputDevice;  ///< Audio input device
+        std::unique_ptr<GuitarIO::AudioDevice> outputDevice; ///< Audio output device
 
-        // Pre‑allocated processing buffer
-        std::vector<float> processingBuffer;    ///< Buffer for DSP processing
-        std::vector<float> outputScratchBuffer; ///< Temporary buffer for output mixing
+        // Diagnostics (one queue per raising thread, drained by OnUpdate; analysis threads use their pipeline's)
+        Audio::DiagnosticQueue inputDiagnostics;                                   ///< Raised by InputCallback
+        Audio::DiagnosticQueue outputDiagnostics;                                  ///< Raised by OutputCallback
+        std::array<DiagnosticLogState, Audio::kDiagnosticCodeCount> diagnosticLog; ///< Per-code log throttling
+        SchedulingReport schedulingReport; ///< Scheduling outcomes collected from the diagnostics (main thread)
+        uint64_t realtimeViolationsUnrecorded; ///< Violations past the recorded ones, already summarized
+
+        // Pre‑allocated callback buffers (grown by ReprovisionBuffers(), never inside a callback)
+        Audio::RcuPointer<InputBuffers> inputBuffers;   ///< Processing and channel scratch (input callback reads)
+        Audio::RcuPointer<OutputBuffers> outputBuffers; ///< Mixing scratch (output callback reads)
+        size_t provisionedBufferFrames;                 ///< Device buffer size the buffers are built for (main thread)
 
         // Device tracking
-        uint32_t currentInputDeviceId;  ///< Active input device ID
-        uint32_t currentOutputDeviceId; ///< Active output device ID
-        uint32_t outputChannels;        ///< Number of output channels
+        uint32_t currentInputDeviceId;      ///< Active input device ID
+        uint32_t currentOutputDeviceId;     ///< Active output device ID
+        bool duplexActive;                  ///< Input and output share one stream on inputDevice
+        Audio::DeviceCatalog deviceCatalog; ///< Cached device lists, rescanned in the background
+        bool deviceListLogged;              ///< Lists from the first catalog scan have been logged
+
+        // Stream switching (the running stream hands the real-time state over to its replacement)
+        AudioDeviceFactory deviceFactory;           ///< Creates devices for background switches
+        std::array<StreamContext, 2> inputStreams;  ///< userData of the input (or duplex) stream slots
+        std::array<StreamContext, 2> outputStreams; ///< userData of the output stream slots
+        Audio::StreamHandoff inputHandoff;          ///< Input slot owning the analysis queue and ring producer
+        Audio::StreamHandoff outputHandoff;         ///< Output slot owning the ring consumer and generators
+        std::unique_ptr<DeviceSwitch> deviceSwitch; ///< Background switch in flight (main thread)
+        std::optional<uint32_t> queuedInputSwitch;  ///< Latest input device requested during a switch
+        std::optional<uint32_t> queuedOutputSwitch; ///< Latest output device requested during a switch
+
+        // Stream watchdogs (main thread; fed by the heartbeats below)
+        Audio::StreamWatchdog inputWatchdog;  ///< Watches the input (or duplex) stream
+        Audio::StreamWatchdog outputWatchdog; ///< Watches the output stream
+
+        // Ring buffer for input monitoring (input callback writes, output callback reads)
+        std::unique_ptr<CallbackMemory> callbackMemory; ///< Newest buffers and ring (main thread; callbacks use theirs)
+        size_t monitoringTargetFill;                    ///< Fill the reader trims back to (samples)
+
+        // Memory replaced by ProvisionBuffers(), freed once neither callback can still be using it (main thread)
+        std::vector<std::unique_ptr<CallbackMemory>> retiredCallbackMemory;
 
-        // Ring buffer for input monitoring
-        std::vector<float> monitoringRingBuffer; ///< Ring buffer for audio pass-through
-        std::atomic<size_t> monitoringWritePos;  ///< Write position in ring buffer
-        std::atomic<size_t> monitoringReadPos;   ///< Read position in ring buffer
+        // Analysis pipelines (pitch detection runs off the real-time callback, one thread per channel)
+        Audio::SeqLock<Audio::PreFilterConfig> preFilterSettings; ///< Pre-filter settings for the workers
+        std::atomic<uint32_t> preFilterVersion;                   ///< Bumped after each preFilterSettings store
+        Audio::MemoryArena analysisMemory;                        ///< Storage of every pipeline's sample queue
+        Audio::AnalysisPlan analysisPlan;                         ///< Window and hop for the stream rate
+        std::vector<std::unique_ptr<ChannelPipeline>> pipelines;  ///< Indexed by input channel
+        PitchTrackingConfig pitchTracking;                        ///< Settings last requested (main thread)
+        uint32_t pitchTrackingGeneration;                         ///< Bumped by each SetPitchTrackingConfig
+        std::atomic<uint32_t> monitoredChannel;                   ///< Primary channel of the open input stream
 
-        // Audio feedback generators and state
-        GuitarIO::SineWaveGenerator beepGenerator;         ///< Beep generator
+        // State shared with the callbacks, grouped by the thread writing it. Each group starts a
+        // cache line, so the meters and counters a callback bumps on every buffer never invalidate
+        // the lines the other callback or the main thread write, nor the settings they read.
+
+        // Settings (written by the main thread, read by the callbacks on every buffer)
+        alignas(Audio::kCacheLineSize) std::atomic<bool> inputMonitoringEnabled; ///< Feed the monitoring ring
+        std::atomic<float> inputGain;                               ///< Input signal gain
+        std::atomic<bool> inputStalled;                             ///< Input watchdog reports a stall
+        FeedbackParameters feedbackDraft;                           ///< Next block to publish (main thread)
+        Audio::TripleBuffer<FeedbackParameters> feedbackParameters; ///< Main thread -> output callback
+
+        // Input side (written by the input callback)
+        alignas(Audio::kCacheLineSize) std::atomic<float> currentInputLevel; ///< Current input peak level
+        std::atomic<float> currentInputRms;             ///< Current input RMS level
+        std::atomic<bool> bufferOverflowDetected;       ///< Set if an input buffer was truncated
+        std::atomic<size_t> oversizedBufferFrames;      ///< Largest truncated buffer since the last OnUpdate
+        std::atomic<uint64_t> monitoringOverruns;       ///< Input blocks that did not fit the ring
+        std::atomic<uint64_t> monitoringDroppedSamples; ///< Samples lost to overruns
+        std::atomic<uint64_t> inputHeartbeats;          ///< Input buffers conditioned (watchdog heartbeat)
+
+        // Output side (written by the output callback)
+        alignas(Audio::kCacheLineSize) GuitarIO::SineWaveGenerator beepGenerator; ///< Beep generator
         GuitarIO::SineWaveGenerator referenceGenerator;    ///< Reference tone generator
         GuitarIO::PolyphonicGenerator polyphonicGenerator; ///< Polyphonic generator
-
-        std::atomic<bool> beepEnabled;            ///< Beep feedback enabled
-        std::atomic<bool> referenceEnabled;       ///< Reference tone enabled
-        std::atomic<bool> inputMonitoringEnabled; ///< Input monitoring enabled
-        std::atomic<bool> droneEnabled;           ///< Drone mode enabled
-        std::atomic<bool> polyphonicEnabled;      ///< Polyphonic mode enabled
-
-        std::atomic<float> beepVolume;         ///< Beep volume
-        std::atomic<float> referenceVolume;    ///< Reference tone volume
-        std::atomic<float> monitoringVolume;   ///< Monitoring volume
-        std::atomic<float> inputGain;          ///< Input signal gain
-        std::atomic<float> referenceFrequency; ///< Reference frequency
-        std::atomic<float> currentInputLevel;  ///< Current input RMS level
+        std::atomic<uint64_t> monitoringUnderruns;         ///< Output blocks the ring could not fill
+        std::atomic<uint64_t> monitoringMissingSamples;    ///< Samples of silence inserted
+        std::atomic<uint64_t> monitoringLatencyTrims;      ///< Skip-aheads to the target fill
+        std::atomic<uint64_t> monitoringTrimmedSamples;    ///< Samples skipped by trims
+        std::atomic<uint64_t> feedbackVersionApplied;      ///< Version the output callback picked up
+        std::atomic<uint64_t> outputHeartbeats;            ///< Output buffers mixed (watchdog heartbeat)
+        uint64_t outputFramesRendered;                     ///< Output frames rendered so far
     };
 
 } // namespace PrecisionTuner::Layers
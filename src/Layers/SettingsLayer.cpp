@@ -17,7 +17,7 @@ namespace PrecisionTuner::Layers
         PrecisionTuner::Config &config)
         : audioLayer(audioLayer), tunerLayer(tunerLayer), config(config), showSettings(true), showAboutDialog(false),
           showKeyboardShortcuts(false), selectedInputDeviceIndex(0), availableInputDevices({}),
-          selectedOutputDeviceIndex(0), availableOutputDevices({})
+          inputDeviceGeneration(0), selectedOutputDeviceIndex(0), availableOutputDevices({}), outputDeviceGeneration(0)
     {
         LOG_INFO("SettingsLayer - Initializing");
     }
@@ -87,31 +87,36 @@ namespace PrecisionTuner::Layers
     {
         ImGui::TextColored(ImVec4(0.8f, 0.9f, 1.0f, 1.0f), "Audio Input Device");
 
-        // Refresh device list on first render
-        static bool firstTime = true;
-        if (firstTime)
+        // Lists come from the device catalog snapshot (scanned in the background, never on this frame)
+        auto &deviceCatalog = audioLayer.GetDeviceCatalog();
+        const auto snapshot = deviceCatalog.GetSnapshot();
+        if (snapshot->generation != inputDeviceGeneration)
         {
-            availableInputDevices = audioLayer.GetAvailableInputDeviceInfo();
-            firstTime = false;
+            availableInputDevices = snapshot->inputDevices;
+            inputDeviceGeneration = snapshot->generation;
 
-            // Find current device in list
+            // Find current device in list (indices shift when devices are plugged in or removed)
             uint32_t currentDeviceId = audioLayer.GetCurrentInputDeviceId();
             auto it = std::ranges::find_if(
                 availableInputDevices, [currentDeviceId](const auto &device) { return device.id == currentDeviceId; });
 
-            if (it != availableInputDevices.end())
-            {
-                selectedInputDeviceIndex = static_cast<int>(std::distance(availableInputDevices.begin(), it));
-            }
+            selectedInputDeviceIndex = it != availableInputDevices.end()
+                                             ? static_cast<int>(std::distance(availableInputDevices.begin(), it))
+                                             : -1;
         }
 
         if (ImGui::Button("Refresh Input Devices"))
         {
-            availableInputDevices = audioLayer.GetAvailableInputDeviceInfo();
-            LOG_INFO("Input device list refreshed - {} devices found", availableInputDevices.size());
+            deviceCatalog.RequestRefresh();
+            LOG_INFO("Input device rescan requested");
         }
 
         // Device dropdown
+        if (snapshot->generation == 0)
+        {
+            ImGui::TextDisabled("Scanning audio devices...");
+            return;
+        }
         if (availableInputDevices.empty())
         {
             ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "No audio input devices found!");
@@ -142,7 +147,7 @@ namespace PrecisionTuner::Layers
                         {
                             config.audio.deviceId = static_cast<int>(deviceId);
                             config.audio.deviceName = availableInputDevices[i].name;
-                            LOG_INFO("Input device switched successfully");
+                            LOG_INFO("Input device switch started");
                         }
                         else
                         {
@@ -169,6 +174,37 @@ namespace PrecisionTuner::Layers
             const auto &device = availableInputDevices[selectedInputDeviceIndex];
             ImGui::TextDisabled("Channels: %u | ID: %u", device.maxInputChannels, device.id);
         }
+        RenderStreamHealth(audioLayer.GetWatchdogReport().input, "Input");
+    }
+
+    void SettingsLayer::RenderStreamHealth(const Audio::StreamHealth &health, const char *direction)
+    {
+        if (health.status == Audio::StreamStatus::Stalled)
+        {
+            ImGui::TextColored(ImVec4(1.0f, 0.6f, 0.2f, 1.0f),
+                "%s stream stalled - recovering (attempt %u)",
+                direction,
+                health.attempts);
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("The device stopped delivering audio\n"
+                                  "The stream is restarted, then moved to the system default device");
+            }
+        }
+        else if (health.recoveries > 0)
+        {
+            ImGui::TextDisabled("Recovered from %llu stall(s) | Last recovery: %.0f ms",
+                static_cast<unsigned long long>(health.recoveries),
+                health.lastRecoveryMs);
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("Audio lost for %.0f ms in the last stall\nLongest recovery: %.0f ms\n"
+                                  "Fallbacks to the default device: %llu",
+                    health.lastOutageMs,
+                    health.maxRecoveryMs,
+                    static_cast<unsigned long long>(health.fallbacks));
+            }
+        }
     }
 
     void SettingsLayer::RenderReferencePitchSlider()
@@ -244,31 +280,36 @@ namespace PrecisionTuner::Layers
     {
         ImGui::TextColored(ImVec4(0.8f, 0.9f, 1.0f, 1.0f), "Audio Output Device");
 
-        // Refresh device list on first render
-        static bool firstTimeOutput = true;
-        if (firstTimeOutput)
+        // Lists come from the device catalog snapshot (scanned in the background, never on this frame)
+        auto &deviceCatalog = audioLayer.GetDeviceCatalog();
+        const auto snapshot = deviceCatalog.GetSnapshot();
+        if (snapshot->generation != outputDeviceGeneration)
         {
-            availableOutputDevices = audioLayer.GetAvailableOutputDeviceInfo();
-            firstTimeOutput = false;
+            availableOutputDevices = snapshot->outputDevices;
+            outputDeviceGeneration = snapshot->generation;
 
-            // Find current device in list
+            // Find current device in list (indices shift when devices are plugged in or removed)
             uint32_t currentDeviceId = audioLayer.GetCurrentOutputDeviceId();
             auto it = std::ranges::find_if(
                 availableOutputDevices, [currentDeviceId](const auto &device) { return device.id == currentDeviceId; });
 
-            if (it != availableOutputDevices.end())
-            {
-                selectedOutputDeviceIndex = static_cast<int>(std::distance(availableOutputDevices.begin(), it));
-            }
+            selectedOutputDeviceIndex = it != availableOutputDevices.end()
+                                             ? static_cast<int>(std::distance(availableOutputDevices.begin(), it))
+                                             : -1;
         }
 
         if (ImGui::Button("Refresh Output Devices"))
         {
-            availableOutputDevices = audioLayer.GetAvailableOutputDeviceInfo();
-            LOG_INFO("Output device list refreshed - {} devices found", availableOutputDevices.size());
+            deviceCatalog.RequestRefresh();
+            LOG_INFO("Output device rescan requested");
         }
 
         // Device dropdown
+        if (snapshot->generation == 0)
+        {
+            ImGui::TextDisabled("Scanning audio devices...");
+            return;
+        }
         if (availableOutputDevices.empty())
         {
             ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "No audio output devices found!");
@@ -299,7 +340,7 @@ namespace PrecisionTuner::Layers
                         {
                             config.audio.outputDeviceId = static_cast<int>(deviceId);
                             config.audio.outputDeviceName = availableOutputDevices[i].name;
-                            LOG_INFO("Output device switched successfully");
+                            LOG_INFO("Output device switch started");
                         }
                         else
                         {
@@ -327,6 +368,7 @@ namespace PrecisionTuner::Layers
             const auto &device = availableOutputDevices[selectedOutputDeviceIndex];
             ImGui::TextDisabled("Channels: %u | ID: %u", device.maxOutputChannels, device.id);
         }
+        RenderStreamHealth(audioLayer.GetWatchdogReport().output, "Output");
     }
 
     void SettingsLayer::RenderAudioFeedbackControls()
@@ -436,6 +478,32 @@ namespace PrecisionTuner::Layers
             ImGui::SameLine();
             ImGui::TextDisabled("Level");
 
+            // Monitoring latency and dropout counters
+            const MonitoringStats monitoringStats = audioLayer.GetMonitoringStats();
+            if (monitoringStats.duplex)
+            {
+                ImGui::TextDisabled("Latency: %.1f ms (full duplex)", monitoringStats.latencyMs);
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("Input and output share one stream: monitoring audio is mixed\n"
+                                      "in the same callback without an intermediate ring");
+                }
+            }
+            else
+            {
+                ImGui::TextDisabled("Latency: %.1f ms | Overruns: %llu | Underruns: %llu",
+                    monitoringStats.latencyMs,
+                    static_cast<unsigned long long>(monitoringStats.overruns),
+                    static_cast<unsigned long long>(monitoringStats.underruns));
+                if (ImGui::IsItemHovered())
+                {
+                    ImGui::SetTooltip("Queued monitoring audio (target %zu frames)\nOverruns drop input, underruns "
+                                      "insert silence\nLatency trims: %llu",
+                        monitoringStats.targetFill,
+                        static_cast<unsigned long long>(monitoringStats.latencyTrims));
+                }
+            }
+
             ImGui::PopItemWidth();
             ImGui::Unindent();
         }
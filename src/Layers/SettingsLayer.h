@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Layer.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <AudioDeviceManager.h>
@@ -56,6 +57,13 @@ namespace PrecisionTuner::Layers
          */
         void RenderOutputDeviceSelector();
 
+        /**
+         * @brief Renders the watchdog status line of one device stream (nothing while all is well)
+         * @param health Stream health from AudioProcessingLayer::GetWatchdogReport()
+         * @param direction "Input" or "Output"
+         */
+        static void RenderStreamHealth(const Audio::StreamHealth &health, const char *direction);
+
         /**
          * @brief Renders reference pitch adjustment slider (A=430-450 Hz)
          */
@@ -104,10 +112,12 @@ namespace PrecisionTuner::Layers
         // Input device selection
         int selectedInputDeviceIndex;                                 ///< Currently selected input device index
         std::vector<GuitarIO::AudioDeviceInfo> availableInputDevices; ///< List of available input devices
+        uint64_t inputDeviceGeneration;                               ///< Catalog snapshot the input list came from
 
         // Output device selection
         int selectedOutputDeviceIndex;                                 ///< Currently selected output device index
         std::vector<GuitarIO::AudioDeviceInfo> availableOutputDevices; ///< List of available output devices
+        uint64_t outputDeviceGeneration;                               ///< Catalog snapshot the output list came from
     };
 
 } // namespace PrecisionTuner::Layers
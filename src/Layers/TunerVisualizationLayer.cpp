@@ -26,10 +26,15 @@ namespace PrecisionTuner::Layers
 {
     TunerVisualizationLayer::TunerVisualizationLayer(AudioProcessingLayer &audioLayer, PrecisionTuner::Config &config)
         : audioLayer(audioLayer), config(config), currentNote(std::nullopt), updateTimer(0.0f), hasPitchData(false),
-          showSettingsPanel(true), targetStringIndex(std::nullopt), smoothedCents(0.0f), woodBackgroundTexture(0),
-          gaugeFaceTexture(0), chromeTexture(0)
+          showSettingsPanel(true), targetStringIndex(std::nullopt), smoothedCents(0.0f), lastPitchSequence(0),
+          pitchFrameScratch({}), confidentFrequencies({}), woodBackgroundTexture(0), gaugeFaceTexture(0),
+          chromeTexture(0)
     {
         LOG_INFO("TunerVisualizationLayer - Initializing tuner UI");
+
+        // Sized for the whole history so one read per tick never truncates
+        pitchFrameScratch.resize(audioLayer.GetPitchHistoryCapacity());
+        confidentFrequencies.reserve(pitchFrameScratch.size());
         InitializeTextures();
     }
 
@@ -57,8 +62,31 @@ namespace PrecisionTuner::Layers
         {
             updateTimer = 0.0f;
 
-            // Get latest pitch data from audio layer
-            auto pitchData = audioLayer.GetLatestPitch();
+            // Gather every analysis frame produced since the last tick
+            const size_t frameCount = audioLayer.ReadPitchHistorySince(lastPitchSequence, pitchFrameScratch);
+
+            PitchFrame pitchData;
+            float confidenceSum = 0.0f;
+            confidentFrequencies.clear();
+            for (size_t i = 0; i < frameCount; ++i)
+            {
+                const PitchFrame &frame = pitchFrameScratch[i];
+                if (frame.detected && frame.confidence > 0.7f)
+                {
+                    confidentFrequencies.push_back(frame.frequency);
+                    confidenceSum += frame.confidence;
+                }
+            }
+
+            // Median of the confident frames rejects the odd octave error within a tick
+            if (!confidentFrequencies.empty())
+            {
+                auto middle = confidentFrequencies.begin() + confidentFrequencies.size() / 2;
+                std::nth_element(confidentFrequencies.begin(), middle, confidentFrequencies.end());
+                pitchData.frequency = *middle;
+                pitchData.confidence = confidenceSum / static_cast<float>(confidentFrequencies.size());
+                pitchData.detected = true;
+            }
 
             if (pitchData.detected && pitchData.confidence > 0.7f)
             {
@@ -3,6 +3,7 @@
 #include <Layer.h>
 #include <imgui.h>
 #include <optional>
+#include <vector>
 #include <AudioProcessingLayer.h>
 #include <Config.h>
 #include <NoteConverter.h>
@@ -92,6 +93,11 @@ namespace PrecisionTuner::Layers
 
         float smoothedCents; ///< Smoothed cent deviation for display
 
+        // Pitch history consumption (every analysis frame, not just the latest one per UI tick)
+        uint64_t lastPitchSequence;                ///< Sequence of the last pitch frame consumed
+        std::vector<PitchFrame> pitchFrameScratch; ///< Frames read from the audio layer since the last tick
+        std::vector<float> confidentFrequencies;   ///< Confident frequencies from the last tick (for the median)
+
         // Texture IDs for visual assets
         ImTextureID woodBackgroundTexture; ///< Wood background texture
         ImTextureID gaugeFaceTexture;      ///< Cream gauge face texture
@@ -13,6 +13,39 @@ PrecisionGuitarTunerApp::PrecisionGuitarTunerApp()
     PrecisionTuner::Layers::AudioProcessingLayerConfig audioLayerConfig;
     audioLayerConfig.sampleRate = static_cast<uint32_t>(config.audio.sampleRate);
     audioLayerConfig.bufferSize = static_cast<uint32_t>(config.audio.bufferSize);
+    // Capture at least up to the selected channel so inputChannel is honoured on its own
+    audioLayerConfig.primaryChannel = static_cast<uint32_t>(std::max(config.audio.inputChannel, 0));
+    audioLayerConfig.inputChannels =
+        static_cast<uint32_t>(std::max(config.audio.inputChannelCount, config.audio.inputChannel + 1));
+
+    const auto &scheduling = config.audio.scheduling;
+    const auto toCpuList = [](const std::vector<int> &cpus) {
+        std::vector<uint32_t> list;
+        for (const int cpu : cpus)
+        {
+            if (cpu >= 0)
+            {
+                list.push_back(static_cast<uint32_t>(cpu));
+            }
+        }
+        return list;
+    };
+    audioLayerConfig.lockMemory = scheduling.lockMemory;
+    audioLayerConfig.audioThreadScheduling = { .realtime = scheduling.realtimeAudio,
+        .priority = scheduling.audioPriority,
+        .cpus = toCpuList(scheduling.audioCpus) };
+    audioLayerConfig.analysisThreadScheduling = { .realtime = scheduling.realtimeAnalysis,
+        .priority = scheduling.analysisPriority,
+        .cpus = toCpuList(scheduling.analysisCpus) };
+    audioLayerConfig.memoryArena.hugePages = scheduling.hugePages;
+
+    const auto &watchdog = config.audio.watchdog;
+    audioLayerConfig.watchdog = { .enabled = watchdog.enabled,
+        .stallBuffers = static_cast<uint32_t>(std::max(watchdog.stallBuffers, 1)),
+        .startupMs = static_cast<uint32_t>(std::max(watchdog.startupMs, 0)),
+        .restartAttempts = static_cast<uint32_t>(std::max(watchdog.restartAttempts, 0)),
+        .backoffMs = static_cast<uint32_t>(std::max(watchdog.backoffMs, 0)),
+        .maxBackoffMs = static_cast<uint32_t>(std::max(watchdog.maxBackoffMs, 0)) };
 
     PushLayer<PrecisionTuner::Layers::AudioProcessingLayer>(audioLayerConfig);
 
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <AnalysisPlan.h>
+
+using PrecisionTuner::Audio::AnalysisPlan;
+using PrecisionTuner::Audio::AnalysisTiming;
+using PrecisionTuner::Audio::DecimationConfig;
+using PrecisionTuner::Audio::PlanAnalysis;
+
+TEST(AnalysisPlan, ReferenceRateKeepsConfiguredSizes)
+{
+    const AnalysisPlan plan = PlanAnalysis(48000, {}, {}, 80.0f, 1200.0f);
+    EXPECT_EQ(plan.sampleRate, 48000u);
+    EXPECT_EQ(plan.windowSize, 4096u);
+    EXPECT_EQ(plan.hopSize, 512u);
+    EXPECT_EQ(plan.decimationFactor, 4u);
+    EXPECT_FLOAT_EQ(plan.detectionRate, 12000.0f);
+    EXPECT_EQ(plan.decimatedWindowSize, 1024u);
+    EXPECT_EQ(plan.minLag, 10u);  // 1200 Hz at 12 kHz
+    EXPECT_EQ(plan.maxLag, 150u); // 80 Hz at 12 kHz
+    EXPECT_EQ(plan.refineRadius, 4u);
+    EXPECT_EQ(plan.refineStride, 1u);
+    EXPECT_EQ(plan.minDetectionSamples, 1200u);
+}
+
+TEST(AnalysisPlan, SizesKeepTheirDurationAtAnyRate)
+{
+    for (const uint32_t sampleRate : { 44100u, 88200u, 96000u, 176400u, 192000u })
+    {
+        const AnalysisPlan plan = PlanAnalysis(sampleRate, {}, {}, 80.0f, 1200.0f);
+        const auto ms = [sampleRate](uint32_t samples) { return 1000.0f * samples / static_cast<float>(sampleRate); };
+        EXPECT_NEAR(ms(plan.windowSize), 85.33f, 0.05f) << sampleRate;
+        EXPECT_NEAR(ms(plan.hopSize), 10.67f, 0.05f) << sampleRate;
+        EXPECT_NEAR(static_cast<double>(plan.minDetectionSamples), sampleRate / 40.0, 1.0) << sampleRate; // 2 x 80 Hz
+    }
+}
+
+TEST(AnalysisPlan, DetectorWorkStaysFlatAsTheRateGoesUp)
+{
+    struct Expected
+    {
+        uint32_t sampleRate;
+        uint32_t factor;
+        uint32_t stride;
+    };
+    for (const Expected &expected : { Expected{ 44100, 3, 1 },
+             Expected{ 96000, 8, 2 },
+             Expected{ 192000, 16, 4 } })
+    {
+        const AnalysisPlan plan = PlanAnalysis(expected.sampleRate, {}, {}, 80.0f, 1200.0f);
+        EXPECT_EQ(plan.decimationFactor, expected.factor) << expected.sampleRate;
+        EXPECT_EQ(plan.refineStride, expected.stride) << expected.sampleRate;
+        EXPECT_EQ(plan.refineRadius, expected.factor) << expected.sampleRate;
+
+        // Detection rate, decimated window and lag range stay close to their 48 kHz values
+        EXPECT_GE(plan.detectionRate, 12000.0f) << expected.sampleRate;
+        EXPECT_LE(plan.detectionRate, 14700.0f) << expected.sampleRate;
+        EXPECT_LE(plan.decimatedWindowSize, 1254u) << expected.sampleRate;
+        EXPECT_LE(plan.maxLag, 184u) << expected.sampleRate;
+    }
+}
+
+TEST(AnalysisPlan, DecimationLimitScalesWithTheRate)
+{
+    // A band limited to the low strings: capped at 8 at 48 kHz, at 32 at 192 kHz
+    EXPECT_EQ(PlanAnalysis(48000, {}, {}, 80.0f, 400.0f).decimationFactor, 8u);
+    EXPECT_EQ(PlanAnalysis(192000, {}, {}, 80.0f, 400.0f).decimationFactor, 32u);
+
+    DecimationConfig disabled;
+    disabled.enabled = false;
+    const AnalysisPlan plan = PlanAnalysis(192000, {}, disabled, 80.0f, 1200.0f);
+    EXPECT_EQ(plan.decimationFactor, 1u);
+    EXPECT_EQ(plan.refineStride, 1u);
+    EXPECT_EQ(plan.decimatedWindowSize, plan.windowSize);
+    EXPECT_EQ(plan.maxLag, 2400u);
+}
+
+TEST(AnalysisPlan, ZeroReferenceRateUsesSizesAsGiven)
+{
+    const AnalysisTiming timing{ .windowSize = 2048, .hopSize = 4096, .referenceRate = 0 };
+    const AnalysisPlan plan = PlanAnalysis(96000, timing, {}, 80.0f, 1200.0f);
+    EXPECT_EQ(plan.windowSize, 2048u);
+    EXPECT_EQ(plan.hopSize, 2048u); // Never more than one window
+    EXPECT_EQ(plan.decimationFactor, 8u);
+    EXPECT_EQ(plan.refineStride, 1u);
+}
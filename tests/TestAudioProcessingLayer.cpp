@@ -1,10 +1,14 @@
 #include "mocks/MockAudioDevice.h"
+#include "mocks/PluckSignal.h"
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <cmath>
 #include <numbers>
+#include <random>
+#include <thread>
 #include <AudioProcessingLayer.h>
 #include <Config.h>
+#include <Constants.h>
 
 using namespace PrecisionTuner::Layers;
 
@@ -150,6 +154,7 @@ TEST_F(AudioProcessingLayerTest, DetectsPitchCorrectly)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
 
     EXPECT_TRUE(result.detected) << "Pitch not detected. Frequency: " << result.frequency
@@ -174,6 +179,7 @@ TEST_F(AudioProcessingLayerTest, DetectsLowEString)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
 
     EXPECT_TRUE(result.detected);
@@ -196,6 +202,7 @@ TEST_F(AudioProcessingLayerTest, DetectsHighEString)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
 
     EXPECT_TRUE(result.detected);
@@ -212,6 +219,7 @@ TEST_F(AudioProcessingLayerTest, HandlesSilence)
 
     inputDevice->TriggerCallback(buffer, output);
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
     EXPECT_FALSE(result.detected);
 }
@@ -233,6 +241,7 @@ TEST_F(AudioProcessingLayerTest, HandlesLowAmplitudeSignal)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
     // May or may not detect depending on threshold, but shouldn't crash
     EXPECT_GE(result.confidence, 0.0f);
@@ -256,6 +265,141 @@ TEST_F(AudioProcessingLayerTest, DetectsBufferOverflow)
     EXPECT_FALSE(layer->CheckBufferOverflow()); // Should be cleared after check
 }
 
+TEST_F(AudioProcessingLayerTest, ReportsOverflowThroughDiagnosticQueue)
+{
+    std::vector<float> hugeBuffer(9000, 0.0f);
+    std::vector<float> output(9000);
+
+    // Events stay queued until the main thread drains them
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_EQ(layer->GetDiagnosticCount(PrecisionTuner::Audio::DiagnosticCode::InputBufferOverflow), 0u);
+
+    // A burst far larger than the queue is still fully counted (OnUpdate then grows the buffers)
+    for (int i = 0; i < 200; ++i)
+    {
+        inputDevice->TriggerCallback(hugeBuffer, output);
+    }
+    layer->OnUpdate(0.016f);
+    EXPECT_EQ(layer->GetDiagnosticCount(PrecisionTuner::Audio::DiagnosticCode::InputBufferOverflow), 201u);
+}
+
+TEST_F(AudioProcessingLayerTest, GrowsBuffersAfterOversizedDeviceBuffer)
+{
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    // Peak past the 8192 pre-allocated frames: lost while the buffer is truncated
+    std::vector<float> hugeBuffer(9000, 0.1f);
+    hugeBuffer[8500] = 0.9f;
+    std::vector<float> output(9000);
+
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_TRUE(layer->CheckBufferOverflow());
+    EXPECT_FLOAT_EQ(layer->GetInputLevel(), 0.1f);
+    const size_t ringCapacity = layer->GetMonitoringStats().capacity;
+    const size_t arenaBytes = layer->GetMemoryFootprint().callbackBuffers.reservedBytes;
+
+    // The main thread grows the buffers; the callback swaps them in at its next buffer
+    layer->OnUpdate(0.016f);
+    EXPECT_GT(layer->GetMemoryFootprint().callbackBuffers.reservedBytes, arenaBytes);
+    EXPECT_GE(layer->GetMonitoringStats().capacity, 4u * hugeBuffer.size());
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_FALSE(layer->CheckBufferOverflow());
+    EXPECT_FLOAT_EQ(layer->GetInputLevel(), 0.9f);
+    EXPECT_EQ(layer->GetMonitoringStats().fillLevel, hugeBuffer.size());
+    EXPECT_GT(layer->GetMonitoringStats().capacity, ringCapacity);
+
+    // Retired buffers are freed on later updates; the new ones stay in use
+    layer->OnUpdate(0.016f);
+    layer->OnUpdate(0.016f);
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_FALSE(layer->CheckBufferOverflow());
+    EXPECT_EQ(layer->GetDiagnosticCount(PrecisionTuner::Audio::DiagnosticCode::InputBufferOverflow), 1u);
+}
+
+TEST_F(AudioProcessingLayerTest, AnalysisQueuesTakeGrownDeviceBuffers)
+{
+    using PrecisionTuner::Audio::DiagnosticCode;
+
+    // Far past the configured 2048 frames, but within what the callback buffers grow to
+    std::vector<float> hugeBuffer(PrecisionTuner::Constants::kuMaxDeviceBufferFrames, 0.1f);
+    std::vector<float> output(hugeBuffer.size());
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_TRUE(layer->CheckBufferOverflow());
+    layer->OnUpdate(0.016f);
+    ASSERT_GE(layer->GetMemoryFootprint().callbackBuffers.usedBytes,
+        PrecisionTuner::Audio::MemoryArena::Footprint<float>(hugeBuffer.size()));
+
+    inputDevice->TriggerCallback(hugeBuffer, output);
+    EXPECT_FALSE(layer->CheckBufferOverflow());
+    ASSERT_TRUE(layer->FlushAnalysis(std::chrono::seconds(10)));
+    layer->OnUpdate(0.016f);
+    EXPECT_EQ(layer->GetDiagnosticCount(DiagnosticCode::AnalysisQueueOverrun), 0u);
+    EXPECT_EQ(layer->GetStreamSampleTime(), 8192u + hugeBuffer.size());
+}
+
+TEST_F(AudioProcessingLayerTest, FreesRetiredBuffersWithoutARunningOutputStream)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    auto outputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *splitInput = inputMock.get();
+    MockAudioDevice *splitOutput = outputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 2048;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    auto splitLayer = std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::move(outputMock));
+    ASSERT_FALSE(splitLayer->IsDuplexActive());
+
+    std::vector<float> hugeBuffer(9000, 0.1f);
+    std::vector<float> output(9000);
+    std::vector<float> stereoOutput(2 * 2048);
+    const auto grow = [&] {
+        splitInput->TriggerCallback(hugeBuffer, output);
+        splitLayer->OnUpdate(0.016f);
+        ASSERT_GT(splitLayer->GetMemoryFootprint().retiredBytes, 0u);
+        splitInput->TriggerCallback(hugeBuffer, output);
+        splitLayer->OnUpdate(0.016f);
+    };
+
+    // A running output stream still uses the old arena until its next buffer
+    grow();
+    EXPECT_GT(splitLayer->GetMemoryFootprint().retiredBytes, 0u);
+    splitOutput->TriggerCallback({}, stereoOutput);
+    splitLayer->OnUpdate(0.016f);
+    EXPECT_EQ(splitLayer->GetMemoryFootprint().retiredBytes, 0u);
+
+    // A stopped one does not: the arena goes once the input side has swapped
+    ASSERT_TRUE(splitOutput->Stop());
+    hugeBuffer.resize(40000, 0.1f);
+    output.resize(40000);
+    grow();
+    EXPECT_EQ(splitLayer->GetMemoryFootprint().retiredBytes, 0u);
+    EXPECT_EQ(splitLayer->GetMemoryFootprint().TotalBytes(),
+        splitLayer->GetMemoryFootprint().callbackBuffers.reservedBytes
+            + splitLayer->GetMemoryFootprint().analysisQueues.reservedBytes);
+}
+
+TEST_F(AudioProcessingLayerTest, CarvesBuffersFromMemoryArenas)
+{
+    using PrecisionTuner::Audio::MemoryArena;
+
+    // Processing, one channel scratch and mixing scratch (8192 frames each), then the 8192-sample ring
+    const MemoryFootprint footprint = layer->GetMemoryFootprint();
+    EXPECT_EQ(footprint.callbackBuffers.allocations, 4u);
+    EXPECT_EQ(footprint.callbackBuffers.usedBytes, 4 * MemoryArena::Footprint<float>(8192));
+    EXPECT_GE(footprint.callbackBuffers.reservedBytes, footprint.callbackBuffers.usedBytes);
+    EXPECT_EQ(footprint.analysisQueues.allocations, 1u);
+    EXPECT_EQ(footprint.TotalBytes(), footprint.callbackBuffers.reservedBytes + footprint.analysisQueues.reservedBytes);
+
+    // Locking is requested by default; whether the OS granted it depends on RLIMIT_MEMLOCK
+    EXPECT_NE(footprint.callbackBuffers.locked, PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+    EXPECT_EQ(footprint.callbackBuffers.hugePages, PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+}
+
 TEST_F(AudioProcessingLayerTest, HandlesMultipleSmallBuffers)
 {
     std::vector<float> buffer(2048);
@@ -268,12 +412,16 @@ TEST_F(AudioProcessingLayerTest, HandlesMultipleSmallBuffers)
     {
         FillSineWave(buffer, 440.0f, 48000, phaseIdx);
         inputDevice->TriggerCallback(buffer, output);
+
+        // Pace like a real device so the analysis queue never overruns and drops samples
+        ASSERT_TRUE(layer->FlushAnalysis());
     }
 
     // Should not overflow (main purpose of this test)
     EXPECT_FALSE(layer->CheckBufferOverflow());
 
     // Should detect pitch after processing many buffers
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto result = layer->GetLatestPitch();
     EXPECT_TRUE(result.detected);
     if (result.detected)
@@ -282,6 +430,170 @@ TEST_F(AudioProcessingLayerTest, HandlesMultipleSmallBuffers)
     }
 }
 
+TEST_F(AudioProcessingLayerTest, DetectsPitchFromSmallDeviceBuffers)
+{
+    // Device delivers 256-frame buffers; the analysis thread accumulates them into full analysis windows
+    std::vector<float> buffer(256);
+    std::vector<float> output(256);
+    int phaseIdx = 0;
+
+    for (int i = 0; i < 80; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        inputDevice->TriggerCallback(buffer, output);
+    }
+
+    ASSERT_TRUE(layer->FlushAnalysis());
+    auto result = layer->GetLatestPitch();
+    EXPECT_TRUE(result.detected);
+    if (result.detected)
+    {
+        EXPECT_NEAR(result.frequency, 440.0f, 10.0f);
+    }
+}
+
+// ============================================================================
+// Analysis Window Tests
+// ============================================================================
+
+/**
+ * @brief Creates a layer whose analysis window is decoupled from a small device buffer
+ */
+static std::unique_ptr<AudioProcessingLayer> MakeWindowedLayer(MockAudioDevice *&inputDevice,
+    uint32_t windowSize,
+    uint32_t hopSize)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    inputDevice = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 128;
+    config.analysisWindowSize = windowSize;
+    config.analysisHopSize = hopSize;
+    config.stabilizerType = StabilizerType::None;
+
+    return std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+}
+
+TEST_F(AudioProcessingLayerTest, SlidingWindowDetectsLowEWithTinyDeviceBuffers)
+{
+    // 128-frame buffers hold less than a quarter of one low E period; the 4096-sample window holds seven
+    MockAudioDevice *windowedInput = nullptr;
+    auto windowed = MakeWindowedLayer(windowedInput, 4096, 256);
+
+    std::vector<float> buffer(128);
+    std::vector<float> output(128);
+    int phaseIdx = 0;
+
+    for (int i = 0; i < 64; ++i)
+    {
+        FillSineWave(buffer, 82.41f, 48000, phaseIdx);
+        windowedInput->TriggerCallback(buffer, output);
+    }
+
+    ASSERT_TRUE(windowed->FlushAnalysis());
+    auto result = windowed->GetLatestPitch();
+    EXPECT_TRUE(result.detected);
+    if (result.detected)
+    {
+        EXPECT_NEAR(result.frequency, 82.41f, 2.0f);
+    }
+}
+
+TEST_F(AudioProcessingLayerTest, SlidingWindowWaitsForFullWindow)
+{
+    MockAudioDevice *windowedInput = nullptr;
+    auto windowed = MakeWindowedLayer(windowedInput, 4096, 256);
+
+    std::vector<float> buffer(128);
+    std::vector<float> output(128);
+    int phaseIdx = 0;
+
+    // 3968 samples: many hops, but one buffer short of a full window
+    for (int i = 0; i < 31; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        windowedInput->TriggerCallback(buffer, output);
+    }
+
+    ASSERT_TRUE(windowed->FlushAnalysis());
+    EXPECT_FALSE(windowed->GetLatestPitch().detected);
+
+    FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+    windowedInput->TriggerCallback(buffer, output);
+
+    ASSERT_TRUE(windowed->FlushAnalysis());
+    EXPECT_TRUE(windowed->GetLatestPitch().detected);
+}
+
+TEST_F(AudioProcessingLayerTest, PitchFrameCarriesSequenceAndStreamTime)
+{
+    // Default window is 4096 samples with a 512-sample hop
+    std::vector<float> buffer(2048);
+    std::vector<float> output(2048);
+    int phaseIdx = 0;
+
+    EXPECT_EQ(layer->GetLatestPitch().sequence, 0u);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        inputDevice->TriggerCallback(buffer, output);
+    }
+
+    ASSERT_TRUE(layer->FlushAnalysis());
+    auto first = layer->GetLatestPitch();
+
+    // 6144 samples: windows end at 4096, 4608, ..., 6144 -> 5 frames
+    EXPECT_EQ(first.sequence, 5u);
+    EXPECT_EQ(first.streamSampleTime, 6144u);
+    EXPECT_EQ(layer->GetStreamSampleTime(), 6144u);
+
+    FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+    inputDevice->TriggerCallback(buffer, output);
+
+    ASSERT_TRUE(layer->FlushAnalysis());
+    auto second = layer->GetLatestPitch();
+    EXPECT_EQ(second.sequence, first.sequence + 4);
+    EXPECT_EQ(second.streamSampleTime, 8192u);
+}
+
+TEST_F(AudioProcessingLayerTest, PitchHistoryKeepsEveryFrame)
+{
+    std::vector<float> buffer(2048);
+    std::vector<float> output(2048);
+    int phaseIdx = 0;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        inputDevice->TriggerCallback(buffer, output);
+    }
+    ASSERT_TRUE(layer->FlushAnalysis());
+
+    // 20480 samples with a 4096 window and 512 hop -> 33 frames
+    std::vector<PitchFrame> frames(layer->GetPitchHistoryCapacity());
+    uint64_t lastSequence = 0;
+    const size_t count = layer->ReadPitchHistorySince(lastSequence, frames);
+
+    ASSERT_EQ(count, 33u);
+    EXPECT_EQ(lastSequence, 33u);
+    for (size_t i = 0; i < count; ++i)
+    {
+        EXPECT_EQ(frames[i].sequence, i + 1);
+        EXPECT_TRUE(frames[i].detected);
+    }
+    EXPECT_EQ(frames[count - 1].sequence, layer->GetLatestPitch().sequence);
+
+    // Nothing new until more audio arrives
+    EXPECT_EQ(layer->ReadPitchHistorySince(lastSequence, frames), 0u);
+
+    std::vector<PitchFrame> latest(4);
+    ASSERT_EQ(layer->CopyPitchHistory(latest), 4u);
+    EXPECT_EQ(latest[3].sequence, 33u);
+}
+
 // ============================================================================
 // Input Level Monitoring Tests
 // ============================================================================
@@ -323,6 +635,20 @@ TEST_F(AudioProcessingLayerTest, InputLevelReflectsAmplitude)
     EXPECT_LT(quietLevel, loudLevel);
 }
 
+TEST_F(AudioProcessingLayerTest, TracksPeakAndRmsLevel)
+{
+    std::vector<float> buffer(2048);
+    std::vector<float> output(2048);
+    int phaseIdx = 0;
+
+    // Full-scale sine: peak 1.0, RMS 1/sqrt(2)
+    FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+    inputDevice->TriggerCallback(buffer, output);
+
+    EXPECT_NEAR(layer->GetInputLevel(), 1.0f, 0.01f);
+    EXPECT_NEAR(layer->GetInputRmsLevel(), 1.0f / std::sqrt(2.0f), 0.01f);
+}
+
 // ============================================================================
 // Audio Feedback Tests - Reference Tone
 // ============================================================================
@@ -408,6 +734,85 @@ TEST_F(AudioProcessingLayerTest, DisablesReferenceTone)
     EXPECT_FLOAT_EQ(maxAmp, 0.0f);
 }
 
+TEST_F(AudioProcessingLayerTest, FeedbackChangesApplyAtBufferBoundary)
+{
+    if (!layer->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    std::vector<float> input(512);
+    std::vector<float> output(512, 0.0f);
+    EXPECT_EQ(layer->GetAppliedFeedbackVersion(), 0u);
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableReference = true;
+    audioConfig.referenceVolume = 1.0f;
+    layer->UpdateAudioFeedback(audioConfig);
+    EXPECT_EQ(layer->GetAppliedFeedbackVersion(), 0u); // Published, not yet played
+    outputDevice->TriggerCallback(input, output);
+    EXPECT_EQ(layer->GetAppliedFeedbackVersion(), 1u);
+    EXPECT_GT(GetMaxAmplitude(output), 0.5f);
+
+    // Several changes between two buffers: only the newest is played
+    layer->SetPolyphonicFrequencies({ 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f });
+    audioConfig.enableReference = false;
+    layer->UpdateAudioFeedback(audioConfig);
+    audioConfig.enablePolyphonicMode = true;
+    audioConfig.referenceVolume = 0.6f;
+    layer->UpdateAudioFeedback(audioConfig);
+    outputDevice->TriggerCallback(input, output);
+    EXPECT_EQ(layer->GetAppliedFeedbackVersion(), 4u);
+    EXPECT_GT(GetMaxAmplitude(output), 0.0f);
+}
+
+TEST_F(AudioProcessingLayerTest, FeedbackUpdatesFromAnotherThreadNeverTear)
+{
+    if (!layer->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    // Two complete settings: loud 440 Hz reference, or quiet 220 Hz drone
+    PrecisionTuner::AudioConfig reference;
+    reference.enableReference = true;
+    reference.referenceFrequency = 440.0f;
+    reference.referenceVolume = 0.8f;
+    PrecisionTuner::AudioConfig drone;
+    drone.enableDroneMode = true;
+    drone.referenceFrequency = 220.0f;
+    drone.referenceVolume = 0.2f;
+
+    layer->UpdateAudioFeedback(drone);
+    std::atomic<bool> done = false;
+    std::thread settings([&]() {
+        for (int i = 0; !done.load(); ++i)
+        {
+            layer->UpdateAudioFeedback(i % 2 == 0 ? reference : drone);
+        }
+    });
+
+    std::vector<float> input(1024);
+    std::vector<float> output(2048, 0.0f); // 1024 stereo frames
+    for (int block = 0; block < 2000; ++block)
+    {
+        outputDevice->TriggerCallback(input, output);
+        const float peak = GetMaxAmplitude(output);
+        size_t crossings = 0;
+        for (size_t i = 1; i < output.size(); ++i)
+        {
+            crossings += (output[i - 1] < 0.0f) != (output[i] < 0.0f) ? 1 : 0;
+        }
+
+        // 1024 frames hold 9.4 periods at 440 Hz and 4.7 at 220 Hz; a mixed block would pair the wrong values
+        const bool loud440 = peak > 0.7f && crossings >= 17 && crossings <= 20;
+        const bool quiet220 = peak > 0.15f && peak < 0.25f && crossings >= 8 && crossings <= 11;
+        ASSERT_TRUE(loud440 || quiet220) << "block " << block << ": peak " << peak << ", " << crossings << " crossings";
+    }
+    done.store(true);
+    settings.join();
+}
+
 // ============================================================================
 // Audio Feedback Tests - Beep
 // ============================================================================
@@ -541,6 +946,444 @@ TEST_F(AudioProcessingLayerTest, InputMonitoringVolumeControl)
     EXPECT_LE(quietLevel, loudLevel);
 }
 
+TEST_F(AudioProcessingLayerTest, MonitoringCountsOverrunsWhenOutputStalls)
+{
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    std::vector<float> input(2048, 0.1f);
+    std::vector<float> dummyOutput(2048);
+
+    // No output callbacks: the ring fills up and further input is dropped, not wrapped over
+    const size_t capacity = layer->GetMonitoringStats().capacity;
+    const size_t blocks = capacity / input.size() + 2;
+    for (size_t i = 0; i < blocks; ++i)
+    {
+        inputDevice->TriggerCallback(input, dummyOutput);
+    }
+
+    MonitoringStats stats = layer->GetMonitoringStats();
+    EXPECT_EQ(stats.fillLevel, capacity);
+    EXPECT_EQ(stats.overruns, 2u);
+    EXPECT_EQ(stats.droppedSamples, 2u * input.size());
+    EXPECT_EQ(stats.underruns, 0u);
+}
+
+TEST_F(AudioProcessingLayerTest, MonitoringCountsUnderrunsWhenInputStarves)
+{
+    if (!layer->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    std::vector<float> input(256, 0.1f);
+    std::vector<float> dummyOutput(256);
+    inputDevice->TriggerCallback(input, dummyOutput);
+
+    // Request more frames than were queued (512 stereo or 1024 mono frames vs. 256 queued)
+    std::vector<float> emptyInput(1024, 0.0f);
+    std::vector<float> output(1024, 0.0f);
+    outputDevice->TriggerCallback(emptyInput, output);
+
+    MonitoringStats stats = layer->GetMonitoringStats();
+    EXPECT_EQ(stats.underruns, 1u);
+    EXPECT_GT(stats.missingSamples, 0u);
+    EXPECT_EQ(stats.fillLevel, 0u);
+    EXPECT_EQ(stats.overruns, 0u);
+}
+
+TEST_F(AudioProcessingLayerTest, MonitoringTrimsBackToTargetFill)
+{
+    if (!layer->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    std::vector<float> input(2048, 0.1f);
+    std::vector<float> dummyOutput(2048);
+    for (int i = 0; i < 3; ++i)
+    {
+        inputDevice->TriggerCallback(input, dummyOutput);
+    }
+
+    // Input ran ahead by three device buffers; one output callback brings latency back to the target
+    std::vector<float> emptyInput(512, 0.0f);
+    std::vector<float> output(512, 0.0f);
+    outputDevice->TriggerCallback(emptyInput, output);
+
+    MonitoringStats stats = layer->GetMonitoringStats();
+    EXPECT_EQ(stats.latencyTrims, 1u);
+    EXPECT_EQ(stats.fillLevel, stats.targetFill);
+    EXPECT_EQ(stats.underruns, 0u);
+    EXPECT_NEAR(stats.latencyMs, 1000.0f * 2048.0f / 48000.0f, 0.01f);
+}
+
+TEST_F(AudioProcessingLayerTest, MonitoringDisabledDrainsRing)
+{
+    if (!layer->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    std::vector<float> input(1024, 0.1f);
+    std::vector<float> dummyOutput(1024);
+    inputDevice->TriggerCallback(input, dummyOutput);
+    ASSERT_EQ(layer->GetMonitoringStats().fillLevel, input.size());
+
+    audioConfig.enableInputMonitoring = false;
+    layer->UpdateAudioFeedback(audioConfig);
+
+    std::vector<float> emptyInput(512, 0.0f);
+    std::vector<float> output(512, 0.0f);
+    outputDevice->TriggerCallback(emptyInput, output);
+
+    EXPECT_EQ(layer->GetMonitoringStats().fillLevel, 0u);
+    EXPECT_FLOAT_EQ(GetMaxAmplitude(output), 0.0f);
+}
+
+/**
+ * @brief Creates a layer that shares one full-duplex stream on the input device
+ */
+static std::unique_ptr<AudioProcessingLayer> MakeDuplexLayer(MockAudioDevice *&inputDevice,
+    MockAudioDevice *&outputDevice,
+    DuplexMode duplexMode)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    auto outputMock = std::make_unique<MockAudioDevice>();
+    inputDevice = inputMock.get();
+    outputDevice = outputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 512;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = duplexMode;
+
+    return std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::move(outputMock));
+}
+
+TEST_F(AudioProcessingLayerTest, DuplexModeMonitorsInSingleCallback)
+{
+    MockAudioDevice *duplexDevice = nullptr;
+    MockAudioDevice *unusedOutput = nullptr;
+    auto duplexLayer = MakeDuplexLayer(duplexDevice, unusedOutput, DuplexMode::Always);
+
+    ASSERT_TRUE(duplexLayer->IsDuplexActive());
+    EXPECT_TRUE(duplexLayer->IsOutputDeviceAvailable());
+    EXPECT_FALSE(unusedOutput->IsRunning());
+    const uint32_t channels = duplexDevice->GetConfig().outputChannels;
+    ASSERT_GE(channels, 1u);
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableInputMonitoring = true;
+    audioConfig.monitoringVolume = 1.0f;
+    duplexLayer->UpdateAudioFeedback(audioConfig);
+
+    // Input and output arrive in the same callback, so the monitored signal is audible immediately
+    std::vector<float> input(512);
+    std::vector<float> output(input.size() * channels, 0.0f);
+    int phaseIdx = 0;
+    FillSineWave(input, 440.0f, 48000, phaseIdx);
+    duplexDevice->TriggerCallback(input, output);
+
+    EXPECT_GT(GetMaxAmplitude(output), 0.0f);
+    const MonitoringStats stats = duplexLayer->GetMonitoringStats();
+    EXPECT_TRUE(stats.duplex);
+    EXPECT_EQ(stats.fillLevel, 0u);
+    EXPECT_EQ(stats.underruns, 0u);
+}
+
+TEST_F(AudioProcessingLayerTest, DuplexModeOffKeepsSeparateStreams)
+{
+    MockAudioDevice *splitInput = nullptr;
+    MockAudioDevice *splitOutput = nullptr;
+    auto splitLayer = MakeDuplexLayer(splitInput, splitOutput, DuplexMode::Off);
+
+    EXPECT_FALSE(splitLayer->IsDuplexActive());
+    EXPECT_FALSE(splitLayer->GetMonitoringStats().duplex);
+    EXPECT_EQ(splitInput->GetConfig().outputChannels, 0u);
+}
+
+// ============================================================================
+// Multi-Channel Capture Tests
+// ============================================================================
+
+TEST_F(AudioProcessingLayerTest, EachInputChannelHasItsOwnPitchPipeline)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *stereoInput = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 2048;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    config.inputChannels = 2;
+    config.primaryChannel = 1;
+    auto stereoLayer =
+        std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+    ASSERT_EQ(stereoLayer->GetInputChannelCount(), 2u);
+    EXPECT_EQ(stereoLayer->GetPrimaryChannel(), 1u);
+    ASSERT_EQ(stereoInput->GetConfig().inputChannels, 2u);
+
+    // A different string on each channel, interleaved as the device delivers it
+    std::vector<float> left(2048);
+    std::vector<float> right(2048);
+    std::vector<float> interleaved(left.size() * 2);
+    std::vector<float> output(2048);
+    int leftPhase = 0;
+    int rightPhase = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        FillSineWave(left, 110.0f, 48000, leftPhase);
+        FillSineWave(right, 329.63f, 48000, rightPhase);
+        for (size_t frame = 0; frame < left.size(); ++frame)
+        {
+            interleaved[2 * frame] = left[frame];
+            interleaved[2 * frame + 1] = right[frame];
+        }
+        stereoInput->TriggerCallback(interleaved, output);
+    }
+
+    // Two detectors share the CPU here, so allow more than the default flush timeout
+    ASSERT_TRUE(stereoLayer->FlushAnalysis(std::chrono::seconds(10)));
+    const PitchFrame leftPitch = stereoLayer->GetLatestPitch(0);
+    const PitchFrame rightPitch = stereoLayer->GetLatestPitch(1);
+    ASSERT_TRUE(leftPitch.detected);
+    ASSERT_TRUE(rightPitch.detected);
+    EXPECT_NEAR(leftPitch.frequency, 110.0f, 3.0f);
+    EXPECT_NEAR(rightPitch.frequency, 329.63f, 5.0f);
+    EXPECT_EQ(leftPitch.channel, 0u);
+    EXPECT_EQ(rightPitch.channel, 1u);
+
+    // The primary channel drives the single-channel accessors
+    EXPECT_EQ(stereoLayer->GetLatestPitch().sequence, rightPitch.sequence);
+    EXPECT_EQ(stereoLayer->GetStreamSampleTime(), 10u * left.size());
+    EXPECT_FALSE(stereoLayer->GetLatestPitch(2).detected);
+}
+
+TEST_F(AudioProcessingLayerTest, PrimaryChannelFollowsAMonoFallbackStream)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *stereoInput = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 2048;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    config.inputChannels = 2;
+    config.primaryChannel = 1;
+    auto stereoLayer =
+        std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+    ASSERT_EQ(stereoLayer->GetPrimaryChannel(), 1u);
+
+    // The new device fails to start, so the layer falls back to the default device in mono
+    stereoInput->SetStartResult(false);
+    EXPECT_FALSE(stereoLayer->SwitchInputDevice(stereoLayer->GetCurrentInputDeviceId() + 1));
+    ASSERT_EQ(stereoInput->GetConfig().inputChannels, 1u);
+    EXPECT_EQ(stereoLayer->GetPrimaryChannel(), 0u);
+
+    std::vector<float> input(2048);
+    std::vector<float> output(2048);
+    int phase = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        FillSineWave(input, 329.63f, 48000, phase);
+        stereoInput->TriggerCallback(input, output);
+    }
+
+    // The single-channel accessors read the channel the stream delivers, not the configured one
+    ASSERT_TRUE(stereoLayer->FlushAnalysis(std::chrono::seconds(10)));
+    const PitchFrame pitch = stereoLayer->GetLatestPitch();
+    ASSERT_TRUE(pitch.detected);
+    EXPECT_NEAR(pitch.frequency, 329.63f, 5.0f);
+    EXPECT_EQ(pitch.channel, 0u);
+    EXPECT_EQ(stereoLayer->GetStreamSampleTime(), 10u * input.size());
+
+    std::vector<PitchFrame> history(stereoLayer->GetPitchHistoryCapacity());
+    EXPECT_GT(stereoLayer->CopyPitchHistory(history), 0u);
+    uint64_t lastSequence = 0;
+    EXPECT_GT(stereoLayer->ReadPitchHistorySince(lastSequence, history), 0u);
+    EXPECT_EQ(lastSequence, pitch.sequence);
+}
+
+// ============================================================================
+// Background Device Switching Tests
+// ============================================================================
+
+/**
+ * @brief Creates a layer that switches devices in the background
+ * Every device the factory creates is recorded in created (main thread only).
+ */
+static std::unique_ptr<AudioProcessingLayer> MakeSwitchingLayer(MockAudioDevice *&inputDevice,
+    MockAudioDevice *&outputDevice,
+    std::vector<MockAudioDevice *> &created,
+    bool newDevicesOpen = true)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    auto outputMock = std::make_unique<MockAudioDevice>();
+    inputDevice = inputMock.get();
+    outputDevice = outputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 512;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+
+    return std::make_unique<AudioProcessingLayer>(config,
+        std::move(inputMock),
+        std::move(outputMock),
+        [&created, newDevicesOpen]() -> std::unique_ptr<GuitarIO::AudioDevice> {
+            auto device = std::make_unique<MockAudioDevice>();
+            device->SetOpenResult(newDevicesOpen);
+            created.push_back(device.get());
+            return device;
+        });
+}
+
+TEST_F(AudioProcessingLayerTest, BackgroundInputSwitchKeepsOldStreamUntilHandoff)
+{
+    std::vector<MockAudioDevice *> created;
+    MockAudioDevice *oldInput = nullptr;
+    MockAudioDevice *oldOutput = nullptr;
+    auto switching = MakeSwitchingLayer(oldInput, oldOutput, created);
+    const uint32_t previousId = switching->GetCurrentInputDeviceId();
+
+    ASSERT_TRUE(switching->SwitchInputDevice(previousId + 1));
+    ASSERT_EQ(created.size(), 1u);
+    MockAudioDevice *newInput = created[0];
+    EXPECT_TRUE(switching->IsDeviceSwitchPending());
+    EXPECT_EQ(switching->GetCurrentInputDeviceId(), previousId);
+
+    // The old stream keeps feeding the tuner until it hands over at a buffer boundary
+    std::vector<float> buffer(512);
+    std::vector<float> output(512);
+    int phaseIdx = 0;
+    bool switched = false;
+    for (int i = 0; i < 400 && !switched; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        oldInput->TriggerCallback(buffer, output);
+        switched = switching->WaitForDeviceSwitch(std::chrono::milliseconds(5));
+    }
+
+    ASSERT_TRUE(switched);
+    EXPECT_EQ(switching->GetCurrentInputDeviceId(), previousId + 1);
+    EXPECT_TRUE(switching->IsInputDeviceAvailable());
+    EXPECT_TRUE(newInput->IsRunning());
+
+    // The analysis timeline continues on the new stream
+    const uint64_t sampleTimeAtSwitch = switching->GetStreamSampleTime();
+    for (int i = 0; i < 16; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        newInput->TriggerCallback(buffer, output);
+        ASSERT_TRUE(switching->FlushAnalysis());
+    }
+
+    EXPECT_EQ(switching->GetStreamSampleTime(), sampleTimeAtSwitch + 16 * buffer.size());
+    auto result = switching->GetLatestPitch();
+    EXPECT_TRUE(result.detected);
+    EXPECT_NEAR(result.frequency, 440.0f, 10.0f);
+}
+
+TEST_F(AudioProcessingLayerTest, FailedBackgroundSwitchKeepsCurrentStream)
+{
+    std::vector<MockAudioDevice *> created;
+    MockAudioDevice *oldInput = nullptr;
+    MockAudioDevice *oldOutput = nullptr;
+    auto switching = MakeSwitchingLayer(oldInput, oldOutput, created, false);
+    const uint32_t previousId = switching->GetCurrentInputDeviceId();
+
+    ASSERT_TRUE(switching->SwitchInputDevice(previousId + 1));
+    ASSERT_TRUE(switching->WaitForDeviceSwitch());
+
+    EXPECT_EQ(switching->GetCurrentInputDeviceId(), previousId);
+    EXPECT_TRUE(oldInput->IsRunning());
+    EXPECT_EQ(created.size(), 1u); // The failed device was released with the switch
+
+    // The old stream was never interrupted
+    std::vector<float> buffer(512, 0.1f);
+    std::vector<float> output(512);
+    const uint64_t sampleTime = switching->GetStreamSampleTime();
+    oldInput->TriggerCallback(buffer, output);
+    EXPECT_EQ(switching->GetStreamSampleTime(), sampleTime + buffer.size());
+}
+
+TEST_F(AudioProcessingLayerTest, BackgroundOutputSwitchFadesAcrossHandoff)
+{
+    std::vector<MockAudioDevice *> created;
+    MockAudioDevice *oldInput = nullptr;
+    MockAudioDevice *oldOutput = nullptr;
+    auto switching = MakeSwitchingLayer(oldInput, oldOutput, created);
+    if (!switching->IsOutputDeviceAvailable())
+    {
+        GTEST_SKIP() << "Output device not available (CI environment)";
+    }
+
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableReference = true;
+    audioConfig.referenceFrequency = 440.0f;
+    audioConfig.referenceVolume = 0.5f;
+    switching->UpdateAudioFeedback(audioConfig);
+
+    const uint32_t previousId = switching->GetCurrentOutputDeviceId();
+    ASSERT_TRUE(switching->SwitchOutputDevice(previousId == 0 ? 1 : 0));
+    ASSERT_EQ(created.size(), 1u);
+    MockAudioDevice *newOutput = created[0];
+
+    // Keep the old device playing; its last audible buffer is the one it handed over after
+    const size_t frames = 512;
+    const size_t oldChannels = oldOutput->GetConfig().outputChannels;
+    std::vector<float> input(frames, 0.0f);
+    std::vector<float> handoffBuffer;
+    bool switched = false;
+    for (int i = 0; i < 400 && !switched; ++i)
+    {
+        std::vector<float> output(frames * oldChannels, 0.0f);
+        oldOutput->TriggerCallback(input, output);
+        if (GetMaxAmplitude(output) > 0.0f)
+        {
+            handoffBuffer = output;
+        }
+        switched = switching->WaitForDeviceSwitch(std::chrono::milliseconds(5));
+    }
+    ASSERT_TRUE(switched);
+    ASSERT_EQ(handoffBuffer.size(), frames * oldChannels);
+
+    // Old device fades out over its final buffer
+    const size_t edge = 8 * oldChannels;
+    std::vector<float> oldHead(handoffBuffer.begin(), handoffBuffer.begin() + handoffBuffer.size() / 4);
+    std::vector<float> oldTail(handoffBuffer.end() - edge, handoffBuffer.end());
+    EXPECT_GT(GetMaxAmplitude(oldHead), 0.2f);
+    EXPECT_LT(GetMaxAmplitude(oldTail), 0.05f);
+
+    // New device fades in over its first buffer
+    const size_t newChannels = newOutput->GetConfig().outputChannels;
+    std::vector<float> firstBuffer(frames * newChannels, 0.0f);
+    newOutput->TriggerCallback(input, firstBuffer);
+    std::vector<float> newHead(firstBuffer.begin(), firstBuffer.begin() + 8 * newChannels);
+    std::vector<float> newTail(firstBuffer.end() - firstBuffer.size() / 4, firstBuffer.end());
+    EXPECT_LT(GetMaxAmplitude(newHead), 0.05f);
+    EXPECT_GT(GetMaxAmplitude(newTail), 0.2f);
+}
+
 // ============================================================================
 // Audio Feedback Tests - Polyphonic Mode
 // ============================================================================
@@ -661,6 +1504,9 @@ TEST_P(PitchStabilizationTest, StabilizesPitchDetection)
     {
         FillSineWave(buffer, 440.0f, 48000, phaseIdx);
         inputDevice->TriggerCallback(buffer, output);
+
+        // Pace like a real device so the analysis queue never overruns and drops samples
+        ASSERT_TRUE(layer->FlushAnalysis());
     }
 
     auto result = layer->GetLatestPitch();
@@ -715,6 +1561,7 @@ TEST_F(AudioProcessingLayerTest, HandlesFrequencyAtBoundaries)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto lowResult = layer->GetLatestPitch();
     // May or may not detect at boundary, but shouldn't crash
     EXPECT_GE(lowResult.confidence, 0.0f);
@@ -727,6 +1574,7 @@ TEST_F(AudioProcessingLayerTest, HandlesFrequencyAtBoundaries)
         inputDevice->TriggerCallback(buffer, output);
     }
 
+    ASSERT_TRUE(layer->FlushAnalysis());
     auto highResult = layer->GetLatestPitch();
     EXPECT_GE(highResult.confidence, 0.0f);
 }
@@ -764,3 +1612,564 @@ TEST_F(AudioProcessingLayerTest, HandlesMixedAudioFeedbackModes)
     EXPECT_GE(maxAmp, 0.0f);
     EXPECT_LE(maxAmp, 1.0f); // Should not clip
 }
+
+TEST_F(AudioProcessingLayerTest, DeviceListsComeFromBackgroundCatalog)
+{
+    auto &catalog = layer->GetDeviceCatalog();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, std::chrono::milliseconds(2000)));
+
+    // Served from the cached snapshot, no enumeration on the caller's thread
+    const auto inputs = layer->GetAvailableInputDeviceInfo();
+    const auto outputs = layer->GetAvailableOutputDeviceInfo();
+    ASSERT_FALSE(inputs.empty());
+    EXPECT_EQ(inputs.size(), catalog.GetSnapshot()->inputDevices.size());
+    EXPECT_EQ(inputs.front().name, catalog.GetSnapshot()->inputDevices.front().name);
+    EXPECT_FALSE(outputs.empty());
+    EXPECT_EQ(layer->GetAvailableInputDevices().size(), inputs.size());
+
+    // First scan is logged once; the baseline raises no change events
+    layer->OnUpdate(0.016f);
+    EXPECT_EQ(catalog.DrainChanges([](const PrecisionTuner::Audio::DeviceChangeEvent &) {}), 0u);
+}
+
+TEST_F(AudioProcessingLayerTest, WatchdogRestartsStalledInputStream)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *watchedInput = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 2048;
+    config.stabilizerType = StabilizerType::None;
+    config.watchdog = { .enabled = true,
+        .stallBuffers = 2, // ~85 ms
+        .startupMs = 50,
+        .restartAttempts = 2,
+        .backoffMs = 10,
+        .maxBackoffMs = 50 };
+    auto watched =
+        std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+    std::vector<float> buffer(2048);
+    std::vector<float> output(2048);
+    int phaseIdx = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        FillSineWave(buffer, 110.0f, 48000, phaseIdx);
+        watchedInput->TriggerCallback(buffer, output);
+    }
+    ASSERT_TRUE(watched->FlushAnalysis());
+    watched->OnUpdate(0.016f);
+    EXPECT_EQ(watched->GetWatchdogReport().input.status, PrecisionTuner::Audio::StreamStatus::Running);
+    EXPECT_TRUE(watched->GetLatestPitch().detected);
+
+    // The device still reports running, but no buffer arrives any more
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    watched->OnUpdate(0.016f);
+    auto health = watched->GetWatchdogReport().input;
+    EXPECT_EQ(health.status, PrecisionTuner::Audio::StreamStatus::Stalled);
+    EXPECT_EQ(health.stalls, 1u);
+    EXPECT_EQ(health.attempts, 1u);
+    EXPECT_FALSE(watched->IsInputDeviceAvailable());
+    EXPECT_FALSE(watched->GetLatestPitch().detected);
+    EXPECT_EQ(watched->GetInputLevel(), 0.0f);
+
+    // The restarted stream calls back again
+    ASSERT_TRUE(watchedInput->IsRunning());
+    FillSineWave(buffer, 110.0f, 48000, phaseIdx);
+    watchedInput->TriggerCallback(buffer, output);
+    watched->OnUpdate(0.016f);
+    health = watched->GetWatchdogReport().input;
+    EXPECT_EQ(health.status, PrecisionTuner::Audio::StreamStatus::Running);
+    EXPECT_EQ(health.recoveries, 1u);
+    EXPECT_GT(health.lastOutageMs, health.lastRecoveryMs);
+    EXPECT_TRUE(watched->IsInputDeviceAvailable());
+    EXPECT_GT(watched->GetInputLevel(), 0.5f);
+}
+
+// ============================================================================
+// Signal Gate Tests
+// ============================================================================
+
+TEST_F(AudioProcessingLayerTest, SignalGateSkipsDetectionOnNoiseFloor)
+{
+    std::vector<float> buffer(2048);
+    std::vector<float> output(2048);
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> noise(-0.001f, 0.001f); // About -65 dBFS RMS
+
+    // One second of background noise: the gate calibrates to it and the detector never runs
+    for (int i = 0; i < 24; ++i)
+    {
+        std::generate(buffer.begin(), buffer.end(), [&] { return noise(random); });
+        inputDevice->TriggerCallback(buffer, output);
+    }
+    ASSERT_TRUE(layer->FlushAnalysis());
+
+    const AnalysisStats idle = layer->GetAnalysisStats(0);
+    ASSERT_GT(idle.frames, 0u);
+    EXPECT_EQ(idle.gatedFrames, idle.frames);
+    EXPECT_FLOAT_EQ(idle.GatedShare(), 1.0f);
+    EXPECT_FALSE(idle.gateOpen);
+    EXPECT_NEAR(idle.noiseFloorDb, -72.0f, 3.0f); // White noise past the 5 kHz pre-filter low-pass: -65 dB - 7 dB
+    EXPECT_FALSE(layer->GetLatestPitch().detected);
+
+    // A note opens the gate and is detected as before
+    int phaseIdx = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        FillSineWave(buffer, 440.0f, 48000, phaseIdx);
+        inputDevice->TriggerCallback(buffer, output);
+    }
+    ASSERT_TRUE(layer->FlushAnalysis());
+
+    const AnalysisStats playing = layer->GetAnalysisStats(0);
+    EXPECT_TRUE(playing.gateOpen);
+    EXPECT_EQ(playing.gatedFrames, idle.gatedFrames);
+    EXPECT_GT(playing.frames, idle.frames);
+    EXPECT_LT(playing.GatedShare(), 1.0f);
+    const PitchFrame frame = layer->GetLatestPitch();
+    EXPECT_TRUE(frame.detected);
+    EXPECT_NEAR(frame.frequency, 440.0f, 10.0f);
+
+    EXPECT_EQ(layer->GetAnalysisStats(5).frames, 0u); // Channel not captured
+}
+
+// ============================================================================
+// Onset Detection Tests
+// ============================================================================
+
+namespace
+{
+    /** Plays plucked strings (see RenderPlucks) into a fresh layer and returns its analysis stats */
+    AnalysisStats PlayPlucks(bool reseedOnOnset)
+    {
+        auto inputMock = std::make_unique<MockAudioDevice>();
+        MockAudioDevice *input = inputMock.get();
+
+        AudioProcessingLayerConfig config;
+        config.sampleRate = 48000;
+        config.bufferSize = 512;
+        config.stabilizerType = StabilizerType::Hybrid;
+        config.duplexMode = DuplexMode::Off;
+        config.onsetDetector.reseedOnOnset = reseedOnOnset;
+        AudioProcessingLayer layer(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+        const std::array<float, 4> strings = { 110.0f, 146.83f, 196.0f, 146.83f };
+        const std::vector<float> signal = RenderPlucks(strings, 48000, 48000, 24000);
+
+        std::vector<float> output(512);
+        for (size_t offset = 0; offset + 512 <= signal.size(); offset += 512)
+        {
+            input->TriggerCallback(std::span<const float>(signal).subspan(offset, 512), output);
+            EXPECT_TRUE(layer.FlushAnalysis(std::chrono::milliseconds(10000))); // Never overrun the analysis queue
+        }
+        return layer.GetAnalysisStats(0);
+    }
+} // namespace
+
+TEST_F(AudioProcessingLayerTest, MeasuresTimeToLockAfterEachPluck)
+{
+    const AnalysisStats reseeded = PlayPlucks(true);
+    const AnalysisStats smoothed = PlayPlucks(false);
+
+    EXPECT_EQ(reseeded.onsets, 4u);
+    EXPECT_EQ(reseeded.locks, 4u);
+    EXPECT_GT(reseeded.meanTimeToLockMs, 0.0f);
+    EXPECT_GT(reseeded.lastTimeToLockMs, 0.0f);
+
+    // Without the reset the old string is smoothed into every new note
+    EXPECT_EQ(smoothed.onsets, 4u);
+    EXPECT_LE(reseeded.meanTimeToLockMs, smoothed.meanTimeToLockMs);
+}
+
+namespace
+{
+    /** Plays a steady tone into a fresh layer and returns the mean absolute error of its detected frames in cents */
+    float MeanCentsError(float frequency,
+        bool decimate,
+        uint32_t *decimationFactor = nullptr,
+        uint32_t sampleRate = 48000)
+    {
+        auto inputMock = std::make_unique<MockAudioDevice>();
+        MockAudioDevice *input = inputMock.get();
+
+        AudioProcessingLayerConfig config;
+        config.sampleRate = sampleRate;
+        config.bufferSize = 512;
+        config.stabilizerType = StabilizerType::None;
+        config.duplexMode = DuplexMode::Off;
+        config.decimation.enabled = decimate;
+        AudioProcessingLayer layer(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+        std::mt19937 random(3);
+        std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+        std::vector<float> buffer(512);
+        std::vector<float> output(512);
+        size_t sample = 0;
+        const uint32_t blocks = 40 * sampleRate / 48000; // Same duration, and so the same frame count, at any rate
+        for (uint32_t block = 0; block < blocks; ++block)
+        {
+            for (float &value : buffer)
+            {
+                const float t = static_cast<float>(sample++) / static_cast<float>(sampleRate);
+                value = 0.3f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * t) + noise(random);
+            }
+            input->TriggerCallback(buffer, output);
+            EXPECT_TRUE(layer.FlushAnalysis(std::chrono::milliseconds(10000)));
+        }
+
+        if (decimationFactor != nullptr)
+        {
+            *decimationFactor = layer.GetAnalysisStats(0).decimationFactor;
+        }
+
+        std::vector<PitchFrame> frames(layer.GetPitchHistoryCapacity());
+        frames.resize(layer.CopyPitchHistory(frames));
+        float totalError = 0.0f;
+        size_t detected = 0;
+        for (const PitchFrame &frame : frames)
+        {
+            if (frame.detected)
+            {
+                totalError += std::abs(1200.0f * std::log2(frame.frequency / frequency));
+                ++detected;
+            }
+        }
+        EXPECT_GT(detected, 20u) << frequency << " Hz";
+        return detected > 0 ? totalError / static_cast<float>(detected) : 0.0f;
+    }
+} // namespace
+
+TEST_F(AudioProcessingLayerTest, DecimatedDetectionKeepsFullRateAccuracy)
+{
+    // Open strings, a few notes off by some cents, and the top of the range
+    for (const float frequency : { 82.41f, 83.5f, 110.0f, 146.83f, 196.0f, 244.0f, 329.63f, 659.26f, 1100.0f })
+    {
+        uint32_t factor = 0;
+        const float decimated = MeanCentsError(frequency, true, &factor);
+        const float fullRate = MeanCentsError(frequency, false);
+        EXPECT_EQ(factor, 4u); // 12 kHz for the default 1200 Hz ceiling
+        EXPECT_LT(decimated, 0.5f) << frequency << " Hz";
+        EXPECT_LE(decimated, fullRate + 0.1f) << frequency << " Hz"; // Noise alone moves both by a few hundredths
+    }
+}
+
+TEST_F(AudioProcessingLayerTest, AnalysisPlanFollowsStreamRate)
+{
+    struct Expected
+    {
+        uint32_t sampleRate;
+        uint32_t windowSize;
+        uint32_t hopSize;
+        uint32_t decimationFactor;
+    };
+    for (const Expected &expected : { Expected{ 44100, 3763, 470, 3 },
+             Expected{ 48000, 4096, 512, 4 },
+             Expected{ 96000, 8192, 1024, 8 },
+             Expected{ 192000, 16384, 2048, 16 } })
+    {
+        AudioProcessingLayerConfig config;
+        config.sampleRate = expected.sampleRate;
+        config.bufferSize = 512;
+        config.duplexMode = DuplexMode::Off;
+        AudioProcessingLayer layer(config, std::make_unique<MockAudioDevice>(), std::make_unique<MockAudioDevice>());
+
+        // The window stays about 85 ms and the hop 10.7 ms; the detector stays near 12 kHz and 1024 samples
+        const PrecisionTuner::Audio::AnalysisPlan &plan = layer.GetAnalysisPlan();
+        EXPECT_EQ(plan.windowSize, expected.windowSize) << expected.sampleRate;
+        EXPECT_EQ(plan.hopSize, expected.hopSize) << expected.sampleRate;
+        EXPECT_EQ(plan.decimationFactor, expected.decimationFactor) << expected.sampleRate;
+        EXPECT_LE(plan.decimatedWindowSize, 1254u) << expected.sampleRate;
+        EXPECT_EQ(layer.GetAnalysisStats(0).decimationFactor, expected.decimationFactor) << expected.sampleRate;
+    }
+}
+
+TEST_F(AudioProcessingLayerTest, DecimatedDetectionKeepsAccuracyAtHighRates)
+{
+    for (const uint32_t sampleRate : { 44100u, 96000u, 192000u })
+    {
+        for (const float frequency : { 82.41f, 110.0f, 196.0f, 329.63f, 1100.0f })
+        {
+            uint32_t factor = 0;
+            const float error = MeanCentsError(frequency, true, &factor, sampleRate);
+            EXPECT_GT(factor, 1u) << sampleRate;
+            EXPECT_LT(error, 0.75f) << frequency << " Hz at " << sampleRate << " Hz"; // Noise-limited, as at 48 kHz
+        }
+    }
+}
+
+namespace
+{
+    /** Plays a low A over loud 50 Hz hum and a DC offset; returns the detected frames still in the history */
+    std::vector<PitchFrame> PlayOverHum(AudioProcessingLayer &layer, MockAudioDevice &input, size_t blocks)
+    {
+        std::vector<float> buffer(512);
+        std::vector<float> output(512);
+        for (size_t block = 0; block < blocks; ++block)
+        {
+            for (size_t i = 0; i < buffer.size(); ++i)
+            {
+                const float t = static_cast<float>(block * buffer.size() + i) / 48000.0f;
+                buffer[i] = 0.25f * std::sin(2.0f * std::numbers::pi_v<float> * 110.0f * t)
+                            + 0.4f * std::sin(2.0f * std::numbers::pi_v<float> * 50.0f * t) + 0.2f;
+            }
+            input.TriggerCallback(buffer, output);
+            EXPECT_TRUE(layer.FlushAnalysis(std::chrono::milliseconds(10000)));
+        }
+
+        std::vector<PitchFrame> frames(layer.GetPitchHistoryCapacity());
+        frames.resize(layer.CopyPitchHistory(frames));
+        std::erase_if(frames, [](const PitchFrame &frame) { return !frame.detected; });
+        return frames;
+    }
+} // namespace
+
+TEST_F(AudioProcessingLayerTest, PreFilterRemovesHumAndDcBeforeDetection)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *input = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 512;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    config.pitchHistorySeconds = 0.5f; // Only frames of the current setting
+    AudioProcessingLayer layer(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+    const std::vector<PitchFrame> filtered = PlayOverHum(layer, *input, 80);
+    ASSERT_GT(filtered.size(), 20u);
+    for (const PitchFrame &frame : filtered)
+    {
+        ASSERT_NEAR(1200.0f * std::log2(frame.frequency / 110.0f), 0.0f, 5.0f) << frame.frequency;
+    }
+
+    const PreFilterStats cost = layer.GetPreFilterStats(0);
+    for (const PreFilterStageStats &stage : cost.stages)
+    {
+        EXPECT_TRUE(stage.enabled);
+        EXPECT_EQ(stage.blocks, 80u); // One per hop
+        EXPECT_GT(stage.meanMicroseconds, 0.0f);
+    }
+
+    // Switched off at runtime: the hum reaches the detector again and the stages stop counting
+    PrecisionTuner::Audio::PreFilterConfig off = layer.GetPreFilterConfig();
+    off.dcBlocker = off.highPass = off.lowPass = off.humNotch = false;
+    layer.SetPreFilterConfig(off);
+    const std::vector<PitchFrame> unfiltered = PlayOverHum(layer, *input, 80);
+    const auto correct = std::count_if(unfiltered.begin(), unfiltered.end(), [](const PitchFrame &frame) {
+        return std::abs(1200.0f * std::log2(frame.frequency / 110.0f)) < 5.0f;
+    });
+    EXPECT_LT(static_cast<size_t>(correct), filtered.size());
+    EXPECT_EQ(layer.GetPreFilterStats(0).stages[0].blocks, 80u);
+    EXPECT_FALSE(layer.GetPreFilterStats(0).stages[0].enabled);
+}
+
+namespace
+{
+    /**
+     * Plays a sine through the layer hop by hop; returns the cents error of each detected frame whose
+     * window lies entirely within the sine (with 512-sample hops and the default 4096-sample window)
+     */
+    std::vector<float> PlayTone(AudioProcessingLayer &layer, MockAudioDevice &input, float frequency, size_t blocks)
+    {
+        const uint64_t firstSequence = layer.GetLatestPitch().sequence + 4096 / 512;
+        std::vector<float> buffer(512);
+        std::vector<float> output(512);
+        for (size_t block = 0; block < blocks; ++block)
+        {
+            for (size_t i = 0; i < buffer.size(); ++i)
+            {
+                const float t = static_cast<float>(block * buffer.size() + i) / 48000.0f;
+                buffer[i] = 0.3f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * t);
+            }
+            input.TriggerCallback(buffer, output);
+            EXPECT_TRUE(layer.FlushAnalysis(std::chrono::milliseconds(10000)));
+        }
+
+        std::vector<PitchFrame> frames(layer.GetPitchHistoryCapacity());
+        frames.resize(layer.CopyPitchHistory(frames));
+        std::vector<float> cents;
+        for (const PitchFrame &frame : frames)
+        {
+            if (frame.detected && frame.sequence >= firstSequence)
+            {
+                cents.push_back(1200.0f * std::log2(frame.frequency / frequency));
+            }
+        }
+        return cents;
+    }
+} // namespace
+
+TEST_F(AudioProcessingLayerTest, RetunesPitchTrackingWhileRunning)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *input = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 512;
+    config.minFrequency = 150.0f; // A2 is out of range
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    AudioProcessingLayer layer(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+    EXPECT_EQ(layer.GetAnalysisStats(0).decimationFactor, 4u);
+
+    for (const float cents : PlayTone(layer, *input, 110.0f, 40))
+    {
+        EXPECT_GT(std::abs(cents), 5.0f);
+    }
+
+    // Lower the range and narrow the ceiling without touching the streams
+    PitchTrackingConfig retuned = layer.GetPitchTrackingConfig();
+    EXPECT_FLOAT_EQ(retuned.minFrequency, 150.0f);
+    retuned.minFrequency = 80.0f;
+    retuned.maxFrequency = 400.0f;
+    layer.SetPitchTrackingConfig(retuned);
+    EXPECT_FLOAT_EQ(layer.GetPitchTrackingConfig().maxFrequency, 400.0f);
+    EXPECT_EQ(layer.GetAnalysisStats(0).pitchTrackingGeneration, 0u); // Not picked up before the next hop
+
+    const std::vector<float> inRange = PlayTone(layer, *input, 110.0f, 40);
+    ASSERT_GT(inRange.size(), 20u);
+    for (const float cents : inRange)
+    {
+        EXPECT_NEAR(cents, 0.0f, 5.0f);
+    }
+    AnalysisStats stats = layer.GetAnalysisStats(0);
+    EXPECT_EQ(stats.pitchTrackingGeneration, 1u);
+    EXPECT_EQ(stats.decimationFactor, 8u); // 6 kHz is enough for a 400 Hz ceiling
+    layer.OnUpdate(0.0f);                  // Frees the constructor's tracker
+
+    // Two changes between hops: the threads only ever see the second
+    retuned.stabilizerType = StabilizerType::Median;
+    layer.SetPitchTrackingConfig(retuned);
+    retuned.maxFrequency = 1200.0f;
+    layer.SetPitchTrackingConfig(retuned);
+    EXPECT_FALSE(PlayTone(layer, *input, 110.0f, 40).empty());
+    stats = layer.GetAnalysisStats(0);
+    EXPECT_EQ(stats.pitchTrackingGeneration, 3u);
+    EXPECT_EQ(stats.decimationFactor, 4u);
+    EXPECT_EQ(layer.GetPitchTrackingConfig().stabilizerType, StabilizerType::Median);
+}
+
+// ============================================================================
+// Real-Time Scheduling Tests
+// ============================================================================
+
+TEST_F(AudioProcessingLayerTest, ReportsSchedulingOutcomePerThread)
+{
+    auto inputMock = std::make_unique<MockAudioDevice>();
+    MockAudioDevice *scheduledInput = inputMock.get();
+
+    AudioProcessingLayerConfig config;
+    config.sampleRate = 48000;
+    config.bufferSize = 512;
+    config.stabilizerType = StabilizerType::None;
+    config.duplexMode = DuplexMode::Off;
+    config.audioThreadScheduling.cpus = { 0 };
+    config.analysisThreadScheduling.cpus = { 0 };
+    auto scheduledLayer =
+        std::make_unique<AudioProcessingLayer>(config, std::move(inputMock), std::make_unique<MockAudioDevice>());
+
+    // Nothing is known about the callback thread until it runs (on its own thread, so the runner is not pinned)
+    scheduledLayer->OnUpdate(0.016f);
+    EXPECT_FALSE(scheduledLayer->GetSchedulingReport().inputThread.applied);
+    EXPECT_EQ(scheduledLayer->GetSchedulingReport().memoryLock.outcome,
+        PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+
+    std::thread([&] {
+        std::vector<float> input(512, 0.0f);
+        std::vector<float> output(512);
+        scheduledInput->TriggerCallback(input, output);
+    }).join();
+
+    // Analysis workers apply their policy on start; both report through the diagnostic queues
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    scheduledLayer->OnUpdate(0.016f);
+    while (!scheduledLayer->GetSchedulingReport().analysisThreads.front().applied
+           && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        scheduledLayer->OnUpdate(0.016f);
+    }
+
+    const SchedulingReport &report = scheduledLayer->GetSchedulingReport();
+    ASSERT_TRUE(report.inputThread.applied);
+    EXPECT_NE(report.inputThread.affinity, PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+    EXPECT_EQ(report.inputThread.priority, PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+    ASSERT_EQ(report.analysisThreads.size(), 1u);
+    ASSERT_TRUE(report.analysisThreads[0].applied);
+    EXPECT_NE(report.analysisThreads[0].affinity, PrecisionTuner::Audio::SchedulingOutcome::NotRequested);
+    EXPECT_FALSE(report.outputThread.applied); // Output callback has not run yet
+    EXPECT_EQ(scheduledLayer->GetDiagnosticCount(PrecisionTuner::Audio::DiagnosticCode::ThreadScheduling), 2u);
+}
+
+// ============================================================================
+// Real-Time Safety Tests
+// ============================================================================
+
+TEST_F(AudioProcessingLayerTest, RealtimeCheckerCatchesAllocations)
+{
+    if (!PrecisionTuner::Audio::IsRealtimeCheckingActive())
+    {
+        GTEST_SKIP() << "Allocation interception not available in this build";
+    }
+    PrecisionTuner::Audio::ResetRealtimeViolations();
+
+    {
+        const PrecisionTuner::Audio::RealtimeScope realtime("test");
+        auto allocated = std::make_unique<std::vector<float>>(64);
+        EXPECT_EQ(allocated->size(), 64u);
+    }
+
+    EXPECT_GE(PrecisionTuner::Audio::GetRealtimeViolationCount(), 2u); // new + delete
+    std::vector<PrecisionTuner::Audio::RealtimeViolation> violations;
+    (void)PrecisionTuner::Audio::DrainRealtimeViolations(
+        [&](const PrecisionTuner::Audio::RealtimeViolation &violation) { violations.push_back(violation); });
+    ASSERT_FALSE(violations.empty());
+    EXPECT_EQ(violations.front().kind, PrecisionTuner::Audio::RealtimeViolationKind::Allocation);
+    EXPECT_STREQ(violations.front().thread, "test");
+    EXPECT_GT(violations.front().depth, 0u);
+    EXPECT_FALSE(PrecisionTuner::Audio::SymbolizeRealtimeViolation(violations.front()).empty());
+    PrecisionTuner::Audio::ResetRealtimeViolations();
+}
+
+TEST_F(AudioProcessingLayerTest, CallbacksNeitherAllocateNorLock)
+{
+    if (!PrecisionTuner::Audio::IsRealtimeCheckingActive())
+    {
+        GTEST_SKIP() << "Allocation interception not available in this build";
+    }
+
+    // Exercise every output path: beep, reference, monitoring and the polyphonic generator
+    PrecisionTuner::AudioConfig audioConfig;
+    audioConfig.enableBeep = true;
+    audioConfig.enableReference = true;
+    audioConfig.enableInputMonitoring = true;
+    audioConfig.enablePolyphonicMode = true;
+    layer->UpdateAudioFeedback(audioConfig);
+    std::array<float, 6> frequencies = { 82.41f, 110.0f, 146.83f, 196.0f, 246.94f, 329.63f };
+    layer->SetPolyphonicFrequencies(frequencies);
+
+    std::vector<float> input(512);
+    std::vector<float> output(512);
+    int phase = 0;
+    PrecisionTuner::Audio::ResetRealtimeViolations();
+
+    for (int i = 0; i < 64; ++i)
+    {
+        FillSineWave(input, 440.0f, 48000, phase);
+        inputDevice->TriggerCallback(input, output);
+        outputDevice->TriggerCallback(input, output);
+    }
+    // Oversized buffers take the overflow path
+    std::vector<float> hugeInput(8192, 0.1f);
+    std::vector<float> hugeOutput(8192);
+    inputDevice->TriggerCallback(hugeInput, hugeOutput);
+    outputDevice->TriggerCallback(hugeInput, hugeOutput);
+
+    const uint64_t violations = PrecisionTuner::Audio::GetRealtimeViolationCount();
+    layer->OnUpdate(0.016f); // Logs each violation with its stack
+    EXPECT_EQ(violations, 0u);
+}
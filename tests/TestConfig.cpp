@@ -20,6 +20,8 @@ TEST(ConfigTest, Serialization)
     Config config = Config::GetDefault();
     config.window.width = 1920;
     config.tuning.referencePitch = 442.0f;
+    config.audio.inputChannel = 1;
+    config.audio.inputChannelCount = 2;
 
     std::filesystem::path testPath = "test_config.json";
 
@@ -33,6 +35,8 @@ TEST(ConfigTest, Serialization)
 
     EXPECT_EQ(loadedConfig.window.width, 1920);
     EXPECT_EQ(loadedConfig.tuning.referencePitch, 442.0f);
+    EXPECT_EQ(loadedConfig.audio.inputChannel, 1);
+    EXPECT_EQ(loadedConfig.audio.inputChannelCount, 2);
 
     // Cleanup
     std::filesystem::remove(testPath);
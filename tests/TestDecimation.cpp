@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include <Decimation.h>
+
+using PrecisionTuner::Audio::ChooseDecimationFactor;
+using PrecisionTuner::Audio::DecimationConfig;
+using PrecisionTuner::Audio::PolyphaseDecimator;
+using PrecisionTuner::Audio::RefineFrequency;
+using PrecisionTuner::Audio::SimdLevel;
+
+namespace
+{
+    constexpr float kSampleRate = 48000.0f;
+    constexpr size_t kWindow = 4096;
+
+    std::vector<float> Sine(float frequency, size_t samples = kWindow, float amplitude = 0.5f)
+    {
+        std::vector<float> signal(samples);
+        for (size_t i = 0; i < samples; ++i)
+        {
+            signal[i] = amplitude * std::sin(2.0f * std::numbers::pi_v<float> * frequency * i / kSampleRate);
+        }
+        return signal;
+    }
+
+    /// Gain (dB) of the decimator for a sine, measured past the filter's warm-up
+    float GainDb(const PolyphaseDecimator &decimator, float frequency)
+    {
+        const std::vector<float> input = Sine(frequency);
+        std::vector<float> output(kWindow / decimator.Factor());
+        const size_t produced = decimator.Process(input, 0, output);
+
+        const size_t settled = decimator.TapCount() / decimator.Factor();
+        double sumSquares = 0.0;
+        for (size_t i = settled; i < produced; ++i)
+        {
+            sumSquares += static_cast<double>(output[i]) * output[i];
+        }
+        const double rms = std::sqrt(sumSquares / static_cast<double>(produced - settled));
+        return static_cast<float>(20.0 * std::log10(std::max(rms, 1e-12) / (0.5 / std::sqrt(2.0))));
+    }
+} // namespace
+
+TEST(Decimation, FactorFollowsPitchCeiling)
+{
+    const DecimationConfig config;
+    EXPECT_EQ(ChooseDecimationFactor(config, 48000, 1200.0f), 4u); // 12 kHz for a D6 ceiling
+    EXPECT_EQ(ChooseDecimationFactor(config, 48000, 400.0f), 8u);  // Low strings only: capped
+    EXPECT_EQ(ChooseDecimationFactor(config, 44100, 1200.0f), 3u);
+    EXPECT_EQ(ChooseDecimationFactor(config, 16000, 1200.0f), 1u);
+
+    DecimationConfig highRate;
+    highRate.maxFactor = 32;
+    EXPECT_EQ(ChooseDecimationFactor(highRate, 192000, 1200.0f), 16u);
+    highRate.maxFactor = 64;
+    EXPECT_EQ(ChooseDecimationFactor(highRate, 192000, 400.0f), PolyphaseDecimator::kMaxFactor);
+
+    DecimationConfig disabled;
+    disabled.enabled = false;
+    EXPECT_EQ(ChooseDecimationFactor(disabled, 48000, 400.0f), 1u);
+}
+
+TEST(Decimation, PassesPitchBandAndRejectsAliases)
+{
+    const PolyphaseDecimator decimator(4); // 12 kHz output
+    EXPECT_EQ(decimator.TapCount(), 4 * PolyphaseDecimator::kTapsPerPhase);
+
+    for (const float frequency : { 82.41f, 440.0f, 1200.0f, 2400.0f })
+    {
+        EXPECT_NEAR(GainDb(decimator, frequency), 0.0f, 0.1f) << frequency << " Hz";
+    }
+
+    // Everything that would fold back below the output Nyquist frequency is gone
+    for (const float frequency : { 7500.0f, 9000.0f, 12000.0f, 17000.0f, 23000.0f })
+    {
+        EXPECT_LT(GainDb(decimator, frequency), -60.0f) << frequency << " Hz";
+    }
+}
+
+TEST(Decimation, LargestFactorRejectsAliases)
+{
+    // 192 kHz to 6 kHz: the filter grows with the factor, so the band edge stays as sharp
+    const PolyphaseDecimator decimator(PolyphaseDecimator::kMaxFactor);
+    std::vector<float> input(16 * kWindow);
+    std::vector<float> output(input.size() / decimator.Factor());
+    for (const float frequency : { 300.0f, 3750.0f })
+    {
+        for (size_t i = 0; i < input.size(); ++i)
+        {
+            input[i] = 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * i / 192000.0f);
+        }
+        const size_t produced = decimator.Process(input, 0, output);
+        const size_t settled = decimator.TapCount() / decimator.Factor();
+        float peak = 0.0f;
+        for (size_t i = settled; i < produced; ++i)
+        {
+            peak = std::max(peak, std::abs(output[i]));
+        }
+        if (frequency < 1000.0f)
+        {
+            EXPECT_NEAR(peak, 0.5f, 0.01f);
+        }
+        else
+        {
+            EXPECT_LT(peak, 0.5e-3f); // Below -60 dB
+        }
+    }
+}
+
+TEST(Decimation, HistoryBeforeStartIsUsed)
+{
+    const PolyphaseDecimator decimator(4);
+    const std::vector<float> input = Sine(440.0f);
+
+    std::vector<float> whole(kWindow / 4);
+    ASSERT_EQ(decimator.Process(input, 0, whole), whole.size());
+
+    // Decimating only the tail gives the same samples as the tail of the whole window
+    constexpr size_t kStart = 1024;
+    std::vector<float> tail((kWindow - kStart) / 4);
+    ASSERT_EQ(decimator.Process(input, kStart, tail), tail.size());
+    for (size_t i = 0; i < tail.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(tail[i], whole[kStart / 4 + i]) << i;
+    }
+}
+
+TEST(Decimation, SimdLevelsAgree)
+{
+    const PolyphaseDecimator decimator(3);
+    const std::vector<float> input = Sine(330.0f, 3001);
+
+    std::vector<float> scalar(input.size() / 3);
+    ASSERT_EQ(decimator.ProcessWith(SimdLevel::Scalar, input, 1, scalar), 1000u);
+    for (const SimdLevel level : { SimdLevel::SSE2, SimdLevel::AVX2 })
+    {
+        std::vector<float> vector(scalar.size());
+        ASSERT_EQ(decimator.ProcessWith(level, input, 1, vector), 1000u);
+        for (size_t i = 0; i < scalar.size(); ++i)
+        {
+            ASSERT_NEAR(vector[i], scalar[i], 1e-5f) << i;
+        }
+    }
+}
+
+TEST(Decimation, FactorOnePassesThrough)
+{
+    const PolyphaseDecimator decimator(1);
+    const std::vector<float> input = Sine(440.0f, 64);
+    std::vector<float> output(64);
+    ASSERT_EQ(decimator.Process(input, 16, output), 48u);
+    EXPECT_EQ(output[0], input[16]);
+    EXPECT_EQ(output[47], input[63]);
+}
+
+TEST(Decimation, RefinementRestoresFullRateResolution)
+{
+    for (const float frequency : { 82.41f, 110.0f, 196.5f, 329.63f, 987.0f })
+    {
+        const std::vector<float> window = Sine(frequency);
+
+        // An estimate one decimated sample (4 full-rate samples) off the true period
+        const float period = kSampleRate / frequency;
+        const float coarse = kSampleRate / (period + 3.0f);
+        const float refined = RefineFrequency(window, kSampleRate, coarse, 4);
+        EXPECT_LT(std::abs(1200.0f * std::log2(refined / frequency)), 0.5f) << frequency << " Hz";
+    }
+}
+
+TEST(Decimation, StridedRefinementAtHighRates)
+{
+    constexpr float kHighRate = 192000.0f;
+    for (const float frequency : { 82.41f, 110.0f, 196.5f, 329.63f, 987.0f })
+    {
+        std::vector<float> window(4 * kWindow);
+        for (size_t i = 0; i < window.size(); ++i)
+        {
+            window[i] = 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * i / kHighRate);
+        }
+
+        // One decimated sample (16 full-rate samples) off, searched 4 samples apart as at 48 kHz
+        const float period = kHighRate / frequency;
+        const float coarse = kHighRate / (period + 12.0f);
+        const float refined = RefineFrequency(window, kHighRate, coarse, 16, 4);
+        EXPECT_LT(std::abs(1200.0f * std::log2(refined / frequency)), 0.5f) << frequency << " Hz";
+    }
+}
+
+TEST(Decimation, RefinementKeepsEstimateOutsideRange)
+{
+    // The true period (436 samples) lies far outside the searched lags: no confident minimum inside
+    const std::vector<float> window = Sine(110.0f);
+    EXPECT_FLOAT_EQ(RefineFrequency(window, kSampleRate, 300.0f, 4), 300.0f);
+    EXPECT_FLOAT_EQ(RefineFrequency(std::vector<float>(64, 0.0f), kSampleRate, 110.0f, 4), 110.0f);
+}
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <DeviceCatalog.h>
+
+using namespace std::chrono_literals;
+using PrecisionTuner::Audio::DeviceCatalog;
+using PrecisionTuner::Audio::DeviceChange;
+using PrecisionTuner::Audio::DeviceChangeEvent;
+using PrecisionTuner::Audio::DeviceSnapshot;
+using PrecisionTuner::Audio::DeviceSource;
+
+namespace
+{
+    GuitarIO::AudioDeviceInfo MakeDevice(uint32_t id, const char *name, uint32_t inputs, uint32_t outputs)
+    {
+        GuitarIO::AudioDeviceInfo device;
+        device.id = id;
+        device.name = name;
+        device.maxInputChannels = inputs;
+        device.maxOutputChannels = outputs;
+        return device;
+    }
+
+    /// Device lists a test can change while the catalog scans them ("hotplug")
+    struct FakeDevices
+    {
+        std::mutex mutex;
+        std::vector<GuitarIO::AudioDeviceInfo> inputs = { MakeDevice(0, "Built-in Mic", 1, 0) };
+        std::vector<GuitarIO::AudioDeviceInfo> outputs = { MakeDevice(1, "Speakers", 0, 2) };
+        std::atomic<int> describeCalls = 0;
+        std::atomic<uint32_t> defaultOutputId = 1;
+
+        DeviceSource Source()
+        {
+            return DeviceSource{
+                .enumerate =
+                    [this] {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        return DeviceSnapshot{
+                            .inputDevices = inputs, .outputDevices = outputs, .defaultInputId = 0, .defaultOutputId = 1
+                        };
+                    },
+                .describe =
+                    [this](uint32_t deviceId) {
+                        ++describeCalls;
+                        return MakeDevice(deviceId, "Described", 0, 0);
+                    },
+                .defaultDevice = [this](bool input) { return input ? 0u : defaultOutputId.load(); },
+            };
+        }
+
+        void PlugIn(const GuitarIO::AudioDeviceInfo &device)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inputs.push_back(device);
+        }
+
+        void UnplugOutputs()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            outputs.clear();
+        }
+    };
+} // namespace
+
+TEST(DeviceCatalog, EmptyUntilFirstScan)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1h, devices.Source());
+
+    // Not started: readers get an empty snapshot instead of waiting for a scan
+    const auto snapshot = catalog.GetSnapshot();
+    EXPECT_EQ(snapshot->generation, 0u);
+    EXPECT_TRUE(snapshot->inputDevices.empty());
+    EXPECT_EQ(catalog.GetScanCount(), 0u);
+}
+
+TEST(DeviceCatalog, FirstScanPublishesBaselineWithoutEvents)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1h, devices.Source());
+    catalog.Start();
+
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+    const auto snapshot = catalog.GetSnapshot();
+    ASSERT_EQ(snapshot->inputDevices.size(), 1u);
+    EXPECT_EQ(snapshot->inputDevices[0].name, "Built-in Mic");
+    ASSERT_EQ(snapshot->outputDevices.size(), 1u);
+    EXPECT_EQ(snapshot->defaultOutputId, 1u);
+
+    EXPECT_EQ(catalog.DrainChanges([](const DeviceChangeEvent &) {}), 0u);
+}
+
+TEST(DeviceCatalog, RefreshPublishesHotplugChanges)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1h, devices.Source()); // Only explicit refreshes scan during the test
+    catalog.Start();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+
+    devices.PlugIn(MakeDevice(7, "USB Interface", 2, 0));
+    devices.UnplugOutputs();
+    catalog.RequestRefresh();
+    ASSERT_TRUE(catalog.WaitForGeneration(2, 2s));
+
+    const auto snapshot = catalog.GetSnapshot();
+    EXPECT_EQ(snapshot->inputDevices.size(), 2u);
+    EXPECT_TRUE(snapshot->outputDevices.empty());
+
+    std::vector<DeviceChangeEvent> events;
+    EXPECT_EQ(catalog.DrainChanges([&](const DeviceChangeEvent &event) { events.push_back(event); }), 2u);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].change, DeviceChange::Added);
+    EXPECT_TRUE(events[0].input);
+    EXPECT_EQ(events[0].device.id, 7u);
+    EXPECT_EQ(events[0].generation, 2u);
+    EXPECT_EQ(events[1].change, DeviceChange::Removed);
+    EXPECT_FALSE(events[1].input);
+    EXPECT_EQ(events[1].device.name, "Speakers");
+
+    // Drained once only
+    EXPECT_EQ(catalog.DrainChanges([](const DeviceChangeEvent &) {}), 0u);
+}
+
+TEST(DeviceCatalog, PollingDetectsChangesWithoutRefresh)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(5ms, devices.Source());
+    catalog.Start();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+
+    devices.PlugIn(MakeDevice(9, "Headset", 1, 0));
+    ASSERT_TRUE(catalog.WaitForGeneration(2, 2s));
+    EXPECT_EQ(catalog.GetSnapshot()->inputDevices.back().name, "Headset");
+}
+
+TEST(DeviceCatalog, UnchangedScanKeepsGeneration)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1ms, devices.Source());
+    catalog.Start();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+
+    const auto first = catalog.GetSnapshot();
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while (catalog.GetScanCount() < 5 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    catalog.Stop();
+
+    EXPECT_GE(catalog.GetScanCount(), 5u);
+    EXPECT_EQ(catalog.GetSnapshot(), first); // Same published snapshot: readers see no spurious updates
+}
+
+TEST(DeviceCatalog, DeviceInfoServedFromSnapshot)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1h, devices.Source());
+
+    // Before the first scan the source is asked directly
+    EXPECT_EQ(catalog.GetDeviceInfo(1).name, "Described");
+    EXPECT_EQ(devices.describeCalls.load(), 1);
+
+    catalog.Start();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+    EXPECT_EQ(catalog.GetDeviceInfo(1).name, "Speakers");
+    EXPECT_EQ(catalog.GetDeviceInfo(0).name, "Built-in Mic");
+    EXPECT_EQ(devices.describeCalls.load(), 1);
+}
+
+TEST(DeviceCatalog, DefaultDeviceAskedFromSource)
+{
+    FakeDevices devices;
+    DeviceCatalog catalog(1h, devices.Source());
+    catalog.Start();
+    ASSERT_TRUE(catalog.WaitForGeneration(1, 2s));
+
+    // A default changed since the last scan is reported before the next scan lists it
+    devices.defaultOutputId = 5;
+    EXPECT_EQ(catalog.GetDefaultDevice(false), 5u);
+    EXPECT_EQ(catalog.GetDefaultDevice(true), 0u);
+    EXPECT_EQ(catalog.GetSnapshot()->defaultOutputId, 1u);
+}
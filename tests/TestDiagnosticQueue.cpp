@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <DiagnosticQueue.h>
+
+using namespace PrecisionTuner::Audio;
+
+TEST(DiagnosticQueue, DrainsEventsInOrder)
+{
+    DiagnosticQueue queue(8);
+    ASSERT_TRUE(queue.Push({ .code = DiagnosticCode::InputBufferOverflow, .sampleTime = 10, .value0 = 1 }));
+    ASSERT_TRUE(queue.Push({ .code = DiagnosticCode::MonitoringOverrun, .sampleTime = 20, .value0 = 2 }));
+
+    std::vector<DiagnosticEvent> drained;
+    EXPECT_EQ(queue.Drain([&](const DiagnosticEvent &event) { drained.push_back(event); }), 2u);
+
+    ASSERT_EQ(drained.size(), 2u);
+    EXPECT_EQ(drained[0].code, DiagnosticCode::InputBufferOverflow);
+    EXPECT_EQ(drained[0].sampleTime, 10u);
+    EXPECT_EQ(drained[1].code, DiagnosticCode::MonitoringOverrun);
+    EXPECT_EQ(drained[1].value0, 2u);
+    EXPECT_EQ(queue.Drain([](const DiagnosticEvent &) {}), 0u);
+}
+
+TEST(DiagnosticQueue, CountsEventsThatDoNotFit)
+{
+    DiagnosticQueue queue(4);
+    for (int i = 0; i < 10; ++i)
+    {
+        (void)queue.Push({ .code = DiagnosticCode::MonitoringUnderrun });
+    }
+    (void)queue.Push({ .code = DiagnosticCode::OutputChannelMismatch });
+
+    EXPECT_EQ(queue.Drain([](const DiagnosticEvent &) {}), 4u);
+    EXPECT_EQ(queue.TakeDropped(DiagnosticCode::MonitoringUnderrun), 6u);
+    EXPECT_EQ(queue.TakeDropped(DiagnosticCode::OutputChannelMismatch), 1u);
+    EXPECT_EQ(queue.TakeDropped(DiagnosticCode::MonitoringUnderrun), 0u); // Cleared by the previous call
+}
+
+TEST(DiagnosticQueue, ConcurrentBurstIsQueuedOrCounted)
+{
+    DiagnosticQueue queue(16);
+    constexpr uint64_t kTotal = 20000;
+    std::atomic<bool> producerDone{ false };
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < kTotal; ++i)
+        {
+            (void)queue.Push({ .code = DiagnosticCode::AnalysisQueueOverrun, .sampleTime = i });
+        }
+        producerDone.store(true, std::memory_order_release);
+    });
+
+    uint64_t drained = 0;
+    uint64_t dropped = 0;
+    uint64_t lastTime = 0;
+    bool ordered = true;
+    auto handler = [&](const DiagnosticEvent &event) {
+        ordered = ordered && (drained == 0 || event.sampleTime > lastTime);
+        lastTime = event.sampleTime;
+        ++drained;
+    };
+
+    bool done = false;
+    while (!done)
+    {
+        done = producerDone.load(std::memory_order_acquire);
+        (void)queue.Drain(handler);
+        dropped += queue.TakeDropped(DiagnosticCode::AnalysisQueueOverrun);
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(drained + dropped, kTotal);
+}
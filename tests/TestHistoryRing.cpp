@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <HistoryRing.h>
+
+using PrecisionTuner::Audio::HistoryRing;
+
+TEST(HistoryRing, CopyLatestReturnsOldestFirst)
+{
+    HistoryRing<int> history(8);
+    for (int i = 1; i <= 5; ++i)
+    {
+        history.Push(i);
+    }
+
+    std::vector<int> out(3);
+    ASSERT_EQ(history.CopyLatest(out), 3u);
+    EXPECT_EQ(out, (std::vector<int>{ 3, 4, 5 }));
+}
+
+TEST(HistoryRing, KeepsOnlyCapacityEntries)
+{
+    HistoryRing<int> history(4);
+    for (int i = 1; i <= 10; ++i)
+    {
+        history.Push(i);
+    }
+
+    std::vector<int> out(16);
+    ASSERT_EQ(history.CopyLatest(out), 4u);
+    EXPECT_EQ(out[0], 7);
+    EXPECT_EQ(out[3], 10);
+    EXPECT_EQ(history.TotalPushed(), 10u);
+}
+
+TEST(HistoryRing, CopySinceAdvancesCursor)
+{
+    HistoryRing<int> history(8);
+    std::vector<int> out(8);
+    uint64_t cursor = 0;
+
+    history.Push(1);
+    history.Push(2);
+    ASSERT_EQ(history.CopySince(cursor, out), 2u);
+    EXPECT_EQ(cursor, 2u);
+
+    history.Push(3);
+    ASSERT_EQ(history.CopySince(cursor, out), 1u);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_EQ(history.CopySince(cursor, out), 0u);
+}
+
+TEST(HistoryRing, CopySinceSkipsOverwrittenEntries)
+{
+    HistoryRing<int> history(4);
+    std::vector<int> out(8);
+    uint64_t cursor = 0;
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        history.Push(i);
+    }
+
+    ASSERT_EQ(history.CopySince(cursor, out), 4u);
+    EXPECT_EQ(out[0], 7);
+    EXPECT_EQ(cursor, 10u);
+}
+
+TEST(HistoryRing, ConcurrentReadersSeeIncreasingEntries)
+{
+    HistoryRing<uint64_t> history(64);
+    std::atomic<bool> done = false;
+
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= 50000; ++i)
+        {
+            history.Push(i);
+        }
+        done.store(true);
+    });
+
+    bool ordered = true;
+    std::vector<uint64_t> out(64);
+    while (!done.load())
+    {
+        const size_t count = history.CopyLatest(out);
+        for (size_t i = 1; i < count; ++i)
+        {
+            ordered = ordered && (out[i] > out[i - 1]);
+        }
+    }
+    writer.join();
+
+    EXPECT_TRUE(ordered);
+}
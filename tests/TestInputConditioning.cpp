@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <InputConditioning.h>
+
+using namespace PrecisionTuner::Audio;
+
+namespace
+{
+    std::vector<float> MakeSignal(size_t count)
+    {
+        std::vector<float> signal(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            signal[i] = 0.8f * std::sin(0.05f * static_cast<float>(i)) - 0.1f * static_cast<float>(i % 7) / 7.0f;
+        }
+        return signal;
+    }
+
+    constexpr SimdLevel kAllLevels[] = { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 };
+
+    /** Encodes integer samples little-endian in the given format (Int24 packed in 3 bytes) */
+    std::vector<std::byte> Encode(const std::vector<int32_t> &samples, SampleFormat format)
+    {
+        const size_t width = BytesPerSample(format);
+        std::vector<std::byte> bytes(samples.size() * width);
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            const auto value = static_cast<uint32_t>(samples[i]);
+            for (size_t byte = 0; byte < width; ++byte)
+            {
+                bytes[i * width + byte] = static_cast<std::byte>((value >> (8 * byte)) & 0xFF);
+            }
+        }
+        return bytes;
+    }
+
+    /** Integer version of MakeSignal() at the format's full scale, including both extremes */
+    std::vector<int32_t> MakeIntegerSignal(size_t count, SampleFormat format)
+    {
+        const int64_t fullScale = int64_t{ 1 } << (8 * BytesPerSample(format) - 1);
+        const std::vector<float> signal = MakeSignal(count);
+        std::vector<int32_t> samples(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            samples[i] = static_cast<int32_t>(static_cast<double>(signal[i]) * static_cast<double>(fullScale));
+        }
+        samples[0] = static_cast<int32_t>(-fullScale);
+        if (count > 1)
+        {
+            samples[count - 1] = static_cast<int32_t>(fullScale - 1);
+        }
+        return samples;
+    }
+
+    constexpr SampleFormat kIntegerFormats[] = { SampleFormat::Int16, SampleFormat::Int24, SampleFormat::Int32 };
+} // namespace
+
+TEST(InputConditioning, ScalarComputesGainPeakAndRms)
+{
+    const std::vector<float> input = { 0.5f, -1.0f, 0.25f, 0.0f };
+    std::vector<float> output(input.size(), 0.0f);
+
+    ConditioningStats stats = ConditionBlockWith(SimdLevel::Scalar, input, 2.0f, output);
+
+    EXPECT_FLOAT_EQ(output[0], 1.0f);
+    EXPECT_FLOAT_EQ(output[1], -2.0f);
+    EXPECT_FLOAT_EQ(output[2], 0.5f);
+    EXPECT_FLOAT_EQ(output[3], 0.0f);
+    EXPECT_FLOAT_EQ(stats.peak, 2.0f);
+    EXPECT_FLOAT_EQ(stats.sumSquares, 1.0f + 4.0f + 0.25f);
+    EXPECT_EQ(stats.samples, 4u);
+    EXPECT_FLOAT_EQ(stats.Rms(), std::sqrt(5.25f / 4.0f));
+}
+
+TEST(InputConditioning, EveryLevelMatchesScalarOnOddSizes)
+{
+    for (size_t count : { 1u, 3u, 7u, 9u, 17u, 128u, 131u, 1023u })
+    {
+        const std::vector<float> input = MakeSignal(count);
+        std::vector<float> expected(count, 0.0f);
+        const ConditioningStats reference = ConditionBlockWith(SimdLevel::Scalar, input, 1.5f, expected);
+
+        for (SimdLevel level : kAllLevels)
+        {
+            if (!IsSimdLevelSupported(level))
+            {
+                continue;
+            }
+
+            std::vector<float> output(count, 0.0f);
+            std::vector<float> mirror(count, 0.0f);
+            const ConditioningStats stats = ConditionBlockWith(level, input, 1.5f, output, mirror);
+
+            SCOPED_TRACE(testing::Message() << ToString(level) << " count=" << count);
+            EXPECT_EQ(output, expected);
+            EXPECT_EQ(mirror, expected);
+            EXPECT_FLOAT_EQ(stats.peak, reference.peak);
+            EXPECT_NEAR(stats.sumSquares, reference.sumSquares, 1e-4f * reference.sumSquares);
+            EXPECT_EQ(stats.samples, count);
+        }
+    }
+}
+
+TEST(InputConditioning, MergeCombinesSplitBlocks)
+{
+    const std::vector<float> input = MakeSignal(100);
+    std::vector<float> output(input.size(), 0.0f);
+    const std::span<const float> in(input);
+    const std::span<float> out(output);
+
+    const ConditioningStats whole = ConditionBlock(in, 1.0f, out);
+    ConditioningStats split = ConditionBlock(in.first(37), 1.0f, out.first(37));
+    split.Merge(ConditionBlock(in.subspan(37), 1.0f, out.subspan(37)));
+
+    EXPECT_FLOAT_EQ(split.peak, whole.peak);
+    EXPECT_NEAR(split.Rms(), whole.Rms(), 1e-5f);
+    EXPECT_EQ(split.samples, whole.samples);
+}
+
+TEST(InputConditioning, EmptyBlockHasZeroRms)
+{
+    ConditioningStats stats = ConditionBlock({}, 1.0f, {});
+    EXPECT_EQ(stats.samples, 0u);
+    EXPECT_FLOAT_EQ(stats.Rms(), 0.0f);
+}
+
+TEST(InputConditioning, ActiveLevelIsSupported)
+{
+    EXPECT_TRUE(IsSimdLevelSupported(GetActiveSimdLevel()));
+    EXPECT_TRUE(IsSimdLevelSupported(SimdLevel::Scalar));
+}
+
+TEST(InputConditioning, DeinterleaveSplitsEveryChannelCount)
+{
+    for (size_t channels : { 1u, 2u, 3u, 4u, 6u, 8u })
+    {
+        for (size_t frames : { 1u, 5u, 8u, 17u, 256u, 259u })
+        {
+            const std::vector<float> interleaved = MakeSignal(frames * channels);
+
+            for (SimdLevel level : kAllLevels)
+            {
+                if (!IsSimdLevelSupported(level))
+                {
+                    continue;
+                }
+
+                std::vector<std::vector<float>> outputs(channels, std::vector<float>(frames, 0.0f));
+                std::vector<std::span<float>> views(outputs.begin(), outputs.end());
+                const size_t written = DeinterleaveBlockWith(level, interleaved, views);
+
+                SCOPED_TRACE(testing::Message() << ToString(level) << " channels=" << channels << " frames=" << frames);
+                ASSERT_EQ(written, frames);
+                for (size_t channel = 0; channel < channels; ++channel)
+                {
+                    for (size_t frame = 0; frame < frames; ++frame)
+                    {
+                        ASSERT_EQ(outputs[channel][frame], interleaved[frame * channels + channel])
+                            << "channel " << channel << " frame " << frame;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(InputConditioning, DeinterleaveStopsAtSmallestDestination)
+{
+    const std::vector<float> interleaved = MakeSignal(2 * 16);
+    std::vector<float> left(16, 0.0f);
+    std::vector<float> right(10, -1.0f);
+    const std::vector<std::span<float>> views = { left, right };
+
+    EXPECT_EQ(DeinterleaveBlock(interleaved, views), 10u);
+    EXPECT_EQ(right[9], interleaved[19]);
+    EXPECT_EQ(left[10], 0.0f); // Frames past the limit are not written
+}
+
+TEST(InputConditioning, ConvertsIntegerSamplesToFullScaleFloat)
+{
+    const std::vector<int32_t> int16Samples = { -32768, 16384, -8192, 0 };
+    const std::vector<int32_t> int24Samples = { -8388608, 4194304, -2097152, 0 };
+    const std::vector<int32_t> int32Samples = { INT32_MIN, 1 << 30, -(1 << 29), 0 };
+
+    for (const auto &[format, samples] : { std::pair{ SampleFormat::Int16, int16Samples },
+             std::pair{ SampleFormat::Int24, int24Samples },
+             std::pair{ SampleFormat::Int32, int32Samples } })
+    {
+        const std::vector<std::byte> bytes = Encode(samples, format);
+        std::vector<float> output(samples.size(), 1.0f);
+
+        const ConditioningStats stats = ConditionBlockWith(SimdLevel::Scalar, bytes, format, 2.0f, output);
+
+        SCOPED_TRACE(ToString(format));
+        EXPECT_FLOAT_EQ(output[0], -2.0f);
+        EXPECT_FLOAT_EQ(output[1], 1.0f);
+        EXPECT_FLOAT_EQ(output[2], -0.5f);
+        EXPECT_FLOAT_EQ(output[3], 0.0f);
+        EXPECT_FLOAT_EQ(stats.peak, 2.0f);
+        EXPECT_FLOAT_EQ(stats.sumSquares, 4.0f + 1.0f + 0.25f);
+        EXPECT_EQ(stats.samples, 4u);
+    }
+}
+
+TEST(InputConditioning, IntegerKernelsMatchScalarOnOddSizes)
+{
+    for (SampleFormat format : kIntegerFormats)
+    {
+        for (size_t count : { 1u, 3u, 7u, 9u, 10u, 11u, 17u, 128u, 131u, 1023u })
+        {
+            const std::vector<std::byte> bytes = Encode(MakeIntegerSignal(count, format), format);
+            std::vector<float> expected(count, 0.0f);
+            const ConditioningStats reference = ConditionBlockWith(SimdLevel::Scalar, bytes, format, 1.5f, expected);
+
+            for (SimdLevel level : kAllLevels)
+            {
+                if (!IsSimdLevelSupported(level))
+                {
+                    continue;
+                }
+
+                // Exactly sized source, so a vector load past the last sample would be caught by sanitizers
+                std::vector<float> output(count, 0.0f);
+                std::vector<float> mirror(count, 0.0f);
+                const ConditioningStats stats = ConditionBlockWith(level, bytes, format, 1.5f, output, mirror);
+
+                SCOPED_TRACE(testing::Message() << ToString(format) << " " << ToString(level) << " count=" << count);
+                EXPECT_EQ(output, expected);
+                EXPECT_EQ(mirror, expected);
+                EXPECT_FLOAT_EQ(stats.peak, reference.peak);
+                EXPECT_NEAR(stats.sumSquares, reference.sumSquares, 1e-4f * reference.sumSquares);
+                EXPECT_EQ(stats.samples, count);
+            }
+        }
+    }
+}
+
+TEST(InputConditioning, FloatDeviceSamplesTakeThePlainKernel)
+{
+    const std::vector<float> input = MakeSignal(67);
+    std::vector<float> expected(input.size(), 0.0f);
+    std::vector<float> output(input.size(), 0.0f);
+
+    const ConditioningStats reference = ConditionBlock(input, 0.5f, expected);
+    const ConditioningStats stats =
+        ConditionBlock(std::as_bytes(std::span<const float>(input)), SampleFormat::Float32, 0.5f, output);
+
+    EXPECT_EQ(output, expected);
+    EXPECT_FLOAT_EQ(stats.peak, reference.peak);
+    EXPECT_EQ(stats.samples, input.size());
+}
+
+TEST(InputConditioning, IgnoresTrailingPartialSample)
+{
+    std::vector<std::byte> bytes = Encode({ 16384, -16384 }, SampleFormat::Int24);
+    bytes.pop_back();
+    std::vector<float> output(2, -1.0f);
+
+    EXPECT_EQ(ConditionBlock(bytes, SampleFormat::Int24, 1.0f, output).samples, 1u);
+    EXPECT_EQ(output[1], -1.0f);
+}
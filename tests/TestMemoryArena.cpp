@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <MemoryArena.h>
+
+using PrecisionTuner::Audio::MemoryArena;
+using PrecisionTuner::Audio::MemoryArenaConfig;
+using PrecisionTuner::Audio::SchedulingOutcome;
+
+TEST(MemoryArena, CarvesAlignedZeroedBuffers)
+{
+    const size_t bytes = MemoryArena::Footprint<float>(100) + MemoryArena::Footprint<float>(3);
+    EXPECT_EQ(MemoryArena::Footprint<float>(100), 448u); // 400 bytes rounded up to cache lines
+    EXPECT_EQ(MemoryArena::Footprint<float>(3), 64u);
+
+    MemoryArena arena;
+    ASSERT_TRUE(arena.Reserve(bytes, MemoryArenaConfig{ .hugePages = false, .lock = false }));
+    auto first = arena.Allocate<float>(100);
+    auto second = arena.Allocate<float>(3);
+    ASSERT_EQ(first.size(), 100u);
+    ASSERT_EQ(second.size(), 3u);
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first.data()) % MemoryArena::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second.data()) % MemoryArena::kAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<const std::byte *>(second.data()) - reinterpret_cast<const std::byte *>(first.data()),
+        448);
+    for (const float sample : first)
+    {
+        EXPECT_EQ(sample, 0.0f);
+    }
+
+    EXPECT_EQ(arena.Stats().usedBytes, bytes);
+    EXPECT_EQ(arena.Stats().allocations, 2u);
+    EXPECT_GE(arena.Stats().reservedBytes, bytes);
+    EXPECT_EQ(arena.Stats().locked, SchedulingOutcome::NotRequested);
+    EXPECT_EQ(arena.Stats().hugePages, SchedulingOutcome::NotRequested);
+}
+
+TEST(MemoryArena, ExhaustedReservationReturnsEmptyBuffers)
+{
+    MemoryArena arena;
+    EXPECT_TRUE(arena.Allocate<float>(1).empty()); // Nothing reserved yet
+
+    ASSERT_TRUE(arena.Reserve(MemoryArena::Footprint<float>(16), MemoryArenaConfig{ .lock = false }));
+    EXPECT_EQ(arena.Allocate<float>(16).size(), 16u);
+    EXPECT_TRUE(arena.Allocate<float>(1).empty());
+    EXPECT_EQ(arena.Stats().allocations, 1u);
+
+    // Reserving again starts over with a fresh block
+    ASSERT_TRUE(arena.Reserve(MemoryArena::Footprint<int32_t>(8), MemoryArenaConfig{ .lock = false }));
+    EXPECT_EQ(arena.Stats().usedBytes, 0u);
+    EXPECT_EQ(arena.Allocate<int32_t>(8).size(), 8u);
+}
+
+TEST(MemoryArena, ReportsLockingAndHugePageOutcome)
+{
+    MemoryArena arena;
+    const MemoryArenaConfig config{ .hugePages = true, .lock = true };
+    ASSERT_TRUE(arena.Reserve(MemoryArena::Footprint<float>(4096), config));
+
+    // Depends on the machine (hugetlbfs pool, THP, RLIMIT_MEMLOCK), but is always reported
+    EXPECT_NE(arena.Stats().locked, SchedulingOutcome::NotRequested);
+    EXPECT_NE(arena.Stats().hugePages, SchedulingOutcome::NotRequested);
+    EXPECT_EQ(arena.Allocate<float>(4096).size(), 4096u);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include <OnsetDetection.h>
+#include <SignalGate.h>
+
+using PrecisionTuner::Audio::LockTimer;
+using PrecisionTuner::Audio::OnsetDetector;
+using PrecisionTuner::Audio::SignalGate;
+
+namespace
+{
+    constexpr float kSampleRate = 48000.0f;
+    constexpr size_t kHop = 512;
+    constexpr float kHopSeconds = static_cast<float>(kHop) / kSampleRate;
+
+    /// One hop of a 440 Hz sine with the given amplitude, silent before startOffset
+    std::vector<float> Hop(float amplitude, size_t startOffset = 0)
+    {
+        std::vector<float> hop(kHop, 0.0f);
+        for (size_t i = startOffset; i < hop.size(); ++i)
+        {
+            hop[i] = amplitude * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f * i / kSampleRate);
+        }
+        return hop;
+    }
+
+    /// Runs a hop through the detector the way the analysis thread does (gate treated as open)
+    std::optional<size_t> Feed(OnsetDetector &detector, const std::vector<float> &hop)
+    {
+        return detector.Process(hop, SignalGate::MeasureLevelDb(hop), true);
+    }
+} // namespace
+
+TEST(OnsetDetector, FlagsPluckAndLocatesAttack)
+{
+    OnsetDetector detector({}, kHopSeconds);
+    (void)Feed(detector, Hop(0.001f)); // Rises out of digital silence
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_FALSE(Feed(detector, Hop(0.001f)).has_value());
+    }
+
+    const auto onset = Feed(detector, Hop(0.5f, 300));
+    ASSERT_TRUE(onset.has_value());
+    EXPECT_GE(*onset, 256u);
+    EXPECT_LE(*onset, 320u);
+}
+
+TEST(OnsetDetector, SteadyOrDecayingNoteIsNoOnset)
+{
+    OnsetDetector detector({}, kHopSeconds);
+    (void)Feed(detector, Hop(0.5f)); // First hop after silence is an onset
+
+    float amplitude = 0.5f;
+    for (int i = 0; i < 50; ++i)
+    {
+        amplitude *= 0.97f;
+        EXPECT_FALSE(Feed(detector, Hop(amplitude)).has_value()) << "hop " << i;
+    }
+}
+
+TEST(OnsetDetector, IgnoresRetriggerWithinInterval)
+{
+    OnsetDetector detector({}, kHopSeconds); // 80 ms = 8 hops
+    ASSERT_TRUE(Feed(detector, Hop(0.01f, 0)).has_value());
+    (void)Feed(detector, Hop(0.001f));
+    (void)Feed(detector, Hop(0.001f));
+    EXPECT_FALSE(Feed(detector, Hop(0.5f)).has_value());
+
+    for (int i = 0; i < 8; ++i)
+    {
+        (void)Feed(detector, Hop(0.001f));
+    }
+    EXPECT_TRUE(Feed(detector, Hop(0.5f)).has_value());
+}
+
+TEST(OnsetDetector, ClosedGateSuppressesOnsets)
+{
+    OnsetDetector detector({}, kHopSeconds);
+    const auto hop = Hop(0.5f);
+    EXPECT_FALSE(detector.Process(hop, SignalGate::MeasureLevelDb(hop), false).has_value());
+}
+
+TEST(LockTimer, LocksAfterAgreeingFrames)
+{
+    LockTimer timer({ .toleranceCents = 5.0f, .frames = 3, .timeoutSeconds = 2.0f }, 48000);
+    timer.Start(1000);
+
+    EXPECT_FALSE(timer.Update(true, 110.0f, 900).has_value()); // Window ends before the onset: ignored
+    EXPECT_FALSE(timer.Update(true, 104.0f, 1512).has_value());
+    EXPECT_FALSE(timer.Update(true, 110.1f, 2024).has_value());
+    EXPECT_FALSE(timer.Update(true, 110.0f, 2536).has_value()); // 104 Hz still in the run
+    const auto locked = timer.Update(true, 110.05f, 3048);
+    ASSERT_TRUE(locked.has_value());
+    EXPECT_EQ(*locked, 2048u);
+    EXPECT_FALSE(timer.IsRunning());
+    EXPECT_FALSE(timer.Update(true, 110.0f, 3560).has_value()); // One lock per onset
+}
+
+TEST(LockTimer, UndetectedFrameRestartsRun)
+{
+    LockTimer timer({ .toleranceCents = 5.0f, .frames = 2, .timeoutSeconds = 2.0f }, 48000);
+    timer.Start(0);
+
+    EXPECT_FALSE(timer.Update(true, 82.4f, 512).has_value());
+    EXPECT_FALSE(timer.Update(false, 0.0f, 1024).has_value());
+    EXPECT_FALSE(timer.Update(true, 82.4f, 1536).has_value());
+    EXPECT_EQ(timer.Update(true, 82.41f, 2048), std::optional<uint64_t>(2048));
+}
+
+TEST(LockTimer, GivesUpAfterTimeout)
+{
+    LockTimer timer({ .toleranceCents = 5.0f, .frames = 2, .timeoutSeconds = 0.1f }, 48000);
+    timer.Start(0);
+
+    EXPECT_FALSE(timer.Update(true, 82.4f, 4000).has_value());
+    EXPECT_FALSE(timer.Update(true, 82.4f, 5000).has_value()); // Past 4800 samples
+    EXPECT_FALSE(timer.IsRunning());
+}
@@ -0,0 +1,185 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+#include <PreFilter.h>
+
+using PrecisionTuner::Audio::Biquad;
+using PrecisionTuner::Audio::BiquadCoefficients;
+using PrecisionTuner::Audio::PreFilterChain;
+using PrecisionTuner::Audio::PreFilterConfig;
+using PrecisionTuner::Audio::PreFilterStage;
+using PrecisionTuner::Audio::SimdLevel;
+using PrecisionTuner::Audio::ToString;
+
+namespace
+{
+    constexpr uint32_t kSampleRate = 48000;
+    constexpr size_t kHop = 512;
+
+    std::vector<float> Sine(float frequency, size_t samples, float offset = 0.0f)
+    {
+        std::vector<float> signal(samples);
+        for (size_t i = 0; i < samples; ++i)
+        {
+            signal[i] = offset
+                        + 0.5f * std::sin(2.0f * std::numbers::pi_v<float> * frequency * i
+                                          / static_cast<float>(kSampleRate));
+        }
+        return signal;
+    }
+
+    /// Runs one second of a sine through the chain hop by hop; returns the gain (dB) over the last half
+    float ChainGainDb(PreFilterChain &chain, float frequency)
+    {
+        std::vector<float> signal = Sine(frequency, kSampleRate);
+        for (size_t offset = 0; offset + kHop <= signal.size(); offset += kHop)
+        {
+            chain.Process(std::span<float>(signal).subspan(offset, kHop));
+        }
+
+        double sumSquares = 0.0;
+        const size_t settled = signal.size() / 2;
+        const size_t end = signal.size() - signal.size() % kHop;
+        for (size_t i = settled; i < end; ++i)
+        {
+            sumSquares += static_cast<double>(signal[i]) * signal[i];
+        }
+        const double rms = std::sqrt(sumSquares / static_cast<double>(end - settled));
+        return static_cast<float>(20.0 * std::log10(std::max(rms, 1e-12) / (0.5 / std::sqrt(2.0))));
+    }
+
+    PreFilterConfig OnlyStage(PreFilterStage stage)
+    {
+        PreFilterConfig config;
+        config.dcBlocker = stage == PreFilterStage::DcBlocker;
+        config.highPass = stage == PreFilterStage::HighPass;
+        config.lowPass = stage == PreFilterStage::LowPass;
+        config.humNotch = stage == PreFilterStage::HumNotch;
+        return config;
+    }
+} // namespace
+
+TEST(PreFilter, BlockKernelsMatchRecursion)
+{
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    std::vector<float> input(10003); // Not a multiple of the block size: exercises the tail
+    for (float &sample : input)
+    {
+        sample = noise(random);
+    }
+
+    // Direct-form I in double precision as the reference
+    const auto coefficients = BiquadCoefficients::Notch(50.0f, 8.0f, static_cast<float>(kSampleRate));
+    std::vector<double> expected(input.size());
+    double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+    for (size_t i = 0; i < input.size(); ++i)
+    {
+        expected[i] = coefficients.b0 * input[i] + coefficients.b1 * x1 + coefficients.b2 * x2 - coefficients.a1 * y1
+                      - coefficients.a2 * y2;
+        x2 = x1;
+        x1 = input[i];
+        y2 = y1;
+        y1 = expected[i];
+    }
+
+    // The narrow notch has poles close to the unit circle, so float rounding settles around -60 dB
+    for (const SimdLevel level : { SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2 })
+    {
+        Biquad filter;
+        filter.SetCoefficients(coefficients);
+        std::vector<float> output = input;
+        filter.ProcessWith(level, std::span<float>(output).first(5001)); // State carries across calls
+        filter.ProcessWith(level, std::span<float>(output).subspan(5001));
+        for (size_t i = 0; i < output.size(); ++i)
+        {
+            ASSERT_NEAR(output[i], expected[i], 3e-3) << ToString(level) << " sample " << i;
+        }
+    }
+}
+
+TEST(PreFilter, DcBlockerRemovesOffset)
+{
+    PreFilterChain chain;
+    chain.Configure(OnlyStage(PreFilterStage::DcBlocker), kSampleRate);
+
+    std::vector<float> signal = Sine(110.0f, kSampleRate, 0.2f);
+    for (size_t offset = 0; offset + kHop <= signal.size(); offset += kHop)
+    {
+        chain.Process(std::span<float>(signal).subspan(offset, kHop));
+    }
+
+    // Mean over whole periods of the last quarter second
+    double sum = 0.0;
+    constexpr size_t kPeriods = 24000 / 436 * 436;
+    const size_t start = signal.size() / 2;
+    for (size_t i = start; i < start + kPeriods; ++i)
+    {
+        sum += signal[i];
+    }
+    EXPECT_LT(std::abs(sum / kPeriods), 0.005);
+}
+
+TEST(PreFilter, NotchRemovesMainsAndKeepsStrings)
+{
+    PreFilterChain notch50;
+    notch50.Configure(OnlyStage(PreFilterStage::HumNotch), kSampleRate);
+    EXPECT_LT(ChainGainDb(notch50, 50.0f), -30.0f);
+    EXPECT_NEAR(ChainGainDb(notch50, 82.41f), 0.0f, 0.5f);
+
+    PreFilterConfig config = OnlyStage(PreFilterStage::HumNotch);
+    config.humFrequencyHz = 60.0f;
+    PreFilterChain notch60;
+    notch60.Configure(config, kSampleRate);
+    EXPECT_LT(ChainGainDb(notch60, 60.0f), -30.0f);
+}
+
+TEST(PreFilter, DefaultChainPassesPitchRange)
+{
+    for (const float frequency : { 82.41f, 110.0f, 329.63f, 1200.0f })
+    {
+        PreFilterChain fresh;
+        fresh.Configure({}, kSampleRate);
+        EXPECT_NEAR(ChainGainDb(fresh, frequency), 0.0f, 1.0f) << frequency << " Hz";
+    }
+
+    PreFilterChain hiss;
+    hiss.Configure({}, kSampleRate);
+    EXPECT_LT(ChainGainDb(hiss, 18000.0f), -20.0f);
+
+    PreFilterChain rumble;
+    rumble.Configure({}, kSampleRate);
+    EXPECT_LT(ChainGainDb(rumble, 15.0f), -15.0f);
+}
+
+TEST(PreFilter, StagesSwitchAtRuntimeAndReportCost)
+{
+    PreFilterChain chain;
+    chain.Configure({}, kSampleRate);
+
+    std::vector<float> block = Sine(440.0f, kHop);
+    chain.Process(block);
+    for (size_t stage = 0; stage < PreFilterChain::kStageCount; ++stage)
+    {
+        EXPECT_GT(chain.GetLastStageNanoseconds(static_cast<PreFilterStage>(stage)), 0u) << stage;
+    }
+
+    // Everything off: the block passes untouched and no stage reports a cost
+    PreFilterConfig off;
+    off.dcBlocker = off.highPass = off.lowPass = off.humNotch = false;
+    chain.Configure(off, kSampleRate);
+    const std::vector<float> input = Sine(440.0f, kHop);
+    block = input;
+    chain.Process(block);
+    EXPECT_EQ(block, input);
+    EXPECT_EQ(chain.GetLastStageNanoseconds(PreFilterStage::LowPass), 0u);
+
+    // Only the notch back on
+    chain.Configure(OnlyStage(PreFilterStage::HumNotch), kSampleRate);
+    chain.Process(block);
+    EXPECT_EQ(chain.GetLastStageNanoseconds(PreFilterStage::DcBlocker), 0u);
+    EXPECT_GT(chain.GetLastStageNanoseconds(PreFilterStage::HumNotch), 0u);
+}
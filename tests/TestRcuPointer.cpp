@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <RcuPointer.h>
+
+using PrecisionTuner::Audio::RcuPointer;
+
+namespace
+{
+    /** Counts live instances so tests can check what was destroyed and when */
+    struct Tracked
+    {
+        explicit Tracked(int value, std::atomic<int> &live) : value(value), live(live)
+        {
+            live.fetch_add(1);
+        }
+
+        ~Tracked()
+        {
+            live.fetch_sub(1);
+        }
+
+        int value;
+        std::atomic<int> &live;
+    };
+} // namespace
+
+TEST(RcuPointer, ReaderSwapsAtAcquireAndWriterReclaims)
+{
+    std::atomic<int> live = 0;
+    RcuPointer<Tracked> slot(std::make_unique<Tracked>(1, live));
+    EXPECT_EQ(slot.Acquire()->value, 1);
+    EXPECT_EQ(slot.Reclaim(), nullptr);
+
+    slot.Publish(std::make_unique<Tracked>(2, live));
+    EXPECT_TRUE(slot.HasPending());
+    EXPECT_EQ(slot.Current()->value, 1); // Nothing changes until the reader asks
+    EXPECT_EQ(slot.Acquire()->value, 2);
+    EXPECT_FALSE(slot.HasPending());
+    EXPECT_EQ(live.load(), 2); // The old instance waits for the writer
+
+    auto retired = slot.Reclaim();
+    ASSERT_NE(retired, nullptr);
+    EXPECT_EQ(retired->value, 1);
+    retired.reset();
+    EXPECT_EQ(live.load(), 1);
+}
+
+TEST(RcuPointer, RepublishingDropsTheUntakenValue)
+{
+    std::atomic<int> live = 0;
+    RcuPointer<Tracked> slot(std::make_unique<Tracked>(1, live));
+    slot.Publish(std::make_unique<Tracked>(2, live));
+    slot.Publish(std::make_unique<Tracked>(3, live));
+    EXPECT_EQ(live.load(), 2);
+    EXPECT_EQ(slot.Acquire()->value, 3);
+}
+
+TEST(RcuPointer, SwapWaitsForTheWriterToReclaim)
+{
+    std::atomic<int> live = 0;
+    RcuPointer<Tracked> slot(std::make_unique<Tracked>(1, live));
+    slot.Publish(std::make_unique<Tracked>(2, live));
+    EXPECT_EQ(slot.Acquire()->value, 2);
+
+    // Instance 1 is still retired, so the reader keeps 2 rather than freeing anything itself
+    slot.Publish(std::make_unique<Tracked>(3, live));
+    EXPECT_EQ(slot.Acquire()->value, 2);
+    EXPECT_EQ(slot.Reclaim()->value, 1);
+    EXPECT_EQ(slot.Acquire()->value, 3);
+}
+
+TEST(RcuPointer, DestructorReleasesEveryInstance)
+{
+    std::atomic<int> live = 0;
+    {
+        RcuPointer<Tracked> slot(std::make_unique<Tracked>(1, live));
+        slot.Publish(std::make_unique<Tracked>(2, live));
+        (void)slot.Acquire();
+        slot.Publish(std::make_unique<Tracked>(3, live));
+        EXPECT_EQ(live.load(), 3);
+    }
+    EXPECT_EQ(live.load(), 0);
+}
+
+TEST(RcuPointer, ConcurrentSwapsNeverExposeFreedInstances)
+{
+    std::atomic<int> live = 0;
+    RcuPointer<Tracked> slot(std::make_unique<Tracked>(0, live));
+    std::atomic<bool> done = false;
+
+    std::thread reader([&]() {
+        int last = 0;
+        bool monotonic = true;
+        while (!done.load())
+        {
+            const int value = slot.Acquire()->value;
+            monotonic = monotonic && value >= last;
+            last = value;
+        }
+        EXPECT_TRUE(monotonic);
+    });
+
+    for (int i = 1; i <= 20000; ++i)
+    {
+        slot.Publish(std::make_unique<Tracked>(i, live));
+        (void)slot.Reclaim();
+    }
+    done.store(true);
+    reader.join();
+
+    // At most the instance in use, one pending and one retired are alive
+    EXPECT_LE(live.load(), 3);
+}
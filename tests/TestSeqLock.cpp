@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <SeqLock.h>
+
+using PrecisionTuner::Audio::SeqLock;
+
+namespace
+{
+    struct Snapshot
+    {
+        float a = 0.0f;
+        float b = 0.0f;
+        uint64_t counter = 0;
+    };
+} // namespace
+
+TEST(SeqLock, ReturnsInitialValue)
+{
+    SeqLock<Snapshot> lock(Snapshot{ 1.0f, 2.0f, 3 });
+    Snapshot value = lock.Load();
+
+    EXPECT_FLOAT_EQ(value.a, 1.0f);
+    EXPECT_FLOAT_EQ(value.b, 2.0f);
+    EXPECT_EQ(value.counter, 3u);
+}
+
+TEST(SeqLock, LoadReturnsLastStore)
+{
+    SeqLock<Snapshot> lock;
+    lock.Store(Snapshot{ 4.0f, 5.0f, 6 });
+    lock.Store(Snapshot{ 7.0f, 8.0f, 9 });
+
+    Snapshot value = lock.Load();
+    EXPECT_FLOAT_EQ(value.a, 7.0f);
+    EXPECT_FLOAT_EQ(value.b, 8.0f);
+    EXPECT_EQ(value.counter, 9u);
+}
+
+TEST(SeqLock, ConcurrentReadersNeverSeeTornValues)
+{
+    SeqLock<Snapshot> lock;
+    std::atomic<bool> done = false;
+
+    std::thread writer([&]() {
+        for (uint64_t i = 1; i <= 50000; ++i)
+        {
+            const auto value = static_cast<float>(i);
+            lock.Store(Snapshot{ value, -value, i });
+        }
+        done.store(true);
+    });
+
+    bool consistent = true;
+    uint64_t lastCounter = 0;
+    bool monotonic = true;
+    while (!done.load())
+    {
+        Snapshot value = lock.Load();
+        consistent = consistent && (value.a == -value.b) && (value.a == static_cast<float>(value.counter));
+        monotonic = monotonic && (value.counter >= lastCounter);
+        lastCounter = value.counter;
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(monotonic);
+    EXPECT_EQ(lock.Load().counter, 50000u);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include <SignalGate.h>
+
+using PrecisionTuner::Audio::SignalGate;
+using PrecisionTuner::Audio::SignalGateConfig;
+
+namespace
+{
+    constexpr float kSampleRate = 48000.0f;
+    constexpr size_t kHop = 512;
+    constexpr float kHopSeconds = static_cast<float>(kHop) / kSampleRate;
+
+    /// One hop of a sine at the given RMS level (dBFS)
+    std::vector<float> Tone(float levelDb)
+    {
+        const float amplitude = std::sqrt(2.0f) * std::pow(10.0f, levelDb / 20.0f);
+        std::vector<float> hop(kHop);
+        for (size_t i = 0; i < hop.size(); ++i)
+        {
+            hop[i] = amplitude * std::sin(2.0f * std::numbers::pi_v<float> * 440.0f * i / kSampleRate);
+        }
+        return hop;
+    }
+
+    /// Feeds the same hop repeatedly, returning the gate state after the last one
+    bool Feed(SignalGate &gate, const std::vector<float> &hop, int hops)
+    {
+        bool open = false;
+        for (int i = 0; i < hops; ++i)
+        {
+            open = gate.Process(hop);
+        }
+        return open;
+    }
+} // namespace
+
+TEST(SignalGate, MeasuresRmsLevel)
+{
+    EXPECT_NEAR(SignalGate::MeasureLevelDb(Tone(-20.0f)), -20.0f, 0.1f);
+    EXPECT_EQ(SignalGate::MeasureLevelDb(std::vector<float>(kHop, 0.0f)), SignalGate::kSilenceDb);
+    EXPECT_EQ(SignalGate::MeasureLevelDb({}), SignalGate::kSilenceDb);
+}
+
+TEST(SignalGate, CalibratesToBackgroundNoise)
+{
+    SignalGate gate({}, kHopSeconds);
+    EXPECT_TRUE(gate.IsCalibrating());
+
+    EXPECT_FALSE(Feed(gate, Tone(-60.0f), 100));
+    EXPECT_FALSE(gate.IsCalibrating());
+    EXPECT_NEAR(gate.GetNoiseFloorDb(), -60.0f, 0.5f);
+
+    // A note well above the floor opens the gate on its first hop
+    EXPECT_TRUE(gate.Process(Tone(-30.0f)));
+}
+
+TEST(SignalGate, HysteresisKeepsDecayingNoteOpen)
+{
+    SignalGateConfig config;
+    config.holdSeconds = 0.0f;
+    SignalGate gate(config, kHopSeconds);
+    (void)Feed(gate, Tone(-60.0f), 100);
+
+    EXPECT_TRUE(gate.Process(Tone(-45.0f)));  // floor + 15 dB: opens
+    EXPECT_TRUE(gate.Process(Tone(-53.0f)));  // floor + 7 dB: between close and open margins, stays open
+    EXPECT_FALSE(gate.Process(Tone(-57.0f))); // floor + 3 dB: closes
+    EXPECT_FALSE(gate.Process(Tone(-53.0f))); // floor + 7 dB: not enough to reopen
+}
+
+TEST(SignalGate, HoldsOpenBrieflyAfterLevelDrops)
+{
+    SignalGateConfig config;
+    config.holdSeconds = 2.0f * kHopSeconds;
+    SignalGate gate(config, kHopSeconds);
+    (void)Feed(gate, Tone(-60.0f), 100);
+
+    EXPECT_TRUE(gate.Process(Tone(-30.0f)));
+    EXPECT_TRUE(gate.Process(Tone(-60.0f)));
+    EXPECT_TRUE(gate.Process(Tone(-60.0f)));
+    EXPECT_FALSE(gate.Process(Tone(-60.0f)));
+}
+
+TEST(SignalGate, FloorFollowsRisingNoiseSlowly)
+{
+    SignalGate gate({}, kHopSeconds);
+    (void)Feed(gate, Tone(-70.0f), 100);
+
+    // Noise rising by less than the open margin never opens the gate, and the floor catches up
+    const auto louderNoise = Tone(-62.0f);
+    EXPECT_FALSE(Feed(gate, louderNoise, 400));
+    EXPECT_NEAR(gate.GetNoiseFloorDb(), -62.0f, 0.5f);
+}
+
+TEST(SignalGate, FloorStaysWithinBounds)
+{
+    SignalGate gate({}, kHopSeconds);
+
+    // Digital silence: the floor stops at minFloorDb, so a faint signal still has to clear it
+    EXPECT_FALSE(Feed(gate, std::vector<float>(kHop, 0.0f), 100));
+    EXPECT_FLOAT_EQ(gate.GetNoiseFloorDb(), SignalGateConfig{}.minFloorDb);
+
+    // A loud calibration period (playing at startup) cannot raise the floor past maxFloorDb
+    SignalGate loudStart({}, kHopSeconds);
+    EXPECT_TRUE(Feed(loudStart, Tone(-10.0f), 100));
+    EXPECT_LE(loudStart.GetNoiseFloorDb(), SignalGateConfig{}.maxFloorDb);
+}
+
+TEST(SignalGate, DisabledGateAlwaysOpen)
+{
+    SignalGateConfig config;
+    config.enabled = false;
+    SignalGate gate(config, kHopSeconds);
+
+    EXPECT_TRUE(gate.IsOpen());
+    EXPECT_TRUE(Feed(gate, std::vector<float>(kHop, 0.0f), 10));
+}
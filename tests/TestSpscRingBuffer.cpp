@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <thread>
+#include <vector>
+#include <SpscRingBuffer.h>
+
+using PrecisionTuner::Audio::SpscRingBuffer;
+
+TEST(SpscRingBuffer, RoundsCapacityUpToPowerOfTwo)
+{
+    SpscRingBuffer<float> ring(1000);
+    EXPECT_EQ(ring.Capacity(), 1024u);
+    EXPECT_EQ(ring.AvailableToRead(), 0u);
+    EXPECT_EQ(ring.AvailableToWrite(), 1024u);
+}
+
+TEST(SpscRingBuffer, WriteThenReadPreservesOrder)
+{
+    SpscRingBuffer<float> ring(8);
+    std::vector<float> input = { 1.0f, 2.0f, 3.0f };
+    std::vector<float> output(3, 0.0f);
+
+    EXPECT_EQ(ring.Write(input), 3u);
+    EXPECT_EQ(ring.AvailableToRead(), 3u);
+    EXPECT_EQ(ring.Read(output), 3u);
+    EXPECT_EQ(output, input);
+    EXPECT_EQ(ring.AvailableToRead(), 0u);
+}
+
+TEST(SpscRingBuffer, WrapsAroundEnd)
+{
+    SpscRingBuffer<float> ring(8);
+    std::vector<float> first(6, 0.0f);
+    std::vector<float> scratch(6);
+    ASSERT_EQ(ring.Write(first), 6u);
+    ASSERT_EQ(ring.Read(scratch), 6u);
+
+    // Next write straddles the end of the storage
+    std::vector<float> input(5);
+    std::iota(input.begin(), input.end(), 10.0f);
+    std::vector<float> output(5, 0.0f);
+
+    EXPECT_EQ(ring.Write(input), 5u);
+    EXPECT_EQ(ring.Read(output), 5u);
+    EXPECT_EQ(output, input);
+}
+
+TEST(SpscRingBuffer, WriteStopsWhenFull)
+{
+    SpscRingBuffer<float> ring(4);
+    std::vector<float> input(6, 1.0f);
+
+    EXPECT_EQ(ring.Write(input), 4u);
+    EXPECT_EQ(ring.AvailableToWrite(), 0u);
+    EXPECT_EQ(ring.Write(input), 0u);
+}
+
+TEST(SpscRingBuffer, DiscardSkipsSamples)
+{
+    SpscRingBuffer<float> ring(8);
+    std::vector<float> input = { 1.0f, 2.0f, 3.0f, 4.0f };
+    std::vector<float> output(2, 0.0f);
+    ring.Write(input);
+
+    EXPECT_EQ(ring.Discard(2), 2u);
+    EXPECT_EQ(ring.Read(output), 2u);
+    EXPECT_FLOAT_EQ(output[0], 3.0f);
+    EXPECT_FLOAT_EQ(output[1], 4.0f);
+    EXPECT_EQ(ring.Discard(10), 0u);
+}
+
+TEST(SpscRingBuffer, PrepareWriteSplitsAtWrapPoint)
+{
+    SpscRingBuffer<float> ring(8);
+    std::vector<float> scratch(6, 0.0f);
+    ASSERT_EQ(ring.Write(scratch), 6u);
+    ASSERT_EQ(ring.Read(scratch), 6u);
+
+    auto regions = ring.PrepareWrite(5);
+    ASSERT_EQ(regions[0].size(), 2u);
+    ASSERT_EQ(regions[1].size(), 3u);
+    EXPECT_EQ(ring.AvailableToRead(), 0u); // Not visible before commit
+
+    float next = 10.0f;
+    for (std::span<float> region : regions)
+    {
+        for (float &sample : region)
+        {
+            sample = next++;
+        }
+    }
+    ring.CommitWrite(5);
+
+    std::vector<float> output(5, 0.0f);
+    EXPECT_EQ(ring.Read(output), 5u);
+    EXPECT_EQ(output, (std::vector<float>{ 10.0f, 11.0f, 12.0f, 13.0f, 14.0f }));
+}
+
+TEST(SpscRingBuffer, PrepareWriteIsLimitedByFreeSpace)
+{
+    SpscRingBuffer<float> ring(4);
+    std::vector<float> input(3, 1.0f);
+    ASSERT_EQ(ring.Write(input), 3u);
+
+    auto regions = ring.PrepareWrite(10);
+    EXPECT_EQ(regions[0].size() + regions[1].size(), 1u);
+
+    ASSERT_EQ(ring.Write(input), 1u);
+    regions = ring.PrepareWrite(10);
+    EXPECT_TRUE(regions[0].empty());
+    EXPECT_TRUE(regions[1].empty());
+}
+
+TEST(SpscRingBuffer, UsesCallerProvidedStorage)
+{
+    std::vector<float> storage(12, -1.0f);
+    SpscRingBuffer<float> ring(64);
+    ring.Reset(std::span<float>(storage));
+    EXPECT_EQ(ring.Capacity(), 8u); // Largest power-of-two prefix
+    EXPECT_EQ(SpscRingBuffer<float>::CapacityFor(12), 16u);
+
+    std::vector<float> input = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f };
+    EXPECT_EQ(ring.Write(input), 8u);
+    EXPECT_FLOAT_EQ(storage[7], 8.0f);
+    EXPECT_FLOAT_EQ(storage[8], -1.0f); // Past the prefix: never touched
+
+    std::vector<float> output(8);
+    EXPECT_EQ(ring.Read(output), 8u);
+    EXPECT_EQ(output, std::vector<float>(input.begin(), input.begin() + 8));
+}
+
+TEST(SpscRingBuffer, ConcurrentProducerConsumerKeepsSequence)
+{
+    SpscRingBuffer<int> ring(64);
+    constexpr int kTotal = 20000;
+
+    std::thread producer([&ring]() {
+        int next = 0;
+        std::vector<int> block(7);
+        while (next < kTotal)
+        {
+            size_t count = 0;
+            for (; count < block.size() && next + static_cast<int>(count) < kTotal; ++count)
+            {
+                block[count] = next + static_cast<int>(count);
+            }
+            next += static_cast<int>(ring.Write(std::span<const int>(block.data(), count)));
+        }
+    });
+
+    int expected = 0;
+    bool inOrder = true;
+    std::vector<int> block(5);
+    while (expected < kTotal)
+    {
+        size_t count = ring.Read(block);
+        for (size_t i = 0; i < count; ++i)
+        {
+            inOrder = inOrder && (block[i] == expected);
+            ++expected;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+}
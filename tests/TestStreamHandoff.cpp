@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <StreamHandoff.h>
+
+using PrecisionTuner::Audio::ApplyGainRamp;
+using PrecisionTuner::Audio::StreamHandoff;
+
+TEST(StreamHandoff, InitialSlotIsActive)
+{
+    StreamHandoff handoff(0);
+
+    EXPECT_EQ(handoff.Active(), 0u);
+    EXPECT_TRUE(handoff.IsActive(0));
+    EXPECT_FALSE(handoff.IsActive(1));
+    EXPECT_EQ(handoff.Successor(0), StreamHandoff::kNoSlot);
+}
+
+TEST(StreamHandoff, HandsOffOnlyAfterOffer)
+{
+    StreamHandoff handoff(0);
+
+    // Without an offer the active stream keeps ownership
+    handoff.HandOff(handoff.Successor(0));
+    EXPECT_TRUE(handoff.IsActive(0));
+
+    handoff.Offer(1);
+    const uint32_t successor = handoff.Successor(0);
+    ASSERT_EQ(successor, 1u);
+    EXPECT_TRUE(handoff.IsActive(0)); // Still the old stream until the end of its buffer
+
+    handoff.HandOff(successor);
+    EXPECT_TRUE(handoff.IsActive(1));
+    EXPECT_EQ(handoff.Successor(1), StreamHandoff::kNoSlot); // The new stream never hands off to itself
+
+    handoff.Complete(1);
+    EXPECT_TRUE(handoff.IsActive(1));
+    EXPECT_EQ(handoff.Successor(1), StreamHandoff::kNoSlot);
+}
+
+TEST(StreamHandoff, CompleteForcesSwapWithoutHandoff)
+{
+    StreamHandoff handoff(1);
+    handoff.Offer(0);
+
+    // Old stream stalled and was stopped: the switching thread takes over
+    handoff.Complete(0);
+    EXPECT_TRUE(handoff.IsActive(0));
+    EXPECT_EQ(handoff.Successor(0), StreamHandoff::kNoSlot);
+}
+
+TEST(StreamHandoff, ConcurrentStreamsNeverShareOwnership)
+{
+    StreamHandoff handoff(0);
+    std::atomic<bool> stop = false;
+    uint64_t sharedCounter = 0; // Plain on purpose: only the owning stream may touch it
+    std::array<std::atomic<uint64_t>, 2> ownedBuffers = {};
+
+    auto streamThread = [&](uint32_t slot) {
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            if (!handoff.IsActive(slot))
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            const uint32_t successor = handoff.Successor(slot);
+            ++sharedCounter;
+            ownedBuffers[slot].fetch_add(1, std::memory_order_relaxed);
+            handoff.HandOff(successor);
+        }
+    };
+
+    std::thread oldStream(streamThread, 0u);
+    std::thread newStream(streamThread, 1u);
+
+    while (ownedBuffers[0].load(std::memory_order_relaxed) == 0)
+    {
+        std::this_thread::yield();
+    }
+    handoff.Offer(1);
+    while (!handoff.IsActive(1))
+    {
+        std::this_thread::yield();
+    }
+
+    stop.store(true, std::memory_order_relaxed);
+    oldStream.join();
+    newStream.join();
+    handoff.Complete(1);
+
+    EXPECT_EQ(sharedCounter, ownedBuffers[0].load() + ownedBuffers[1].load());
+    EXPECT_TRUE(handoff.IsActive(1));
+}
+
+TEST(ApplyGainRamp, RampsInterleavedFrames)
+{
+    std::vector<float> stereo(8, 1.0f);
+    ApplyGainRamp(stereo, 2, 0.0f, 1.0f);
+
+    const std::vector<float> expected = { 0.0f, 0.0f, 0.25f, 0.25f, 0.5f, 0.5f, 0.75f, 0.75f };
+    for (size_t i = 0; i < stereo.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(stereo[i], expected[i]) << "sample " << i;
+    }
+}
+
+TEST(ApplyGainRamp, FadeOutEndsNearSilence)
+{
+    std::vector<float> mono(512, 1.0f);
+    ApplyGainRamp(mono, 1, 1.0f, 0.0f);
+
+    EXPECT_FLOAT_EQ(mono.front(), 1.0f);
+    EXPECT_LT(mono.back(), 0.01f);
+}
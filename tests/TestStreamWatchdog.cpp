@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <StreamWatchdog.h>
+
+using PrecisionTuner::Audio::StreamStatus;
+using PrecisionTuner::Audio::StreamWatchdog;
+using PrecisionTuner::Audio::StreamWatchdogConfig;
+using PrecisionTuner::Audio::WatchdogAction;
+using namespace std::chrono_literals;
+
+namespace
+{
+    constexpr auto kBufferPeriod = 5ms;
+
+    StreamWatchdogConfig Enabled()
+    {
+        StreamWatchdogConfig config;
+        config.enabled = true;
+        config.stallBuffers = 4; // 20 ms
+        config.startupMs = 100;
+        config.restartAttempts = 2;
+        config.backoffMs = 50;
+        config.maxBackoffMs = 120;
+        return config;
+    }
+} // namespace
+
+TEST(StreamWatchdog, StaysIdleUntilArmedOrFed)
+{
+    StreamWatchdog watchdog(Enabled(), kBufferPeriod);
+    const auto start = StreamWatchdog::Clock::time_point{};
+
+    EXPECT_EQ(watchdog.Observe(0, start + 10s), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Health().status, StreamStatus::Idle);
+
+    // The first buffer starts the watch
+    EXPECT_EQ(watchdog.Observe(1, start + 10s), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Health().status, StreamStatus::Running);
+    EXPECT_EQ(watchdog.StallTimeout(), 20ms);
+}
+
+TEST(StreamWatchdog, FlagsStallAfterConfiguredBufferPeriods)
+{
+    StreamWatchdog watchdog(Enabled(), kBufferPeriod);
+    const auto start = StreamWatchdog::Clock::time_point{};
+
+    watchdog.Arm(start);
+    EXPECT_EQ(watchdog.Observe(0, start + 99ms), WatchdogAction::None); // Startup time for the first buffer
+    EXPECT_EQ(watchdog.Observe(1, start + 100ms), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Observe(1, start + 119ms), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Health().status, StreamStatus::Running);
+
+    EXPECT_EQ(watchdog.Observe(1, start + 120ms), WatchdogAction::Restart);
+    EXPECT_EQ(watchdog.Health().status, StreamStatus::Stalled);
+    EXPECT_EQ(watchdog.Health().stalls, 1u);
+    EXPECT_EQ(watchdog.Health().attempts, 1u);
+}
+
+TEST(StreamWatchdog, BacksOffAndFallsBackToDefaultDevice)
+{
+    StreamWatchdog watchdog(Enabled(), kBufferPeriod);
+    const auto start = StreamWatchdog::Clock::time_point{};
+    watchdog.Arm(start);
+    ASSERT_EQ(watchdog.Observe(1, start), WatchdogAction::None);
+
+    // Attempt 1 right away; each next one after the startup time plus 0, 50, 100, 120 (capped) ms
+    auto now = start + 20ms;
+    EXPECT_EQ(watchdog.Observe(1, now), WatchdogAction::Restart);
+    EXPECT_EQ(watchdog.Observe(1, now + 99ms), WatchdogAction::None);
+    now += 100ms;
+    EXPECT_EQ(watchdog.Observe(1, now), WatchdogAction::Restart);
+    EXPECT_EQ(watchdog.Observe(1, now + 149ms), WatchdogAction::None);
+    now += 150ms;
+    EXPECT_EQ(watchdog.Observe(1, now), WatchdogAction::FallBack);
+    now += 200ms;
+    EXPECT_EQ(watchdog.Observe(1, now), WatchdogAction::FallBack);
+    EXPECT_EQ(watchdog.Observe(1, now + 219ms), WatchdogAction::None);
+    now += 220ms;
+    EXPECT_EQ(watchdog.Observe(1, now), WatchdogAction::FallBack);
+
+    EXPECT_EQ(watchdog.Health().stalls, 1u);
+    EXPECT_EQ(watchdog.Health().attempts, 5u);
+    EXPECT_EQ(watchdog.Health().fallbacks, 3u);
+}
+
+TEST(StreamWatchdog, RecordsRecoveryWhenBuffersResume)
+{
+    StreamWatchdog watchdog(Enabled(), kBufferPeriod);
+    const auto start = StreamWatchdog::Clock::time_point{};
+    watchdog.Arm(start);
+    ASSERT_EQ(watchdog.Observe(10, start), WatchdogAction::None);
+    ASSERT_EQ(watchdog.Observe(10, start + 30ms), WatchdogAction::Restart);
+
+    EXPECT_EQ(watchdog.Observe(11, start + 75ms), WatchdogAction::None);
+    const auto &health = watchdog.Health();
+    EXPECT_EQ(health.status, StreamStatus::Running);
+    EXPECT_EQ(health.heartbeats, 11u);
+    EXPECT_EQ(health.recoveries, 1u);
+    EXPECT_EQ(health.attempts, 0u);
+    EXPECT_DOUBLE_EQ(health.lastOutageMs, 75.0);
+    EXPECT_DOUBLE_EQ(health.lastRecoveryMs, 45.0);
+    EXPECT_DOUBLE_EQ(health.maxRecoveryMs, 45.0);
+
+    // A later stall starts over with a restart on the same device
+    EXPECT_EQ(watchdog.Observe(11, start + 95ms), WatchdogAction::Restart);
+    EXPECT_EQ(watchdog.Health().stalls, 2u);
+}
+
+TEST(StreamWatchdog, DisabledNeverActs)
+{
+    StreamWatchdog watchdog(StreamWatchdogConfig{}, kBufferPeriod);
+    const auto start = StreamWatchdog::Clock::time_point{};
+    watchdog.Arm(start);
+    EXPECT_EQ(watchdog.Observe(1, start), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Observe(1, start + 1h), WatchdogAction::None);
+    EXPECT_EQ(watchdog.Health().status, StreamStatus::Idle);
+    EXPECT_EQ(watchdog.Health().heartbeats, 1u);
+}
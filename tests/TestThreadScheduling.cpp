@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cerrno>
+#include <thread>
+#include <ThreadScheduling.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+using PrecisionTuner::Audio::ApplyThreadScheduling;
+using PrecisionTuner::Audio::LockProcessMemory;
+using PrecisionTuner::Audio::SchedulingOutcome;
+using PrecisionTuner::Audio::ThreadSchedulingPolicy;
+using PrecisionTuner::Audio::ThreadSchedulingResult;
+
+namespace
+{
+    /// Applies a policy on a throwaway thread so the test runner's own scheduling is never changed
+    ThreadSchedulingResult ApplyOnWorker(const ThreadSchedulingPolicy &policy)
+    {
+        ThreadSchedulingResult result;
+        std::thread([&] { result = ApplyThreadScheduling(policy); }).join();
+        return result;
+    }
+
+#if defined(__linux__)
+    /// First CPU this process may run on
+    uint32_t AllowedCpu()
+    {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        (void)sched_getaffinity(0, sizeof(allowed), &allowed);
+        for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                return cpu;
+            }
+        }
+        return 0;
+    }
+#endif
+} // namespace
+
+TEST(ThreadScheduling, NothingRequestedLeavesThreadAlone)
+{
+    const ThreadSchedulingResult result = ApplyOnWorker({});
+
+    EXPECT_TRUE(result.applied);
+    EXPECT_EQ(result.priority, SchedulingOutcome::NotRequested);
+    EXPECT_EQ(result.affinity, SchedulingOutcome::NotRequested);
+    EXPECT_EQ(LockProcessMemory(false).outcome, SchedulingOutcome::NotRequested);
+}
+
+TEST(ThreadScheduling, ResultSurvivesDiagnosticPacking)
+{
+    const ThreadSchedulingResult result{ .priority = SchedulingOutcome::FellBack,
+        .affinity = SchedulingOutcome::Granted,
+        .applied = true,
+        .grantedPriority = 40,
+        .pinnedCpus = 3,
+        .error = EPERM };
+
+    const auto unpacked = ThreadSchedulingResult::Unpack(result.Pack(), static_cast<uint64_t>(result.error));
+    EXPECT_EQ(unpacked.priority, SchedulingOutcome::FellBack);
+    EXPECT_EQ(unpacked.affinity, SchedulingOutcome::Granted);
+    EXPECT_TRUE(unpacked.applied);
+    EXPECT_EQ(unpacked.grantedPriority, 40);
+    EXPECT_EQ(unpacked.pinnedCpus, 3u);
+    EXPECT_EQ(unpacked.error, EPERM);
+}
+
+TEST(ThreadScheduling, RealtimeRequestAlwaysReportsAnOutcome)
+{
+    // Whether SCHED_FIFO is allowed depends on the machine; either way the outcome must say so
+    const ThreadSchedulingResult result = ApplyOnWorker({ .realtime = true, .priority = 1, .cpus = {} });
+
+    EXPECT_NE(result.priority, SchedulingOutcome::NotRequested);
+    if (result.priority == SchedulingOutcome::Granted)
+    {
+        EXPECT_EQ(result.grantedPriority, 1);
+    }
+    else if (result.priority == SchedulingOutcome::Denied)
+    {
+        EXPECT_NE(result.error, 0);
+        EXPECT_EQ(result.grantedPriority, 0);
+    }
+}
+
+#if defined(__linux__)
+TEST(ThreadScheduling, PinsToAllowedCpu)
+{
+    const ThreadSchedulingResult result = ApplyOnWorker({ .cpus = { AllowedCpu() } });
+
+    EXPECT_EQ(result.affinity, SchedulingOutcome::Granted);
+    EXPECT_EQ(result.pinnedCpus, 1u);
+}
+
+TEST(ThreadScheduling, UnknownCpusAreDenied)
+{
+    const ThreadSchedulingResult result = ApplyOnWorker({ .cpus = { 100000 } });
+
+    EXPECT_EQ(result.affinity, SchedulingOutcome::Denied);
+    EXPECT_EQ(result.error, EINVAL);
+}
+
+TEST(ThreadScheduling, PartlyUnknownCpusFallBack)
+{
+    const ThreadSchedulingResult result = ApplyOnWorker({ .cpus = { AllowedCpu(), 100000 } });
+
+    EXPECT_EQ(result.affinity, SchedulingOutcome::FellBack);
+    EXPECT_EQ(result.pinnedCpus, 1u);
+}
+#endif
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <TripleBuffer.h>
+
+using PrecisionTuner::Audio::kCacheLineSize;
+using PrecisionTuner::Audio::TripleBuffer;
+
+namespace
+{
+    struct Parameters
+    {
+        float frequency = 0.0f;
+        float volume = 0.0f;
+        uint64_t version = 0;
+    };
+} // namespace
+
+TEST(TripleBuffer, ReadsInitialValueUntilUpdate)
+{
+    TripleBuffer<Parameters> buffer(Parameters{ 440.0f, 0.5f, 0 });
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_FLOAT_EQ(buffer.Read().frequency, 440.0f);
+
+    buffer.Write(Parameters{ 220.0f, 0.25f, 1 });
+    EXPECT_FLOAT_EQ(buffer.Read().frequency, 440.0f); // Nothing changes until the reader asks
+    EXPECT_TRUE(buffer.Update());
+    EXPECT_FLOAT_EQ(buffer.Read().frequency, 220.0f);
+    EXPECT_FALSE(buffer.Update());
+    EXPECT_EQ(buffer.Read().version, 1u);
+}
+
+TEST(TripleBuffer, ReaderSkipsToNewestValue)
+{
+    TripleBuffer<Parameters> buffer;
+    for (uint64_t version = 1; version <= 5; ++version)
+    {
+        buffer.Write(Parameters{ static_cast<float>(version), 0.0f, version });
+    }
+    EXPECT_TRUE(buffer.Update());
+    EXPECT_EQ(buffer.Read().version, 5u);
+
+    // Writes after an update land in the slots the reader is not using
+    buffer.Write(Parameters{ 6.0f, 0.0f, 6 });
+    EXPECT_EQ(buffer.Read().version, 5u);
+    buffer.Write(Parameters{ 7.0f, 0.0f, 7 });
+    EXPECT_TRUE(buffer.Update());
+    EXPECT_EQ(buffer.Read().version, 7u);
+}
+
+TEST(TripleBuffer, KeepsSlotsOnSeparateCacheLines)
+{
+    TripleBuffer<Parameters> buffer;
+    EXPECT_EQ(alignof(TripleBuffer<Parameters>), kCacheLineSize);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(&buffer.Read()) % kCacheLineSize, 0u);
+
+    // Values written after an update land in other slots, each starting a line of its own
+    const Parameters *front = &buffer.Read();
+    buffer.Write(Parameters{ 1.0f, 0.0f, 1 });
+    EXPECT_TRUE(buffer.Update());
+    const auto distance = reinterpret_cast<const char *>(&buffer.Read()) - reinterpret_cast<const char *>(front);
+    EXPECT_EQ(static_cast<size_t>(distance < 0 ? -distance : distance) % kCacheLineSize, 0u);
+    EXPECT_NE(distance, 0);
+}
+
+TEST(TripleBuffer, ConcurrentReaderNeverSeesTornOrOlderValues)
+{
+    TripleBuffer<Parameters> buffer;
+    std::atomic<bool> done = false;
+
+    std::thread writer([&]() {
+        for (uint64_t version = 1; version <= 50000; ++version)
+        {
+            const auto value = static_cast<float>(version);
+            buffer.Write(Parameters{ value, -value, version });
+        }
+        done.store(true);
+    });
+
+    bool consistent = true;
+    bool monotonic = true;
+    uint64_t lastVersion = 0;
+    while (!done.load())
+    {
+        (void)buffer.Update();
+        const Parameters &value = buffer.Read();
+        consistent = consistent && value.frequency == -value.volume
+                     && value.frequency == static_cast<float>(value.version);
+        monotonic = monotonic && value.version >= lastVersion;
+        lastVersion = value.version;
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_TRUE(monotonic);
+    EXPECT_TRUE(buffer.Update() || buffer.Read().version == 50000u);
+    EXPECT_EQ(buffer.Read().version, 50000u);
+}
@@ -11,6 +11,7 @@ bool MockAudioDevice::Open(uint32_t deviceId,
     GuitarIO::AudioCallback userCallback,
     void *userPtr)
 {
+    std::lock_guard<std::mutex> lock(callbackMutex);
     this->config = config;
     this->callback = userCallback;
     this->userPtr = userPtr;
@@ -37,6 +38,7 @@ bool MockAudioDevice::Start()
 
 bool MockAudioDevice::Stop()
 {
+    std::lock_guard<std::mutex> lock(callbackMutex);
     isRunning = false;
     callback = nullptr;
     userPtr = nullptr;
@@ -76,6 +78,7 @@ void MockAudioDevice::SetStartResult(bool result)
 
 int MockAudioDevice::TriggerCallback(std::span<const float> input, std::span<float> output)
 {
+    std::lock_guard<std::mutex> lock(callbackMutex);
     if (callback && isRunning)
     {
         return callback(input, output, userPtr);
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <span>
 #include <string>
 #include <AudioDevice.h>
@@ -10,6 +12,9 @@
  * Provides a controllable audio device for unit testing audio processing
  * components without requiring real hardware. Supports simulating device
  * operations, callback triggering, and error conditions.
+ *
+ * Like a real device, Stop()/Close() wait for a callback in flight, so a test thread
+ * may trigger callbacks while another thread (e.g. a device switch) stops the stream.
  */
 class MockAudioDevice : public GuitarIO::AudioDevice
 {
@@ -105,12 +110,13 @@ public:
     const GuitarIO::AudioStreamConfig &GetConfig() const;
 
 private:
-    bool isOpen;
-    bool isRunning;
+    std::atomic<bool> isOpen;
+    std::atomic<bool> isRunning;
     bool openResult;
     bool startResult;
 
     GuitarIO::AudioStreamConfig config;
     GuitarIO::AudioCallback callback;
     void *userPtr;
+    std::mutex callbackMutex; ///< Serializes callbacks with Open/Stop, like a real stream thread
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <random>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Renders a sequence of synthetic guitar plucks
+ *
+ * Each pluck is a short burst of pick noise on top of an exponentially decaying sine.
+ * The previous string keeps ringing quietly underneath the next pluck, the way an
+ * undamped string does when tuning string after string, so a pitch stabilizer that is
+ * not reset at the onset drags the old pitch into the new note.
+ *
+ * @param frequencies Fundamental of each pluck, in order
+ * @param sampleRate Sample rate in Hz
+ * @param samplesPerPluck Length of each note
+ * @param leadInSamples Silence before the first pluck
+ * @param seed Seed of the pick noise (same seed, same signal)
+ * @return Mono signal
+ */
+inline std::vector<float> RenderPlucks(std::span<const float> frequencies,
+    uint32_t sampleRate,
+    size_t samplesPerPluck,
+    size_t leadInSamples,
+    uint32_t seed = 7)
+{
+    constexpr float kAmplitude = 0.5f;     // New string
+    constexpr float kRingAmplitude = 0.1f; // Previous string still ringing
+    constexpr float kDecaySeconds = 0.6f;  // Time constant of the decay
+    constexpr float kPickSeconds = 0.005f; // Length of the pick noise burst
+    constexpr float kPickAmplitude = 0.3f;
+
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    const auto pickSamples = static_cast<size_t>(kPickSeconds * static_cast<float>(sampleRate));
+
+    std::vector<float> signal(leadInSamples, 0.0f);
+    signal.reserve(leadInSamples + frequencies.size() * samplesPerPluck);
+    float previous = 0.0f;
+    for (const float frequency : frequencies)
+    {
+        for (size_t i = 0; i < samplesPerPluck; ++i)
+        {
+            const float t = static_cast<float>(i) / static_cast<float>(sampleRate);
+            const float envelope = std::exp(-t / kDecaySeconds);
+            float sample = kAmplitude * envelope * std::sin(2.0f * std::numbers::pi_v<float> * frequency * t);
+            if (previous > 0.0f)
+            {
+                sample += kRingAmplitude * envelope * std::sin(2.0f * std::numbers::pi_v<float> * previous * t);
+            }
+            if (i < pickSamples)
+            {
+                sample += kPickAmplitude * noise(random);
+            }
+            signal.push_back(sample);
+        }
+        previous = frequency;
+    }
+    return signal;
+}